@@ -201,12 +201,21 @@ ifneq ("$(wildcard $(KEYMAP_JSON))", "")
     INFO_RULES_MK = $(shell $(QMK_BIN) generate-rules-mk --quiet --escape --output $(INTERMEDIATE_OUTPUT)/src/rules.mk $(KEYMAP_JSON))
     include $(INFO_RULES_MK)
 
+    JSON2C_OPTS = $(if $(filter yes,$(strip $(SPARSE_KEYMAP_ENABLE))),--sparse)
+
 # Add rules to generate the keymap files - indentation here is important
-$(INTERMEDIATE_OUTPUT)/src/keymap.c: $(KEYMAP_JSON)
+$(INTERMEDIATE_OUTPUT)/src/keymap.c: $(KEYMAP_JSON) $(INTERMEDIATE_OUTPUT)/src/json2c_opts.txt
 	@$(SILENT) || printf "$(MSG_GENERATING) $@" | $(AWK_CMD)
-	$(eval CMD=$(QMK_BIN) json2c --quiet --output $(KEYMAP_C) $(KEYMAP_JSON))
+	$(eval CMD=$(QMK_BIN) json2c --quiet $(JSON2C_OPTS) --output $(KEYMAP_C) $(KEYMAP_JSON))
 	@$(BUILD_CMD)
 
+# Only touched when the json2c options change, so that toggling SPARSE_KEYMAP_ENABLE regenerates keymap.c
+$(INTERMEDIATE_OUTPUT)/src/json2c_opts.txt: $(INTERMEDIATE_OUTPUT)/src/force
+	@mkdir -p $(@D)
+	@echo '$(JSON2C_OPTS)' | cmp -s - $@ || echo '$(JSON2C_OPTS)' > $@
+
+$(INTERMEDIATE_OUTPUT)/src/force:
+
 $(INTERMEDIATE_OUTPUT)/src/config.h: $(KEYMAP_JSON)
 	@$(SILENT) || printf "$(MSG_GENERATING) $@" | $(AWK_CMD)
 	$(eval CMD=$(QMK_BIN) generate-config-h --quiet --output $(KEYMAP_H) $(KEYMAP_JSON))
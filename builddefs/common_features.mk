@@ -26,6 +26,7 @@ QUANTUM_SRC += \
     $(QUANTUM_DIR)/keymap_common.c \
     $(QUANTUM_DIR)/keycode_config.c \
     $(QUANTUM_DIR)/sync_timer.c \
+    $(QUANTUM_DIR)/sync_timer_discipline.c \
     $(QUANTUM_DIR)/logging/debug.c \
     $(QUANTUM_DIR)/logging/sendchar.c \
 
@@ -37,6 +38,11 @@ else
     include $(PLATFORM_PATH)/$(PLATFORM_KEY)/printf.mk
 endif
 
+ifeq ($(strip $(DEFERRED_LOG_ENABLE)), yes)
+    OPT_DEFS += -DDEFERRED_LOG_ENABLE
+    QUANTUM_SRC += $(QUANTUM_DIR)/logging/deferred_log.c
+endif
+
 ifeq ($(strip $(DEBUG_MATRIX_SCAN_RATE_ENABLE)), yes)
     OPT_DEFS += -DDEBUG_MATRIX_SCAN_RATE
     CONSOLE_ENABLE = yes
@@ -44,6 +50,20 @@ else ifeq ($(strip $(DEBUG_MATRIX_SCAN_RATE_ENABLE)), api)
     OPT_DEFS += -DDEBUG_MATRIX_SCAN_RATE
 endif
 
+ifeq ($(strip $(TICKLESS_IDLE_ENABLE)), yes)
+    OPT_DEFS += -DTICKLESS_IDLE_ENABLE
+    QUANTUM_SRC += $(QUANTUM_DIR)/tickless_idle.c
+    SRC += $(wildcard $(PLATFORM_PATH)/$(PLATFORM_KEY)/tickless_idle.c)
+endif
+
+ifeq ($(strip $(LATENCY_TRACE_ENABLE)), yes)
+    OPT_DEFS += -DLATENCY_TRACE_ENABLE
+    COMMON_VPATH += $(QUANTUM_DIR)/latency_trace
+    QUANTUM_SRC += \
+        $(QUANTUM_DIR)/latency_trace/latency_trace.c \
+        $(QUANTUM_DIR)/latency_trace/latency_histogram.c
+endif
+
 AUDIO_ENABLE ?= no
 ifeq ($(strip $(AUDIO_ENABLE)), yes)
     ifeq ($(PLATFORM),CHIBIOS)
@@ -58,6 +78,9 @@ ifeq ($(strip $(AUDIO_ENABLE)), yes)
         else ifeq ($(strip $(AUDIO_DRIVER)), pwm_hardware)
             OPT_DEFS += -DAUDIO_DRIVER_PWM
         endif
+    else ifeq ($(PLATFORM)_$(strip $(AUDIO_DRIVER)),TEST_dac_additive)
+        # the test platform renders dac_additive output to memory
+        OPT_DEFS += -DAUDIO_DRIVER_DAC
     else
         # fallback for all other platforms is pwm
         AUDIO_DRIVER ?= pwm_hardware
@@ -70,6 +93,9 @@ ifeq ($(strip $(AUDIO_ENABLE)), yes)
     SRC += $(QUANTUM_DIR)/process_keycode/process_clicky.c
     SRC += $(QUANTUM_DIR)/audio/audio.c ## common audio code, hardware agnostic
     SRC += $(PLATFORM_PATH)/$(PLATFORM_KEY)/$(DRIVER_DIR)/audio_$(strip $(AUDIO_DRIVER)).c
+    ifeq ($(strip $(AUDIO_DRIVER)), dac_additive)
+        SRC += $(QUANTUM_DIR)/audio/dac_additive.c
+    endif
     SRC += $(QUANTUM_DIR)/audio/voices.c
     SRC += $(QUANTUM_DIR)/audio/luts.c
 endif
@@ -113,6 +139,11 @@ ifeq ($(strip $(STENO_ENABLE)), yes)
         endif
 
         SRC += $(QUANTUM_DIR)/process_keycode/process_steno.c
+
+        ifeq ($(strip $(STENO_DICTIONARY_ENABLE)), yes)
+            OPT_DEFS += -DSTENO_DICTIONARY_ENABLE
+            SRC += $(QUANTUM_DIR)/steno_dictionary.c
+        endif
     endif
 endif
 
@@ -282,7 +313,15 @@ ifneq ($(strip $(WEAR_LEVELING_DRIVER)),none)
   endif
 endif
 
-VALID_FLASH_DRIVER_TYPES := spi
+ifeq ($(strip $(AUTOCORRECT_ENABLE)), yes)
+    ifeq ($(strip $(AUTOCORRECT_FLASH_ENABLE)), yes)
+        OPT_DEFS += -DAUTOCORRECT_FLASH_ENABLE
+        FLASH_DRIVER ?= spi
+        SRC += $(QUANTUM_DIR)/process_keycode/autocorrect_flash.c
+    endif
+endif
+
+VALID_FLASH_DRIVER_TYPES := spi custom
 FLASH_DRIVER ?= none
 ifneq ($(strip $(FLASH_DRIVER)), none)
     ifeq ($(filter $(FLASH_DRIVER),$(VALID_FLASH_DRIVER_TYPES)),)
@@ -294,6 +333,9 @@ ifneq ($(strip $(FLASH_DRIVER)), none)
             OPT_DEFS += -DFLASH_DRIVER -DFLASH_SPI
             COMMON_VPATH += $(DRIVER_PATH)/flash
             SRC += flash_spi.c
+        else ifeq ($(strip $(FLASH_DRIVER)),custom)
+            OPT_DEFS += -DFLASH_DRIVER -DFLASH_CUSTOM
+            COMMON_VPATH += $(DRIVER_PATH)/flash
         endif
     endif
 endif
@@ -613,6 +655,11 @@ ifeq ($(strip $(VIA_ENABLE)), yes)
     RAW_ENABLE := yes
     BOOTMAGIC_ENABLE := yes
     TRI_LAYER_ENABLE := yes
+
+    ifeq ($(strip $(VIA_BULK_ENABLE)), yes)
+        OPT_DEFS += -DVIA_BULK_ENABLE
+        SRC += $(QUANTUM_DIR)/via_bulk.c
+    endif
 endif
 
 VALID_MAGIC_TYPES := yes
@@ -23,7 +23,7 @@ along with this program.  If not, see <http://www.gnu.org/licenses/>.
     The slave select pin of the FLASH.
     This needs to be a normal GPIO pin_t value, such as B14.
 */
-#ifndef EXTERNAL_FLASH_SPI_SLAVE_SELECT_PIN
+#if !defined(EXTERNAL_FLASH_SPI_SLAVE_SELECT_PIN) && !defined(FLASH_CUSTOM)
 #    error "No chip select pin defined -- missing EXTERNAL_FLASH_SPI_SLAVE_SELECT_PIN"
 #endif
 
@@ -118,6 +118,7 @@ extern "C" {
 #endif
 
 #include <stdint.h>
+#include <stddef.h>
 
 void flash_init(void);
 
@@ -166,6 +166,13 @@ uint32_t oled_scroll_timeout;
 uint16_t oled_update_timeout;
 #endif
 
+// Inclusive range of modified bytes within each dirty block, so only those need to be rotated and sent.
+// While a block isn't dirty its range covers the whole block, so setting a bit in oled_dirty directly
+// still renders that block in full.
+_Static_assert(OLED_BLOCK_SIZE <= 256, "OLED_BLOCK_SIZE must fit the 8-bit dirty range");
+static uint8_t oled_dirty_start[OLED_BLOCK_COUNT];
+static uint8_t oled_dirty_end[OLED_BLOCK_COUNT] = {[0 ... OLED_BLOCK_COUNT - 1] = OLED_BLOCK_SIZE - 1};
+
 #if defined(OLED_TRANSPORT_SPI)
 #    ifndef OLED_DC_PIN
 #        error "The OLED driver in SPI needs a D/C pin defined"
@@ -204,6 +211,9 @@ __attribute__((weak)) bool oled_send_cmd(const uint8_t *data, uint16_t size) {
     i2c_status_t status = i2c_transmit((OLED_DISPLAY_ADDRESS << 1), data, size, OLED_I2C_TIMEOUT);
 
     return (status == I2C_STATUS_SUCCESS);
+#else
+    // OLED_TRANSPORT = custom, the keyboard is expected to provide this
+    return false;
 #endif
 }
 
@@ -255,6 +265,9 @@ __attribute__((weak)) bool oled_send_data(const uint8_t *data, uint16_t size) {
 #elif defined(OLED_TRANSPORT_I2C)
     i2c_status_t status = i2c_writeReg((OLED_DISPLAY_ADDRESS << 1), I2C_DATA, data, size, OLED_I2C_TIMEOUT);
     return (status == I2C_STATUS_SUCCESS);
+#else
+    // OLED_TRANSPORT = custom, the keyboard is expected to provide this
+    return false;
 #endif
 }
 
@@ -279,6 +292,29 @@ __attribute__((weak)) void oled_driver_init(void) {
 #endif
 }
 
+static void oled_mark_dirty(uint16_t start, uint16_t end) {
+    for (uint16_t block = start / OLED_BLOCK_SIZE; block <= end / OLED_BLOCK_SIZE && block < OLED_BLOCK_COUNT; ++block) {
+        uint16_t        block_start = block * OLED_BLOCK_SIZE;
+        uint8_t         first       = start > block_start ? start - block_start : 0;
+        uint8_t         last        = end - block_start < OLED_BLOCK_SIZE ? end - block_start : OLED_BLOCK_SIZE - 1;
+        OLED_BLOCK_TYPE mask        = (OLED_BLOCK_TYPE)1 << block;
+        if (!(oled_dirty & mask)) {
+            oled_dirty |= mask;
+            oled_dirty_start[block] = first;
+            oled_dirty_end[block]   = last;
+        } else {
+            if (first < oled_dirty_start[block]) oled_dirty_start[block] = first;
+            if (last > oled_dirty_end[block]) oled_dirty_end[block] = last;
+        }
+    }
+}
+
+static void oled_mark_all_dirty(void) {
+    oled_dirty = OLED_ALL_BLOCKS_MASK;
+    memset(oled_dirty_start, 0, sizeof(oled_dirty_start));
+    memset(oled_dirty_end, OLED_BLOCK_SIZE - 1, sizeof(oled_dirty_end));
+}
+
 // Flips the rendering bits for a character at the current cursor position
 static void InvertCharacter(uint8_t *cursor) {
     const uint8_t *end = cursor + OLED_FONT_WIDTH;
@@ -384,13 +420,10 @@ __attribute__((weak)) oled_rotation_t oled_init_user(oled_rotation_t rotation) {
 void oled_clear(void) {
     memset(oled_buffer, 0, sizeof(oled_buffer));
     oled_cursor = &oled_buffer[0];
-    oled_dirty  = OLED_ALL_BLOCKS_MASK;
+    oled_mark_all_dirty();
 }
 
-static void calc_bounds(uint8_t update_start, uint8_t *cmd_array) {
-    // Calculate commands to set memory addressing bounds.
-    uint8_t start_page   = OLED_BLOCK_SIZE * update_start / OLED_DISPLAY_WIDTH;
-    uint8_t start_column = OLED_BLOCK_SIZE * update_start % OLED_DISPLAY_WIDTH;
+static void calc_bounds_window(uint8_t start_page, uint8_t start_column, uint8_t end_page, uint8_t end_column, uint8_t *cmd_array) {
 #if !OLED_IC_HAS_HORIZONTAL_MODE
     // Commands for Page Addressing Mode. Sets starting page and column; has no end bound.
     // Column value must be split into high and low nybble and sent as two commands.
@@ -401,15 +434,25 @@ static void calc_bounds(uint8_t update_start, uint8_t *cmd_array) {
     // Commands for use in Horizontal Addressing mode.
     cmd_array[1] = start_column + OLED_COLUMN_OFFSET;
     cmd_array[4] = start_page;
-    cmd_array[2] = (OLED_BLOCK_SIZE + OLED_DISPLAY_WIDTH - 1) % OLED_DISPLAY_WIDTH + cmd_array[1];
-    cmd_array[5] = (OLED_BLOCK_SIZE + OLED_DISPLAY_WIDTH - 1) / OLED_DISPLAY_WIDTH - 1 + cmd_array[4];
+    cmd_array[2] = end_column + OLED_COLUMN_OFFSET;
+    cmd_array[5] = end_page;
 #endif
 }
 
-static void calc_bounds_90(uint8_t update_start, uint8_t *cmd_array) {
+static void calc_bounds(uint16_t start, uint16_t length, uint8_t *cmd_array) {
+    // Calculate commands to set memory addressing bounds.
+    uint8_t start_page   = start / OLED_DISPLAY_WIDTH;
+    uint8_t start_column = start % OLED_DISPLAY_WIDTH;
+    uint8_t end_column   = (length + OLED_DISPLAY_WIDTH - 1) % OLED_DISPLAY_WIDTH + start_column;
+    uint8_t end_page     = (length + OLED_DISPLAY_WIDTH - 1) / OLED_DISPLAY_WIDTH - 1 + start_page;
+    calc_bounds_window(start_page, start_column, end_page, end_column, cmd_array);
+}
+
+static void calc_bounds_90(uint8_t update_start, uint8_t first_page, uint8_t first_column, uint8_t last_page, uint8_t last_column, uint8_t *cmd_array) {
     // Block numbering starts from the bottom left corner, going up and then to
     // the right.  The controller needs the page and column numbers for the top
-    // left and bottom right corners of that block.
+    // left and bottom right corners of the region of that block being sent,
+    // given relative to the block's own top left corner.
 
     // Total number of pages across the screen height.
     const uint8_t height_in_pages = OLED_DISPLAY_HEIGHT / 8;
@@ -421,19 +464,9 @@ static void calc_bounds_90(uint8_t update_start, uint8_t *cmd_array) {
     // Top page number for a block which is at the bottom edge of the screen.
     const uint8_t bottom_block_top_page = (height_in_pages - page_inc_per_block) % height_in_pages;
 
-#if !OLED_IC_HAS_HORIZONTAL_MODE
-    // Only the Page Addressing Mode is supported
     uint8_t start_page   = bottom_block_top_page - (OLED_BLOCK_SIZE * update_start % OLED_DISPLAY_HEIGHT / 8);
     uint8_t start_column = OLED_BLOCK_SIZE * update_start / OLED_DISPLAY_HEIGHT * 8;
-    cmd_array[0]         = PAM_PAGE_ADDR | start_page;
-    cmd_array[1]         = PAM_SETCOLUMN_LSB | ((OLED_COLUMN_OFFSET + start_column) & 0x0f);
-    cmd_array[2]         = PAM_SETCOLUMN_MSB | ((OLED_COLUMN_OFFSET + start_column) >> 4 & 0x0f);
-#else
-    cmd_array[1] = OLED_BLOCK_SIZE * update_start / OLED_DISPLAY_HEIGHT * 8 + OLED_COLUMN_OFFSET;
-    cmd_array[4] = bottom_block_top_page - (OLED_BLOCK_SIZE * update_start % OLED_DISPLAY_HEIGHT / 8);
-    cmd_array[2] = (OLED_BLOCK_SIZE + OLED_DISPLAY_HEIGHT - 1) / OLED_DISPLAY_HEIGHT * 8 - 1 + cmd_array[1];
-    cmd_array[5] = (OLED_BLOCK_SIZE + OLED_DISPLAY_HEIGHT - 1) % OLED_DISPLAY_HEIGHT / 8 + cmd_array[4];
-#endif
+    calc_bounds_window(start_page + first_page, start_column + first_column, start_page + last_page, start_column + last_column, cmd_array);
 }
 
 uint8_t crot(uint8_t a, int8_t n) {
@@ -469,6 +502,9 @@ void oled_render_dirty(bool all) {
             ++update_start;
         }
 
+        const uint8_t dirty_start = oled_dirty_start[update_start];
+        const uint8_t dirty_end   = oled_dirty_end[update_start];
+
         // Set column & page position
 #if OLED_IC_HAS_HORIZONTAL_MODE
         static uint8_t display_start[] = {I2C_CMD, COLUMN_ADDR, 0, OLED_DISPLAY_WIDTH - 1, PAGE_ADDR, 0, OLED_DISPLAY_HEIGHT / 8 - 1};
@@ -476,20 +512,23 @@ void oled_render_dirty(bool all) {
         static uint8_t display_start[] = {I2C_CMD, PAM_PAGE_ADDR, PAM_SETCOLUMN_LSB, PAM_SETCOLUMN_MSB};
 #endif
         if (!HAS_FLAGS(oled_rotation, OLED_ROTATION_90)) {
-            calc_bounds(update_start, &display_start[1]); // Offset from I2C_CMD byte at the start
-        } else {
-            calc_bounds_90(update_start, &display_start[1]); // Offset from I2C_CMD byte at the start
-        }
+            uint16_t start  = OLED_BLOCK_SIZE * update_start + dirty_start;
+            uint16_t length = dirty_end - dirty_start + 1;
+            // A range which wraps onto the next page can't be addressed as a single run, so send the whole block
+            if (start % OLED_DISPLAY_WIDTH + length > OLED_DISPLAY_WIDTH) {
+                start  = OLED_BLOCK_SIZE * update_start;
+                length = OLED_BLOCK_SIZE;
+            }
+            calc_bounds(start, length, &display_start[1]); // Offset from I2C_CMD byte at the start
 
-        // Send column & page position
-        if (!oled_send_cmd(display_start, ARRAY_SIZE(display_start))) {
-            print("oled_render offset command failed\n");
-            return;
-        }
+            // Send column & page position
+            if (!oled_send_cmd(display_start, ARRAY_SIZE(display_start))) {
+                print("oled_render offset command failed\n");
+                return;
+            }
 
-        if (!HAS_FLAGS(oled_rotation, OLED_ROTATION_90)) {
             // Send render data chunk as is
-            if (!oled_send_data(&oled_buffer[OLED_BLOCK_SIZE * update_start], OLED_BLOCK_SIZE)) {
+            if (!oled_send_data(&oled_buffer[start], length)) {
                 print("oled_render data failed\n");
                 return;
             }
@@ -498,25 +537,61 @@ void oled_render_dirty(bool all) {
             const static uint8_t source_map[] = OLED_SOURCE_MAP;
             const static uint8_t target_map[] = OLED_TARGET_MAP;
 
+            // Each 8x8 tile of the block lands on one page of the rotated output, so find the smallest page & column
+            // window covering the tiles touched by the dirty range, and only rotate & send that window
+            const uint8_t columns_in_block = (OLED_BLOCK_SIZE + OLED_DISPLAY_HEIGHT - 1) / OLED_DISPLAY_HEIGHT * 8;
+            uint8_t       first_page       = UINT8_MAX;
+            uint8_t       first_column     = UINT8_MAX;
+            uint8_t       last_page        = 0;
+            uint8_t       last_column      = 0;
+            for (uint8_t i = 0; i < sizeof(source_map); ++i) {
+                if (source_map[i] + 7 < dirty_start || source_map[i] > dirty_end) {
+                    continue;
+                }
+                uint8_t page   = target_map[i] / columns_in_block;
+                uint8_t column = target_map[i] % columns_in_block;
+                if (page < first_page) first_page = page;
+                if (page > last_page) last_page = page;
+                if (column < first_column) first_column = column;
+                if (column + 7 > last_column) last_column = column + 7;
+            }
+
             static uint8_t temp_buffer[OLED_BLOCK_SIZE];
-            memset(temp_buffer, 0, sizeof(temp_buffer));
             for (uint8_t i = 0; i < sizeof(source_map); ++i) {
+                uint8_t page   = target_map[i] / columns_in_block;
+                uint8_t column = target_map[i] % columns_in_block;
+                if (page < first_page || page > last_page || column < first_column || column > last_column) {
+                    continue;
+                }
+                memset(&temp_buffer[target_map[i]], 0, 8);
                 rotate_90(&oled_buffer[OLED_BLOCK_SIZE * update_start + source_map[i]], &temp_buffer[target_map[i]]);
             }
 
+            calc_bounds_90(update_start, first_page, first_column, last_page, last_column, &display_start[1]); // Offset from I2C_CMD byte at the start
+
+            // Send column & page position
+            if (!oled_send_cmd(display_start, ARRAY_SIZE(display_start))) {
+                print("oled_render offset command failed\n");
+                return;
+            }
+
+            const uint8_t window_columns = last_column - first_column + 1;
 #if OLED_IC_HAS_HORIZONTAL_MODE
-            // Send render data chunk after rotating
-            if (!oled_send_data(&temp_buffer[0], OLED_BLOCK_SIZE)) {
+            // Pack the window's rows together, then send render data chunk after rotating
+            uint8_t *window_end = temp_buffer;
+            for (uint8_t page = first_page; page <= last_page; ++page) {
+                memmove(window_end, &temp_buffer[columns_in_block * page + first_column], window_columns);
+                window_end += window_columns;
+            }
+            if (!oled_send_data(&temp_buffer[0], window_end - temp_buffer)) {
                 print("oled_render90 data failed\n");
                 return;
             }
 #else
             // For SH1106 or SH1107 the data chunk must be split into separate pieces for each page
-            const uint8_t columns_in_block = (OLED_BLOCK_SIZE + OLED_DISPLAY_HEIGHT - 1) / OLED_DISPLAY_HEIGHT * 8;
-            const uint8_t num_pages        = OLED_BLOCK_SIZE / columns_in_block;
-            for (uint8_t i = 0; i < num_pages; ++i) {
+            for (uint8_t page = first_page; page <= last_page; ++page) {
                 // Send column & page position for all pages except the first one
-                if (i > 0) {
+                if (page > first_page) {
                     display_start[1]++;
                     if (!oled_send_cmd(display_start, ARRAY_SIZE(display_start))) {
                         print("oled_render offset command failed\n");
@@ -524,7 +599,7 @@ void oled_render_dirty(bool all) {
                     }
                 }
                 // Send data for the page
-                if (!oled_send_data(&temp_buffer[columns_in_block * i], columns_in_block)) {
+                if (!oled_send_data(&temp_buffer[columns_in_block * page + first_column], window_columns)) {
                     print("oled_render90 data failed\n");
                     return;
                 }
@@ -534,6 +609,8 @@ void oled_render_dirty(bool all) {
 
         // Clear dirty flag of just rendered block
         oled_dirty &= ~((OLED_BLOCK_TYPE)1 << update_start);
+        oled_dirty_start[update_start] = 0;
+        oled_dirty_end[update_start]   = OLED_BLOCK_SIZE - 1;
     }
 }
 
@@ -625,9 +702,7 @@ void oled_write_char(const char data, bool invert) {
     // Dirty check
     if (memcmp(&oled_temp_buffer, oled_cursor, OLED_FONT_WIDTH)) {
         uint16_t index = oled_cursor - &oled_buffer[0];
-        oled_dirty |= ((OLED_BLOCK_TYPE)1 << (index / OLED_BLOCK_SIZE));
-        // Edgecase check if the written data spans the 2 chunks
-        oled_dirty |= ((OLED_BLOCK_TYPE)1 << ((index + OLED_FONT_WIDTH - 1) / OLED_BLOCK_SIZE));
+        oled_mark_dirty(index, index + OLED_FONT_WIDTH - 1);
     }
 
     // Finally move to the next char
@@ -662,7 +737,7 @@ void oled_pan(bool left) {
             }
         }
     }
-    oled_dirty = OLED_ALL_BLOCKS_MASK;
+    oled_mark_all_dirty();
 }
 
 oled_buffer_reader_t oled_read_raw(uint16_t start_index) {
@@ -677,7 +752,7 @@ void oled_write_raw_byte(const char data, uint16_t index) {
     if (index > OLED_MATRIX_SIZE) index = OLED_MATRIX_SIZE;
     if (oled_buffer[index] == data) return;
     oled_buffer[index] = data;
-    oled_dirty |= ((OLED_BLOCK_TYPE)1 << (index / OLED_BLOCK_SIZE));
+    oled_mark_dirty(index, index);
 }
 
 void oled_write_raw(const char *data, uint16_t size) {
@@ -687,7 +762,7 @@ void oled_write_raw(const char *data, uint16_t size) {
         uint8_t c = *data++;
         if (oled_buffer[i] == c) continue;
         oled_buffer[i] = c;
-        oled_dirty |= ((OLED_BLOCK_TYPE)1 << (i / OLED_BLOCK_SIZE));
+        oled_mark_dirty(i, i);
     }
 }
 
@@ -707,7 +782,7 @@ void oled_write_pixel(uint8_t x, uint8_t y, bool on) {
     }
     if (oled_buffer[index] != data) {
         oled_buffer[index] = data;
-        oled_dirty |= ((OLED_BLOCK_TYPE)1 << (index / OLED_BLOCK_SIZE));
+        oled_mark_dirty(index, index);
     }
 }
 
@@ -732,7 +807,7 @@ void oled_write_raw_P(const char *data, uint16_t size) {
         uint8_t c = pgm_read_byte(data++);
         if (oled_buffer[i] == c) continue;
         oled_buffer[i] = c;
-        oled_dirty |= ((OLED_BLOCK_TYPE)1 << (i / OLED_BLOCK_SIZE));
+        oled_mark_dirty(i, i);
     }
 }
 #endif // defined(__AVR__)
@@ -882,7 +957,7 @@ bool oled_scroll_off(void) {
             return oled_scrolling;
         }
         oled_scrolling = false;
-        oled_dirty     = OLED_ALL_BLOCKS_MASK;
+        oled_mark_all_dirty();
     }
     return !oled_scrolling;
 }
@@ -0,0 +1,14 @@
+#include "printf.h"
+int vprintf_(const char* format, va_list arg) {
+    char buf[1024];
+    int  n = vsnprintf(buf, sizeof(buf), format, arg);
+    for (int i = 0; i < n && i < (int)sizeof(buf) - 1; i++) putchar_(buf[i]);
+    return n;
+}
+int printf_(const char* format, ...) {
+    va_list a;
+    va_start(a, format);
+    int n = vprintf_(format, a);
+    va_end(a);
+    return n;
+}
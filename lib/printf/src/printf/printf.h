@@ -0,0 +1,13 @@
+#pragma once
+#include <stdarg.h>
+#include <stddef.h>
+#include <stdio.h>
+#ifdef __cplusplus
+extern "C" {
+#endif
+void putchar_(char c);
+int  printf_(const char* format, ...);
+int  vprintf_(const char* format, va_list arg);
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,176 @@
+"""Autocorrect dictionaries for external flash.
+
+Builds the image read by `quantum/process_keycode/autocorrect_flash.c`, holding any number of named dictionaries which
+the keyboard selects between at runtime.
+"""
+import struct
+
+MAGIC = b'QAC\x01'
+HEADER_SIZE = 8
+ENTRY_SIZE = 16
+NAME_SIZE = 8
+
+LEAF = 0x80
+CHAIN = 0x40
+MAX_COUNT = 0x3F
+
+KC_A = 4
+KC_SPC = 0x2c
+KC_QUOT = 0x34
+
+TYPO_CHARS = dict([("'", KC_QUOT), (':', KC_SPC)] + [(chr(c), c + KC_A - ord('a')) for c in range(ord('a'), ord('z') + 1)])
+
+
+def _address(value):
+    return value.to_bytes(3, 'little')
+
+
+def _make_trie(autocorrections):
+    """Makes a trie of the typos written in reverse, as they are matched from the last key typed.
+    """
+    trie = {}
+    for typo, correction in autocorrections:
+        node = trie
+        for letter in typo[::-1]:
+            node = node.setdefault(letter, {})
+        node['LEAF'] = (typo, correction)
+    return trie
+
+
+def _correction(typo, correction):
+    """Returns the backspaces and the text to type for a correction, sharing what the typo got right.
+    """
+    word_boundary_ending = typo[-1] == ':'
+    typo = typo.strip(':')
+    i = 0
+    while i < min(len(typo), len(correction)) and typo[i] == correction[i]:
+        i += 1
+    return len(typo) - i - 1 + word_boundary_ending, correction[i:]
+
+
+class _Image:
+    def __init__(self, dictionaries, share):
+        self.share = share
+        self.data = bytearray(HEADER_SIZE + ENTRY_SIZE * len(dictionaries))
+        self.nodes = {}
+        self.strings = {}
+
+    def add_strings(self, strings):
+        """Lays out the corrections, those which end another one pointing into it when sharing.
+        """
+        following = None
+        for string in sorted(set(strings), key=lambda s: s[::-1], reverse=True):
+            if self.share and following is not None and following.endswith(string):
+                self.strings[string] = self.strings[following] + len(following) - len(string)
+            else:
+                self.strings[string] = len(self.data)
+                self.data += string.encode('ascii') + b'\0'
+                following = string
+
+    def add_node(self, node):
+        """Writes a node after its children, returning its address. Identical subtrees are only written once when sharing.
+        """
+        if 'LEAF' in node:
+            backspaces, text = _correction(*node['LEAF'])
+            if not 0 <= backspaces <= MAX_COUNT:
+                raise ValueError(f'Typo "{node["LEAF"][0]}" takes more than {MAX_COUNT} backspaces to correct')
+            data = bytes([LEAF | backspaces]) + _address(self.strings[text])
+        elif len(node) == 1:
+            chars = ''
+            while len(node) == 1 and 'LEAF' not in node and len(chars) < MAX_COUNT:
+                c, node = next(iter(node.items()))
+                chars += c
+            data = bytes([CHAIN | len(chars)] + [TYPO_CHARS[c] for c in chars]) + _address(self.add_node(node))
+        else:
+            data = bytes([len(node)])
+            for c in sorted(node, key=lambda c: TYPO_CHARS[c]):
+                data += bytes([TYPO_CHARS[c]]) + _address(self.add_node(node[c]))
+
+        if self.share and data in self.nodes:
+            return self.nodes[data]
+        address = len(self.data)
+        self.data += data
+        self.nodes[data] = address
+        return address
+
+
+def build_image(dictionaries, share=True):
+    """Builds a flash image from `[(name, [(typo, correction), ...]), ...]`.
+
+    The image starts with a header of the magic `QAC\\x01` and the number of dictionaries, followed by an entry for each:
+    its name (8 bytes, NUL padded), the address of its root node, its shortest and longest typo and its longest
+    correction (a byte each) and two reserved bytes. Corrections follow as NUL terminated strings, then nodes.
+
+    Typos are stored in reverse as a trie of three kinds of nodes, addresses being 3 bytes from the image start:
+
+    * A leaf, `0x80 | backspaces` and the address of the correction
+    * A chain of single children, `0x40 | count`, that many keycodes and the address of the next node
+    * A branch, a count and that many keycodes with the address of their node, sorted by keycode
+
+    With `share` identical subtrees are written once and corrections ending other corrections point into them.
+    """
+    image = _Image(dictionaries, share)
+    image.add_strings(_correction(typo, correction)[1] for _, autocorrections in dictionaries for typo, correction in autocorrections)
+
+    entries = []
+    for name, autocorrections in dictionaries:
+        if len(name.encode('ascii')) > NAME_SIZE:
+            raise ValueError(f'Dictionary name "{name}" is longer than {NAME_SIZE} characters')
+        root = image.add_node(_make_trie(autocorrections))
+        typos = [typo for typo, _ in autocorrections]
+        longest_correction = max(len(_correction(typo, correction)[1]) for typo, correction in autocorrections)
+        entries.append(name.encode('ascii').ljust(NAME_SIZE, b'\0') + _address(root) + struct.pack('<BBBxx', min(map(len, typos)), max(map(len, typos)), longest_correction))
+
+    if len(image.data) > 0xFFFFFF:
+        raise ValueError('The autocorrect image does not fit in 16 MB')
+    image.data[:HEADER_SIZE] = MAGIC + struct.pack('<Bxxx', len(dictionaries))
+    image.data[HEADER_SIZE:HEADER_SIZE + ENTRY_SIZE * len(entries)] = b''.join(entries)
+    return bytes(image.data)
+
+
+def dictionaries(image):
+    """Returns the `(name, root, shortest, longest, longest correction)` of each dictionary in an image.
+    """
+    if image[:4] != MAGIC:
+        raise ValueError('Not an autocorrect image')
+    result = []
+    for i in range(image[4]):
+        offset = HEADER_SIZE + ENTRY_SIZE * i
+        name = image[offset:offset + NAME_SIZE].rstrip(b'\0').decode('ascii')
+        root = int.from_bytes(image[offset + NAME_SIZE:offset + NAME_SIZE + 3], 'little')
+        result.append((name, root) + struct.unpack_from('<BBB', image, offset + NAME_SIZE + 3))
+    return result
+
+
+def lookup(image, root, typed):
+    """Matches the end of `typed`, a string of typo characters, the way the keyboard does.
+
+    Returns `(backspaces, correction)` for a typo, otherwise None.
+    """
+    def address(offset):
+        return int.from_bytes(image[offset:offset + 3], 'little')
+
+    keys = [TYPO_CHARS[c] for c in typed]
+    node = root
+    i = len(keys) - 1
+    while i >= 0:
+        header = image[node]
+        if header & LEAF:
+            return None
+        if header & CHAIN:
+            count = header & MAX_COUNT
+            for j in range(count):
+                if i < 0 or image[node + 1 + j] != keys[i]:
+                    return None
+                i -= 1
+            node = address(node + 1 + count)
+        else:
+            children = [(image[node + 1 + 4 * j], address(node + 2 + 4 * j)) for j in range(header)]
+            node = dict(children).get(keys[i])
+            if node is None:
+                return None
+            i -= 1
+        if image[node] & LEAF:
+            correction = address(node + 1)
+            return image[node] & MAX_COUNT, image[correction:image.index(0, correction)].decode('ascii')
+    return None
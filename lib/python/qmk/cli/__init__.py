@@ -38,6 +38,7 @@ subcommands = [
     'qmk.cli.chibios.confmigrate',
     'qmk.cli.clean',
     'qmk.cli.compile',
+    'qmk.cli.decode_log',
     'qmk.cli.docs',
     'qmk.cli.doctor',
     'qmk.cli.find',
@@ -48,6 +49,7 @@ subcommands = [
     'qmk.cli.format.text',
     'qmk.cli.generate.api',
     'qmk.cli.generate.autocorrect_data',
+    'qmk.cli.generate.autocorrect_flash',
     'qmk.cli.generate.compilation_database',
     'qmk.cli.generate.config_h',
     'qmk.cli.generate.develop_pr_list',
@@ -61,6 +63,7 @@ subcommands = [
     'qmk.cli.generate.make_dependencies',
     'qmk.cli.generate.rgb_breathe_table',
     'qmk.cli.generate.rules_mk',
+    'qmk.cli.generate.steno_dictionary',
     'qmk.cli.generate.version_h',
     'qmk.cli.git.submodule',
     'qmk.cli.hello',
@@ -71,6 +74,7 @@ subcommands = [
     'qmk.cli.json2c',
     'qmk.cli.license_check',
     'qmk.cli.lint',
+    'qmk.cli.keymap_size_report',
     'qmk.cli.kle2json',
     'qmk.cli.list.keyboards',
     'qmk.cli.list.keymaps',
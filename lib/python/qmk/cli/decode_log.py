@@ -0,0 +1,63 @@
+"""Decode the output of the deferred logging backend.
+"""
+import json
+import sys
+
+from milc import cli
+
+from qmk.deferred_log import Decoder, format_table
+from qmk.path import normpath
+
+# Usage page and usage of the console and raw HID interfaces
+CONSOLE_USAGE = (0xFF31, 0x0074)
+RAW_USAGE = (0xFF60, 0x0061)
+
+
+def _listen(decoder, usage):
+    import hid
+
+    devices = [device for device in hid.enumerate() if (device['usage_page'], device['usage']) == usage]
+    if not devices:
+        cli.log.error('No keyboard found with a %s interface.', 'raw HID' if usage == RAW_USAGE else 'console')
+        return False
+
+    device = devices[0]
+    cli.log.info('Listening to %s %s (%04x:%04x)...', device['manufacturer_string'], device['product_string'], device['vendor_id'], device['product_id'])
+    with hid.Device(path=device['path']) as keyboard:
+        try:
+            while True:
+                print(decoder.feed(keyboard.read(64, timeout=1000)), end='', flush=True)
+        except KeyboardInterrupt:
+            pass
+
+    return True
+
+
+@cli.argument('elf', arg_only=True, type=normpath, help='The .elf file of the firmware the keyboard is running')
+@cli.argument('-i', '--input', arg_only=True, type=normpath, help='Decode a capture of the log instead of listening to the keyboard')
+@cli.argument('-r', '--raw', arg_only=True, action='store_true', help='Listen on the raw HID interface, for firmware built with DEFERRED_LOG_RAW_HID')
+@cli.argument('-t', '--table', arg_only=True, action='store_true', help='Print the log formats found in the .elf file as JSON and exit')
+@cli.subcommand('Decodes the output of firmware built with DEFERRED_LOG_ENABLE.')
+def decode_log(cli):
+    """Decodes the output of firmware built with DEFERRED_LOG_ENABLE.
+
+    The keyboard sends the address of each format string with its raw arguments, which are formatted here against the format strings in the firmware's .elf file.
+    """
+    if not cli.args.elf.exists():
+        cli.log.error('No such file: %s', cli.args.elf)
+        return False
+
+    table = format_table(cli.args.elf.read_bytes())
+    if cli.args.table:
+        print(json.dumps({f'0x{address:x}': format_string for address, format_string in sorted(table.items())}, indent=4))
+        return True
+
+    if not table:
+        cli.log.warning('No deferred log formats found in %s, was it built with DEFERRED_LOG_ENABLE?', cli.args.elf)
+
+    decoder = Decoder(table)
+    if cli.args.input:
+        sys.stdout.write(decoder.feed(cli.args.input.read_bytes()))
+        return True
+
+    return _listen(decoder, RAW_USAGE if cli.args.raw else CONSOLE_USAGE)
@@ -0,0 +1,37 @@
+"""Generate an autocorrect image for external flash from dictionary files.
+"""
+from milc import cli
+
+from qmk.autocorrect_flash import NAME_SIZE, build_image
+from qmk.cli.generate.autocorrect_data import parse_file
+from qmk.path import normpath
+
+
+def _dictionary(argument):
+    name, separator, filename = argument.partition('=')
+    if not separator:
+        name, filename = normpath(argument).stem, argument
+    return name[:NAME_SIZE], normpath(filename)
+
+
+@cli.argument('dictionaries', nargs='+', arg_only=True, type=_dictionary, help='Autocorrection dictionary files, as name=file or just file to name it after the file. The first is selected by default.')
+@cli.argument('-o', '--output', arg_only=True, type=normpath, required=True, help='File to write the image to')
+@cli.argument('-q', '--quiet', arg_only=True, action='store_true', help="Quiet mode, only output error messages")
+@cli.subcommand('Generate an autocorrect image for external flash from dictionary files.')
+def generate_autocorrect_flash(cli):
+    dictionaries = [(name, parse_file(filename)) for name, filename in cli.args.dictionaries]
+
+    try:
+        image = build_image(dictionaries)
+        unshared = build_image(dictionaries, share=False)
+    except ValueError as e:
+        cli.log.error(str(e))
+        return False
+
+    cli.args.output.parent.mkdir(parents=True, exist_ok=True)
+    cli.args.output.write_bytes(image)
+
+    if not cli.args.quiet:
+        entries = sum(len(autocorrections) for _, autocorrections in dictionaries)
+        cli.log.info('Wrote %d dictionaries with %d entries to %s.', len(dictionaries), entries, cli.args.output)
+        cli.log.info('Image size: %d bytes, %d bytes without shared suffixes, compression ratio %.2f.', len(image), len(unshared), len(unshared) / len(image))
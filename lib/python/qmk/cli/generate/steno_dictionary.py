@@ -0,0 +1,53 @@
+"""Generate steno_dictionary_data.h from Plover JSON dictionaries.
+"""
+import json
+
+from milc import cli
+
+from qmk.commands import dump_lines
+from qmk.constants import GPL2_HEADER_C_LIKE, GENERATED_HEADER_C_LIKE
+from qmk.keyboard import keyboard_completer, keyboard_folder
+from qmk.keymap import keymap_completer, locate_keymap
+from qmk.path import normpath
+from qmk.steno import build_trie, compile_dictionary, data_lines, longest_outline
+
+
+@cli.argument('filenames', nargs='+', arg_only=True, type=normpath, help='Plover JSON dictionaries, later ones taking precedence')
+@cli.argument('-kb', '--keyboard', type=keyboard_folder, completer=keyboard_completer, help='The keyboard to build a firmware for.')
+@cli.argument('-km', '--keymap', completer=keymap_completer, help='The keymap to build a firmware for.')
+@cli.argument('-o', '--output', arg_only=True, type=normpath, help='File to write to')
+@cli.argument('-q', '--quiet', arg_only=True, action='store_true', help="Quiet mode, only output error messages")
+@cli.subcommand('Generate the steno dictionary data file from Plover dictionaries.')
+def generate_steno_dictionary(cli):
+    dictionary = {}
+    for filename in cli.args.filenames:
+        dictionary.update(json.loads(filename.read_text(encoding='utf-8')))
+
+    entries, skipped = compile_dictionary(dictionary)
+    if skipped:
+        cli.log.warning('Skipped %d entries with strokes or commands the keyboard does not support, such as: %s', len(skipped), ', '.join(skipped[:5]))
+    if not entries:
+        cli.log.error('No entries left to compile.')
+        return False
+
+    try:
+        nodes, text = build_trie(entries)
+    except ValueError as e:
+        cli.log.error(str(e))
+        return False
+
+    current_keyboard = cli.args.keyboard or cli.config.user.keyboard or cli.config.generate_steno_dictionary.keyboard
+    current_keymap = cli.args.keymap or cli.config.user.keymap or cli.config.generate_steno_dictionary.keymap
+
+    if current_keyboard and current_keymap:
+        cli.args.output = locate_keymap(current_keyboard, current_keymap).parent / 'steno_dictionary_data.h'
+
+    source_size = sum(len(outline) + len(translation) for outline, translation in dictionary.items())
+    size = len(nodes) + len(text)
+    cli.log.info('Compiled %d entries into %d bytes, %.1f%% of their outlines and translations.', len(entries), size, 100 * size / source_size)
+
+    lines = [GPL2_HEADER_C_LIKE, GENERATED_HEADER_C_LIKE, '#pragma once', '']
+    lines.append(f'// Steno dictionary ({len(entries)} entries, {len(nodes) + len(text)} bytes)')
+    lines.extend(data_lines(nodes, text, longest_outline(entries)))
+
+    dump_lines(cli.args.output, lines, cli.args.quiet)
@@ -9,6 +9,7 @@ from qmk.commands import dump_lines, parse_configurator_json
 
 
 @cli.argument('-o', '--output', arg_only=True, type=qmk.path.normpath, help='File to write to')
+@cli.argument('--sparse', arg_only=True, action='store_true', help="Store the keymap as a bitmap of non-transparent keys instead of a dense array")
 @cli.argument('-q', '--quiet', arg_only=True, action='store_true', help="Quiet mode, only output error messages")
 @cli.argument('filename', type=qmk.path.FileType('r'), arg_only=True, completer=FilesCompleter('.json'), help='Configurator JSON file')
 @cli.subcommand('Creates a keymap.c from a QMK Configurator export.')
@@ -22,7 +23,7 @@ def json2c(cli):
     user_keymap = parse_configurator_json(cli.args.filename)
 
     # Generate the keymap
-    keymap_c = qmk.keymap.generate_c(user_keymap)
+    keymap_c = qmk.keymap.generate_c(user_keymap, sparse=cli.args.sparse)
 
     # Show the results
     dump_lines(cli.args.output, keymap_c.split('\n'), cli.args.quiet)
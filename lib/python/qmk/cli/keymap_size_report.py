@@ -0,0 +1,59 @@
+"""Report how much flash a sparse keymap would save for each keyboard's default keymap.
+"""
+import json
+
+from milc import cli
+
+import qmk.keymap
+from qmk.keyboard import keyboard_completer, keyboard_folder_or_all, list_keyboards
+from qmk.util import parallel_map
+
+
+def _keymap_size(keyboard):
+    """Returns `(keyboard, layers, dense, sparse)` for a keyboard's default keymap, or `(keyboard, error)` if it couldn't be parsed.
+    """
+    try:
+        keymap_path = qmk.keymap.locate_keymap(keyboard, 'default')
+        if not keymap_path:
+            return keyboard, 'no default keymap'
+
+        if keymap_path.suffix == '.json':
+            keymap_json = json.loads(keymap_path.read_text(encoding='utf-8'))
+        else:
+            keymap_json = qmk.keymap.c2json(keyboard, 'default', keymap_path, use_cpp=False)
+
+        rows, cols, positions = qmk.keymap.layout_matrix(keyboard, keymap_json['layout'])
+        sparse = qmk.keymap.sparse_keymap(keymap_json['layers'], rows, cols, positions)
+
+    except Exception as e:
+        return keyboard, str(e).split('\n')[0]
+
+    return (keyboard, len(keymap_json['layers']), *qmk.keymap.sparse_keymap_size(sparse, rows, cols))
+
+
+@cli.argument('-kb', '--keyboard', arg_only=True, type=keyboard_folder_or_all, default='all', completer=keyboard_completer, help='The keyboard to report on, or "all" (the default)')
+@cli.argument('--show-skipped', arg_only=True, action='store_true', help='Also list the keymaps that could not be parsed')
+@cli.subcommand('Reports the flash used by default keymaps as dense and sparse keymap arrays.', hidden=False if cli.config.user.developer else True)
+def keymap_size_report(cli):
+    """Reports the flash used by default keymaps as dense and sparse keymap arrays.
+
+    Keymaps written in C are parsed without the C pre-processor, so keymaps relying on macros for their keycodes may be skipped.
+    """
+    keyboards = list_keyboards() if cli.args.keyboard == 'all' else [cli.args.keyboard]
+
+    total_dense = total_sparse = 0
+    skipped = 0
+    for result in sorted(parallel_map(_keymap_size, keyboards)):
+        if len(result) == 2:
+            skipped += 1
+            if cli.args.show_skipped:
+                cli.log.warning('{fg_cyan}%s{fg_reset}: %s', *result)
+            continue
+
+        keyboard, layers, dense, sparse = result
+        total_dense += dense
+        total_sparse += sparse
+        print(f'{keyboard:<56} {layers:>3} layers {dense:>7} -> {sparse:>7} bytes ({sparse - dense:+d})')
+
+    if total_dense:
+        print(f'Total: {total_dense} -> {total_sparse} bytes ({100 * (total_dense - total_sparse) / total_dense:.1f}% saved), {skipped} keymaps skipped')
@@ -0,0 +1,167 @@
+"""Decode the records written by the firmware's deferred logging backend.
+
+The firmware sends each log call as its format string's address and the raw arguments, leaving the formatting to the host. The format strings are looked up in the firmware's symbols, see `quantum/logging/deferred_log.c` for the record layout.
+"""
+import re
+import struct
+
+SYNC = 0xFE
+HEADER_SIZE = 6
+DROPPED_ID = 0
+SYMBOL_PREFIX = 'deferred_log_format'
+
+_CONVERSION = re.compile(r'%([-+ #0]*)(\*|\d+)?(?:\.(\*|\d*))?(?:hh|h|ll|l|z|j|t)?([diuxXobcpsfFeEgGaAn%])')
+
+
+def _read_string(data, offset):
+    end = data.find(b'\0', offset)
+    return data[offset:end if end >= 0 else len(data)].decode('utf-8', errors='replace')
+
+
+def format_table(elf):
+    """Returns `{address: format}` for every deferred log site in the ELF image `elf`, given as bytes.
+    """
+    if elf[:4] != b'\x7fELF':
+        raise ValueError('Not an ELF file')
+
+    is_64 = elf[4] == 2
+    endian = '<' if elf[5] == 1 else '>'
+    if is_64:
+        shoff, = struct.unpack_from(endian + 'Q', elf, 0x28)
+        shentsize, shnum = struct.unpack_from(endian + 'HH', elf, 0x3A)
+        section_format, symbol_format = 'IIQQQQIIQQ', 'IBBHQQ'
+    else:
+        shoff, = struct.unpack_from(endian + 'I', elf, 0x20)
+        shentsize, shnum = struct.unpack_from(endian + 'HH', elf, 0x2E)
+        section_format, symbol_format = 'IIIIIIIIII', 'IIIBBH'
+
+    sections = [struct.unpack_from(endian + section_format, elf, shoff + i * shentsize) for i in range(shnum)]
+    table = {}
+    for section in sections:
+        # SHT_SYMTAB, linked to its string table
+        if section[1] != 2:
+            continue
+        strtab = sections[section[6]]
+        entsize = section[9]
+        for offset in range(section[4], section[4] + section[5], entsize):
+            symbol = struct.unpack_from(endian + symbol_format, elf, offset)
+            if is_64:
+                name, shndx, value = symbol[0], symbol[3], symbol[4]
+            else:
+                name, value, shndx = symbol[0], symbol[1], symbol[5]
+
+            if not _read_string(elf, strtab[4] + name).startswith(SYMBOL_PREFIX) or not 0 < shndx < len(sections):
+                continue
+            home = sections[shndx]
+            # The format's bytes, from wherever its section sits in the file. IDs are sent as 32 bits.
+            table[value & 0xFFFFFFFF] = _read_string(elf, home[4] + value - home[3])
+
+    return table
+
+
+def render(format_string, args):
+    """Formats the raw `args` of a record the way printf() would have on the keyboard.
+
+    Arguments which were left off the record for want of room are shown as `?`.
+    """
+    position = 0
+
+    def take(size, unpack):
+        nonlocal position
+        if position + size > len(args):
+            position = len(args)
+            return None
+        value, = struct.unpack_from(unpack, args, position)
+        position += size
+        return value
+
+    def take_string():
+        nonlocal position
+        end = args.find(b'\0', position)
+        if end < 0:
+            position = len(args)
+            return None
+        value = args[position:end].decode('utf-8', errors='replace')
+        position = end + 1
+        return value
+
+    def convert(match):
+        flags, width, precision, conversion = match.groups()
+        if conversion == '%':
+            return '%'
+
+        if width == '*':
+            width = take(4, '<i')
+            if width is None:
+                return '?'
+        if precision == '*':
+            precision = take(4, '<i')
+            if precision is None:
+                return '?'
+        spec = '%' + flags + (str(width) if width is not None else '') + ('.' + str(precision) if precision is not None else '')
+
+        if conversion == 'n':
+            return ''
+        if conversion == 's':
+            value = take_string()
+            return '?' if value is None else (spec + 's') % value
+        if conversion in 'fFeEgGaA':
+            value = take(4, '<f')
+            return '?' if value is None else (spec + ('g' if conversion in 'aA' else conversion)) % value
+
+        value = take(4, '<i' if conversion in 'di' else '<I')
+        if value is None:
+            return '?'
+        if conversion == 'b':
+            digits = format(value, 'b').zfill(int(precision or 0))
+            width = int(width or 0)
+            return digits.ljust(width) if '-' in flags else digits.rjust(width, '0' if '0' in flags else ' ')
+        if conversion == 'p':
+            return '%#x' % value
+        return (spec + ('d' if conversion == 'u' else conversion)) % value
+
+    return _CONVERSION.sub(convert, format_string)
+
+
+class Decoder:
+    """Turns the byte stream from the keyboard back into text.
+
+    Bytes outside of records are passed through, bar the zero padding of raw HID packets.
+    """
+    def __init__(self, table):
+        self.table = table
+        self.pending = bytearray()
+
+    def feed(self, data):
+        """Returns the text for whatever complete records `data` finishes off.
+        """
+        self.pending += data
+        text = []
+        while self.pending:
+            if self.pending[0] != SYNC:
+                end = self.pending.find(SYNC)
+                end = len(self.pending) if end < 0 else end
+                text.append(self.pending[:end].replace(b'\0', b'').decode('utf-8', errors='replace'))
+                del self.pending[:end]
+                continue
+
+            if len(self.pending) < 2 or len(self.pending) < 2 + self.pending[1]:
+                break
+            length = self.pending[1]
+            record = bytes(self.pending[2:2 + length])
+            del self.pending[:2 + length]
+            text.append(self.record(record))
+
+        return ''.join(text)
+
+    def record(self, record):
+        if len(record) < HEADER_SIZE - 2:
+            return '<short deferred log record>\n'
+
+        id, = struct.unpack_from('<I', record)
+        args = record[HEADER_SIZE - 2:]
+        if id == DROPPED_ID:
+            return '<%s log records dropped>\n' % render('%u', args)
+        if id not in self.table:
+            return '<unknown log format 0x%x: %s>\n' % (id, args.hex())
+        return render(self.table[id], args)
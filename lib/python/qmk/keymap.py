@@ -1,6 +1,7 @@
 """Functions that help you work with QMK keymaps.
 """
 import json
+import re
 import sys
 from pathlib import Path
 from subprocess import DEVNULL
@@ -42,6 +43,12 @@ __MACRO_OUTPUT_GOES_HERE__
 
 """
 
+# The dense keymap declaration that `generate_c(..., sparse=True)` replaces
+DENSE_KEYMAP_DECLARATION = re.compile(r'const\s+uint16_t\s+PROGMEM\s+keymaps\s*\[\s*\]\s*\[\s*MATRIX_ROWS\s*\]\s*\[\s*MATRIX_COLS\s*\]\s*=\s*\{\s*__KEYMAP_GOES_HERE__\s*\};')
+
+# Keycodes left out of sparse keymaps, as any key missing from a layer resolves to KC_TRNS
+SPARSE_TRANSPARENT_KEYCODES = ('KC_TRNS', 'KC_TRANSPARENT', '_______')
+
 
 def _generate_keymap_table(keymap_json):
     lines = []
@@ -54,6 +61,108 @@ def _generate_keymap_table(keymap_json):
     return lines
 
 
+# Number of keys per sparse keymap bitmap word, each of which gets its own rank entry
+SPARSE_BLOCK_BITS = 32
+
+
+def _bitmap_words(bits):
+    """Packs a sequence of booleans into 32-bit words, least significant bit first.
+    """
+    output = [0] * ((len(bits) + SPARSE_BLOCK_BITS - 1) // SPARSE_BLOCK_BITS)
+    for index, bit in enumerate(bits):
+        if bit:
+            output[index // SPARSE_BLOCK_BITS] |= 1 << (index % SPARSE_BLOCK_BITS)
+    return output
+
+
+def _format_words(data):
+    return ', '.join(f'0x{word:08X}' for word in data)
+
+
+def layout_matrix(keyboard, layout):
+    """Returns `(rows, cols, positions)` for a keyboard's layout, where positions is the `(row, col)` of each key in LAYOUT order.
+    """
+    kb_info_json = info_json(keyboard)
+    layouts = kb_info_json.get('layouts', {})
+    layout = kb_info_json.get('layout_aliases', {}).get(layout, layout)
+
+    if layout not in layouts:
+        raise ValueError(f'Layout {layout} does not exist for keyboard {keyboard}!')
+
+    positions = [tuple(key['matrix']) for key in layouts[layout]['layout']]
+    return kb_info_json['matrix_size']['rows'], kb_info_json['matrix_size']['cols'], positions
+
+
+def sparse_keymap(layers, rows, cols, positions):
+    """Encodes a keymap as per-layer bitmaps of its non-transparent keys, plus the packed keycodes of those keys.
+
+    Keys are numbered `row * cols + col`. Every layer gets its own bitmap of 32-bit words, `layout` marks the matrix positions used by the LAYOUT macro (all others resolve to KC_NO), and `ranks` holds, for each word of each layer's bitmap, the index within `keycodes` of the first key set in that word. Looking a key up is then a single rank read plus a popcount of the bits below it in its word.
+    """
+    used = [None] * (rows * cols)
+    for key_index, (row, col) in enumerate(positions):
+        used[row * cols + col] = key_index
+
+    sparse = {'layout': _bitmap_words([key_index is not None for key_index in used]), 'bitmaps': [], 'ranks': [], 'keycodes': []}
+
+    for layer_num, layer in enumerate(layers):
+        if len(layer) != len(positions):
+            raise ValueError(f'Layer {layer_num} has {len(layer)} keys, the layout has {len(positions)}!')
+
+        present = []
+        ranks = []
+        for index, key_index in enumerate(used):
+            if index % SPARSE_BLOCK_BITS == 0:
+                ranks.append(len(sparse['keycodes']))
+            keycode = None if key_index is None else _strip_any(layer[key_index])
+            present.append(keycode is not None and keycode not in SPARSE_TRANSPARENT_KEYCODES)
+            if present[-1]:
+                sparse['keycodes'].append(keycode)
+        sparse['bitmaps'].append(_bitmap_words(present))
+        sparse['ranks'].append(ranks)
+
+    return sparse
+
+
+def sparse_keymap_size(sparse, rows, cols):
+    """Returns `(dense, sparse)`, the number of bytes of flash used by each keymap encoding.
+    """
+    dense_size = len(sparse['bitmaps']) * rows * cols * 2
+    sparse_size = len(sparse['layout']) * 4 + sum(map(len, sparse['bitmaps'])) * 4 + sum(map(len, sparse['ranks'])) * 2 + len(sparse['keycodes']) * 2
+    return dense_size, sparse_size
+
+
+def _generate_sparse_keymap_table(keymap_json):
+    rows, cols, positions = layout_matrix(keymap_json['keyboard'], keymap_json['layout'])
+    sparse = sparse_keymap(keymap_json['layers'], rows, cols, positions)
+    dense_size, sparse_size = sparse_keymap_size(sparse, rows, cols)
+
+    lines = [
+        f'// Sparse keymap: {sparse_size} bytes, {dense_size} bytes as a dense keymaps[][MATRIX_ROWS][MATRIX_COLS] array',
+        '#define KEYMAP_SPARSE',
+        '',
+        f'const uint32_t PROGMEM keymap_sparse_layout[] = {{{_format_words(sparse["layout"])}}};',
+        '',
+        f'const uint32_t PROGMEM keymap_sparse_bitmap[][{len(sparse["layout"])}] = {{',
+    ]
+    lines.extend(f'\t[{layer_num}] = {{{_format_words(bitmap)}}},' for layer_num, bitmap in enumerate(sparse['bitmaps']))
+    lines.append('};')
+    lines.append('')
+    lines.append(f'const uint16_t PROGMEM keymap_sparse_ranks[][{len(sparse["layout"])}] = {{')
+    lines.extend(f'\t[{layer_num}] = {{{", ".join(map(str, ranks))}}},' for layer_num, ranks in enumerate(sparse['ranks']))
+    lines.append('};')
+    lines.append('')
+    lines.append('const uint16_t PROGMEM keymap_sparse_keycodes[] = {')
+    for layer_num, ranks in enumerate(sparse['ranks']):
+        start = ranks[0]
+        end = sparse['ranks'][layer_num + 1][0] if layer_num + 1 < len(sparse['ranks']) else len(sparse['keycodes'])
+        if start != end:
+            lines.append(f'\t/* [{layer_num}] */ {", ".join(sparse["keycodes"][start:end])},')
+    if not sparse['keycodes']:
+        lines.append('\tKC_TRNS')
+    lines.append('};')
+    return lines
+
+
 def _generate_encodermap_table(keymap_json):
     lines = []
     for layer_num, layer in enumerate(keymap_json['encoders']):
@@ -311,7 +420,7 @@ def generate_json(keymap, keyboard, layout, layers, macros=None):
     return new_keymap
 
 
-def generate_c(keymap_json):
+def generate_c(keymap_json, sparse=False):
     """Returns a `keymap.c`.
 
     `keymap_json` is a dictionary with the following keys:
@@ -327,11 +436,19 @@ def generate_c(keymap_json):
 
         macros
             A sequence of strings containing macros to implement for this keyboard.
+
+    When `sparse` is True the keymap is emitted as a sparse table of non-transparent keys instead of a dense `keymaps` array.
     """
     new_keymap = template_c(keymap_json['keyboard'])
-    layer_txt = _generate_keymap_table(keymap_json)
-    keymap = '\n'.join(layer_txt)
-    new_keymap = new_keymap.replace('__KEYMAP_GOES_HERE__', keymap)
+    if sparse:
+        if not DENSE_KEYMAP_DECLARATION.search(new_keymap):
+            raise ValueError(f'The keymap.c template for {keymap_json["keyboard"]} does not declare a standard keymaps array, cannot generate a sparse keymap.')
+        keymap = '\n'.join(_generate_sparse_keymap_table(keymap_json))
+        new_keymap = DENSE_KEYMAP_DECLARATION.sub(lambda _: keymap, new_keymap)
+    else:
+        layer_txt = _generate_keymap_table(keymap_json)
+        keymap = '\n'.join(layer_txt)
+        new_keymap = new_keymap.replace('__KEYMAP_GOES_HERE__', keymap)
 
     encodermap = ''
     if 'encoders' in keymap_json and keymap_json['encoders'] is not None:
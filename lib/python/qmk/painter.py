@@ -197,6 +197,39 @@ def rgb_to565(r, g, b):
     return [msb, lsb]
 
 
+def _or_bytes(a, b):
+    """Bitwise-OR two equal-length byte strings together.
+    """
+    return (int.from_bytes(a, 'little') | int.from_bytes(b, 'little')).to_bytes(len(a), 'little')
+
+
+def _translate_table(value_fn):
+    """Build a `bytes.translate()` table by applying the supplied function to every possible byte value.
+    """
+    return bytes(value_fn(v) for v in range(256))
+
+
+def _pack_pixels(pixels, bpp, value_fn):
+    """Pack 8-bit input pixels into the QMK bit-packed representation, least-significant bits first.
+
+    Each input pixel is mapped through `value_fn`, which must return a value fitting within `bpp` bits. Work is done with
+    translation tables and whole-buffer integer operations rather than looping over each pixel in Python.
+    """
+    pixels_per_byte = 8 // bpp
+    if pixels_per_byte == 1:
+        return pixels.translate(_translate_table(value_fn))
+
+    # Pad the input so that every output byte has a full set of pixels -- missing pixels are packed as zeros
+    padding = (pixels_per_byte - (len(pixels) % pixels_per_byte)) % pixels_per_byte
+    pixels = pixels + bytes(padding)
+
+    packed = 0
+    for n in range(pixels_per_byte):
+        table = _translate_table(lambda v: value_fn(v) << (n * bpp))
+        packed |= int.from_bytes(pixels[n::pixels_per_byte].translate(table), 'little')
+    return packed.to_bytes(len(pixels) // pixels_per_byte, 'little')
+
+
 def convert_image_bytes(im, format):
     """Convert the supplied image to the equivalent bytes required by the QMK firmware.
     """
@@ -204,7 +237,7 @@ def convert_image_bytes(im, format):
     # Work out the requested format
     ncolors = format["num_colors"]
     image_format = format["image_format"]
-    shifter = int(math.log2(ncolors))
+    bpp = int(math.log2(ncolors))
     pixels_per_byte = int(8 / math.log2(ncolors))
     bytes_per_pixel = math.ceil(math.log2(ncolors) / 8)
     (width, height) = im.size
@@ -216,25 +249,16 @@ def convert_image_bytes(im, format):
     if image_format == 'IMAGE_FORMAT_GRAYSCALE':
         # Take the red channel
         image_bytes = im.tobytes("raw", "R")
-        image_bytes_len = len(image_bytes)
 
         # No palette
         palette = None
 
-        bytearray = []
-        for x in range(expected_byte_count):
-            byte = 0
-            for n in range(pixels_per_byte):
-                byte_offset = x * pixels_per_byte + n
-                if byte_offset < image_bytes_len:
-                    # If mono, each input byte is a grayscale [0,255] pixel -- rescale to the range we want then pack together
-                    byte = byte | (rescale_byte(image_bytes[byte_offset], ncolors - 1) << int(n * shifter))
-            bytearray.append(byte)
+        # If mono, each input byte is a grayscale [0,255] pixel -- rescale to the range we want then pack together
+        image_data = _pack_pixels(image_bytes, bpp, lambda v: rescale_byte(v, ncolors - 1))
 
     elif image_format == 'IMAGE_FORMAT_PALETTE':
         # Convert each pixel to the palette bytes
         image_bytes = im.tobytes("raw", "P")
-        image_bytes_len = len(image_bytes)
 
         # Export the palette
         palette = []
@@ -242,15 +266,8 @@ def convert_image_bytes(im, format):
         for n in range(0, ncolors * 3, 3):
             palette.append((pal[n + 0], pal[n + 1], pal[n + 2]))
 
-        bytearray = []
-        for x in range(expected_byte_count):
-            byte = 0
-            for n in range(pixels_per_byte):
-                byte_offset = x * pixels_per_byte + n
-                if byte_offset < image_bytes_len:
-                    # If color, each input byte is the index into the color palette -- pack them together
-                    byte = byte | ((image_bytes[byte_offset] & (ncolors - 1)) << int(n * shifter))
-            bytearray.append(byte)
+        # If color, each input byte is the index into the color palette -- pack them together
+        image_data = _pack_pixels(image_bytes, bpp, lambda v: v & (ncolors - 1))
 
     if image_format == 'IMAGE_FORMAT_RGB565':
         # Take the red, green, and blue channels
@@ -261,70 +278,103 @@ def convert_image_bytes(im, format):
         # No palette
         palette = None
 
-        bytearray = [byte for r, g, b in zip(red, green, blue) for byte in rgb_to565(r, g, b)]
+        # Build each half of the 16-bit value from per-channel lookup tables (matching `rgb_to565()`), then interleave them
+        msb = _or_bytes(red.translate(_translate_table(lambda v: rgb_to565(v, 0, 0)[0])), green.translate(_translate_table(lambda v: rgb_to565(0, v, 0)[0])))
+        lsb = _or_bytes(green.translate(_translate_table(lambda v: rgb_to565(0, v, 0)[1])), blue.translate(_translate_table(lambda v: rgb_to565(0, 0, v)[1])))
+        interleaved = bytearray(2 * len(msb))
+        interleaved[0::2] = msb
+        interleaved[1::2] = lsb
+        image_data = bytes(interleaved)
 
     if image_format == 'IMAGE_FORMAT_RGB888':
-        # Take the red, green, and blue channels
-        red = im.tobytes("raw", "R")
-        green = im.tobytes("raw", "G")
-        blue = im.tobytes("raw", "B")
+        # Take the red, green, and blue channels, already interleaved
+        image_data = im.tobytes("raw", "RGB")
 
         # No palette
         palette = None
 
-        bytearray = [byte for r, g, b in zip(red, green, blue) for byte in (r, g, b)]
-
-    if len(bytearray) != expected_byte_count:
-        raise Exception(f"Wrong byte count, was {len(bytearray)}, expected {expected_byte_count}")
+    if len(image_data) != expected_byte_count:
+        raise Exception(f"Wrong byte count, was {len(image_data)}, expected {expected_byte_count}")
 
-    return (palette, bytearray)
+    return (palette, list(image_data))
 
 
 def compress_bytes_qmk_rle(bytearray):
-    debug_dump = False
+    """Compress the supplied bytes using the QMK RLE scheme.
+
+    Output is a sequence of either repeats -- a count byte in [1,127] followed by the byte to repeat -- or literal ranges,
+    with a length byte of 127 plus the range length followed by the bytes themselves.
+
+    Rather than examining each byte in turn, the input is split into runs of identical bytes (located by the regex engine)
+    and the non-repeating ranges between them, each of which is consumed in bulk.
+    """
     output = []
-    temp = []
-    repeat = False
-
-    def append_byte(c):
-        if debug_dump:
-            print('Appending byte:', '0x{0:02X}'.format(int(c)), '=', c)
-        output.append(c)
-
-    def append_range(r):
-        append_byte(127 + len(r))
-        if debug_dump:
-            print('Appending {0} byte(s):'.format(len(r)), '[', ', '.join(['{0:02X}'.format(e) for e in r]), ']')
+    literal = b''
+    repeat_value = None
+    repeat_count = 0
+
+    def flush_literal(r):
+        output.append(127 + len(r))
         output.extend(r)
 
-    for n in range(0, len(bytearray) + 1):
-        end = True if n == len(bytearray) else False
-        if not end:
-            c = bytearray[n]
-            temp.append(c)
-            if len(temp) <= 1:
+    def flush_repeat():
+        nonlocal repeat_value
+        output.append(repeat_count)
+        output.append(repeat_value)
+        repeat_value = None
+
+    def feed_literal(data):
+        # Any change in value terminates an in-progress repeat; literal ranges are written out every 128 bytes
+        nonlocal literal
+        if repeat_value is not None:
+            flush_repeat()
+        literal = literal + data
+        end = len(literal) - (len(literal) % 128)
+        for n in range(0, end, 128):
+            flush_literal(literal[n:n + 128])
+        literal = literal[end:]
+
+    def feed_run(value, length):
+        nonlocal literal, repeat_value, repeat_count
+        feed_literal(bytes([value]))
+        length -= 1
+        while length > 0:
+            if len(literal) == 0:
+                literal = bytes([value])
+                length -= 1
                 continue
 
-        if debug_dump:
-            print('Temp buffer state {0:3d} bytes:'.format(len(temp)), '[', ', '.join(['{0:02X}'.format(e) for e in temp]), ']')
-
-        if repeat:
-            if temp[-1] != temp[-2]:
-                repeat = False
-            if not repeat or len(temp) == 128 or end:
-                append_byte(len(temp) if end else len(temp) - 1)
-                append_byte(temp[0])
-                temp = [temp[-1]]
-                repeat = False
-        else:
-            if len(temp) >= 2 and temp[-1] == temp[-2]:
-                repeat = True
-                if len(temp) > 2:
-                    append_range(temp[0:(len(temp) - 2)])
-                    temp = [temp[-1], temp[-1]]
-                continue
-            if len(temp) == 128 or end:
-                append_range(temp)
-                temp = []
-                repeat = False
+            # The literal range ends with this value, so everything before it is written out and a repeat is started
+            if len(literal) >= 2:
+                flush_literal(literal[0:-1])
+            literal = b''
+            repeat_value = value
+            repeat_count = 2
+            length -= 1
+
+            # Repeats are capped at 127 bytes, with the byte which hit the cap starting a new literal range
+            if length >= 128 - repeat_count:
+                length -= 128 - repeat_count
+                repeat_count = 127
+                flush_repeat()
+                literal = bytes([value])
+            else:
+                repeat_count += length
+                length = 0
+
+    data = bytes(bytearray)
+    pos = 0
+    for match in re.finditer(rb'(.)\1+', data, re.DOTALL):
+        if match.start() > pos:
+            feed_literal(data[pos:match.start()])
+        feed_run(data[match.start()], match.end() - match.start())
+        pos = match.end()
+    if len(data) > pos:
+        feed_literal(data[pos:])
+
+    if repeat_value is not None:
+        flush_repeat()
+    else:
+        flush_literal(literal)
+
     return output
@@ -9,6 +9,7 @@ from types import FunctionType
 from PIL import Image, ImageFile, ImageChops
 from PIL._binary import o8, o16le as o16, o32le as o32
 import qmk.painter
+from qmk.util import parallel_map
 
 
 def o24(i):
@@ -221,6 +222,88 @@ def _accept(prefix):
     return False
 
 
+def _encode_frame(args):
+    """Converts a single frame to the requested format, returning a tuple of (frame index, encoded frame info).
+
+    Each frame only depends on itself and the previous frame, so this is run in parallel across all frames.
+    """
+    (idx, frame, last_frame, format, use_rle, use_deltas) = args
+
+    # If we replace the frame we're going to output with a delta, we can override it here
+    location = (0, 0)
+    size = frame.size
+
+    # Convert the original frame so we can do comparisons
+    converted = qmk.painter.convert_requested_format(frame, format)
+    graphic_data = qmk.painter.convert_image_bytes(converted, format)
+
+    # Convert the raw data to RLE-encoded if requested
+    raw_data = graphic_data[1]
+    if use_rle:
+        rle_data = qmk.painter.compress_bytes_qmk_rle(graphic_data[1])
+    use_raw_this_frame = not use_rle or len(raw_data) <= len(rle_data)
+    image_data = raw_data if use_raw_this_frame else rle_data
+
+    # Work out if a delta frame is smaller than injecting it directly
+    use_delta_this_frame = False
+    if use_deltas and last_frame is not None:
+        # If we want to use deltas, then find the difference
+        diff = ImageChops.difference(frame, last_frame)
+
+        # Get the bounding box of those differences
+        bbox = diff.getbbox()
+
+        # If we have a valid bounding box...
+        if bbox:
+            # ...create the delta frame by cropping the original.
+            delta_frame = frame.crop(bbox)
+            delta_location = (bbox[0], bbox[1])
+            delta_size = (bbox[2] - bbox[0], bbox[3] - bbox[1])
+
+            # Convert the delta frame to the requested format
+            delta_converted = qmk.painter.convert_requested_format(delta_frame, format)
+            delta_graphic_data = qmk.painter.convert_image_bytes(delta_converted, format)
+
+            # Work out how large the delta frame is going to be with compression etc.
+            delta_raw_data = delta_graphic_data[1]
+            if use_rle:
+                delta_rle_data = qmk.painter.compress_bytes_qmk_rle(delta_graphic_data[1])
+            delta_use_raw_this_frame = not use_rle or len(delta_raw_data) <= len(delta_rle_data)
+            delta_image_data = delta_raw_data if delta_use_raw_this_frame else delta_rle_data
+
+            # If the size of the delta frame (plus delta descriptor) is smaller than the original, use that instead
+            # This ensures that if a non-delta is overall smaller in size, we use that in preference due to flash
+            # sizing constraints.
+            if (len(delta_image_data) + QGFFrameDeltaDescriptorV1.length) < len(image_data):
+                # Copy across all the delta equivalents so that the rest of the processing acts on those
+                location = delta_location
+                size = delta_size
+                graphic_data = delta_graphic_data
+                use_raw_this_frame = delta_use_raw_this_frame
+                image_data = delta_image_data
+                use_delta_this_frame = True
+
+    # Convert all palette entries to the QMK "dialect" of HSV888
+    palette = None
+    if format['has_palette']:
+
+        def rgb888_to_qmk_hsv888(e):
+            hsv = rgb_to_hsv(e[0] / 255.0, e[1] / 255.0, e[2] / 255.0)
+            return (int(hsv[0] * 255.0), int(hsv[1] * 255.0), int(hsv[2] * 255.0))
+
+        palette = list(map(rgb888_to_qmk_hsv888, graphic_data[0]))
+
+    return (idx, {
+        'is_delta': use_delta_this_frame,
+        'location': location,
+        'size': size,
+        'use_raw': use_raw_this_frame,
+        'image_data': image_data,
+        'palette': palette,
+        'delay': frame.info['duration'] if 'duration' in frame.info else 1000,  # If we're not an animation, just pretend we're delaying for 1000ms
+    })
+
+
 def _save(im, fp, filename):
     """Helper method used by PIL to write to an output file.
     """
@@ -231,6 +314,9 @@ def _save(im, fp, filename):
     use_deltas = encoderinfo.get("use_deltas", True)
     use_rle = encoderinfo.get("use_rle", True)
 
+    # Work out the format we're going to use
+    format = encoderinfo["qmk_format"]
+
     # Helper for inline verbose prints
     def vprint(s):
         if verbose:
@@ -251,14 +337,19 @@ def _save(im, fp, filename):
                 last_frame = copy
                 frame_num += 1
 
-    # Collect all the frame sizes
-    frame_sizes = []
-    _for_all_frames(lambda idx, frame, last_frame: frame_sizes.append(frame.size))
+    # Collect all the frames, alongside the previous frame for delta calculations
+    frames = []
+    _for_all_frames(lambda idx, frame, last_frame: frames.append((idx, frame, last_frame, format, use_rle, use_deltas)))
 
     # Make sure all frames are the same size
+    frame_sizes = [frame[1].size for frame in frames]
     if len(list(set(frame_sizes))) != 1:
         raise ValueError("Mismatching sizes on frames")
 
+    # Convert all the frames up front -- animations are spread across worker processes, then put back in order
+    map_fn = parallel_map if len(frames) > 1 else map
+    encoded_frames = [e[1] for e in sorted(map_fn(_encode_frame, frames), key=lambda e: e[0])]
+
     # Write out the initial graphics descriptor (and write a dummy value), so that we can come back and fill in the
     # correct values once we've written all the frames to the output
     graphics_descriptor_location = fp.tell()
@@ -277,98 +368,30 @@ def _save(im, fp, filename):
     frame_offsets.write(fp)
 
     # Helper function to save each frame to the output file
-    def _write_frame(idx, frame, last_frame):
-        # If we replace the frame we're going to output with a delta, we can override it here
-        this_frame = frame
-        location = (0, 0)
-        size = frame.size
-
-        # Work out the format we're going to use
-        format = encoderinfo["qmk_format"]
-
-        # Convert the original frame so we can do comparisons
-        converted = qmk.painter.convert_requested_format(this_frame, format)
-        graphic_data = qmk.painter.convert_image_bytes(converted, format)
-
-        # Convert the raw data to RLE-encoded if requested
-        raw_data = graphic_data[1]
-        if use_rle:
-            rle_data = qmk.painter.compress_bytes_qmk_rle(graphic_data[1])
-        use_raw_this_frame = not use_rle or len(raw_data) <= len(rle_data)
-        image_data = raw_data if use_raw_this_frame else rle_data
-
-        # Work out if a delta frame is smaller than injecting it directly
-        use_delta_this_frame = False
-        if use_deltas and last_frame is not None:
-            # If we want to use deltas, then find the difference
-            diff = ImageChops.difference(frame, last_frame)
-
-            # Get the bounding box of those differences
-            bbox = diff.getbbox()
-
-            # If we have a valid bounding box...
-            if bbox:
-                # ...create the delta frame by cropping the original.
-                delta_frame = frame.crop(bbox)
-                delta_location = (bbox[0], bbox[1])
-                delta_size = (bbox[2] - bbox[0], bbox[3] - bbox[1])
-
-                # Convert the delta frame to the requested format
-                delta_converted = qmk.painter.convert_requested_format(delta_frame, format)
-                delta_graphic_data = qmk.painter.convert_image_bytes(delta_converted, format)
-
-                # Work out how large the delta frame is going to be with compression etc.
-                delta_raw_data = delta_graphic_data[1]
-                if use_rle:
-                    delta_rle_data = qmk.painter.compress_bytes_qmk_rle(delta_graphic_data[1])
-                delta_use_raw_this_frame = not use_rle or len(delta_raw_data) <= len(delta_rle_data)
-                delta_image_data = delta_raw_data if delta_use_raw_this_frame else delta_rle_data
-
-                # If the size of the delta frame (plus delta descriptor) is smaller than the original, use that instead
-                # This ensures that if a non-delta is overall smaller in size, we use that in preference due to flash
-                # sizing constraints.
-                if (len(delta_image_data) + QGFFrameDeltaDescriptorV1.length) < len(image_data):
-                    # Copy across all the delta equivalents so that the rest of the processing acts on those
-                    this_frame = delta_frame
-                    location = delta_location
-                    size = delta_size
-                    converted = delta_converted
-                    graphic_data = delta_graphic_data
-                    raw_data = delta_raw_data
-                    rle_data = delta_rle_data
-                    use_raw_this_frame = delta_use_raw_this_frame
-                    image_data = delta_image_data
-                    use_delta_this_frame = True
-
+    def _write_frame(idx, encoded):
         # Write out the frame descriptor
         frame_offsets.frame_offsets[idx] = fp.tell()
         vprint(f'{f"Frame {idx:3d} base":26s} {fp.tell():5d}d / {fp.tell():04X}h')
         frame_descriptor = QGFFrameDescriptorV1()
-        frame_descriptor.is_delta = use_delta_this_frame
+        frame_descriptor.is_delta = encoded['is_delta']
         frame_descriptor.is_transparent = False
         frame_descriptor.format = format['image_format_byte']
-        frame_descriptor.compression = 0x00 if use_raw_this_frame else 0x01  # See qp.h, painter_compression_t
-        frame_descriptor.delay = frame.info['duration'] if 'duration' in frame.info else 1000  # If we're not an animation, just pretend we're delaying for 1000ms
+        frame_descriptor.compression = 0x00 if encoded['use_raw'] else 0x01  # See qp.h, painter_compression_t
+        frame_descriptor.delay = encoded['delay']
         frame_descriptor.write(fp)
 
         # Write out the palette if required
         if format['has_palette']:
-            palette = graphic_data[0]
             palette_descriptor = QGFFramePaletteDescriptorV1()
-
-            # Helper to convert from RGB888 to the QMK "dialect" of HSV888
-            def rgb888_to_qmk_hsv888(e):
-                hsv = rgb_to_hsv(e[0] / 255.0, e[1] / 255.0, e[2] / 255.0)
-                return (int(hsv[0] * 255.0), int(hsv[1] * 255.0), int(hsv[2] * 255.0))
-
-            # Convert all palette entries to HSV888 and write to the output
-            palette_descriptor.palette_entries = list(map(rgb888_to_qmk_hsv888, palette))
+            palette_descriptor.palette_entries = encoded['palette']
             vprint(f'{f"Frame {idx:3d} palette":26s} {fp.tell():5d}d / {fp.tell():04X}h')
             palette_descriptor.write(fp)
 
         # Write out the delta info if required
-        if use_delta_this_frame:
+        if encoded['is_delta']:
             # Set up the rendering location of where the delta frame should be situated
+            location = encoded['location']
+            size = encoded['size']
             delta_descriptor = QGFFrameDeltaDescriptorV1()
             delta_descriptor.left = location[0]
             delta_descriptor.top = location[1]
@@ -381,12 +404,13 @@ def _save(im, fp, filename):
 
         # Write out the data for this frame to the output
         data_descriptor = QGFFrameDataDescriptorV1()
-        data_descriptor.data = image_data
+        data_descriptor.data = encoded['image_data']
         vprint(f'{f"Frame {idx:3d} data":26s} {fp.tell():5d}d / {fp.tell():04X}h')
         data_descriptor.write(fp)
 
-    # Iterate over each if the input frames, writing it to the output in the process
-    _for_all_frames(_write_frame)
+    # Iterate over each of the encoded frames, writing it to the output in the process
+    for idx, encoded in enumerate(encoded_frames):
+        _write_frame(idx, encoded)
 
     # Go back and update the graphics descriptor now that we can determine the final file size
     graphics_descriptor.total_file_size = fp.tell()
@@ -5,7 +5,7 @@ import functools
 import fnmatch
 import logging
 import re
-from typing import List, Tuple
+from typing import Any, List, Tuple
 from dotty_dict import dotty, Dotty
 from milc import cli
 
@@ -48,13 +48,6 @@ def _keymap_exists(keyboard, keymap):
         return keyboard if locate_keymap(keyboard, keymap) is not None else None
 
 
-def _load_keymap_info(kb_km):
-    """Returns a tuple of (keyboard, keymap, info.json) for the given keyboard/keymap combination.
-    """
-    with ignore_logging():
-        return (kb_km[0], kb_km[1], keymap_json(kb_km[0], kb_km[1]))
-
-
 def expand_make_targets(targets: List[str]) -> List[Tuple[str, str]]:
     """Expand a list of make targets into a list of (keyboard, keymap) tuples.
 
@@ -111,8 +104,84 @@ def _construct_build_target_kb_km(e):
     return KeyboardKeymapBuildTarget(keyboard=e[0], keymap=e[1])
 
 
-def _construct_build_target_kb_km_json(e):
-    return KeyboardKeymapBuildTarget(keyboard=e[0], keymap=e[1], json=e[2])
+_function_re = re.compile(r'^(?P<function>[a-zA-Z]+)\((?P<key>[a-zA-Z0-9_\.]+)(,\s*(?P<value>[^#]+))?\)$')
+_equals_re = re.compile(r'^(?P<key>[a-zA-Z0-9_\.]+)\s*=\s*(?P<value>[^#]+)$')
+
+
+def _parse_filters(filters: List[str]) -> List[Tuple[str, str, Any]]:
+    """Convert the supplied filter expressions into a list of (function, key, value) tuples.
+
+    The result only contains picklable values so that it can be shipped to worker processes.
+    """
+    parsed_filters = []
+    for filter_expr in filters:
+        function_match = _function_re.match(filter_expr)
+        equals_match = _equals_re.match(filter_expr)
+
+        if function_match is not None:
+            func_name = function_match.group('function').lower()
+            key = function_match.group('key')
+            value = function_match.group('value')
+
+            if value is not None:
+                if func_name not in ['length', 'contains']:
+                    cli.log.warning(f'Unrecognized filter expression: {function_match.group(0)}')
+                    continue
+
+                cli.log.info(f'Filtering on condition: {{fg_green}}{func_name}{{fg_reset}}({{fg_cyan}}{key}{{fg_reset}}, {{fg_cyan}}{value}{{fg_reset}})...')
+                parsed_filters.append((func_name, key, int(value) if func_name == 'length' else value))
+            else:
+                if func_name not in ['exists', 'absent']:
+                    cli.log.warning(f'Unrecognized filter expression: {function_match.group(0)}')
+                    continue
+
+                cli.log.info(f'Filtering on condition: {{fg_green}}{func_name}{{fg_reset}}({{fg_cyan}}{key}{{fg_reset}})...')
+                parsed_filters.append((func_name, key, None))
+
+        elif equals_match is not None:
+            key = equals_match.group('key')
+            value = equals_match.group('value')
+            cli.log.info(f'Filtering on condition: {{fg_cyan}}{key}{{fg_reset}} == {{fg_cyan}}{value}{{fg_reset}}...')
+
+            expr = fnmatch.translate(value)
+            parsed_filters.append(('equals', key, re.compile(f'^{expr}$', re.IGNORECASE)))
+        else:
+            cli.log.warning(f'Unrecognized filter expression: {filter_expr}')
+            continue
+
+    return parsed_filters
+
+
+def _filter_matches(info: Dotty, func_name: str, key: str, value: Any) -> bool:
+    """Returns True if the supplied info.json data satisfies a single parsed filter.
+    """
+    if func_name == 'length':
+        return key in info and len(info.get(key)) == value
+    elif func_name == 'contains':
+        return key in info and value in info.get(key)
+    elif func_name == 'exists':
+        return key in info
+    elif func_name == 'absent':
+        return key not in info
+    elif func_name == 'equals':
+        lhs = info.get(key)
+        lhs = str(False if lhs is None else lhs)
+        return value.search(lhs) is not None
+    return False
+
+
+def _load_filtered_build_target(kb_km, parsed_filters):
+    """Returns a build target for the given keyboard/keymap combination if its info.json matches all filters, otherwise None.
+
+    Filters are evaluated within the worker, so only matching targets are sent back to the parent process.
+    """
+    with ignore_logging():
+        info = dotty(keymap_json(kb_km[0], kb_km[1]))
+
+    if not all(_filter_matches(info, *f) for f in parsed_filters):
+        return None
+
+    return KeyboardKeymapBuildTarget(keyboard=kb_km[0], keymap=kb_km[1], json=info)
 
 
 def _filter_keymap_targets(target_list: List[Tuple[str, str]], filters: List[str] = []) -> List[BuildTarget]:
@@ -124,66 +193,10 @@ def _filter_keymap_targets(target_list: List[Tuple[str, str]], filters: List[str
         cli.log.info('Preparing target list...')
         targets = list(set(parallel_map(_construct_build_target_kb_km, target_list)))
     else:
+        parsed_filters = _parse_filters(filters)
         cli.log.info('Parsing data for all matching keyboard/keymap combinations...')
-        valid_keymaps = [(e[0], e[1], dotty(e[2])) for e in parallel_map(_load_keymap_info, target_list)]
-
-        function_re = re.compile(r'^(?P<function>[a-zA-Z]+)\((?P<key>[a-zA-Z0-9_\.]+)(,\s*(?P<value>[^#]+))?\)$')
-        equals_re = re.compile(r'^(?P<key>[a-zA-Z0-9_\.]+)\s*=\s*(?P<value>[^#]+)$')
-
-        for filter_expr in filters:
-            function_match = function_re.match(filter_expr)
-            equals_match = equals_re.match(filter_expr)
-
-            if function_match is not None:
-                func_name = function_match.group('function').lower()
-                key = function_match.group('key')
-                value = function_match.group('value')
-
-                if value is not None:
-                    if func_name == 'length':
-                        valid_keymaps = filter(lambda e, key=key, value=value: key in e[2] and len(e[2].get(key)) == int(value), valid_keymaps)
-                    elif func_name == 'contains':
-                        valid_keymaps = filter(lambda e, key=key, value=value: key in e[2] and value in e[2].get(key), valid_keymaps)
-                    else:
-                        cli.log.warning(f'Unrecognized filter expression: {function_match.group(0)}')
-                        continue
-
-                    cli.log.info(f'Filtering on condition: {{fg_green}}{func_name}{{fg_reset}}({{fg_cyan}}{key}{{fg_reset}}, {{fg_cyan}}{value}{{fg_reset}})...')
-                else:
-                    if func_name == 'exists':
-                        valid_keymaps = filter(lambda e, key=key: key in e[2], valid_keymaps)
-                    elif func_name == 'absent':
-                        valid_keymaps = filter(lambda e, key=key: key not in e[2], valid_keymaps)
-                    else:
-                        cli.log.warning(f'Unrecognized filter expression: {function_match.group(0)}')
-                        continue
-
-                    cli.log.info(f'Filtering on condition: {{fg_green}}{func_name}{{fg_reset}}({{fg_cyan}}{key}{{fg_reset}})...')
-
-            elif equals_match is not None:
-                key = equals_match.group('key')
-                value = equals_match.group('value')
-                cli.log.info(f'Filtering on condition: {{fg_cyan}}{key}{{fg_reset}} == {{fg_cyan}}{value}{{fg_reset}}...')
-
-                def _make_filter(k, v):
-                    expr = fnmatch.translate(v)
-                    rule = re.compile(f'^{expr}$', re.IGNORECASE)
-
-                    def f(e):
-                        lhs = e[2].get(k)
-                        lhs = str(False if lhs is None else lhs)
-                        return rule.search(lhs) is not None
-
-                    return f
-
-                valid_keymaps = filter(_make_filter(key, value), valid_keymaps)
-            else:
-                cli.log.warning(f'Unrecognized filter expression: {filter_expr}')
-                continue
-
-        cli.log.info('Preparing target list...')
-        valid_keymaps = [(e[0], e[1], e[2].to_dict() if isinstance(e[2], Dotty) else e[2]) for e in valid_keymaps]  # need to convert dotty_dict back to dict because it doesn't survive parallelisation
-        targets = list(set(parallel_map(_construct_build_target_kb_km_json, list(valid_keymaps))))
+        load_fn = functools.partial(_load_filtered_build_target, parsed_filters=parsed_filters)
+        targets = list(set(filter(lambda e: e is not None, parallel_map(load_fn, target_list))))
 
     return targets
 
@@ -0,0 +1,319 @@
+"""Steno dictionaries for on-device translation.
+
+Compiles Plover JSON dictionaries into the trie read by `quantum/steno_dictionary.c`, and translates strokes the same way as the keyboard does, as a reference for it.
+"""
+import re
+import textwrap
+from collections import deque
+
+# Plover's steno order, a stroke is a bit per key in this order
+KEYS = '#STKPWHRAO*EUFRPBLGTSDZ'
+NUMBER_BAR = 0
+STAR = KEYS.index('*')
+FIRST_RIGHT = KEYS.index('E')
+MIDDLE = range(KEYS.index('A'), KEYS.index('U') + 1)
+
+# Keys that give a digit when pressed along with the number bar
+DIGITS = {1: '1', 2: '2', 4: '3', 6: '4', 8: '5', 9: '0', 13: '6', 15: '7', 17: '8', 19: '9'}
+DIGIT_KEYS = {digit: key for key, digit in DIGITS.items()}
+
+UNDO = 1 << STAR
+
+# Atom flags, as in `quantum/steno_dictionary.h`
+ATOM = 0x80
+ATTACH_PREVIOUS = 0x01
+ATTACH_NEXT = 0x02
+CAPITALIZE_NEXT = 0x04
+GLUE = 0x08
+
+NO_TEXT = 0xFFFFFF
+NODE_SIZE = 8
+
+_META = re.compile(r'\{([^{}]*)\}')
+_PUNCTUATION = {'.': CAPITALIZE_NEXT, '?': CAPITALIZE_NEXT, '!': CAPITALIZE_NEXT, ',': 0, ':': 0, ';': 0}
+
+
+def parse_stroke(text):
+    """Returns the bits of a stroke written in steno notation, such as `STKPW` or `-FRPB` or `1-9`.
+    """
+    bits = 0
+    position = 0
+    for c in text:
+        if c == '-':
+            position = max(position, FIRST_RIGHT)
+            continue
+        if c == '#':
+            key = NUMBER_BAR
+        elif c in DIGIT_KEYS:
+            key = DIGIT_KEYS[c]
+            bits |= 1 << NUMBER_BAR
+        else:
+            key = KEYS.find(c, position)
+        if key < position:
+            raise ValueError(f'Invalid stroke "{text}"')
+        bits |= 1 << key
+        position = key + 1
+    if not bits:
+        raise ValueError(f'Invalid stroke "{text}"')
+    return bits
+
+
+def parse_outline(text):
+    return tuple(parse_stroke(stroke) for stroke in text.split('/'))
+
+
+def stroke_to_string(stroke):
+    """Writes a stroke in steno notation, the inverse of `parse_stroke()`.
+    """
+    numbers = stroke & (1 << NUMBER_BAR) and any(stroke & (1 << key) for key in DIGITS)
+    hyphen = not any(stroke & (1 << key) for key in MIDDLE)
+    text = ''
+    for key, letter in enumerate(KEYS):
+        if not stroke & (1 << key):
+            continue
+        if key == NUMBER_BAR and numbers:
+            continue
+        if key >= FIRST_RIGHT and hyphen:
+            text += '-'
+            hyphen = False
+        text += DIGITS[key] if numbers and key in DIGITS else letter
+    return text
+
+
+def compile_translation(translation):
+    """Compiles a translation into atoms, each a flags byte with the top bit set followed by its text.
+
+    Returns None for translations using Plover commands the keyboard does not support.
+    """
+    if translation.startswith('='):
+        return None
+
+    atoms = []
+    position = 0
+    for match in list(_META.finditer(translation)) + [None]:
+        literal = translation[position:match.start() if match else len(translation)]
+        if literal:
+            atoms.append((0, literal))
+        if not match:
+            break
+        position = match.end()
+
+        meta = match.group(1)
+        if meta == '^':
+            atoms.append((ATTACH_NEXT, ''))
+        elif meta == '-|':
+            atoms.append((CAPITALIZE_NEXT, ''))
+        elif meta in _PUNCTUATION:
+            atoms.append((ATTACH_PREVIOUS | _PUNCTUATION[meta], meta))
+        elif meta.startswith('&') and len(meta) > 1:
+            atoms.append((GLUE, meta[1:]))
+        elif meta.replace('^', '') and not meta[0] in '#&-<>=*@:~$%' and '^' in (meta[0], meta[-1]):
+            flags = (ATTACH_PREVIOUS if meta[0] == '^' else 0) | (ATTACH_NEXT if meta[-1] == '^' else 0)
+            atoms.append((flags, meta.strip('^')))
+        else:
+            return None
+
+    if not atoms or not all(text.isascii() and text.isprintable() for _, text in atoms):
+        return None
+    return b''.join(bytes([ATOM | flags]) + text.encode('ascii') for flags, text in atoms) + b'\0'
+
+
+def parse_atoms(data):
+    """Splits compiled atoms back into `(flags, text)` pairs.
+    """
+    atoms = []
+    for byte in data[:data.index(0)]:
+        if byte & ATOM:
+            atoms.append([byte & ~ATOM, ''])
+        else:
+            atoms[-1][1] += chr(byte)
+    return [tuple(atom) for atom in atoms]
+
+
+def compile_dictionary(dictionary):
+    """Compiles `{outline: translation}` into `(entries, skipped)`, entries being `{strokes: atoms}`.
+    """
+    entries = {}
+    skipped = []
+    for outline, translation in dictionary.items():
+        try:
+            strokes = parse_outline(outline)
+        except ValueError:
+            skipped.append(outline)
+            continue
+        atoms = compile_translation(translation)
+        if atoms is None:
+            skipped.append(outline)
+            continue
+        entries[strokes] = atoms
+    return entries, skipped
+
+
+def build_trie(entries):
+    """Lays the entries out as a trie in level order, returning `(nodes, text)` as bytes.
+
+    Each node is 8 bytes: its stroke (3 bytes), the index of its first child (2 bytes) and the offset of its translation
+    in the text (3 bytes, 0xFFFFFF for none), all little endian. The children of a node are sorted by stroke and sit
+    from its first child up to the first child of the next node, with a node past the last one marking the end.
+    """
+    trie = {}
+    for strokes, atoms in entries.items():
+        node = trie
+        for stroke in strokes:
+            node = node.setdefault(stroke, {})
+        node[None] = atoms
+
+    text = bytearray()
+    offsets = {}
+
+    def text_offset(atoms):
+        if atoms is None:
+            return NO_TEXT
+        if atoms not in offsets:
+            offsets[atoms] = len(text)
+            text.extend(atoms)
+        return offsets[atoms]
+
+    order = [(0, trie)]
+    queue = deque([trie])
+    while queue:
+        node = queue.popleft()
+        for stroke in sorted(key for key in node if key is not None):
+            order.append((stroke, node[stroke]))
+            queue.append(node[stroke])
+
+    if len(order) >= 0xFFFF:
+        raise ValueError(f'The dictionary needs {len(order)} trie nodes, at most 65534 fit')
+
+    nodes = bytearray()
+    first_child = 1
+    for stroke, node in order + [(0, {})]:
+        translation = text_offset(node.get(None))
+        nodes += stroke.to_bytes(3, 'little') + first_child.to_bytes(2, 'little') + translation.to_bytes(3, 'little')
+        first_child += len([key for key in node if key is not None])
+
+    if len(text) >= NO_TEXT:
+        raise ValueError('The dictionary text does not fit in 16 MB')
+    return bytes(nodes), bytes(text)
+
+
+def longest_outline(entries):
+    return max(len(strokes) for strokes in entries)
+
+
+def data_lines(nodes, text, longest):
+    """Returns the C definitions of a compiled dictionary, for `steno_dictionary_data.h`.
+    """
+    def array(name, data):
+        return [
+            f'static const uint8_t {name}[{len(data)}] PROGMEM = {{',
+            textwrap.fill('    %s' % (', '.join(f'0x{b:02X}' for b in data)), width=100, subsequent_indent='    '),
+            '};',
+        ]
+
+    lines = [f'#define STENO_DICTIONARY_LONGEST {longest}', f'#define STENO_DICTIONARY_NODE_COUNT {len(nodes) // NODE_SIZE - 1}', '']
+    return lines + array('steno_dictionary_nodes', nodes) + [''] + array('steno_dictionary_text', text or b'\0')
+
+
+class Trie:
+    """Looks strokes up in the compiled trie, the way the keyboard does.
+    """
+    def __init__(self, nodes, text):
+        self.nodes = nodes
+        self.text = text
+
+    def _field(self, node, offset, size):
+        start = node * NODE_SIZE + offset
+        return int.from_bytes(self.nodes[start:start + size], 'little')
+
+    def lookup(self, strokes):
+        node = 0
+        for stroke in strokes:
+            low, high = self._field(node, 3, 2), self._field(node + 1, 3, 2)
+            while low < high:
+                middle = (low + high) // 2
+                if self._field(middle, 0, 3) < stroke:
+                    low = middle + 1
+                else:
+                    high = middle
+            if low == self._field(node + 1, 3, 2) or self._field(low, 0, 3) != stroke:
+                return None
+            node = low
+        offset = self._field(node, 5, 3)
+        if offset == NO_TEXT:
+            return None
+        return self.text[offset:self.text.index(0, offset) + 1]
+
+
+class Translator:
+    """Reference translator, turning strokes into the text the keyboard types.
+
+    Keeps the last `history` translations, merging a stroke with as many of them as make a longer entry, up to
+    `longest` strokes. The `*` stroke undoes the last translation, bringing back whatever it replaced.
+    """
+    def __init__(self, lookup, longest, history=16, strokes=32):
+        self.lookup = lookup
+        self.longest = longest
+        self.history_size = history
+        self.strokes_size = strokes
+        self.history = []
+        self.state = (True, False, False)
+        self.output = ''
+
+    def _type(self, backspaces, text):
+        if backspaces:
+            self.output = self.output[:-backspaces] if backspaces <= len(self.output) else ''
+        self.output += text
+
+    def _format(self, atoms):
+        attach, capitalize, glue = self.state
+        text = ''
+        for flags, atom in parse_atoms(atoms):
+            if not atom:
+                attach = attach or bool(flags & ATTACH_NEXT)
+                capitalize = capitalize or bool(flags & CAPITALIZE_NEXT)
+                continue
+            if not (attach or flags & ATTACH_PREVIOUS or (flags & GLUE and glue)):
+                text += ' '
+            text += atom[0].upper() + atom[1:] if capitalize else atom
+            attach, capitalize, glue = bool(flags & ATTACH_NEXT), bool(flags & CAPITALIZE_NEXT), bool(flags & GLUE)
+        self.state = (attach, capitalize, glue)
+        return text
+
+    def stroke(self, stroke):
+        if stroke == UNDO:
+            self.undo()
+            return
+
+        # Take the longest entry the stroke ends, along with as many of the previous translations as it covers
+        for merged in range(len(self.history), -1, -1):
+            previous = [s for strokes, _, _ in self.history[len(self.history) - merged:] for s in strokes]
+            if len(previous) + 1 > self.longest:
+                continue
+            atoms = self.lookup(tuple(previous) + (stroke, ))
+            if atoms is not None or merged == 0:
+                break
+        if atoms is None:
+            atoms = bytes([ATOM]) + stroke_to_string(stroke).encode('ascii') + b'\0'
+
+        backspaces = 0
+        for _ in range(merged):
+            _, length, self.state = self.history.pop()
+            backspaces += length
+        state = self.state
+        text = self._format(atoms)
+        self._type(backspaces, text)
+        self._push((tuple(previous) + (stroke, ), min(len(text), 255), state))
+
+    def _push(self, translation):
+        self.history.append(translation)
+        while len(self.history) > self.history_size or sum(len(strokes) for strokes, _, _ in self.history) > self.strokes_size:
+            self.history.pop(0)
+
+    def undo(self):
+        if not self.history:
+            return
+        strokes, length, self.state = self.history.pop()
+        self._type(length, '')
+        for stroke in strokes[:-1]:
+            self.stroke(stroke)
@@ -147,6 +147,21 @@ def test_json2c():
     assert result.stdout == '#include QMK_KEYBOARD_H\nconst uint16_t PROGMEM keymaps[][MATRIX_ROWS][MATRIX_COLS] = {\t[0] = LAYOUT_ortho_1x1(KC_A)};\n\n\n'
 
 
+def test_json2c_sparse():
+    result = check_subcommand('json2c', '--sparse', 'keyboards/handwired/pytest/has_template/keymaps/default_json/keymap.json')
+    check_returncode(result)
+    assert 'keymaps[]' not in result.stdout
+    assert '#define KEYMAP_SPARSE' in result.stdout
+    assert 'const uint16_t PROGMEM keymap_sparse_keycodes[] = {\n\t/* [0] */ KC_A,\n};' in result.stdout
+
+
+def test_keymap_size_report():
+    result = check_subcommand('keymap-size-report', '-kb', 'handwired/pytest/basic')
+    check_returncode(result)
+    assert 'handwired/pytest/basic' in result.stdout
+    assert 'Total: 2 -> 12 bytes' in result.stdout
+
+
 def test_json2c_macros():
     result = check_subcommand("json2c", 'keyboards/handwired/pytest/macro/keymaps/default/keymap.json')
     check_returncode(result)
@@ -286,6 +301,21 @@ def test_generate_rules_mk():
     assert 'MCU ?= atmega32u4' in result.stdout
 
 
+def test_generate_autocorrect_flash(tmp_path):
+    output = tmp_path / 'autocorrect.bin'
+    result = check_subcommand('generate-autocorrect-flash', 'tests/autocorrect_flash/en.txt', 'tests/autocorrect_flash/de.txt', '-o', str(output))
+    check_returncode(result)
+    assert 'Image size: 238 bytes' in result.stdout
+    assert output.read_bytes()[:4] == b'QAC\x01'
+
+
+def test_generate_steno_dictionary():
+    result = check_subcommand('generate-steno-dictionary', 'tests/steno_dictionary/dictionary.json')
+    check_returncode(result)
+    assert '#define STENO_DICTIONARY_LONGEST 3' in result.stdout
+    assert 'static const uint8_t steno_dictionary_nodes[168] PROGMEM' in result.stdout
+
+
 def test_generate_version_h():
     result = check_subcommand('generate-version-h')
     check_returncode(result)
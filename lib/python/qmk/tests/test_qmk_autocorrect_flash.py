@@ -0,0 +1,84 @@
+import random
+import re
+from pathlib import Path
+
+from qmk.autocorrect_flash import MAGIC, build_image, dictionaries, lookup
+
+FIXTURES = Path(__file__).parents[4] / 'tests' / 'autocorrect_flash'
+
+EN = [('fales', 'false'), (':thier', 'their'), (':teh:', 'the'), ('fitler', 'filter'), ('lenght', 'length'), ('lenth', 'length')]
+DE = [('nicth', 'nicht'), (':dsa:', 'das'), ('fitler', 'filter'), ('shcon', 'schon')]
+
+
+def parse_dictionary(path):
+    return [tuple(part.strip() for part in line.split('->')) for line in path.read_text(encoding='utf-8').splitlines()]
+
+
+def _random_dictionary(seed, count):
+    rng = random.Random(seed)
+    entries = {}
+    while len(entries) < count:
+        typo = ''.join(rng.choice('abcdefghijklmnopqrstuvwxyz') for _ in range(rng.randint(6, 10)))
+        if any(typo.endswith(other) or other.endswith(typo) for other in entries):
+            continue
+        position = rng.randrange(len(typo))
+        entries[typo] = typo[:position] + rng.choice([c for c in 'aeiou' if c != typo[position]]) + typo[position + 1:]
+    return list(entries.items())
+
+
+def test_lookup():
+    image = build_image([('en', EN), ('de', DE)])
+    (en, en_root, *en_lengths), (de, de_root, *de_lengths) = dictionaries(image)
+    assert (en, de) == ('en', 'de')
+    assert en_lengths == [5, 6, 4]
+    assert de_lengths == [5, 6, 4]
+
+    assert lookup(image, en_root, ':fales') == (1, 'se')
+    assert lookup(image, en_root, 'xfitler') == (3, 'lter')
+    assert lookup(image, en_root, ':teh:') == (2, 'he')
+    assert lookup(image, en_root, 'teh:') is None
+    assert lookup(image, en_root, 'xthier') is None
+    assert lookup(image, en_root, 'nicth') is None
+    assert lookup(image, de_root, 'nicth') == (1, 'ht')
+    assert lookup(image, de_root, 'fales') is None
+
+
+def test_lookup_random():
+    entries = _random_dictionary(1, 500)
+    for share in (True, False):
+        image = build_image([('random', entries)], share=share)
+        root = dictionaries(image)[0][1]
+        for typo, correction in entries:
+            backspaces, text = lookup(image, root, 'x' + typo)
+            assert (typo[:len(typo) - backspaces - 1] + text) == correction
+
+
+def test_sharing():
+    shared = build_image([('en', EN), ('de', DE)])
+    unshared = build_image([('en', EN), ('de', DE)], share=False)
+    assert len(shared) < len(unshared)
+
+    # A second copy of a dictionary costs only its header entry
+    entries = _random_dictionary(2, 200)
+    once = build_image([('a', entries)])
+    twice = build_image([('a', entries), ('b', entries)])
+    assert len(twice) == len(once) + 16
+    assert dictionaries(twice)[0][1:] == dictionaries(twice)[1][1:]
+
+
+def test_fixture():
+    assert parse_dictionary(FIXTURES / 'en.txt') == EN
+    assert parse_dictionary(FIXTURES / 'de.txt') == DE
+    header = (FIXTURES / 'autocorrect_image.h').read_text(encoding='utf-8')
+    data = bytes(int(byte, 16) for byte in re.findall(r'0x([0-9A-F]{2})', header))
+    assert data[:4] == MAGIC
+    assert data == build_image([('en', EN), ('de', DE)])
+
+
+def test_errors():
+    for dictionary in [[('toolongname', EN)], [('en', [('b' + 'a' * 70, 'c' + 'a' * 70)]), ('de', DE)]]:
+        try:
+            build_image(dictionary)
+        except ValueError:
+            continue
+        assert False, dictionary
@@ -0,0 +1,75 @@
+import struct
+
+from qmk.deferred_log import Decoder, format_table, render
+
+
+def _u32(*values):
+    return b''.join(struct.pack('<I', value & 0xFFFFFFFF) for value in values)
+
+
+def _record(id, args=b''):
+    return bytes([0xFE, 4 + len(args)]) + _u32(id) + args
+
+
+def _elf32(rodata_address, rodata, symbols):
+    """Builds a little endian ELF32 with a .rodata section and a symbol table of `(name, offset into .rodata)`.
+    """
+    strtab = b'\0'
+    symtab = bytes(16)
+    for name, offset in symbols:
+        symtab += struct.pack('<IIIBBH', len(strtab), rodata_address + offset, 0, 0, 0, 1)
+        strtab += name.encode() + b'\0'
+
+    header_size = 52
+    contents = [rodata, symtab, strtab]
+    offsets = []
+    position = header_size
+    for content in contents:
+        offsets.append(position)
+        position += len(content)
+
+    sections = bytes(40)
+    sections += struct.pack('<IIIIIIIIII', 0, 1, 2, rodata_address, offsets[0], len(rodata), 0, 0, 1, 0)
+    sections += struct.pack('<IIIIIIIIII', 0, 2, 0, 0, offsets[1], len(symtab), 3, 1, 4, 16)
+    sections += struct.pack('<IIIIIIIIII', 0, 3, 0, 0, offsets[2], len(strtab), 0, 0, 1, 0)
+
+    header = b'\x7fELF' + bytes([1, 1, 1]) + bytes(9)
+    header += struct.pack('<HHIIIIIHHHHHH', 2, 40, 1, 0, 0, position, 0, header_size, 0, 0, 40, 4, 0)
+    return header + b''.join(contents) + sections
+
+
+def test_render_matches_printf():
+    args = _u32(-5, 7, 0xAB, ord('q')) + b'hi\0' + _u32(3, 42, 0x1234)
+    assert render('%d %u %02x %c %s %5.*d%% %p', args) == '-5 7 ab q hi   042% 0x1234'
+
+
+def test_render_length_modifiers_and_binary():
+    assert render('%ld %lu %hhx %zu', _u32(-70000, 70000, 0x1F, 9)) == '-70000 70000 1f 9'
+    assert render('%08b|%-6b|%b', _u32(5, 3, 0)) == '00000101|11    |0'
+
+
+def test_render_floats():
+    assert render('%.2f', struct.pack('<f', 1.5)) == '1.50'
+
+
+def test_render_marks_what_was_left_off():
+    assert render('%s %u %u', b'cut\0' + _u32(1)) == 'cut 1 ?'
+
+
+def test_format_table_reads_symbols():
+    rodata = b'other\0matrix %u\n\0loop %d\n\0'
+    elf = _elf32(0x08001000, rodata, [('deferred_log_format.0', 6), ('some_other_symbol', 0), ('deferred_log_format.1', 17)])
+    assert format_table(elf) == {0x08001006: 'matrix %u\n', 0x08001011: 'loop %d\n'}
+
+
+def test_decoder_handles_split_records_and_padding():
+    decoder = Decoder({0x1000: 'matrix %u\n', 0x2000: 'loop %d\n'})
+    stream = _record(0x1000, _u32(5)) + bytes(10) + _record(0x2000, _u32(-1)) + _record(0, _u32(3)) + _record(0x3000, b'\x01')
+
+    text = ''.join(decoder.feed(stream[i:i + 7]) for i in range(0, len(stream), 7))
+    assert text == 'matrix 5\nloop -1\n<3 log records dropped>\n<unknown log format 0x3000: 01>\n'
+
+
+def test_decoder_passes_plain_text_through():
+    decoder = Decoder({0x1000: '%u\n'})
+    assert decoder.feed(b'plain ' + _record(0x1000, _u32(1)) + b'text') == 'plain 1\ntext'
@@ -32,6 +32,50 @@ def test_generate_c_pytest_has_template():
     assert templ == '#include QMK_KEYBOARD_H\nconst uint16_t PROGMEM keymaps[][MATRIX_ROWS][MATRIX_COLS] = {\t[0] = LAYOUT(KC_A)};\n'
 
 
+def test_generate_c_pytest_has_template_sparse():
+    keymap_json = {
+        'keyboard': 'handwired/pytest/has_template',
+        'layout': 'LAYOUT',
+        'layers': [['KC_A'], ['KC_TRNS']],
+        'macros': None,
+    }
+    templ = qmk.keymap.generate_c(keymap_json, sparse=True)
+    assert 'keymaps[]' not in templ
+    assert '#define KEYMAP_SPARSE' in templ
+    assert 'const uint32_t PROGMEM keymap_sparse_bitmap[][1] = {\n\t[0] = {0x00000001},\n\t[1] = {0x00000000},\n};' in templ
+    assert 'const uint16_t PROGMEM keymap_sparse_ranks[][1] = {\n\t[0] = {0},\n\t[1] = {1},\n};' in templ
+    assert 'const uint16_t PROGMEM keymap_sparse_keycodes[] = {\n\t/* [0] */ KC_A,\n};' in templ
+
+
+def test_sparse_keymap_matches_dense():
+    rows, cols = 2, 5
+    positions = [(0, 0), (0, 1), (0, 2), (0, 3), (0, 4), (1, 0), (1, 2), (1, 4)]
+    layers = [
+        ['KC_A', 'KC_B', 'KC_C', 'KC_D', 'KC_E', 'KC_F', 'KC_NO', 'MO(1)'],
+        ['KC_TRNS', '_______', 'KC_1', 'KC_TRANSPARENT', 'XXXXXXX', 'ANY(KC_2)', 'KC_TRNS', 'KC_TRNS'],
+        ['KC_TRNS'] * 8,
+    ]
+    sparse = qmk.keymap.sparse_keymap(layers, rows, cols, positions)
+
+    def _bit(bitmap, index):
+        return bitmap[index // 32] & (1 << (index % 32))
+
+    for layer_num, layer in enumerate(layers):
+        dense = {row * cols + col: qmk.keymap._strip_any(keycode) for (row, col), keycode in zip(positions, layer)}
+        bitmap = sparse['bitmaps'][layer_num]
+        for index in range(rows * cols):
+            if _bit(bitmap, index):
+                rank = sparse['ranks'][layer_num][index // 32] + sum(_bit(bitmap, i) != 0 for i in range(index - index % 32, index))
+                keycode = sparse['keycodes'][rank]
+            else:
+                keycode = 'KC_TRNS' if _bit(sparse['layout'], index) else 'KC_NO'
+            expected = dense.get(index, 'KC_NO')
+            assert keycode == ('KC_TRNS' if expected in qmk.keymap.SPARSE_TRANSPARENT_KEYCODES else expected)
+
+    assert sparse['ranks'] == [[0], [8], [11]]
+    assert qmk.keymap.sparse_keymap_size(sparse, rows, cols) == (60, 4 + 3 * 4 + 3 * 2 + 11 * 2)
+
+
 def test_generate_json_pytest_has_template():
     templ = qmk.keymap.generate_json('default', 'handwired/pytest/has_template', 'LAYOUT', [['KC_A']])
     assert templ == {"keyboard": "handwired/pytest/has_template", "documentation": "This file is a keymap.json file for handwired/pytest/has_template", "keymap": "default", "layout": "LAYOUT", "layers": [["KC_A"]]}
@@ -0,0 +1,134 @@
+import io
+import random
+
+from PIL import Image
+
+import qmk.painter
+import qmk.painter_qgf  # noqa: registers the QGF format with PIL
+
+
+def _reference_convert_image_bytes(im, format):
+    """Per-pixel implementation of `qmk.painter.convert_image_bytes()`, used as the source of truth.
+    """
+    ncolors = format["num_colors"]
+    image_format = format["image_format"]
+    shifter = ncolors.bit_length() - 1
+    pixels_per_byte = 8 // shifter
+
+    output = []
+    if image_format in ['IMAGE_FORMAT_GRAYSCALE', 'IMAGE_FORMAT_PALETTE']:
+        if image_format == 'IMAGE_FORMAT_GRAYSCALE':
+            values = [qmk.painter.rescale_byte(v, ncolors - 1) for v in im.tobytes("raw", "R")]
+        else:
+            values = [v & (ncolors - 1) for v in im.tobytes("raw", "P")]
+        for x in range((len(values) + pixels_per_byte - 1) // pixels_per_byte):
+            byte = 0
+            for n in range(pixels_per_byte):
+                if x * pixels_per_byte + n < len(values):
+                    byte = byte | (values[x * pixels_per_byte + n] << (n * shifter))
+            output.append(byte)
+    elif image_format == 'IMAGE_FORMAT_RGB565':
+        for r, g, b in zip(im.tobytes("raw", "R"), im.tobytes("raw", "G"), im.tobytes("raw", "B")):
+            output.extend(qmk.painter.rgb_to565(r, g, b))
+    elif image_format == 'IMAGE_FORMAT_RGB888':
+        for r, g, b in zip(im.tobytes("raw", "R"), im.tobytes("raw", "G"), im.tobytes("raw", "B")):
+            output.extend([r, g, b])
+    return output
+
+
+def _reference_compress_bytes_qmk_rle(data):
+    """Byte-at-a-time implementation of `qmk.painter.compress_bytes_qmk_rle()`, used as the source of truth.
+    """
+    output = []
+    temp = []
+    repeat = False
+    for n in range(0, len(data) + 1):
+        end = n == len(data)
+        if not end:
+            temp.append(data[n])
+            if len(temp) <= 1:
+                continue
+        if repeat:
+            if temp[-1] != temp[-2]:
+                repeat = False
+            if not repeat or len(temp) == 128 or end:
+                output.extend([len(temp) if end else len(temp) - 1, temp[0]])
+                temp = [temp[-1]]
+                repeat = False
+        else:
+            if len(temp) >= 2 and temp[-1] == temp[-2]:
+                repeat = True
+                if len(temp) > 2:
+                    output.append(127 + len(temp) - 2)
+                    output.extend(temp[0:(len(temp) - 2)])
+                    temp = [temp[-1], temp[-1]]
+                continue
+            if len(temp) == 128 or end:
+                output.append(127 + len(temp))
+                output.extend(temp)
+                temp = []
+    return output
+
+
+def _sample_images():
+    rng = random.Random(1234)
+    width, height = 37, 23
+
+    gradient = Image.new('RGB', (width, height))
+    gradient.putdata([(x * 7 % 256, y * 11 % 256, (x * y) % 256) for y in range(height) for x in range(width)])
+
+    noise = Image.new('RGB', (width, height))
+    noise.putdata([(rng.randrange(256), rng.randrange(256), rng.randrange(256)) for _ in range(width * height)])
+
+    blocky = Image.new('RGB', (width, height))
+    blocky.putdata([((x // 9) * 60, (y // 5) * 40, 128) for y in range(height) for x in range(width)])
+
+    return [gradient, noise, blocky]
+
+
+def test_convert_image_bytes_matches_reference():
+    for im in _sample_images():
+        for format in qmk.painter.valid_formats.values():
+            converted = qmk.painter.convert_requested_format(im, format)
+            (_, image_bytes) = qmk.painter.convert_image_bytes(converted, format)
+            assert image_bytes == _reference_convert_image_bytes(converted, format)
+
+
+def test_compress_bytes_qmk_rle_matches_reference():
+    rng = random.Random(5678)
+    samples = [[], [1], [1, 1], [1, 2], [0] * 127, [0] * 128, [0] * 129, [0] * 300, list(range(128)), list(range(256)) * 3]
+    for _ in range(500):
+        data = []
+        while len(data) < 400:
+            data.extend([rng.randrange(rng.choice([2, 4, 256]))] * rng.choice([1, 1, 2, 3, 127, 128, 129, 255]))
+        samples.append(data[:rng.randrange(400)])
+
+    for data in samples:
+        assert qmk.painter.compress_bytes_qmk_rle(data) == _reference_compress_bytes_qmk_rle(data)
+
+    for im in _sample_images():
+        for format in qmk.painter.valid_formats.values():
+            (_, image_bytes) = qmk.painter.convert_image_bytes(qmk.painter.convert_requested_format(im, format), format)
+            assert qmk.painter.compress_bytes_qmk_rle(image_bytes) == _reference_compress_bytes_qmk_rle(image_bytes)
+
+
+def test_qgf_parallel_frames_match_serial():
+    frames = _sample_images()
+
+    def _save(format):
+        out = io.BytesIO()
+        frames[0].save(out, "QGF", append_images=frames[1:], use_deltas=True, use_rle=True, qmk_format=format)
+        return out.getvalue()
+
+    for format in qmk.painter.valid_formats.values():
+        parallel = _save(format)
+
+        # Frames are encoded across worker processes -- the output must match encoding each frame in order
+        original_parallel_map = qmk.painter_qgf.parallel_map
+        qmk.painter_qgf.parallel_map = lambda fn, args: list(map(fn, args))
+        try:
+            serial = _save(format)
+        finally:
+            qmk.painter_qgf.parallel_map = original_parallel_map
+
+        assert parallel == serial
@@ -0,0 +1,71 @@
+import pickle
+
+from dotty_dict import dotty
+
+import qmk.search
+from qmk.search import _filter_matches, _load_filtered_build_target, _parse_filters
+
+INFO = {
+    'keyboard_name': 'Handwired Example',
+    'features': {
+        'rgb_matrix': True,
+    },
+    'layouts': {
+        'LAYOUT': {
+            'layout': [{'x': 0, 'y': 0}, {'x': 1, 'y': 0}],
+        },
+    },
+    'community_layouts': ['ortho_1x2'],
+}
+
+
+def _matches(filters, info=INFO):
+    data = dotty(info)
+    return all(_filter_matches(data, *f) for f in _parse_filters(filters))
+
+
+def test_parse_filters():
+    assert _parse_filters(['exists(features.rgb_matrix)']) == [('exists', 'features.rgb_matrix', None)]
+    assert _parse_filters(['absent(features.audio)']) == [('absent', 'features.audio', None)]
+    assert _parse_filters(['length(layouts.LAYOUT.layout, 2)']) == [('length', 'layouts.LAYOUT.layout', 2)]
+    assert _parse_filters(['contains(community_layouts, ortho_1x2)']) == [('contains', 'community_layouts', 'ortho_1x2')]
+
+    parsed = _parse_filters(['keyboard_name=handwired*'])
+    assert len(parsed) == 1
+    assert parsed[0][:2] == ('equals', 'keyboard_name')
+
+
+def test_parse_filters_unrecognized():
+    assert _parse_filters(['nonsense(features.rgb_matrix)', 'exists(features.rgb_matrix, 1)', 'length(layouts)', '?!']) == []
+
+
+def test_parse_filters_picklable():
+    # Parsed filters are shipped to the search worker processes
+    parsed = _parse_filters(['exists(features.rgb_matrix)', 'keyboard_name=handwired*', 'length(community_layouts, 1)'])
+    assert pickle.loads(pickle.dumps(parsed)) == parsed
+
+
+def test_filter_matches():
+    assert _matches(['exists(features.rgb_matrix)'])
+    assert not _matches(['exists(features.audio)'])
+    assert _matches(['absent(features.audio)'])
+    assert _matches(['length(layouts.LAYOUT.layout, 2)'])
+    assert not _matches(['length(layouts.LAYOUT.layout, 3)'])
+    assert _matches(['contains(community_layouts, ortho_1x2)'])
+    assert not _matches(['contains(community_layouts, ortho_4x4)'])
+    assert _matches(['keyboard_name=handwired*'])
+    assert not _matches(['keyboard_name=planck*'])
+    assert _matches(['features.audio=false'])
+    assert _matches(['exists(features.rgb_matrix)', 'keyboard_name=*example'])
+    assert not _matches(['exists(features.rgb_matrix)', 'keyboard_name=planck*'])
+
+
+def test_load_filtered_build_target(monkeypatch):
+    monkeypatch.setattr(qmk.search, 'keymap_json', lambda keyboard, keymap: INFO)
+
+    target = _load_filtered_build_target(('planck/rev6', 'default'), _parse_filters(['exists(features.rgb_matrix)']))
+    assert target.keyboard == 'planck/rev6'
+    assert target.keymap == 'default'
+    assert target.json['keyboard_name'] == 'Handwired Example'
+
+    assert _load_filtered_build_target(('planck/rev6', 'default'), _parse_filters(['exists(features.audio)'])) is None
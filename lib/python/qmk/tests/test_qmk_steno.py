@@ -0,0 +1,92 @@
+import json
+import random
+import re
+from pathlib import Path
+
+from qmk.steno import ATOM, ATTACH_NEXT, ATTACH_PREVIOUS, CAPITALIZE_NEXT, GLUE, Translator, Trie, build_trie, compile_dictionary, compile_translation, longest_outline, parse_atoms, parse_outline, parse_stroke, stroke_to_string
+
+FIXTURES = Path(__file__).parents[4] / 'tests' / 'steno_dictionary'
+
+
+def _fixture():
+    entries, _ = compile_dictionary(json.loads((FIXTURES / 'dictionary.json').read_text(encoding='utf-8')))
+    return entries, Trie(*build_trie(entries))
+
+
+def test_stroke_notation():
+    for stroke in ['STKPW', '-FRPB', 'KAEF', '1-9', '#*', '#-Z', '12K3W4R50*EU6R7B8G9SDZ', 'S', '-S', '*E']:
+        assert stroke_to_string(parse_stroke(stroke)) == stroke
+    assert parse_stroke('#S') == parse_stroke('1')
+    assert parse_outline('TEFT/-G') == (parse_stroke('TEFT'), parse_stroke('-G'))
+
+
+def test_stroke_notation_invalid():
+    for stroke in ['', '-', 'SS-SS', 'FA', 'X', 'E-A']:
+        try:
+            parse_stroke(stroke)
+        except ValueError:
+            continue
+        assert False, stroke
+
+
+def test_compile_translation():
+    assert parse_atoms(compile_translation('hello world')) == [(0, 'hello world')]
+    assert parse_atoms(compile_translation('{^ing}')) == [(ATTACH_PREVIOUS, 'ing')]
+    assert parse_atoms(compile_translation('{mega^}')) == [(ATTACH_NEXT, 'mega')]
+    assert parse_atoms(compile_translation('{.}')) == [(ATTACH_PREVIOUS | CAPITALIZE_NEXT, '.')]
+    assert parse_atoms(compile_translation('{^}{-|}')) == [(ATTACH_NEXT, ''), (CAPITALIZE_NEXT, '')]
+    assert parse_atoms(compile_translation('{&a}')) == [(GLUE, 'a')]
+    assert compile_translation('{^}') == bytes([ATOM | ATTACH_NEXT, 0])
+    for unsupported in ['=undo', '{#Return}', '{PLOVER:TOGGLE}', 'café', '{*-|}', '']:
+        assert compile_translation(unsupported) is None
+
+
+def test_trie_lookup():
+    random.seed(1)
+    keys = [1 << key for key in range(23)]
+    dictionary = {}
+    for _ in range(2000):
+        outline = '/'.join(stroke_to_string(sum(random.sample(keys, random.randint(1, 6)))) for _ in range(random.randint(1, 4)))
+        dictionary[outline] = f'word{len(dictionary)}'
+
+    entries, skipped = compile_dictionary(dictionary)
+    assert not skipped
+    trie = Trie(*build_trie(entries))
+    for strokes, atoms in entries.items():
+        assert trie.lookup(strokes) == atoms
+        assert trie.lookup(strokes + (1 << 22, 1 << 22, 1 << 22, 1 << 22)) is None
+    assert trie.lookup(()) is None
+
+
+def test_fixture_is_generated():
+    entries, _ = _fixture()
+    nodes, text = build_trie(entries)
+    header = (FIXTURES / 'steno_dictionary_data.h').read_text(encoding='utf-8')
+    arrays = {name: bytes(int(b, 16) for b in re.findall(r'0x([0-9A-F]{2})', body)) for name, body in re.findall(r'(\w+)\[\d+\] PROGMEM = \{(.*?)\};', header, re.S)}
+    assert arrays == {'steno_dictionary_nodes': nodes, 'steno_dictionary_text': text}
+    assert f'#define STENO_DICTIONARY_LONGEST {longest_outline(entries)}' in header
+
+
+def test_translator_cases():
+    entries, trie = _fixture()
+    count = 0
+    for line in (FIXTURES / 'cases.txt').read_text(encoding='utf-8').splitlines():
+        if not line or line.startswith('#'):
+            continue
+        outline, expected = line.split(' ->')
+        translator = Translator(trie.lookup, longest_outline(entries))
+        for stroke in outline.split('/'):
+            translator.stroke(parse_stroke(stroke))
+        assert translator.output == expected[1:], outline
+        count += 1
+    assert count > 20
+
+
+def test_translator_history():
+    entries, trie = _fixture()
+    translator = Translator(trie.lookup, longest_outline(entries), history=4)
+    for _ in range(10):
+        translator.stroke(parse_stroke('H-L'))
+    for _ in range(10):
+        translator.stroke(parse_stroke('*'))
+    assert translator.output == ' '.join(['hello'] * 6)
@@ -0,0 +1,31 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <stdbool.h>
+#include <avr/sleep.h>
+#include <avr/interrupt.h>
+#include "tickless_idle.h"
+#include "timer.h"
+
+static volatile bool wake_pending = false;
+
+void tickless_idle_sleep_until(uint32_t deadline) {
+    // The timer interrupt wakes the MCU every millisecond, as do USB interrupts
+    set_sleep_mode(SLEEP_MODE_IDLE);
+    while ((int32_t)TIMER_DIFF_32(deadline, timer_read32()) > 0) {
+        cli();
+        if (wake_pending) {
+            sei();
+            break;
+        }
+        sleep_enable();
+        sei();
+        sleep_cpu();
+        sleep_disable();
+    }
+    wake_pending = false;
+}
+
+void tickless_idle_wake(void) {
+    wake_pending = true;
+}
@@ -0,0 +1,24 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <ch.h>
+#include "tickless_idle.h"
+#include "timer.h"
+
+static BSEMAPHORE_DECL(wake_semaphore, true);
+
+void tickless_idle_sleep_until(uint32_t deadline) {
+    int32_t sleep_ms = (int32_t)TIMER_DIFF_32(deadline, timer_read32());
+    if (sleep_ms <= 0) {
+        return;
+    }
+
+    // The idle thread runs in the meantime, which waits for interrupts if the port enables it
+    chBSemWaitTimeout(&wake_semaphore, TIME_MS2I(sleep_ms));
+}
+
+void tickless_idle_wake(void) {
+    chSysLockFromISR();
+    chBSemSignalI(&wake_semaphore);
+    chSysUnlockFromISR();
+}
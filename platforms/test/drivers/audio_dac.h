@@ -0,0 +1,45 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+
+// Mirrors the defaults of platforms/chibios/drivers/audio_dac.h, see there for details
+
+#define AUDIO_DAC_BUFFER_SIZE 256U
+
+#ifndef AUDIO_DAC_SAMPLE_MAX
+#    define AUDIO_DAC_SAMPLE_MAX 4095U
+#endif
+
+#ifndef AUDIO_DAC_SAMPLE_RATE
+#    define AUDIO_DAC_SAMPLE_RATE 44100U
+#endif
+
+#ifndef AUDIO_MAX_SIMULTANEOUS_TONES
+#    define AUDIO_MAX_SIMULTANEOUS_TONES 2
+#endif
+
+#ifndef AUDIO_DAC_OFF_VALUE
+#    define AUDIO_DAC_OFF_VALUE AUDIO_DAC_SAMPLE_MAX / 2
+#endif
+
+typedef uint16_t dacsample_t;
+
+/**
+ *user overridable sample generation/processing
+ */
+uint16_t dac_value_generate(void);
+
+/**
+ * Renders the next `count` samples, at AUDIO_DAC_OUTPUT_RATE, as the DAC would output them.
+ *
+ * Audio state is advanced once per call, so this should be called with AUDIO_DAC_BUFFER_SIZE / 2 samples at a time to
+ * match the hardware.
+ *
+ * @return false while the output is stopped
+ */
+bool audio_dac_render(dacsample_t *samples, size_t count);
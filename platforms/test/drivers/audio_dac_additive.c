@@ -0,0 +1,34 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "audio.h"
+#include "dac_additive.h"
+
+static bool dac_running = false;
+
+void audio_driver_initialize(void) {
+    dac_running = false;
+}
+
+void audio_driver_start(void) {
+    dac_additive_start();
+    dac_running = true;
+}
+
+void audio_driver_stop(void) {
+    dac_additive_stop();
+}
+
+bool audio_dac_render(dacsample_t *samples, size_t count) {
+    if (!dac_running) {
+        for (size_t s = 0; s < count; s++) {
+            samples[s] = AUDIO_DAC_OFF_VALUE;
+        }
+        return false;
+    }
+
+    if (dac_additive_render(samples, count)) {
+        dac_running = false;
+    }
+    return true;
+}
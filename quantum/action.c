@@ -32,6 +32,10 @@ along with this program.  If not, see <http://www.gnu.org/licenses/>.
 #include "debug.h"
 #include "quantum.h"
 
+#ifdef LATENCY_TRACE_ENABLE
+#    include "latency_trace.h"
+#endif
+
 #ifdef BACKLIGHT_ENABLE
 #    include "backlight.h"
 #endif
@@ -271,6 +275,10 @@ void process_record(keyrecord_t *record) {
         return;
     }
 
+#ifdef LATENCY_TRACE_ENABLE
+    latency_trace_processed(&record->event);
+#endif
+
     if (!process_record_quantum(record)) {
 #ifndef NO_ACTION_ONESHOT
         if (is_oneshot_layer_active() && record->event.pressed && keymap_config.oneshot_enable) {
@@ -1,5 +1,6 @@
 #include <limits.h>
 #include <stdint.h>
+#include <string.h>
 
 #include "keyboard.h"
 #include "action.h"
@@ -316,16 +317,15 @@ action_t store_or_get_action(bool pressed, keypos_t key) {
 #endif
 }
 
-/** \brief Layer switch get layer
+#ifndef NO_ACTION_LAYER
+/** \brief Layer switch search
  *
- * Gets the layer based on key info
+ * Finds the topmost non-transparent layer for the key amongst the given layers
  */
-uint8_t layer_switch_get_layer(keypos_t key) {
-#ifndef NO_ACTION_LAYER
+static uint8_t layer_switch_search(keypos_t key, layer_state_t layers) {
     action_t action;
     action.code = ACTION_TRANSPARENT;
 
-    layer_state_t layers = layer_state | default_layer_state;
     /* check top layer first */
     for (int8_t i = MAX_LAYER - 1; i >= 0; i--) {
         if (layers & ((layer_state_t)1 << i)) {
@@ -337,6 +337,75 @@ uint8_t layer_switch_get_layer(keypos_t key) {
     }
     /* fall back to layer 0 */
     return 0;
+}
+#endif
+
+#if defined(RESOLVED_LAYER_CACHE) && !defined(NO_ACTION_LAYER)
+#    define RESOLVED_LAYER_UNKNOWN UINT8_MAX
+
+/** \brief resolved layer cache
+ *
+ * Topmost non-transparent layer of each matrix position for the layers in resolved_layers_state,
+ * or RESOLVED_LAYER_UNKNOWN if it hasn't been looked up since it could have changed.
+ */
+static uint8_t       resolved_layers[MATRIX_ROWS][MATRIX_COLS];
+static layer_state_t resolved_layers_state = 0;
+static bool          resolved_layers_valid = false;
+
+/** \brief Resolved layer cache invalidate
+ *
+ * Forgets every resolved layer, needed whenever the keymap itself changes
+ */
+void resolved_layer_cache_invalidate(void) {
+    resolved_layers_valid = false;
+}
+
+/** \brief Resolved layer cache update
+ *
+ * Forgets the resolved layers which may differ for the new layer state
+ */
+static void resolved_layer_cache_update(layer_state_t layers) {
+    if (!resolved_layers_valid) {
+        memset(resolved_layers, RESOLVED_LAYER_UNKNOWN, sizeof(resolved_layers));
+        resolved_layers_valid = true;
+    } else {
+        layer_state_t enabled = layers & ~resolved_layers_state;
+        uint8_t *     entry   = &resolved_layers[0][0];
+        for (uint16_t i = 0; i < MATRIX_ROWS * MATRIX_COLS; i++, entry++) {
+            if (*entry == RESOLVED_LAYER_UNKNOWN) {
+                continue;
+            }
+            // Only stale if the resolved layer was turned off, or a layer above it was turned on
+            layer_state_t layer_mask = (layer_state_t)1 << *entry;
+            if (!(layers & layer_mask) || (enabled & ~(layer_mask | (layer_mask - 1)))) {
+                *entry = RESOLVED_LAYER_UNKNOWN;
+            }
+        }
+    }
+    resolved_layers_state = layers;
+}
+#endif
+
+/** \brief Layer switch get layer
+ *
+ * Gets the layer based on key info
+ */
+uint8_t layer_switch_get_layer(keypos_t key) {
+#ifndef NO_ACTION_LAYER
+    layer_state_t layers = layer_state | default_layer_state;
+#    ifdef RESOLVED_LAYER_CACHE
+    if (key.row < MATRIX_ROWS && key.col < MATRIX_COLS) {
+        if (!resolved_layers_valid || layers != resolved_layers_state) {
+            resolved_layer_cache_update(layers);
+        }
+        uint8_t *entry = &resolved_layers[key.row][key.col];
+        if (*entry == RESOLVED_LAYER_UNKNOWN) {
+            *entry = layer_switch_search(key, layers);
+        }
+        return *entry;
+    }
+#    endif
+    return layer_switch_search(key, layers);
 #else
     return get_highest_layer(default_layer_state);
 #endif
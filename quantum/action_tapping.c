@@ -55,6 +55,22 @@ __attribute__((weak)) bool get_hold_on_other_key_press(uint16_t keycode, keyreco
 }
 #    endif
 
+#    ifdef ROLLING_HOLD_PER_KEY
+__attribute__((weak)) bool get_rolling_hold(uint16_t keycode, keyrecord_t *record) {
+    return false;
+}
+#    endif
+
+#    ifdef ROLLING_HOLD_OVERLAP_PER_KEY
+__attribute__((weak)) uint8_t get_rolling_hold_overlap(uint16_t keycode, keyrecord_t *record) {
+    return ROLLING_HOLD_OVERLAP;
+}
+#    endif
+
+#    if defined(ROLLING_HOLD) || defined(ROLLING_HOLD_PER_KEY)
+#        define ROLLING_HOLD_ENABLE
+#    endif
+
 #    if defined(AUTO_SHIFT_ENABLE) && defined(RETRO_SHIFT)
 #        include "process_auto_shift.h"
 #    endif
@@ -70,6 +86,10 @@ static void waiting_buffer_clear(void);
 static bool waiting_buffer_typed(keyevent_t event);
 static bool waiting_buffer_has_anykey_pressed(void);
 static void waiting_buffer_scan_tap(void);
+#    ifdef ROLLING_HOLD_ENABLE
+static bool rolling_hold_resolve(bool expired);
+static bool rolling_hold_resume(keyrecord_t *keyp);
+#    endif
 static void debug_tapping_key(void);
 static void debug_waiting_buffer(void);
 
@@ -157,6 +177,14 @@ void action_tapping_process(keyrecord_t record) {
 #        define TAP_GET_HOLD_ON_OTHER_KEY_PRESS false
 #    endif
 
+#    ifdef ROLLING_HOLD_PER_KEY
+#        define TAP_GET_ROLLING_HOLD get_rolling_hold(tapping_keycode, &tapping_key)
+#    elif defined(ROLLING_HOLD)
+#        define TAP_GET_ROLLING_HOLD true
+#    else
+#        define TAP_GET_ROLLING_HOLD false
+#    endif
+
 /** \brief Tapping
  *
  * Rule: Tap key is typed(pressed and released) within TAPPING_TERM.
@@ -188,13 +216,33 @@ bool process_tapping(keyrecord_t *keyp) {
         return true;
     }
 
-#    if (defined(AUTO_SHIFT_ENABLE) && defined(RETRO_SHIFT)) || defined(PERMISSIVE_HOLD_PER_KEY) || defined(HOLD_ON_OTHER_KEY_PRESS_PER_KEY)
+#    if (defined(AUTO_SHIFT_ENABLE) && defined(RETRO_SHIFT)) || defined(PERMISSIVE_HOLD_PER_KEY) || defined(HOLD_ON_OTHER_KEY_PRESS_PER_KEY) || defined(ROLLING_HOLD_PER_KEY)
     TAP_DEFINE_KEYCODE;
 #    endif
 
     // process "pressed" tapping key state
     if (tapping_key.event.pressed) {
         if (WITHIN_TAPPING_TERM(event) || MAYBE_RETRO_SHIFTING(event, keyp)) {
+#    ifdef ROLLING_HOLD_ENABLE
+            if (tapping_key.tap.count == 0 && TAP_GET_ROLLING_HOLD) {
+                if (rolling_hold_resolve(false)) {
+                    return rolling_hold_resume(keyp);
+                }
+                if (IS_NOEVENT(event)) {
+                    return true;
+                }
+                if (event.pressed) {
+                    tapping_key.tap.interrupted = true;
+                    // enqueue
+                    return false;
+                }
+                if (IS_TAPPING_RECORD(keyp) || waiting_buffer_typed(event)) {
+                    // enqueue, decided once in the waiting buffer
+                    return false;
+                }
+                // release of a key pressed before tapping starts, as below
+            }
+#    endif
             if (IS_NOEVENT(event)) {
                 // early return for tick events
                 return true;
@@ -332,6 +380,12 @@ bool process_tapping(keyrecord_t *keyp) {
         }
         // after TAPPING_TERM
         else {
+#    ifdef ROLLING_HOLD_ENABLE
+            if (tapping_key.tap.count == 0 && TAP_GET_ROLLING_HOLD) {
+                rolling_hold_resolve(true);
+                return rolling_hold_resume(keyp);
+            }
+#    endif
             if (tapping_key.tap.count == 0) {
                 ac_dprintf("Tapping: End. Timeout. Not tap(0): ");
                 debug_event(event);
@@ -520,6 +574,96 @@ void waiting_buffer_scan_tap(void) {
     }
 }
 
+#    ifdef ROLLING_HOLD_ENABLE
+/** \brief Rolling hold
+ *
+ * Decides the tapping key from all the events waiting behind it. Another key pressed while it is held makes it a
+ * hold if the two were held together for at least ROLLING_HOLD_OVERLAP percent of the time the other key was
+ * held, which a key pressed and released within it always is. Once the tapping key is released and every key
+ * pressed meanwhile is below that, it is a tap. A key still held only overlaps less the longer it is held, so this
+ * is decided on tick events as soon as it is certain, rather than on its release.
+ *
+ * \param expired The tapping term has run out, decide on what is known.
+ * \return Whether the tapping key was decided, either registered as a tap or processed as a hold.
+ */
+static bool rolling_hold_resolve(bool expired) {
+    const uint16_t now         = timer_read();
+    const uint8_t  overlap     = GET_ROLLING_HOLD_OVERLAP(get_record_keycode(&tapping_key, false), &tapping_key);
+    bool           released    = false;
+    uint16_t       released_at = now;
+    uint8_t        end         = waiting_buffer_head;
+
+    for (uint8_t i = waiting_buffer_tail; i != waiting_buffer_head; i = (i + 1) % WAITING_BUFFER_SIZE) {
+        if (IS_EVENT(waiting_buffer[i].event) && KEYEQ(waiting_buffer[i].event.key, tapping_key.event.key) && !waiting_buffer[i].event.pressed) {
+            released    = true;
+            released_at = waiting_buffer[i].event.time;
+            end         = i;
+            break;
+        }
+    }
+
+    bool hold = expired && !released, undecided = false;
+    for (uint8_t i = waiting_buffer_tail; i != end && !hold; i = (i + 1) % WAITING_BUFFER_SIZE) {
+        const keyevent_t press = waiting_buffer[i].event;
+        if (!IS_EVENT(press) || !press.pressed || KEYEQ(press.key, tapping_key.event.key)) {
+            continue;
+        }
+
+        bool     key_released = false;
+        uint16_t key_end      = now;
+        for (uint8_t j = (i + 1) % WAITING_BUFFER_SIZE; j != waiting_buffer_head; j = (j + 1) % WAITING_BUFFER_SIZE) {
+            if (IS_EVENT(waiting_buffer[j].event) && KEYEQ(waiting_buffer[j].event.key, press.key) && !waiting_buffer[j].event.pressed) {
+                key_released = true;
+                key_end      = waiting_buffer[j].event.time;
+                break;
+            }
+        }
+
+        const uint16_t held     = TIMER_DIFF_16(key_end, press.time);
+        uint16_t       together = held;
+        if (released && TIMER_DIFF_16(released_at, press.time) < together) {
+            together = TIMER_DIFF_16(released_at, press.time);
+        }
+        const bool over = (uint32_t)together * 100 >= (uint32_t)overlap * held;
+
+        if (key_released || expired) {
+            hold = over;
+        } else if (!released || over) {
+            undecided = true;
+        }
+    }
+
+    if (!hold) {
+        if (!released || undecided) {
+            return false;
+        }
+        waiting_buffer_scan_tap();
+        if (tapping_key.tap.count > 0) {
+            ac_dprintf("Tapping: End. Rolling tap.\n");
+            return true;
+        }
+    }
+
+    ac_dprintf("Tapping: End. Rolling hold.\n");
+    process_record(&tapping_key);
+    tapping_key = (keyrecord_t){0};
+    debug_tapping_key();
+    return true;
+}
+
+/** \brief Carries on with an event once rolling hold decided the tapping key.
+ *
+ * A new event still goes behind the ones already waiting, only the oldest waiting one is processed straight away.
+ */
+static bool rolling_hold_resume(keyrecord_t *keyp) {
+    if (IS_EVENT(keyp->event) && keyp != &waiting_buffer[waiting_buffer_tail]) {
+        // enqueue
+        return false;
+    }
+    return process_tapping(keyp);
+}
+#    endif
+
 /** \brief Tapping key debug print
  *
  * FIXME: Needs docs
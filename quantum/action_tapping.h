@@ -32,7 +32,15 @@ along with this program.  If not, see <http://www.gnu.org/licenses/>.
 #    define TAPPING_TOGGLE 5
 #endif
 
-#define WAITING_BUFFER_SIZE 8
+/* percentage of the time another key is held spent together with a rolling hold key which makes it a hold */
+#ifndef ROLLING_HOLD_OVERLAP
+#    define ROLLING_HOLD_OVERLAP 60
+#endif
+
+/* how many key events may wait for a tap-or-hold decision */
+#ifndef WAITING_BUFFER_SIZE
+#    define WAITING_BUFFER_SIZE 8
+#endif
 
 #ifndef NO_ACTION_TAPPING
 uint16_t get_record_keycode(keyrecord_t *record, bool update_layer_cache);
@@ -45,6 +53,8 @@ uint16_t get_quick_tap_term(uint16_t keycode, keyrecord_t *record);
 bool     get_permissive_hold(uint16_t keycode, keyrecord_t *record);
 bool     get_retro_tapping(uint16_t keycode, keyrecord_t *record);
 bool     get_hold_on_other_key_press(uint16_t keycode, keyrecord_t *record);
+bool     get_rolling_hold(uint16_t keycode, keyrecord_t *record);
+uint8_t  get_rolling_hold_overlap(uint16_t keycode, keyrecord_t *record);
 
 #ifdef DYNAMIC_TAPPING_TERM_ENABLE
 extern uint16_t g_tapping_term;
@@ -63,3 +73,9 @@ extern uint16_t g_tapping_term;
 #else
 #    define GET_QUICK_TAP_TERM(keycode, record) (QUICK_TAP_TERM)
 #endif
+
+#ifdef ROLLING_HOLD_OVERLAP_PER_KEY
+#    define GET_ROLLING_HOLD_OVERLAP(keycode, record) get_rolling_hold_overlap(keycode, record)
+#else
+#    define GET_ROLLING_HOLD_OVERLAP(keycode, record) (ROLLING_HOLD_OVERLAP)
+#endif
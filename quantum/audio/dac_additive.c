@@ -0,0 +1,275 @@
+/* Copyright 2016-2019 Jack Humbert
+ * Copyright 2020 JohSchneider
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "dac_additive.h"
+#include "util.h"
+
+/*
+  Synthesis core of the dac_additive driver: every active tone advances its own fixed-point phase
+  accumulator through the same wavetable, the resulting samples are summed up and scaled by the number of active tones.
+
+  it is also possible to have a custom sample-LUT by implementing/overriding 'dac_value_generate'
+*/
+
+#if !defined(AUDIO_DAC_SAMPLE_WAVEFORM_SINE) && !defined(AUDIO_DAC_SAMPLE_WAVEFORM_TRIANGLE) && !defined(AUDIO_DAC_SAMPLE_WAVEFORM_SQUARE) && !defined(AUDIO_DAC_SAMPLE_WAVEFORM_TRAPEZOID)
+#    define AUDIO_DAC_SAMPLE_WAVEFORM_SINE
+#endif
+
+#ifdef AUDIO_DAC_SAMPLE_WAVEFORM_SINE
+/* one full sine wave over [0,2*pi], but shifted up one amplitude and left pi/4; for the samples to start at 0
+ */
+static const uint16_t dac_buffer_sine[AUDIO_DAC_BUFFER_SIZE] = {
+    // 256 values, max 4095
+    0x0,   0x1,   0x2,   0x6,   0xa,   0xf,   0x16,  0x1e,  0x27,  0x32,  0x3d,  0x4a,  0x58,  0x67,  0x78,  0x89,  0x9c,  0xb0,  0xc5,  0xdb,  0xf2,  0x10a, 0x123, 0x13e, 0x159, 0x175, 0x193, 0x1b1, 0x1d1, 0x1f1, 0x212, 0x235, 0x258, 0x27c, 0x2a0, 0x2c6, 0x2ed, 0x314, 0x33c, 0x365, 0x38e, 0x3b8, 0x3e3, 0x40e, 0x43a, 0x467, 0x494, 0x4c2, 0x4f0, 0x51f, 0x54e, 0x57d, 0x5ad, 0x5dd, 0x60e, 0x63f, 0x670, 0x6a1, 0x6d3, 0x705, 0x737, 0x769, 0x79b, 0x7cd, 0x800, 0x832, 0x864, 0x896, 0x8c8, 0x8fa, 0x92c, 0x95e, 0x98f, 0x9c0, 0x9f1, 0xa22, 0xa52, 0xa82, 0xab1, 0xae0, 0xb0f, 0xb3d, 0xb6b, 0xb98, 0xbc5, 0xbf1, 0xc1c, 0xc47, 0xc71, 0xc9a, 0xcc3, 0xceb, 0xd12, 0xd39, 0xd5f, 0xd83, 0xda7, 0xdca, 0xded, 0xe0e, 0xe2e, 0xe4e, 0xe6c, 0xe8a, 0xea6, 0xec1, 0xedc, 0xef5, 0xf0d, 0xf24, 0xf3a, 0xf4f, 0xf63, 0xf76, 0xf87, 0xf98, 0xfa7, 0xfb5, 0xfc2, 0xfcd, 0xfd8, 0xfe1, 0xfe9, 0xff0, 0xff5, 0xff9, 0xffd, 0xffe,
+    0xfff, 0xffe, 0xffd, 0xff9, 0xff5, 0xff0, 0xfe9, 0xfe1, 0xfd8, 0xfcd, 0xfc2, 0xfb5, 0xfa7, 0xf98, 0xf87, 0xf76, 0xf63, 0xf4f, 0xf3a, 0xf24, 0xf0d, 0xef5, 0xedc, 0xec1, 0xea6, 0xe8a, 0xe6c, 0xe4e, 0xe2e, 0xe0e, 0xded, 0xdca, 0xda7, 0xd83, 0xd5f, 0xd39, 0xd12, 0xceb, 0xcc3, 0xc9a, 0xc71, 0xc47, 0xc1c, 0xbf1, 0xbc5, 0xb98, 0xb6b, 0xb3d, 0xb0f, 0xae0, 0xab1, 0xa82, 0xa52, 0xa22, 0x9f1, 0x9c0, 0x98f, 0x95e, 0x92c, 0x8fa, 0x8c8, 0x896, 0x864, 0x832, 0x800, 0x7cd, 0x79b, 0x769, 0x737, 0x705, 0x6d3, 0x6a1, 0x670, 0x63f, 0x60e, 0x5dd, 0x5ad, 0x57d, 0x54e, 0x51f, 0x4f0, 0x4c2, 0x494, 0x467, 0x43a, 0x40e, 0x3e3, 0x3b8, 0x38e, 0x365, 0x33c, 0x314, 0x2ed, 0x2c6, 0x2a0, 0x27c, 0x258, 0x235, 0x212, 0x1f1, 0x1d1, 0x1b1, 0x193, 0x175, 0x159, 0x13e, 0x123, 0x10a, 0xf2,  0xdb,  0xc5,  0xb0,  0x9c,  0x89,  0x78,  0x67,  0x58,  0x4a,  0x3d,  0x32,  0x27,  0x1e,  0x16,  0xf,   0xa,   0x6,   0x2,   0x1};
+#endif // AUDIO_DAC_SAMPLE_WAVEFORM_SINE
+#ifdef AUDIO_DAC_SAMPLE_WAVEFORM_TRIANGLE
+static const uint16_t dac_buffer_triangle[AUDIO_DAC_BUFFER_SIZE] = {
+    // 256 values, max 4095
+    0x0,   0x20,  0x40,  0x60,  0x80,  0xa0,  0xc0,  0xe0,  0x100, 0x120, 0x140, 0x160, 0x180, 0x1a0, 0x1c0, 0x1e0, 0x200, 0x220, 0x240, 0x260, 0x280, 0x2a0, 0x2c0, 0x2e0, 0x300, 0x320, 0x340, 0x360, 0x380, 0x3a0, 0x3c0, 0x3e0, 0x400, 0x420, 0x440, 0x460, 0x480, 0x4a0, 0x4c0, 0x4e0, 0x500, 0x520, 0x540, 0x560, 0x580, 0x5a0, 0x5c0, 0x5e0, 0x600, 0x620, 0x640, 0x660, 0x680, 0x6a0, 0x6c0, 0x6e0, 0x700, 0x720, 0x740, 0x760, 0x780, 0x7a0, 0x7c0, 0x7e0, 0x800, 0x81f, 0x83f, 0x85f, 0x87f, 0x89f, 0x8bf, 0x8df, 0x8ff, 0x91f, 0x93f, 0x95f, 0x97f, 0x99f, 0x9bf, 0x9df, 0x9ff, 0xa1f, 0xa3f, 0xa5f, 0xa7f, 0xa9f, 0xabf, 0xadf, 0xaff, 0xb1f, 0xb3f, 0xb5f, 0xb7f, 0xb9f, 0xbbf, 0xbdf, 0xbff, 0xc1f, 0xc3f, 0xc5f, 0xc7f, 0xc9f, 0xcbf, 0xcdf, 0xcff, 0xd1f, 0xd3f, 0xd5f, 0xd7f, 0xd9f, 0xdbf, 0xddf, 0xdff, 0xe1f, 0xe3f, 0xe5f, 0xe7f, 0xe9f, 0xebf, 0xedf, 0xeff, 0xf1f, 0xf3f, 0xf5f, 0xf7f, 0xf9f, 0xfbf, 0xfdf,
+    0xfff, 0xfdf, 0xfbf, 0xf9f, 0xf7f, 0xf5f, 0xf3f, 0xf1f, 0xeff, 0xedf, 0xebf, 0xe9f, 0xe7f, 0xe5f, 0xe3f, 0xe1f, 0xdff, 0xddf, 0xdbf, 0xd9f, 0xd7f, 0xd5f, 0xd3f, 0xd1f, 0xcff, 0xcdf, 0xcbf, 0xc9f, 0xc7f, 0xc5f, 0xc3f, 0xc1f, 0xbff, 0xbdf, 0xbbf, 0xb9f, 0xb7f, 0xb5f, 0xb3f, 0xb1f, 0xaff, 0xadf, 0xabf, 0xa9f, 0xa7f, 0xa5f, 0xa3f, 0xa1f, 0x9ff, 0x9df, 0x9bf, 0x99f, 0x97f, 0x95f, 0x93f, 0x91f, 0x8ff, 0x8df, 0x8bf, 0x89f, 0x87f, 0x85f, 0x83f, 0x81f, 0x800, 0x7e0, 0x7c0, 0x7a0, 0x780, 0x760, 0x740, 0x720, 0x700, 0x6e0, 0x6c0, 0x6a0, 0x680, 0x660, 0x640, 0x620, 0x600, 0x5e0, 0x5c0, 0x5a0, 0x580, 0x560, 0x540, 0x520, 0x500, 0x4e0, 0x4c0, 0x4a0, 0x480, 0x460, 0x440, 0x420, 0x400, 0x3e0, 0x3c0, 0x3a0, 0x380, 0x360, 0x340, 0x320, 0x300, 0x2e0, 0x2c0, 0x2a0, 0x280, 0x260, 0x240, 0x220, 0x200, 0x1e0, 0x1c0, 0x1a0, 0x180, 0x160, 0x140, 0x120, 0x100, 0xe0,  0xc0,  0xa0,  0x80,  0x60,  0x40,  0x20};
+#endif // AUDIO_DAC_SAMPLE_WAVEFORM_TRIANGLE
+#ifdef AUDIO_DAC_SAMPLE_WAVEFORM_SQUARE
+static const uint16_t dac_buffer_square[AUDIO_DAC_BUFFER_SIZE] = {
+    [0 ... AUDIO_DAC_BUFFER_SIZE / 2 - 1]                     = AUDIO_DAC_OFF_VALUE,  // first and
+    [AUDIO_DAC_BUFFER_SIZE / 2 ... AUDIO_DAC_BUFFER_SIZE - 1] = AUDIO_DAC_SAMPLE_MAX, // second half
+};
+#endif // AUDIO_DAC_SAMPLE_WAVEFORM_SQUARE
+/*
+// four steps: 0, 1/3, 2/3 and 1
+static const uint16_t dac_buffer_staircase[AUDIO_DAC_BUFFER_SIZE] = {
+    [0 ... AUDIO_DAC_BUFFER_SIZE/3 -1 ]                               = 0,
+    [AUDIO_DAC_BUFFER_SIZE / 4 ... AUDIO_DAC_BUFFER_SIZE / 2 -1 ]     = AUDIO_DAC_SAMPLE_MAX / 3,
+    [AUDIO_DAC_BUFFER_SIZE / 2 ... 3 * AUDIO_DAC_BUFFER_SIZE / 4 -1 ] = 2 * AUDIO_DAC_SAMPLE_MAX / 3,
+    [3 * AUDIO_DAC_BUFFER_SIZE / 4 ... AUDIO_DAC_BUFFER_SIZE -1 ]     = AUDIO_DAC_SAMPLE_MAX,
+}
+*/
+#ifdef AUDIO_DAC_SAMPLE_WAVEFORM_TRAPEZOID
+static const uint16_t dac_buffer_trapezoid[AUDIO_DAC_BUFFER_SIZE] = {0x0,   0x1f,  0x7f,  0xdf,  0x13f, 0x19f, 0x1ff, 0x25f, 0x2bf, 0x31f, 0x37f, 0x3df, 0x43f, 0x49f, 0x4ff, 0x55f, 0x5bf, 0x61f, 0x67f, 0x6df, 0x73f, 0x79f, 0x7ff, 0x85f, 0x8bf, 0x91f, 0x97f, 0x9df, 0xa3f, 0xa9f, 0xaff, 0xb5f, 0xbbf, 0xc1f, 0xc7f, 0xcdf, 0xd3f, 0xd9f, 0xdff, 0xe5f, 0xebf, 0xf1f, 0xf7f, 0xfdf, 0xfff, 0xfff, 0xfff, 0xfff, 0xfff, 0xfff, 0xfff, 0xfff, 0xfff, 0xfff, 0xfff, 0xfff, 0xfff, 0xfff, 0xfff, 0xfff, 0xfff, 0xfff, 0xfff, 0xfff, 0xfff, 0xfff, 0xfff, 0xfff, 0xfff, 0xfff, 0xfff, 0xfff, 0xfff, 0xfff, 0xfff, 0xfff, 0xfff, 0xfff, 0xfff, 0xfff, 0xfff, 0xfff, 0xfff, 0xfff, 0xfff, 0xfff, 0xfff, 0xfff, 0xfff, 0xfff, 0xfff, 0xfff, 0xfff, 0xfff, 0xfff, 0xfff, 0xfff, 0xfff, 0xfff, 0xfff, 0xfff, 0xfff, 0xfff, 0xfff, 0xfff, 0xfff, 0xfff, 0xfff, 0xfff, 0xfff, 0xfff, 0xfff, 0xfff, 0xfff, 0xfff, 0xfff, 0xfff, 0xfff, 0xfff, 0xfff, 0xfff, 0xfff, 0xfff, 0xfff, 0xfff, 0xfff, 0xfff, 0xfff,
+                                                                        0xfff, 0xfdf, 0xf7f, 0xf1f, 0xebf, 0xe5f, 0xdff, 0xd9f, 0xd3f, 0xcdf, 0xc7f, 0xc1f, 0xbbf, 0xb5f, 0xaff, 0xa9f, 0xa3f, 0x9df, 0x97f, 0x91f, 0x8bf, 0x85f, 0x7ff, 0x79f, 0x73f, 0x6df, 0x67f, 0x61f, 0x5bf, 0x55f, 0x4ff, 0x49f, 0x43f, 0x3df, 0x37f, 0x31f, 0x2bf, 0x25f, 0x1ff, 0x19f, 0x13f, 0xdf,  0x7f,  0x1f,  0x0,   0x0,   0x0,   0x0,   0x0,   0x0,   0x0,   0x0,   0x0,   0x0,   0x0,   0x0,   0x0,   0x0,   0x0,   0x0,   0x0,   0x0,   0x0,   0x0,   0x0,   0x0,   0x0,   0x0,   0x0,   0x0,   0x0,   0x0,   0x0,   0x0,   0x0,   0x0,   0x0,   0x0,   0x0,   0x0,   0x0,   0x0,   0x0,   0x0,   0x0,   0x0,   0x0,   0x0,   0x0,   0x0,   0x0,   0x0,   0x0,   0x0,   0x0,   0x0,   0x0,   0x0,   0x0,   0x0,   0x0,   0x0,   0x0,   0x0,   0x0,   0x0,   0x0,   0x0,   0x0,   0x0,   0x0,   0x0,   0x0,   0x0,   0x0,   0x0,   0x0,   0x0,   0x0,   0x0,   0x0,   0x0,   0x0,   0x0,   0x0,   0x0,   0x0,   0x0};
+#endif // AUDIO_DAC_SAMPLE_WAVEFORM_TRAPEZOID
+
+#if defined(AUDIO_DAC_SAMPLE_WAVEFORM_SINE)
+#    define dac_wavetable dac_buffer_sine
+#elif defined(AUDIO_DAC_SAMPLE_WAVEFORM_TRIANGLE)
+#    define dac_wavetable dac_buffer_triangle
+#elif defined(AUDIO_DAC_SAMPLE_WAVEFORM_TRAPEZOID)
+#    define dac_wavetable dac_buffer_trapezoid
+#elif defined(AUDIO_DAC_SAMPLE_WAVEFORM_SQUARE)
+#    define dac_wavetable dac_buffer_square
+#endif
+
+/* The phase of each tone is a 32bit fraction of one full wave; the top 8 bits index the 256 entry wavetable, so the
+ * accumulator wraps around at the end of the table on its own.
+ */
+_Static_assert(AUDIO_DAC_BUFFER_SIZE == 256, "dac_additive wavetables need to have 256 entries");
+#define DAC_PHASE_TO_INDEX(phase) ((phase) >> 24)
+
+/* keep track of the phase, and how far it advances per sample, for each frequency */
+static uint32_t dac_phase[AUDIO_MAX_SIMULTANEOUS_TONES]     = {0};
+static uint32_t dac_increment[AUDIO_MAX_SIMULTANEOUS_TONES] = {0};
+
+static uint8_t active_tones_snapshot_length = 0;
+/* 65536 / active_tones_snapshot_length, so the mix can be scaled with a multiplication instead of a division per sample */
+static uint32_t active_tones_snapshot_gain = 0;
+
+typedef enum {
+    OUTPUT_SHOULD_START,
+    OUTPUT_RUN_NORMALLY,
+    // path 1: wait for zero, then change/update active tones
+    OUTPUT_TONES_CHANGED,
+    OUTPUT_REACHED_ZERO_BEFORE_TONE_CHANGE,
+    // path 2: hardware should stop, wait for zero then turn output off = stop the timer
+    OUTPUT_SHOULD_STOP,
+    OUTPUT_REACHED_ZERO_BEFORE_OFF,
+    OUTPUT_OFF,
+    OUTPUT_OFF_1,
+    OUTPUT_OFF_2, // trailing off: giving the DAC two more conversion cycles until the AUDIO_DAC_OFF_VALUE reaches the output, then turn the timer off, which leaves the output at that level
+    number_of_output_states
+} output_states_t;
+static output_states_t state = OUTPUT_OFF_2;
+
+/**
+ * Takes a new snapshot of the active tones, converting their frequencies to phase increments once instead of on every
+ * sample.
+ */
+static void dac_update_tones(void) {
+    uint8_t active_tones         = MIN(AUDIO_MAX_SIMULTANEOUS_TONES, audio_get_number_of_active_tones());
+    active_tones_snapshot_length = 0;
+    for (uint8_t i = 0; i < active_tones; i++) {
+        float freq = audio_get_processed_frequency(i);
+        if (freq > 0 && freq < AUDIO_DAC_OUTPUT_RATE) { // disregard 'rest' notes, with valid frequency 0.0f; which would only lower the resulting waveform volume during the additive synthesis step
+            dac_increment[active_tones_snapshot_length++] = (uint32_t)(freq * (4294967296.0f / AUDIO_DAC_OUTPUT_RATE));
+        }
+    }
+    active_tones_snapshot_gain = active_tones_snapshot_length ? 65536U / active_tones_snapshot_length : 0;
+}
+
+void dac_additive_fill(uint16_t *samples, size_t count) {
+    // DAC is running/asking for values but snapshot length is zero -> must be playing a pause
+    if (0 == active_tones_snapshot_length) {
+        for (size_t s = 0; s < count; s++) {
+            samples[s] = AUDIO_DAC_OFF_VALUE;
+        }
+        return;
+    }
+
+#if AUDIO_MAX_SIMULTANEOUS_TONES * AUDIO_DAC_SAMPLE_MAX > UINT16_MAX
+    /* the sum of all tones could overflow the 16bit samples, so mix each sample in 32bit instead
+     */
+    for (size_t s = 0; s < count; s++) {
+        uint32_t sum = 0;
+        for (uint8_t i = 0; i < active_tones_snapshot_length; i++) {
+            dac_phase[i] += dac_increment[i];
+            sum += dac_wavetable[DAC_PHASE_TO_INDEX(dac_phase[i])];
+        }
+        samples[s] = (sum * active_tones_snapshot_gain) >> 16;
+    }
+#else
+    /* one pass over the buffer per tone, so that its phase stays in a register; the sum of all tones still fits into
+     * the 16bit samples, and is scaled down in a final pass
+     */
+    uint32_t phase     = dac_phase[0];
+    uint32_t increment = dac_increment[0];
+    for (size_t s = 0; s < count; s++) {
+        phase += increment;
+        samples[s] = dac_wavetable[DAC_PHASE_TO_INDEX(phase)];
+    }
+    dac_phase[0] = phase;
+
+    for (uint8_t i = 1; i < active_tones_snapshot_length; i++) {
+        phase     = dac_phase[i];
+        increment = dac_increment[i];
+        for (size_t s = 0; s < count; s++) {
+            phase += increment;
+            samples[s] += dac_wavetable[DAC_PHASE_TO_INDEX(phase)];
+        }
+        dac_phase[i] = phase;
+    }
+
+    if (active_tones_snapshot_length > 1) {
+        for (size_t s = 0; s < count; s++) {
+            samples[s] = (samples[s] * active_tones_snapshot_gain) >> 16;
+        }
+    }
+#endif
+}
+
+static uint16_t dac_value_generate_default(void) {
+    uint16_t value;
+    dac_additive_fill(&value, 1);
+    return value;
+}
+
+/**
+ * Generation of the waveform being passed to the callback. Declared weak so users
+ * can override it with their own wave-forms/noises.
+ *
+ * Unless overridden, whole buffers are rendered through dac_additive_fill instead.
+ */
+uint16_t dac_value_generate(void) __attribute__((weak, alias("dac_value_generate_default")));
+
+bool dac_additive_render(uint16_t *samples, size_t count) {
+    if ((OUTPUT_RUN_NORMALLY == state) && (dac_value_generate == dac_value_generate_default)) {
+        // nothing is waiting for a zero crossing, so there is no need to look at every single sample
+        dac_additive_fill(samples, count);
+    } else {
+        for (size_t s = 0; s < count; s++) {
+            if (OUTPUT_OFF <= state) {
+                samples[s] = AUDIO_DAC_OFF_VALUE;
+                continue;
+            } else {
+                samples[s] = dac_value_generate();
+            }
+
+            /* zero crossing (or approach, whereas zero == DAC_OFF_VALUE, which can be configured to anything from 0 to DAC_SAMPLE_MAX)
+             * ============================*=*========================== AUDIO_DAC_SAMPLE_MAX
+             *                          *       *
+             *                        *           *
+             * ---------------------------------------------------------
+             *                     *                 *                  } AUDIO_DAC_SAMPLE_MAX/100
+             * --------------------------------------------------------- AUDIO_DAC_OFF_VALUE
+             *                  *                       *               } AUDIO_DAC_SAMPLE_MAX/100
+             * ---------------------------------------------------------
+             *               *
+             * *           *
+             *   *       *
+             * =====*=*================================================= 0x0
+             */
+            if (((samples[s] + (AUDIO_DAC_SAMPLE_MAX / 100)) > AUDIO_DAC_OFF_VALUE) && // value approaches from below
+                (samples[s] < (AUDIO_DAC_OFF_VALUE + (AUDIO_DAC_SAMPLE_MAX / 100)))    // or above
+            ) {
+                if ((OUTPUT_SHOULD_START == state) && (active_tones_snapshot_length > 0)) {
+                    state = OUTPUT_RUN_NORMALLY;
+                } else if (OUTPUT_TONES_CHANGED == state) {
+                    state = OUTPUT_REACHED_ZERO_BEFORE_TONE_CHANGE;
+                } else if (OUTPUT_SHOULD_STOP == state) {
+                    state = OUTPUT_REACHED_ZERO_BEFORE_OFF;
+                }
+            }
+
+            // still 'ramping up', reset the output to OFF_VALUE until the generated values reach that value, to do a smooth handover
+            if (OUTPUT_SHOULD_START == state) {
+                samples[s] = AUDIO_DAC_OFF_VALUE;
+            }
+
+            if ((OUTPUT_SHOULD_START == state) || (OUTPUT_REACHED_ZERO_BEFORE_OFF == state) || (OUTPUT_REACHED_ZERO_BEFORE_TONE_CHANGE == state)) {
+                // update the snapshot - once, and only on occasion that something changed;
+                // -> saves cpu cycles (?)
+                dac_update_tones();
+
+                if ((0 == active_tones_snapshot_length) && (OUTPUT_REACHED_ZERO_BEFORE_OFF == state)) {
+                    state = OUTPUT_OFF;
+                }
+                if (OUTPUT_REACHED_ZERO_BEFORE_TONE_CHANGE == state) {
+                    state = OUTPUT_RUN_NORMALLY;
+                }
+            }
+        }
+    }
+
+    // update audio internal state (note position, current_note, ...)
+    if (audio_update_state()) {
+        if (OUTPUT_SHOULD_STOP != state) {
+            state = OUTPUT_TONES_CHANGED;
+        }
+    }
+
+    if (OUTPUT_OFF <= state) {
+        // OUTPUT_OFF_2 = the DAC is pushing AUDIO_DAC_OFF_VALUE, and its trigger can be stopped
+        if (OUTPUT_OFF_2 == state) {
+            return true;
+        }
+        state++;
+    }
+
+    return false;
+}
+
+void dac_additive_start(void) {
+    for (uint8_t i = 0; i < AUDIO_MAX_SIMULTANEOUS_TONES; i++) {
+        dac_phase[i]     = 0;
+        dac_increment[i] = 0;
+    }
+    active_tones_snapshot_length = 0;
+    active_tones_snapshot_gain   = 0;
+    state                        = OUTPUT_SHOULD_START;
+}
+
+void dac_additive_stop(void) {
+    state = OUTPUT_SHOULD_STOP;
+}
@@ -0,0 +1,47 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include "audio.h"
+
+/*
+  Hardware agnostic part of the dac_additive audio driver: wavetables, the fixed-point synthesis core and the output state
+  machine. The platform driver only has to feed the rendered samples to its DAC, which allows the same code to run on the
+  host for rendering songs to memory.
+*/
+
+/**
+ * Rate at which rendered samples are played back.
+ *
+ * The GPT timer runs with 3*AUDIO_DAC_SAMPLE_RATE, and the DAC is triggered on every other timer update, so the DAC
+ * outputs 3/2*AUDIO_DAC_SAMPLE_RATE samples per second (as measured with an oscilloscope).
+ */
+#define AUDIO_DAC_OUTPUT_RATE (AUDIO_DAC_SAMPLE_RATE * 3 / 2)
+
+/**
+ * Resets the synthesizer phases and (re)starts the output, which fades in on the next zero crossing.
+ */
+void dac_additive_start(void);
+
+/**
+ * Requests the output to stop on the next zero crossing.
+ */
+void dac_additive_stop(void);
+
+/**
+ * Renders the next `count` samples into `samples` and updates the audio state (note positions, ...) once.
+ *
+ * Platform drivers call this from their DAC callback, once per half-buffer.
+ *
+ * @return true once the output has settled at AUDIO_DAC_OFF_VALUE and the DAC trigger can be stopped
+ */
+bool dac_additive_render(uint16_t *samples, size_t count);
+
+/**
+ * Fills `samples` from the wavetable, mixing all currently active tones.
+ */
+void dac_additive_fill(uint16_t *samples, size_t count);
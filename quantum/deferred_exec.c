@@ -9,34 +9,104 @@
 #    define MAX_DEFERRED_EXECUTORS 8
 #endif
 
+#if MAX_DEFERRED_EXECUTORS > 255
+#    error "MAX_DEFERRED_EXECUTORS must be 255 or less"
+#endif
+
 //------------------------------------
 // Helpers
 //
+// Each table is kept as a binary heap ordered by trigger time, threaded through the table itself: `heap_entry` of the
+// n-th entry is the table index of the entry at position n of the heap, and `heap_index` is the reverse mapping. The
+// pending entries occupy the first `heap_size` positions, the free ones the rest.
+//
 
-static deferred_token current_token = 0;
+static deferred_executor_t *executing_entry = NULL;
 
-static inline bool token_can_be_used(deferred_executor_t *table, size_t table_count, deferred_token token) {
-    if (token == INVALID_DEFERRED_TOKEN) {
-        return false;
-    }
-    for (int i = 0; i < table_count; ++i) {
-        if (table[i].token == token) {
-            return false;
+static inline bool table_is_valid(deferred_executor_t *table, size_t table_count) {
+    return table && table_count > 0 && table_count <= UINT8_MAX;
+}
+
+static inline deferred_executor_t *heap_at(deferred_executor_t *table, uint8_t index) {
+    return &table[table[index].heap_entry];
+}
+
+static inline bool triggers_before(const deferred_executor_t *a, const deferred_executor_t *b) {
+    return ((int32_t)TIMER_DIFF_32(a->trigger_time, b->trigger_time)) < 0;
+}
+
+static void heap_swap(deferred_executor_t *table, uint8_t a, uint8_t b) {
+    uint8_t entry_a = table[a].heap_entry;
+    uint8_t entry_b = table[b].heap_entry;
+
+    table[a].heap_entry       = entry_b;
+    table[b].heap_entry       = entry_a;
+    table[entry_a].heap_index = b;
+    table[entry_b].heap_index = a;
+}
+
+static void heap_sift_up(deferred_executor_t *table, uint8_t index) {
+    while (index > 0) {
+        uint8_t parent = (index - 1) / 2;
+        if (!triggers_before(heap_at(table, index), heap_at(table, parent))) {
+            break;
         }
+        heap_swap(table, index, parent);
+        index = parent;
     }
-    return true;
 }
 
-static inline deferred_token allocate_token(deferred_executor_t *table, size_t table_count) {
-    deferred_token first = ++current_token;
-    while (!token_can_be_used(table, table_count, current_token)) {
-        ++current_token;
-        if (current_token == first) {
-            // If we've looped back around to the first, everything is already allocated (yikes!). Need to exit with a failure.
-            return INVALID_DEFERRED_TOKEN;
+static void heap_sift_down(deferred_executor_t *table, uint8_t index) {
+    uint8_t size = table[0].heap_size;
+    while (true) {
+        uint16_t child = 2 * index + 1;
+        if (child >= size) {
+            break;
+        }
+        if (child + 1 < size && triggers_before(heap_at(table, child + 1), heap_at(table, child))) {
+            ++child;
         }
+        if (!triggers_before(heap_at(table, child), heap_at(table, index))) {
+            break;
+        }
+        heap_swap(table, index, child);
+        index = child;
+    }
+}
+
+static void heap_update(deferred_executor_t *table, uint8_t index) {
+    if (index > 0 && triggers_before(heap_at(table, index), heap_at(table, (index - 1) / 2))) {
+        heap_sift_up(table, index);
+    } else {
+        heap_sift_down(table, index);
+    }
+}
+
+static void heap_remove(deferred_executor_t *table, uint8_t index) {
+    deferred_executor_t *entry = heap_at(table, index);
+    entry->trigger_time        = 0;
+    entry->callback            = NULL;
+    entry->cb_arg              = NULL;
+
+    // Move the last pending entry into the hole, the removed one ends up first in line for reuse
+    uint8_t last = --table[0].heap_size;
+    if (index != last) {
+        heap_swap(table, index, last);
+        heap_update(table, index);
     }
-    return current_token;
+}
+
+static inline deferred_executor_t *find_entry(deferred_executor_t *table, size_t table_count, deferred_token token) {
+    if (token == INVALID_DEFERRED_TOKEN) {
+        return NULL;
+    }
+
+    // Tokens map straight back onto their table entry, which keeps the last token handed out even once it's free
+    deferred_executor_t *entry = &table[(token - 1) % table_count];
+    if (entry->token != token || entry->heap_index >= table[0].heap_size) {
+        return NULL;
+    }
+    return entry;
 }
 
 //------------------------------------
@@ -45,112 +115,126 @@ static inline deferred_token allocate_token(deferred_executor_t *table, size_t t
 
 deferred_token defer_exec_advanced(deferred_executor_t *table, size_t table_count, uint32_t delay_ms, deferred_exec_callback callback, void *cb_arg) {
     // Ignore queueing if the table isn't valid, it's a zero-time delay, or the token is not valid
-    if (!table || table_count == 0 || delay_ms == 0 || !callback) {
+    if (!table_is_valid(table, table_count) || delay_ms == 0 || !callback) {
         return INVALID_DEFERRED_TOKEN;
     }
 
-    // Find an unused slot and claim it
-    for (int i = 0; i < table_count; ++i) {
-        deferred_executor_t *entry = &table[i];
-        if (entry->token == INVALID_DEFERRED_TOKEN) {
-            // Work out the new token value, dropping out if none were available
-            deferred_token token = allocate_token(table, table_count);
-            if (token == INVALID_DEFERRED_TOKEN) {
-                return false;
-            }
+    // None available
+    uint8_t size = table[0].heap_size;
+    if (size == table_count) {
+        return INVALID_DEFERRED_TOKEN;
+    }
 
-            // Set up the executor table entry
-            entry->token        = current_token;
-            entry->trigger_time = timer_read32() + delay_ms;
-            entry->callback     = callback;
-            entry->cb_arg       = cb_arg;
-            return current_token;
+    // Tables start out zeroed, so lay the heap out afresh whenever it's empty
+    if (size == 0) {
+        for (uint8_t i = 0; i < table_count; ++i) {
+            table[i].heap_index = i;
+            table[i].heap_entry = i;
         }
     }
 
-    // None available
-    return INVALID_DEFERRED_TOKEN;
+    // Claim the first free entry. Its tokens step through the values mapping back onto it, so that a token isn't
+    // handed out again straight after being cancelled.
+    deferred_executor_t *entry = heap_at(table, size);
+    uint8_t              index = table[size].heap_entry;
+    uint16_t             token = entry->token == INVALID_DEFERRED_TOKEN ? index + 1 : entry->token + table_count;
+    if (token > UINT8_MAX) {
+        token = index + 1;
+    }
+
+    // Set up the executor table entry
+    entry->token        = token;
+    entry->trigger_time = timer_read32() + delay_ms;
+    entry->callback     = callback;
+    entry->cb_arg       = cb_arg;
+    table[0].heap_size  = size + 1;
+    heap_sift_up(table, size);
+    return token;
 }
 
 bool extend_deferred_exec_advanced(deferred_executor_t *table, size_t table_count, deferred_token token, uint32_t delay_ms) {
     // Ignore queueing if the table isn't valid, it's a zero-time delay, or the token is not valid
-    if (!table || table_count == 0 || delay_ms == 0 || token == INVALID_DEFERRED_TOKEN) {
+    if (!table_is_valid(table, table_count) || delay_ms == 0) {
         return false;
     }
 
     // Find the entry corresponding to the token
-    for (int i = 0; i < table_count; ++i) {
-        deferred_executor_t *entry = &table[i];
-        if (entry->token == token) {
-            // Found it, extend the delay
-            entry->trigger_time = timer_read32() + delay_ms;
-            return true;
-        }
+    deferred_executor_t *entry = find_entry(table, table_count, token);
+    if (!entry) {
+        return false;
     }
 
-    // Not found
-    return false;
+    // Found it, extend the delay
+    entry->trigger_time = timer_read32() + delay_ms;
+    heap_update(table, entry->heap_index);
+    return true;
 }
 
 bool cancel_deferred_exec_advanced(deferred_executor_t *table, size_t table_count, deferred_token token) {
     // Ignore request if the table/token are not valid
-    if (!table || table_count == 0 || token == INVALID_DEFERRED_TOKEN) {
+    if (!table_is_valid(table, table_count)) {
         return false;
     }
 
     // Find the entry corresponding to the token
-    for (int i = 0; i < table_count; ++i) {
-        deferred_executor_t *entry = &table[i];
-        if (entry->token == token) {
-            // Found it, cancel and clear the table entry
-            entry->token        = INVALID_DEFERRED_TOKEN;
-            entry->trigger_time = 0;
-            entry->callback     = NULL;
-            entry->cb_arg       = NULL;
-            return true;
-        }
+    deferred_executor_t *entry = find_entry(table, table_count, token);
+    if (!entry) {
+        return false;
     }
 
-    // Not found
-    return false;
+    // Found it, cancel and clear the table entry
+    if (entry == executing_entry) {
+        executing_entry = NULL;
+    }
+    heap_remove(table, entry->heap_index);
+    return true;
+}
+
+bool deferred_exec_advanced_next_deadline(deferred_executor_t *table, size_t table_count, uint32_t *trigger_time) {
+    if (!table_is_valid(table, table_count) || table[0].heap_size == 0) {
+        return false;
+    }
+
+    *trigger_time = heap_at(table, 0)->trigger_time;
+    return true;
 }
 
 void deferred_exec_advanced_task(deferred_executor_t *table, size_t table_count, uint32_t *last_execution_time) {
     uint32_t now = timer_read32();
 
     // Throttle only once per millisecond
-    if (((int32_t)TIMER_DIFF_32(now, (*last_execution_time))) > 0) {
+    if (table_is_valid(table, table_count) && ((int32_t)TIMER_DIFF_32(now, (*last_execution_time))) > 0) {
         *last_execution_time = now;
 
-        // Run through each of the executors
-        for (int i = 0; i < table_count; ++i) {
-            deferred_executor_t *entry      = &table[i];
-            deferred_token       curr_token = entry->token;
-
-            // Check if we're supposed to execute this entry
-            if (curr_token != INVALID_DEFERRED_TOKEN && ((int32_t)TIMER_DIFF_32(entry->trigger_time, now)) <= 0) {
-                // Invoke the callback and work work out if we should be requeued
-                uint32_t delay_ms = entry->callback(entry->trigger_time, entry->cb_arg);
-
-                // If the token has changed, then the callback has canceled and re-queued. Skip further processing.
-                if (entry->token != curr_token) {
-                    continue;
-                }
-
-                // Update the trigger time if we have to repeat, otherwise clear it out
-                if (delay_ms > 0) {
-                    // Intentionally add just the delay to the existing trigger time -- this ensures the next
-                    // invocation is with respect to the previous trigger, rather than when it got to execution. Under
-                    // normal circumstances this won't cause issue, but if another executor is invoked that takes a
-                    // considerable length of time, then this ensures best-effort timing between invocations.
-                    entry->trigger_time += delay_ms;
-                } else {
-                    // If it was zero, then the callback is cancelling repeated execution. Free up the slot.
-                    entry->token        = INVALID_DEFERRED_TOKEN;
-                    entry->trigger_time = 0;
-                    entry->callback     = NULL;
-                    entry->cb_arg       = NULL;
-                }
+        // Run through the executors which are due, earliest first. Callbacks running behind are requeued with a trigger
+        // time which may still have passed, so stop after as many invocations as there were pending executors.
+        for (uint8_t remaining = table[0].heap_size; remaining > 0 && table[0].heap_size > 0; --remaining) {
+            deferred_executor_t *entry = heap_at(table, 0);
+            if (((int32_t)TIMER_DIFF_32(entry->trigger_time, now)) > 0) {
+                break;
+            }
+
+            // Invoke the callback and work work out if we should be requeued
+            executing_entry   = entry;
+            uint32_t delay_ms = entry->callback(entry->trigger_time, entry->cb_arg);
+
+            // If the callback has canceled (and maybe re-queued) its executor, skip further processing.
+            if (executing_entry != entry) {
+                continue;
+            }
+            executing_entry = NULL;
+
+            // Update the trigger time if we have to repeat, otherwise clear it out
+            if (delay_ms > 0) {
+                // Intentionally add just the delay to the existing trigger time -- this ensures the next
+                // invocation is with respect to the previous trigger, rather than when it got to execution. Under
+                // normal circumstances this won't cause issue, but if another executor is invoked that takes a
+                // considerable length of time, then this ensures best-effort timing between invocations.
+                entry->trigger_time += delay_ms;
+                heap_update(table, entry->heap_index);
+            } else {
+                // If it was zero, then the callback is cancelling repeated execution. Free up the slot.
+                heap_remove(table, entry->heap_index);
             }
         }
     }
@@ -175,3 +259,6 @@ bool cancel_deferred_exec(deferred_token token) {
 void deferred_exec_task(void) {
     deferred_exec_advanced_task(basic_executors, MAX_DEFERRED_EXECUTORS, &last_deferred_exec_check);
 }
+bool deferred_exec_next_deadline(uint32_t *trigger_time) {
+    return deferred_exec_advanced_next_deadline(basic_executors, MAX_DEFERRED_EXECUTORS, trigger_time);
+}
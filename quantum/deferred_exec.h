@@ -65,6 +65,14 @@ bool cancel_deferred_exec(deferred_token token);
  */
 void deferred_exec_task(void);
 
+/**
+ * Retrieves when the next deferred execution is due, so the main loop can work out how long it may idle for.
+ *
+ * @param trigger_time[out] the time the next callback is due -- equivalent time-space as timer_read32()
+ * @return true if any deferred execution is pending, otherwise false
+ */
+bool deferred_exec_next_deadline(uint32_t *trigger_time);
+
 //------------------------------------
 // Advanced API: used when a custom-allocated table is used, primarily for core code.
 //------------------------------------
@@ -73,9 +81,13 @@ void deferred_exec_task(void);
  * @struct Structure for containing self-hosted deferred executor tables.
  * @brief Core-side code can use this to create their own tables without impacting on the use of users' ability to add deferred execution.
  *        Code outside deferred_exec.c should not worry about internals of this struct, and should just allocate the required number in an array.
+ *        Tables hold at most 255 entries, kept as a binary heap ordered by trigger time.
  */
 typedef struct deferred_executor_t {
     deferred_token         token;
+    uint8_t                heap_index; // position of this entry in the table's heap
+    uint8_t                heap_entry; // entry found at this position of the table's heap
+    uint8_t                heap_size;  // number of pending entries, kept in the first entry of the table only
     uint32_t               trigger_time;
     deferred_exec_callback callback;
     void *                 cb_arg;
@@ -110,6 +122,16 @@ bool extend_deferred_exec_advanced(deferred_executor_t *table, size_t table_coun
  */
 bool cancel_deferred_exec_advanced(deferred_executor_t *table, size_t table_count, deferred_token token);
 
+/**
+ * Retrieves when the next deferred execution in a custom table is due.
+ *
+ * @param table[in] the custom table used for storage
+ * @param table_count[in] the number of available items in the table
+ * @param trigger_time[out] the time the next callback is due -- equivalent time-space as timer_read32()
+ * @return true if any deferred execution is pending in the table, otherwise false
+ */
+bool deferred_exec_advanced_next_deadline(deferred_executor_t *table, size_t table_count, uint32_t *trigger_time);
+
 /**
  * Forward declaration for the main loop in order to execute any custom table deferred executors. Should not be invoked by keyboard/user code.
  * Needed for any custom-allocated deferred execution tables. Any core tasks should add appropriate invocation to quantum/main.c.
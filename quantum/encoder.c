@@ -25,6 +25,10 @@
 #    include "split_util.h"
 #endif
 
+#ifdef ENCODER_INTERRUPT_MODE
+#    include "atomic_util.h"
+#endif
+
 // for memcpy
 #include <string.h>
 
@@ -62,6 +66,12 @@ static int8_t encoder_LUT[] = {0, -1, 1, 0, 1, 0, 0, -1, -1, 0, 0, 1, 0, 1, -1,
 static uint8_t encoder_state[NUM_ENCODERS]  = {0};
 static int8_t  encoder_pulses[NUM_ENCODERS] = {0};
 
+#ifdef ENCODER_INTERRUPT_MODE
+// Pin history and undrained quarter-steps, written from the pin-change interrupt and drained by encoder_read()
+static volatile uint8_t encoder_isr_state[NUM_ENCODERS_MAX_PER_SIDE]  = {0};
+static volatile int8_t  encoder_isr_pulses[NUM_ENCODERS_MAX_PER_SIDE] = {0};
+#endif // ENCODER_INTERRUPT_MODE
+
 // encoder counts
 static uint8_t thisCount;
 #ifdef SPLIT_KEYBOARD
@@ -111,6 +121,44 @@ __attribute__((weak)) bool should_process_encoder(void) {
     return is_keyboard_master();
 }
 
+#ifdef ENCODER_INTERRUPT_MODE
+#    if defined(PROTOCOL_CHIBIOS)
+static void encoder_pal_callback(void *arg) {
+    encoder_isr((uint8_t)(uintptr_t)arg);
+}
+
+__attribute__((weak)) void encoder_interrupt_init(uint8_t index, pin_t pad_a, pin_t pad_b) {
+    palEnableLineEvent(pad_a, PAL_EVENT_MODE_BOTH_EDGES);
+    palSetLineCallback(pad_a, encoder_pal_callback, (void *)(uintptr_t)index);
+    palEnableLineEvent(pad_b, PAL_EVENT_MODE_BOTH_EDGES);
+    palSetLineCallback(pad_b, encoder_pal_callback, (void *)(uintptr_t)index);
+}
+#    else
+// Platforms without a generic pin-change API need the keyboard to enable the interrupts and call encoder_isr() itself
+__attribute__((weak)) void encoder_interrupt_init(uint8_t index, pin_t pad_a, pin_t pad_b) {}
+#    endif
+
+void encoder_isr(uint8_t index) {
+    if (index >= thisCount) {
+        return;
+    }
+    uint8_t new_status = (readPin(encoders_pad_a[index]) << 0) | (readPin(encoders_pad_b[index]) << 1);
+    uint8_t state      = encoder_isr_state[index];
+    if ((state & 0x3) == new_status) {
+        return;
+    }
+    state                    = (state << 2) | new_status;
+    encoder_isr_state[index] = state;
+
+    // Saturate rather than wrap if encoder_read() hasn't drained the counter in a long time
+    int8_t pulses = encoder_isr_pulses[index];
+    int8_t step   = encoder_LUT[state & 0xF];
+    if ((step > 0 && pulses < INT8_MAX) || (step < 0 && pulses > -INT8_MAX)) {
+        encoder_isr_pulses[index] = pulses + step;
+    }
+}
+#endif // ENCODER_INTERRUPT_MODE
+
 void encoder_init(void) {
 #ifdef SPLIT_KEYBOARD
     thisHand  = isLeftHand ? 0 : NUM_ENCODERS_LEFT;
@@ -129,6 +177,10 @@ void encoder_init(void) {
     memset(encoder_value, 0, sizeof(encoder_value));
     memset(encoder_state, 0, sizeof(encoder_state));
     memset(encoder_pulses, 0, sizeof(encoder_pulses));
+#    ifdef ENCODER_INTERRUPT_MODE
+    memset((void *)encoder_isr_state, 0, sizeof(encoder_isr_state));
+    memset((void *)encoder_isr_pulses, 0, sizeof(encoder_isr_pulses));
+#    endif
     static const pin_t encoders_pad_a_left[] = ENCODERS_PAD_A;
     static const pin_t encoders_pad_b_left[] = ENCODERS_PAD_B;
     for (uint8_t i = 0; i < thisCount; i++) {
@@ -169,6 +221,14 @@ void encoder_init(void) {
     for (uint8_t i = 0; i < thisCount; i++) {
         encoder_state[i] = (readPin(encoders_pad_a[i]) << 0) | (readPin(encoders_pad_b[i]) << 1);
     }
+
+#ifdef ENCODER_INTERRUPT_MODE
+    for (uint8_t i = 0; i < thisCount; i++) {
+        encoder_isr_state[i]  = encoder_state[i];
+        encoder_isr_pulses[i] = 0;
+        encoder_interrupt_init(i, encoders_pad_a[i], encoders_pad_b[i]);
+    }
+#endif // ENCODER_INTERRUPT_MODE
 }
 
 #ifdef ENCODER_MAP_ENABLE
@@ -186,7 +246,7 @@ static void encoder_exec_mapping(uint8_t index, bool clockwise) {
 }
 #endif // ENCODER_MAP_ENABLE
 
-static bool encoder_update(uint8_t index, uint8_t state) {
+static bool encoder_update(uint8_t index, int8_t step, uint8_t state) {
     bool    changed = false;
     uint8_t i       = index;
 
@@ -199,7 +259,7 @@ static bool encoder_update(uint8_t index, uint8_t state) {
 #ifdef SPLIT_KEYBOARD
     index += thisHand;
 #endif
-    encoder_pulses[i] += encoder_LUT[state & 0xF];
+    encoder_pulses[i] += step;
 
 #ifdef ENCODER_DEFAULT_POS
     if ((encoder_pulses[i] >= resolution) || (encoder_pulses[i] <= -resolution) || ((state & 0x3) == ENCODER_DEFAULT_POS)) {
@@ -244,6 +304,31 @@ static bool encoder_update(uint8_t index, uint8_t state) {
     return changed;
 }
 
+#ifdef ENCODER_INTERRUPT_MODE
+bool encoder_read(void) {
+    bool changed = false;
+    for (uint8_t i = 0; i < thisCount; i++) {
+        int8_t  pulses = 0;
+        uint8_t state  = 0;
+        ATOMIC_BLOCK_FORCEON {
+            pulses                = encoder_isr_pulses[i];
+            encoder_isr_pulses[i] = 0;
+            state                 = encoder_isr_state[i];
+        }
+        // Only the final quarter-step is known to have landed on the current pin state -- replay the ones
+        // before it with the opposite pin state so they can't be mistaken for ENCODER_DEFAULT_POS.
+        while (pulses > 0) {
+            pulses--;
+            changed |= encoder_update(i, 1, pulses ? ~state : state);
+        }
+        while (pulses < 0) {
+            pulses++;
+            changed |= encoder_update(i, -1, pulses ? ~state : state);
+        }
+    }
+    return changed;
+}
+#else  // ENCODER_INTERRUPT_MODE
 bool encoder_read(void) {
     bool changed = false;
     for (uint8_t i = 0; i < thisCount; i++) {
@@ -251,11 +336,12 @@ bool encoder_read(void) {
         if ((encoder_state[i] & 0x3) != new_status) {
             encoder_state[i] <<= 2;
             encoder_state[i] |= new_status;
-            changed |= encoder_update(i, encoder_state[i]);
+            changed |= encoder_update(i, encoder_LUT[encoder_state[i] & 0xF], encoder_state[i]);
         }
     }
     return changed;
 }
+#endif // ENCODER_INTERRUPT_MODE
 
 #ifdef SPLIT_KEYBOARD
 void last_encoder_activity_trigger(void);
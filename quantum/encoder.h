@@ -28,6 +28,11 @@ bool encoder_read(void);
 bool encoder_update_kb(uint8_t index, bool clockwise);
 bool encoder_update_user(uint8_t index, bool clockwise);
 
+#ifdef ENCODER_INTERRUPT_MODE
+void encoder_interrupt_init(uint8_t index, pin_t pad_a, pin_t pad_b);
+void encoder_isr(uint8_t index);
+#endif // ENCODER_INTERRUPT_MODE
+
 #ifdef SPLIT_KEYBOARD
 
 void encoder_state_raw(uint8_t* slave_state);
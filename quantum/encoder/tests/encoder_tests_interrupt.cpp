@@ -0,0 +1,130 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "gtest/gtest.h"
+#include "gmock/gmock.h"
+#include <vector>
+#include <algorithm>
+#include <stdio.h>
+
+extern "C" {
+#include "encoder.h"
+#include "encoder/tests/mock.h"
+}
+
+struct update {
+    int8_t index;
+    bool   clockwise;
+};
+
+uint8_t updates_array_idx = 0;
+update  updates[32];
+
+bool encoder_update_kb(uint8_t index, bool clockwise) {
+    updates[updates_array_idx % 32] = {index, clockwise};
+    updates_array_idx++;
+    return true;
+}
+
+// Simulates the pin-change interrupt firing for every edge, without the main loop getting a chance to run
+void setAndInterrupt(pin_t pin, bool val) {
+    setPin(pin, val);
+    encoder_isr(0);
+}
+
+void clockwiseDetents(int count) {
+    for (int i = 0; i < count; i++) {
+        setAndInterrupt(0, false);
+        setAndInterrupt(1, false);
+        setAndInterrupt(0, true);
+        setAndInterrupt(1, true);
+    }
+}
+
+void counterClockwiseDetents(int count) {
+    for (int i = 0; i < count; i++) {
+        setAndInterrupt(1, false);
+        setAndInterrupt(0, false);
+        setAndInterrupt(1, true);
+        setAndInterrupt(0, true);
+    }
+}
+
+class EncoderInterruptTest : public ::testing::Test {
+   protected:
+    void SetUp() override {
+        updates_array_idx = 0;
+        for (int i = 0; i < 32; i++) {
+            pinIsInputHigh[i] = 0;
+            pins[i]           = 0;
+        }
+        encoder_init();
+    }
+};
+
+TEST_F(EncoderInterruptTest, TestNothingUntilRead) {
+    clockwiseDetents(1);
+    EXPECT_EQ(updates_array_idx, 0);
+    EXPECT_TRUE(encoder_read());
+    EXPECT_EQ(updates_array_idx, 1);
+    EXPECT_EQ(updates[0].index, 0);
+    EXPECT_EQ(updates[0].clockwise, true);
+}
+
+TEST_F(EncoderInterruptTest, TestDrainedCountersStayEmpty) {
+    counterClockwiseDetents(1);
+    EXPECT_TRUE(encoder_read());
+    EXPECT_FALSE(encoder_read());
+    EXPECT_EQ(updates_array_idx, 1);
+    EXPECT_EQ(updates[0].clockwise, false);
+}
+
+TEST_F(EncoderInterruptTest, TestFastSpinBetweenReads) {
+    // Polling once per main loop iteration would only see the start and end state of these 40 transitions
+    clockwiseDetents(10);
+    EXPECT_TRUE(encoder_read());
+    EXPECT_EQ(updates_array_idx, 10);
+    for (int i = 0; i < 10; i++) {
+        EXPECT_EQ(updates[i].clockwise, true);
+    }
+}
+
+TEST_F(EncoderInterruptTest, TestDirectionChangeBetweenReads) {
+    clockwiseDetents(3);
+    counterClockwiseDetents(5);
+    EXPECT_TRUE(encoder_read());
+    EXPECT_EQ(updates_array_idx, 2);
+    EXPECT_EQ(updates[0].clockwise, false);
+    EXPECT_EQ(updates[1].clockwise, false);
+}
+
+TEST_F(EncoderInterruptTest, TestPartialDetentCarriesOver) {
+    setAndInterrupt(0, false);
+    setAndInterrupt(1, false);
+    setAndInterrupt(0, true);
+    EXPECT_FALSE(encoder_read());
+    setAndInterrupt(1, true);
+    EXPECT_TRUE(encoder_read());
+    EXPECT_EQ(updates_array_idx, 1);
+    EXPECT_EQ(updates[0].clockwise, true);
+}
+
+TEST_F(EncoderInterruptTest, TestBounceIgnored) {
+    // The interrupt can fire without either pad having changed by the time it samples them
+    setAndInterrupt(0, false);
+    encoder_isr(0);
+    encoder_isr(0);
+    setAndInterrupt(1, false);
+    setAndInterrupt(0, true);
+    setAndInterrupt(1, true);
+    EXPECT_TRUE(encoder_read());
+    EXPECT_EQ(updates_array_idx, 1);
+}
+
+TEST_F(EncoderInterruptTest, TestCounterSaturates) {
+    // 40 detents is 160 quarter-steps, which can't be represented -- expect the counter to pin at its limit rather than wrap
+    clockwiseDetents(40);
+    EXPECT_TRUE(encoder_read());
+    EXPECT_EQ(updates_array_idx, 127 / 4);
+    EXPECT_EQ(updates[0].clockwise, true);
+}
@@ -0,0 +1,94 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "gtest/gtest.h"
+#include "gmock/gmock.h"
+#include <vector>
+#include <algorithm>
+#include <stdio.h>
+
+extern "C" {
+#include "encoder.h"
+#include "encoder/tests/mock_split.h"
+}
+
+struct update {
+    int8_t index;
+    bool   clockwise;
+};
+
+uint8_t updates_array_idx = 0;
+update  updates[32];
+
+bool isLeftHand;
+
+bool encoder_update_kb(uint8_t index, bool clockwise) {
+    if (!isLeftHand) {
+        // this method has no effect on slave half
+        printf("ignoring update on right hand (%d,%s)\n", index, clockwise ? "CW" : "CC");
+        return true;
+    }
+    updates[updates_array_idx % 32] = {index, clockwise};
+    updates_array_idx++;
+    return true;
+}
+
+void setAndInterrupt(uint8_t index, pin_t pin, bool val) {
+    setPin(pin, val);
+    encoder_isr(index);
+}
+
+class EncoderSplitInterruptTest : public ::testing::Test {
+   protected:
+    void SetUp() override {
+        updates_array_idx = 0;
+        for (int i = 0; i < 32; i++) {
+            pinIsInputHigh[i] = 0;
+            pins[i]           = 0;
+        }
+    }
+};
+
+TEST_F(EncoderSplitInterruptTest, TestFastSpinRightSent) {
+    isLeftHand = false;
+    encoder_init();
+    // three clockwise detents on the second right-hand encoder, all before the slave gets to run encoder_read()
+    for (int i = 0; i < 3; i++) {
+        setAndInterrupt(1, 6, false);
+        setAndInterrupt(1, 7, false);
+        setAndInterrupt(1, 6, true);
+        setAndInterrupt(1, 7, true);
+    }
+
+    uint8_t slave_state[32] = {0};
+    encoder_state_raw(slave_state);
+    EXPECT_EQ(slave_state[1], 0); // nothing is visible to the master until the counters are drained
+
+    encoder_read();
+    encoder_state_raw(slave_state);
+    EXPECT_EQ(slave_state[0], 0);
+    EXPECT_EQ(slave_state[1], (uint8_t)-3);
+}
+
+TEST_F(EncoderSplitInterruptTest, TestFastSpinRightReceived) {
+    isLeftHand = true;
+    encoder_init();
+
+    uint8_t slave_state[32] = {0, (uint8_t)-3};
+    encoder_update_raw(slave_state);
+
+    EXPECT_EQ(updates_array_idx, 3);
+    for (int i = 0; i < 3; i++) {
+        EXPECT_EQ(updates[i].index, 3);
+        EXPECT_EQ(updates[i].clockwise, true);
+    }
+}
+
+TEST_F(EncoderSplitInterruptTest, TestLeftInterruptIndexOutOfRange) {
+    isLeftHand = true;
+    encoder_init();
+    // index is per-half, so anything past the local encoder count must be ignored
+    setAndInterrupt(2, 4, true);
+    EXPECT_FALSE(encoder_read());
+    EXPECT_EQ(updates_array_idx, 0);
+}
@@ -66,3 +66,22 @@ encoder_split_role_SRC := \
 	$(QUANTUM_PATH)/encoder/tests/mock_split.c \
 	$(QUANTUM_PATH)/encoder/tests/encoder_tests_split_role.cpp \
 	$(QUANTUM_PATH)/encoder.c
+
+encoder_interrupt_DEFS := -DENCODER_TESTS -DENCODER_ENABLE -DENCODER_MOCK_SINGLE -DENCODER_INTERRUPT_MODE -DIGNORE_ATOMIC_BLOCK
+encoder_interrupt_CONFIG := $(QUANTUM_PATH)/encoder/tests/config_mock.h
+
+encoder_interrupt_SRC := \
+	platforms/test/timer.c \
+	$(QUANTUM_PATH)/encoder/tests/mock.c \
+	$(QUANTUM_PATH)/encoder/tests/encoder_tests_interrupt.cpp \
+	$(QUANTUM_PATH)/encoder.c
+
+encoder_split_interrupt_DEFS := -DENCODER_TESTS -DENCODER_ENABLE -DENCODER_MOCK_SPLIT -DENCODER_INTERRUPT_MODE -DIGNORE_ATOMIC_BLOCK
+encoder_split_interrupt_INC := $(QUANTUM_PATH)/split_common
+encoder_split_interrupt_CONFIG := $(QUANTUM_PATH)/encoder/tests/config_mock_split_left_eq_right.h
+
+encoder_split_interrupt_SRC := \
+	platforms/test/timer.c \
+	$(QUANTUM_PATH)/encoder/tests/mock_split.c \
+	$(QUANTUM_PATH)/encoder/tests/encoder_tests_split_interrupt.cpp \
+	$(QUANTUM_PATH)/encoder.c
@@ -135,6 +135,15 @@ along with this program.  If not, see <http://www.gnu.org/licenses/>.
 #ifdef WPM_ENABLE
 #    include "wpm.h"
 #endif
+#ifdef REPORT_SCHEDULER_ENABLE
+#    include "report_scheduler.h"
+#endif
+#ifdef LATENCY_TRACE_ENABLE
+#    include "latency_trace.h"
+#endif
+#ifdef DEFERRED_LOG_ENABLE
+#    include "deferred_log.h"
+#endif
 
 static uint32_t last_input_modification_time = 0;
 uint32_t        last_input_activity_time(void) {
@@ -543,6 +552,9 @@ static bool matrix_task(void) {
                 const bool key_pressed = current_row & col_mask;
 
                 if (process_keypress) {
+#ifdef LATENCY_TRACE_ENABLE
+                    latency_trace_event(MAKE_KEYPOS(row, col), key_pressed);
+#endif
                     action_exec(MAKE_KEYEVENT(row, col, key_pressed));
                 }
 
@@ -717,5 +729,17 @@ void keyboard_task(void) {
     haptic_task();
 #endif
 
+#ifdef REPORT_SCHEDULER_ENABLE
+    report_scheduler_task();
+#endif
+
     led_task();
+
+#ifdef LATENCY_TRACE_ENABLE
+    latency_trace_task();
+#endif
+
+#ifdef DEFERRED_LOG_ENABLE
+    deferred_log_task();
+#endif
 }
@@ -14,7 +14,20 @@
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 // Key mapping
 
-#define NUM_KEYMAP_LAYERS_RAW ((uint8_t)(sizeof(keymaps) / ((MATRIX_ROWS) * (MATRIX_COLS) * sizeof(uint16_t))))
+#ifdef KEYMAP_SPARSE
+// The keymap was generated by `qmk json2c --sparse`: each layer is a bitmap of its non-transparent keys, with the keycodes
+// of those keys packed into keymap_sparse_keycodes[]. keymap_sparse_ranks[] holds the index of the first keycode of each
+// 32-bit word of the bitmap, so a lookup is one rank read plus a popcount within the word.
+#    define NUM_KEYMAP_LAYERS_RAW ((uint8_t)(sizeof(keymap_sparse_bitmap) / sizeof(keymap_sparse_bitmap[0])))
+#    define KEYMAP_SPARSE_BITMAP_WORDS (((MATRIX_ROWS) * (MATRIX_COLS) + 31) / 32)
+
+_Static_assert(sizeof(keymap_sparse_layout) == KEYMAP_SPARSE_BITMAP_WORDS * sizeof(uint32_t), "Sparse keymap was generated for a different matrix size");
+_Static_assert(sizeof(keymap_sparse_bitmap[0]) == KEYMAP_SPARSE_BITMAP_WORDS * sizeof(uint32_t), "Sparse keymap was generated for a different matrix size");
+_Static_assert(sizeof(keymap_sparse_ranks) / sizeof(keymap_sparse_ranks[0]) == NUM_KEYMAP_LAYERS_RAW, "Sparse keymap ranks don't match the number of layers");
+_Static_assert(sizeof(keymap_sparse_ranks[0]) == KEYMAP_SPARSE_BITMAP_WORDS * sizeof(uint16_t), "Sparse keymap ranks don't match the bitmap size");
+#else
+#    define NUM_KEYMAP_LAYERS_RAW ((uint8_t)(sizeof(keymaps) / ((MATRIX_ROWS) * (MATRIX_COLS) * sizeof(uint16_t))))
+#endif
 
 uint8_t keymap_layer_count_raw(void) {
     return NUM_KEYMAP_LAYERS_RAW;
@@ -30,12 +43,31 @@ _Static_assert(NUM_KEYMAP_LAYERS_RAW <= MAX_LAYER, "Number of keymap layers exce
 _Static_assert(NUM_KEYMAP_LAYERS_RAW <= MAX_LAYER, "Number of keymap layers exceeds maximum set by LAYER_STATE_(8|16|32)BIT");
 #endif
 
+#ifdef KEYMAP_SPARSE
+uint16_t keycode_at_keymap_location_raw(uint8_t layer_num, uint8_t row, uint8_t column) {
+    if (layer_num < NUM_KEYMAP_LAYERS_RAW && row < MATRIX_ROWS && column < MATRIX_COLS) {
+        uint16_t index = (uint16_t)row * MATRIX_COLS + column;
+        uint32_t mask  = (uint32_t)1 << (index % 32);
+        uint32_t bits  = pgm_read_dword(&keymap_sparse_bitmap[layer_num][index / 32]);
+        if (!(bits & mask)) {
+            // Keys outside the layout are KC_NO on every layer, same as the LAYOUT macro fills in for the dense array
+            return (pgm_read_dword(&keymap_sparse_layout[index / 32]) & mask) ? KC_TRNS : KC_NO;
+        }
+
+        // Rank of this key amongst the layer's non-transparent keys
+        uint16_t rank = pgm_read_word(&keymap_sparse_ranks[layer_num][index / 32]) + __builtin_popcountl(bits & (mask - 1));
+        return pgm_read_word(&keymap_sparse_keycodes[rank]);
+    }
+    return KC_TRNS;
+}
+#else
 uint16_t keycode_at_keymap_location_raw(uint8_t layer_num, uint8_t row, uint8_t column) {
     if (layer_num < NUM_KEYMAP_LAYERS_RAW && row < MATRIX_ROWS && column < MATRIX_COLS) {
         return pgm_read_word(&keymaps[layer_num][row][column]);
     }
     return KC_TRNS;
 }
+#endif
 
 __attribute__((weak)) uint16_t keycode_at_keymap_location(uint8_t layer_num, uint8_t row, uint8_t column) {
     return keycode_at_keymap_location_raw(layer_num, row, column);
@@ -0,0 +1,64 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <string.h>
+#include "latency_histogram.h"
+
+static uint8_t bucket_of(uint32_t latency_us) {
+    if (latency_us < 8) return latency_us;
+    uint8_t msb = 31 - __builtin_clz(latency_us);
+    return (msb - 1) * 4 + ((latency_us >> (msb - 2)) & 3);
+}
+
+static uint32_t bucket_floor(uint8_t bucket) {
+    if (bucket < 8) return bucket;
+    return (4UL + bucket % 4) << (bucket / 4 - 1);
+}
+
+void latency_histogram_reset(latency_histogram_t *histogram) {
+    memset(histogram, 0, sizeof(*histogram));
+    histogram->min_us = UINT32_MAX;
+}
+
+void latency_histogram_add(latency_histogram_t *histogram, uint32_t latency_us) {
+    if (latency_us > LATENCY_HISTOGRAM_MAX_US) latency_us = LATENCY_HISTOGRAM_MAX_US;
+    uint8_t bucket = bucket_of(latency_us);
+
+    histogram->count++;
+    histogram->total_us += latency_us;
+    if (latency_us < histogram->min_us) histogram->min_us = latency_us;
+    if (latency_us > histogram->max_us) histogram->max_us = latency_us;
+    if (histogram->buckets[bucket] < UINT16_MAX) histogram->buckets[bucket]++;
+}
+
+uint32_t latency_histogram_percentile(const latency_histogram_t *histogram, uint16_t permille) {
+    if (!histogram->count) return 0;
+
+    // Rank of the sample, counting from 1, from the bucket counts themselves as they saturate
+    uint32_t total = 0;
+    for (uint8_t i = 0; i < LATENCY_HISTOGRAM_BUCKETS; i++) {
+        total += histogram->buckets[i];
+    }
+    uint32_t rank = ((uint64_t)total * permille + 999) / 1000;
+    if (rank < 1) rank = 1;
+
+    uint32_t seen = 0;
+    for (uint8_t i = 0; i < LATENCY_HISTOGRAM_BUCKETS; i++) {
+        seen += histogram->buckets[i];
+        if (seen >= rank) {
+            uint32_t floor  = bucket_floor(i);
+            uint32_t middle = floor + (bucket_floor(i + 1) - floor) / 2;
+            return MIN(MAX(middle, histogram->min_us), histogram->max_us);
+        }
+    }
+    return histogram->max_us;
+}
+
+void latency_histogram_summary(const latency_histogram_t *histogram, latency_summary_t *summary) {
+    summary->count  = histogram->count;
+    summary->min_us = histogram->count ? histogram->min_us : 0;
+    summary->avg_us = histogram->count ? histogram->total_us / histogram->count : 0;
+    summary->p50_us = latency_histogram_percentile(histogram, 500);
+    summary->p99_us = latency_histogram_percentile(histogram, 990);
+    summary->max_us = histogram->max_us;
+}
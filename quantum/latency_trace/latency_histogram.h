@@ -0,0 +1,47 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <stdint.h>
+#include "util.h"
+
+// Four buckets per power of two up to 2^24us (about 16s), values below 8us are counted exactly
+#define LATENCY_HISTOGRAM_MAX_US ((1UL << 24) - 1)
+#define LATENCY_HISTOGRAM_BUCKETS 92
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef struct {
+    uint32_t count;
+    uint32_t min_us;
+    uint32_t max_us;
+    uint64_t total_us;
+    uint16_t buckets[LATENCY_HISTOGRAM_BUCKETS];
+} latency_histogram_t;
+
+typedef struct PACKED {
+    uint32_t count;
+    uint32_t min_us;
+    uint32_t avg_us;
+    uint32_t p50_us;
+    uint32_t p99_us;
+    uint32_t max_us;
+} latency_summary_t;
+
+void latency_histogram_reset(latency_histogram_t *histogram);
+void latency_histogram_add(latency_histogram_t *histogram, uint32_t latency_us);
+
+/**
+ * \brief Returns the latency under which `permille` of the samples fall, to within an eighth of it: the middle of the
+ * bucket holding it, kept within the smallest and largest samples.
+ */
+uint32_t latency_histogram_percentile(const latency_histogram_t *histogram, uint16_t permille);
+
+void latency_histogram_summary(const latency_histogram_t *histogram, latency_summary_t *summary);
+
+#ifdef __cplusplus
+}
+#endif
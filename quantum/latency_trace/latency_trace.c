@@ -0,0 +1,211 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <string.h>
+#include "latency_trace.h"
+#include "timer.h"
+#include "debug.h"
+#if defined(PROTOCOL_CHIBIOS)
+#    include <ch.h>
+#endif
+
+typedef enum {
+    TRACE_FREE,
+    TRACE_RAW,       // seen changing in the raw matrix
+    TRACE_EVENT,     // out of debounce, on its way through action_exec()
+    TRACE_PROCESSED, // reached process_record(), waiting for the report
+} trace_stage_t;
+
+typedef struct {
+    keypos_t      key;
+    bool          pressed;
+    trace_stage_t stage;
+    uint32_t      raw_us;
+    uint32_t      event_us;
+    uint32_t      processed_us;
+} trace_t;
+
+static trace_t             traces[LATENCY_TRACE_PENDING];
+static latency_histogram_t histograms[LATENCY_STAGE_COUNT];
+static uint32_t            unreported;
+static bool                initialized;
+#ifdef DEBUG_LATENCY_TRACE
+static uint32_t print_timer;
+#endif
+
+__attribute__((weak)) uint32_t latency_trace_timer_us(void) {
+#if defined(PROTOCOL_CHIBIOS) && CH_CFG_ST_RESOLUTION == 32
+    return TIME_I2US(chVTGetSystemTimeX());
+#else
+    return timer_read32() * 1000;
+#endif
+}
+
+static void init_if_needed(void) {
+    if (!initialized) latency_trace_reset();
+}
+
+static trace_t *find(keypos_t key, bool pressed, trace_stage_t stage) {
+    trace_t *found = NULL;
+    for (uint8_t i = 0; i < LATENCY_TRACE_PENDING; i++) {
+        trace_t *trace = &traces[i];
+        if (trace->stage == stage && trace->pressed == pressed && KEYEQ(trace->key, key)) {
+            // The oldest one, should the key go round more than once while held back
+            if (!found || (int32_t)(trace->event_us - found->event_us) < 0) found = trace;
+        }
+    }
+    return found;
+}
+
+static trace_t *allocate(void) {
+    trace_t *oldest = &traces[0];
+    for (uint8_t i = 0; i < LATENCY_TRACE_PENDING; i++) {
+        if (traces[i].stage == TRACE_FREE) return &traces[i];
+        if ((int32_t)(traces[i].raw_us - oldest->raw_us) < 0) oldest = &traces[i];
+    }
+    // Make room by forgetting the longest waiting key
+    return oldest;
+}
+
+void latency_trace_raw_changes(const matrix_row_t *previous, const matrix_row_t *current, uint8_t first_row, uint8_t rows) {
+    uint32_t now = 0;
+    for (uint8_t row = 0; row < rows; row++) {
+        matrix_row_t changes = previous[row] ^ current[row];
+        for (uint8_t col = 0; changes; col++, changes >>= 1) {
+            if (!(changes & 1)) continue;
+            if (!now) {
+                init_if_needed();
+                now = latency_trace_timer_us();
+            }
+
+            keypos_t key     = MAKE_KEYPOS(first_row + row, col);
+            bool     pressed = current[row] & ((matrix_row_t)1 << col);
+
+            // A bounce back before debounce let the first change through: neither of them will become an event
+            trace_t *bounced = find(key, !pressed, TRACE_RAW);
+            if (bounced) {
+                bounced->stage = TRACE_FREE;
+                continue;
+            }
+
+            trace_t *trace = allocate();
+            *trace         = (trace_t){.key = key, .pressed = pressed, .stage = TRACE_RAW, .raw_us = now};
+        }
+    }
+}
+
+void latency_trace_event(keypos_t key, bool pressed) {
+    init_if_needed();
+    uint32_t now   = latency_trace_timer_us();
+    trace_t *trace = find(key, pressed, TRACE_RAW);
+    if (trace) {
+        latency_histogram_add(&histograms[LATENCY_STAGE_DEBOUNCE], now - trace->raw_us);
+    } else {
+        // Matrices which do not report their raw changes are measured from the event on
+        trace  = allocate();
+        *trace = (trace_t){.key = key, .pressed = pressed, .raw_us = now};
+    }
+    trace->stage    = TRACE_EVENT;
+    trace->event_us = now;
+}
+
+static void processed(trace_t *trace, uint32_t now) {
+    latency_histogram_add(&histograms[LATENCY_STAGE_PROCESS], now - trace->event_us);
+    trace->stage        = TRACE_PROCESSED;
+    trace->processed_us = now;
+}
+
+void latency_trace_processed(const keyevent_t *event) {
+    if (!initialized) return;
+    uint32_t now = latency_trace_timer_us();
+
+    if (IS_COMBOEVENT(*event)) {
+        // The combo stands for all of the keys it held back
+        for (uint8_t i = 0; i < LATENCY_TRACE_PENDING; i++) {
+            if (traces[i].stage == TRACE_EVENT && traces[i].pressed == event->pressed) {
+                processed(&traces[i], now);
+            }
+        }
+        return;
+    }
+
+    trace_t *trace = find(event->key, event->pressed, TRACE_EVENT);
+    if (trace) {
+        processed(trace, now);
+    }
+}
+
+void latency_trace_report(void) {
+    if (!initialized) return;
+    uint32_t now = latency_trace_timer_us();
+
+    for (uint8_t i = 0; i < LATENCY_TRACE_PENDING; i++) {
+        trace_t *trace = &traces[i];
+        if (trace->stage != TRACE_PROCESSED) continue;
+        latency_histogram_add(&histograms[LATENCY_STAGE_REPORT], now - trace->processed_us);
+        latency_histogram_add(&histograms[LATENCY_STAGE_TOTAL], now - trace->raw_us);
+        trace->stage = TRACE_FREE;
+    }
+}
+
+void latency_trace_task(void) {
+    if (!initialized) return;
+    uint32_t now = latency_trace_timer_us();
+
+    for (uint8_t i = 0; i < LATENCY_TRACE_PENDING; i++) {
+        trace_t *trace = &traces[i];
+        switch (trace->stage) {
+            case TRACE_PROCESSED:
+                // Layer keys and the like change nothing the host sees
+                unreported++;
+                trace->stage = TRACE_FREE;
+                break;
+            case TRACE_RAW:
+            case TRACE_EVENT:
+                if (now - trace->raw_us > LATENCY_TRACE_TIMEOUT * 1000UL) {
+                    trace->stage = TRACE_FREE;
+                }
+                break;
+            default:
+                break;
+        }
+    }
+
+#ifdef DEBUG_LATENCY_TRACE
+    if (timer_elapsed32(print_timer) >= LATENCY_TRACE_PRINT_INTERVAL) {
+        print_timer = timer_read32();
+        latency_trace_print();
+    }
+#endif
+}
+
+bool latency_trace_summary(latency_stage_t stage, latency_summary_t *summary) {
+    if (stage >= LATENCY_STAGE_COUNT) return false;
+    init_if_needed();
+    latency_histogram_summary(&histograms[stage], summary);
+    return true;
+}
+
+uint32_t latency_trace_unreported(void) {
+    return unreported;
+}
+
+void latency_trace_reset(void) {
+    memset(traces, 0, sizeof(traces));
+    for (uint8_t i = 0; i < LATENCY_STAGE_COUNT; i++) {
+        latency_histogram_reset(&histograms[i]);
+    }
+    unreported  = 0;
+    initialized = true;
+}
+
+void latency_trace_print(void) {
+    __attribute__((unused)) static const char *const names[LATENCY_STAGE_COUNT] = {"debounce", "process", "report", "total"};
+
+    for (uint8_t i = 0; i < LATENCY_STAGE_COUNT; i++) {
+        latency_summary_t summary;
+        latency_trace_summary(i, &summary);
+        dprintf("%-8s: %lu events, min %lu avg %lu p50 %lu p99 %lu max %lu us\n", names[i], summary.count, summary.min_us, summary.avg_us, summary.p50_us, summary.p99_us, summary.max_us);
+    }
+    dprintf("unreported: %lu\n", unreported);
+}
@@ -0,0 +1,63 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "keyboard.h"
+#include "matrix.h"
+#include "latency_histogram.h"
+
+// Key events followed at once, from their raw matrix change to the report they end up in
+#ifndef LATENCY_TRACE_PENDING
+#    define LATENCY_TRACE_PENDING 8
+#endif
+
+// Events still waiting after this long are forgotten, such as keys held in the tapping buffer
+#ifndef LATENCY_TRACE_TIMEOUT
+#    define LATENCY_TRACE_TIMEOUT 5000
+#endif
+
+#ifndef LATENCY_TRACE_PRINT_INTERVAL
+#    define LATENCY_TRACE_PRINT_INTERVAL 10000
+#endif
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef enum {
+    LATENCY_STAGE_DEBOUNCE, // raw matrix change to key event
+    LATENCY_STAGE_PROCESS,  // key event to process_record(), held back by tap-hold keys, combos and the like
+    LATENCY_STAGE_REPORT,   // process_record() to the report
+    LATENCY_STAGE_TOTAL,    // raw matrix change to the report
+    LATENCY_STAGE_COUNT,
+} latency_stage_t;
+
+/** \brief Called by the matrix for the raw rows `first_row` on, before debouncing. */
+void latency_trace_raw_changes(const matrix_row_t *previous, const matrix_row_t *current, uint8_t first_row, uint8_t rows);
+
+/** \brief Called for every key event coming out of the debounced matrix. */
+void latency_trace_event(keypos_t key, bool pressed);
+
+/** \brief Called when a key event reaches process_record(). */
+void latency_trace_processed(const keyevent_t *event);
+
+/** \brief Called when a keyboard or extra report is sent to the host. */
+void latency_trace_report(void);
+
+/** \brief Forgets the processed events which did not produce a report, at the end of the main loop. */
+void latency_trace_task(void);
+
+bool     latency_trace_summary(latency_stage_t stage, latency_summary_t *summary);
+uint32_t latency_trace_unreported(void);
+void     latency_trace_reset(void);
+void     latency_trace_print(void);
+
+/** \brief Microsecond timer the latencies are measured with. */
+uint32_t latency_trace_timer_us(void);
+
+#ifdef __cplusplus
+}
+#endif
@@ -243,6 +243,13 @@ static void led_task_sync(void) {
     if (sync_timer_elapsed32(g_led_timer) >= LED_MATRIX_LED_FLUSH_LIMIT) led_task_state = STARTING;
 }
 
+uint32_t led_matrix_next_frame_ms(void) {
+    // Frames are rendered over several calls to led_matrix_task(), the next one starts once the flush limit has passed
+    if (led_task_state != SYNCING) return 0;
+    uint32_t elapsed = sync_timer_elapsed32(g_led_timer);
+    return elapsed >= LED_MATRIX_LED_FLUSH_LIMIT ? 0 : LED_MATRIX_LED_FLUSH_LIMIT - elapsed;
+}
+
 static void led_task_start(void) {
     // reset iter
     led_effect_params.iter = 0;
@@ -0,0 +1,208 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <string.h>
+#include "deferred_log.h"
+#include "atomic_util.h"
+#include "sendchar.h"
+#include "util.h"
+#ifdef DEFERRED_LOG_RAW_HID
+#    include "raw_hid.h"
+#    include "usb_descriptor.h"
+#endif
+
+_Static_assert(DEFERRED_LOG_MAX_RECORD <= UINT8_MAX, "DEFERRED_LOG_MAX_RECORD must fit the record length byte");
+_Static_assert(DEFERRED_LOG_MAX_RECORD <= DEFERRED_LOG_BUFFER_SIZE, "DEFERRED_LOG_BUFFER_SIZE must hold at least one record");
+
+static uint8_t  buffer[DEFERRED_LOG_BUFFER_SIZE];
+static uint16_t head;
+static uint16_t tail;
+static uint16_t used;
+static uint16_t dropped;
+
+typedef struct {
+    uint8_t *data;
+    uint8_t  length;
+} record_t;
+
+static bool put(record_t *record, const void *data, uint8_t length) {
+    if (record->length + length > DEFERRED_LOG_MAX_RECORD) return false;
+    memcpy(&record->data[record->length], data, length);
+    record->length += length;
+    return true;
+}
+
+static bool put_u32(record_t *record, uint32_t value) {
+    uint8_t bytes[4] = {value, value >> 8, value >> 16, value >> 24};
+    return put(record, bytes, sizeof(bytes));
+}
+
+static bool put_string(record_t *record, const char *string) {
+    uint8_t length = string ? strnlen(string, DEFERRED_LOG_MAX_STRING) : 0;
+    if (record->length + length + 1 > DEFERRED_LOG_MAX_RECORD) return false;
+    if (length) put(record, string, length);
+    return put(record, "", 1);
+}
+
+// Walks the format just far enough to take each argument off the list the way printf() would
+static void encode(record_t *record, const char *format, va_list args) {
+    for (char c; (c = pgm_read_byte(format++));) {
+        if (c != '%') continue;
+
+        // Flags, width and precision, the latter two possibly taken from the arguments
+        while ((c = pgm_read_byte(format++)) && strchr("-+ #0123456789.*", c)) {
+            if (c == '*' && !put_u32(record, va_arg(args, int))) return;
+        }
+
+        uint8_t longs = 0;
+        bool    size  = false;
+        for (; c && strchr("hlzjt", c); c = pgm_read_byte(format++)) {
+            if (c == 'l') longs++;
+            if (c == 'z' || c == 'j' || c == 't') size = true;
+        }
+
+        bool fits = true;
+        switch (c) {
+            case '\0':
+                return;
+            case 'd':
+            case 'i':
+                fits = put_u32(record, longs > 1 ? (int32_t)va_arg(args, long long) : longs ? va_arg(args, long) : size ? (int32_t)va_arg(args, ptrdiff_t) : va_arg(args, int));
+                break;
+            case 'u':
+            case 'x':
+            case 'X':
+            case 'o':
+            case 'b':
+            case 'c':
+                fits = put_u32(record, longs > 1 ? (uint32_t)va_arg(args, unsigned long long) : longs ? va_arg(args, unsigned long) : size ? (uint32_t)va_arg(args, size_t) : va_arg(args, unsigned int));
+                break;
+            case 'p':
+                fits = put_u32(record, (uintptr_t)va_arg(args, void *));
+                break;
+            case 's':
+                fits = put_string(record, va_arg(args, const char *));
+                break;
+            case 'f':
+            case 'F':
+            case 'e':
+            case 'E':
+            case 'g':
+            case 'G':
+            case 'a':
+            case 'A': {
+                float value = va_arg(args, double);
+                fits        = put(record, &value, sizeof(value));
+                break;
+            }
+            case 'n':
+                (void)va_arg(args, void *);
+                break;
+            default:
+                break;
+        }
+        // The host shows whatever is missing off the end as such
+        if (!fits) return;
+    }
+}
+
+static bool push(const uint8_t *data, uint8_t length) {
+    if (DEFERRED_LOG_BUFFER_SIZE - used < length) return false;
+    uint16_t first = MIN(length, DEFERRED_LOG_BUFFER_SIZE - head);
+    memcpy(&buffer[head], data, first);
+    memcpy(buffer, &data[first], length - first);
+    head = (head + length) % DEFERRED_LOG_BUFFER_SIZE;
+    used += length;
+    return true;
+}
+
+static void start(record_t *record, uint8_t *data, uint32_t id) {
+    *record = (record_t){.data = data};
+    put(record, (uint8_t[]){DEFERRED_LOG_SYNC, 0}, 2);
+    put_u32(record, id);
+}
+
+static uint8_t finish(record_t *record) {
+    record->data[1] = record->length - 2;
+    return record->length;
+}
+
+int deferred_log_vwrite(const char *format, va_list args) {
+    uint8_t  data[DEFERRED_LOG_MAX_RECORD];
+    record_t record;
+    start(&record, data, (uintptr_t)format);
+    encode(&record, format, args);
+    uint8_t length = finish(&record);
+
+    ATOMIC_BLOCK_FORCEON {
+        if (dropped) {
+            uint8_t  notice_data[DEFERRED_LOG_HEADER_SIZE + 4];
+            record_t notice;
+            start(&notice, notice_data, DEFERRED_LOG_DROPPED_ID);
+            put_u32(&notice, dropped);
+            if (push(notice_data, finish(&notice))) dropped = 0;
+        }
+        // Never wait for the host: whatever does not fit is counted, and the count logged once there is room
+        if (dropped || !push(data, length)) {
+            if (dropped < UINT16_MAX) dropped++;
+            length = 0;
+        }
+    }
+    return length;
+}
+
+int deferred_log_write(const char *format, ...) {
+    va_list args;
+    va_start(args, format);
+    int length = deferred_log_vwrite(format, args);
+    va_end(args);
+    return length;
+}
+
+uint16_t deferred_log_pending(void) {
+    uint16_t pending;
+    ATOMIC_BLOCK_FORCEON {
+        pending = used;
+    }
+    return pending;
+}
+
+void deferred_log_task(void) {
+    for (;;) {
+        uint16_t offset;
+        uint16_t length;
+        ATOMIC_BLOCK_FORCEON {
+            offset = tail;
+            length = MIN(used, DEFERRED_LOG_BUFFER_SIZE - tail);
+        }
+        if (!length) return;
+
+        // Writers only ever add past `used`, so the bytes being sent stay put
+        uint8_t sent = deferred_log_send(&buffer[offset], MIN(length, UINT8_MAX));
+        ATOMIC_BLOCK_FORCEON {
+            tail = (tail + sent) % DEFERRED_LOG_BUFFER_SIZE;
+            used -= sent;
+        }
+        if (sent < MIN(length, UINT8_MAX)) return;
+    }
+}
+
+#ifdef DEFERRED_LOG_RAW_HID
+__attribute__((weak)) uint8_t deferred_log_send(const uint8_t *data, uint8_t length) {
+    // A packet per pass, padding between records is skipped by the host
+    uint8_t packet[RAW_EPSIZE] = {0};
+    length                     = MIN(length, sizeof(packet));
+    memcpy(packet, data, length);
+    raw_hid_send(packet, sizeof(packet));
+    return length;
+}
+#else
+__attribute__((weak)) uint8_t deferred_log_send(const uint8_t *data, uint8_t length) {
+    for (uint8_t i = 0; i < length; i++) {
+        sendchar(data[i]);
+    }
+    return length;
+}
+#endif
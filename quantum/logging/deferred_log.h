@@ -0,0 +1,59 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <stdint.h>
+#include <stdarg.h>
+#include "progmem.h"
+
+// RAM ring the records wait in until the host takes them
+#ifndef DEFERRED_LOG_BUFFER_SIZE
+#    define DEFERRED_LOG_BUFFER_SIZE 512
+#endif
+
+// Longest a record can be, arguments which do not fit are left off
+#ifndef DEFERRED_LOG_MAX_RECORD
+#    define DEFERRED_LOG_MAX_RECORD 48
+#endif
+
+// Longest a `%s` argument is copied out to
+#ifndef DEFERRED_LOG_MAX_STRING
+#    define DEFERRED_LOG_MAX_STRING 16
+#endif
+
+// Every record starts with this, followed by its length, the format ID and the arguments
+#define DEFERRED_LOG_SYNC 0xFE
+#define DEFERRED_LOG_HEADER_SIZE 6
+
+// Format ID of the record telling how many were dropped for want of room
+#define DEFERRED_LOG_DROPPED_ID 0
+
+/**
+ * \brief Logs `format` and its arguments without formatting them.
+ *
+ * The format string is kept in a static of its own, whose address is the ID the
+ * host looks it up by in the firmware's symbols.
+ */
+#define deferred_log(format, ...)                                                   \
+    deferred_log_write((__extension__({                                             \
+                           static const char deferred_log_format[] PROGMEM = format; \
+                           &deferred_log_format[0];                                  \
+                       })),                                                         \
+                       ##__VA_ARGS__)
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+int      deferred_log_write(const char *format, ...) __attribute__((format(printf, 1, 2)));
+int      deferred_log_vwrite(const char *format, va_list args) __attribute__((format(printf, 1, 0)));
+void     deferred_log_task(void);
+uint16_t deferred_log_pending(void);
+
+/** \brief Hands records to the host, returning how many bytes were taken. Must not wait. */
+uint8_t deferred_log_send(const uint8_t *data, uint8_t length);
+
+#ifdef __cplusplus
+}
+#endif
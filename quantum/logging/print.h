@@ -76,6 +76,23 @@ void print_set_sendchar(sendchar_func_t func);
 
 #endif /* NO_PRINT */
 
+#if defined(DEFERRED_LOG_ENABLE) && !defined(NO_PRINT)
+// Hand the arguments over as they are, and leave the formatting to the host
+#    include "deferred_log.h"
+#    undef print
+#    undef println
+#    undef xprintf
+#    undef uprint
+#    undef uprintln
+#    undef uprintf
+#    define print(s) deferred_log(s)
+#    define println(s) deferred_log(s "\r\n")
+#    define xprintf(fmt, ...) deferred_log(fmt, ##__VA_ARGS__)
+#    define uprint(s) deferred_log(s)
+#    define uprintln(s) deferred_log(s "\r\n")
+#    define uprintf(fmt, ...) deferred_log(fmt, ##__VA_ARGS__)
+#endif /* DEFERRED_LOG_ENABLE */
+
 #ifdef USER_PRINT
 // Remove normal print defines
 #    undef print
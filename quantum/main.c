@@ -16,6 +16,10 @@
 
 #include "keyboard.h"
 
+#ifdef TICKLESS_IDLE_ENABLE
+#    include "tickless_idle.h"
+#endif
+
 void platform_setup(void);
 
 void protocol_setup(void);
@@ -72,5 +76,10 @@ int main(void) {
 #endif // DEFERRED_EXEC_ENABLE
 
         housekeeping_task();
+
+#ifdef TICKLESS_IDLE_ENABLE
+        // Sleep until anything is due
+        tickless_idle_task();
+#endif // TICKLESS_IDLE_ENABLE
     }
 }
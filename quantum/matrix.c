@@ -21,6 +21,9 @@ along with this program.  If not, see <http://www.gnu.org/licenses/>.
 #include "matrix.h"
 #include "debounce.h"
 #include "atomic_util.h"
+#ifdef LATENCY_TRACE_ENABLE
+#    include "latency_trace.h"
+#endif
 
 #ifdef SPLIT_KEYBOARD
 #    include "split_common/split_util.h"
@@ -337,6 +340,13 @@ uint8_t matrix_scan(void) {
 #endif
 
     bool changed = memcmp(raw_matrix, curr_matrix, sizeof(curr_matrix)) != 0;
+#ifdef LATENCY_TRACE_ENABLE
+#    ifdef SPLIT_KEYBOARD
+    if (changed) latency_trace_raw_changes(raw_matrix, curr_matrix, thisHand, ROWS_PER_HAND);
+#    else
+    if (changed) latency_trace_raw_changes(raw_matrix, curr_matrix, 0, ROWS_PER_HAND);
+#    endif
+#endif
     if (changed) memcpy(raw_matrix, curr_matrix, sizeof(curr_matrix));
 
 #ifdef SPLIT_KEYBOARD
@@ -3,6 +3,7 @@
 // SPDX-License-Identifier: GPL-2.0-or-later
 
 #include "qp_lvgl.h"
+#include "qp_lvgl_transfer.h"
 #include "timer.h"
 #include "deferred_exec.h"
 #include "lvgl.h"
@@ -13,6 +14,8 @@ typedef struct lvgl_state_t {
     deferred_token defer_token;
 } lvgl_state_t;
 
+_Static_assert(sizeof(lv_area_t) == sizeof(qp_lvgl_area_t), "qp_lvgl_area_t must match lv_area_t, LV_USE_LARGE_COORD is not supported");
+
 static deferred_executor_t lvgl_executors[2] = {0}; // For lv_tick_inc and lv_task_handler
 static lvgl_state_t        lvgl_states[2]    = {0}; // For lv_tick_inc and lv_task_handler
 
@@ -24,10 +27,7 @@ void *           color_buffer     = NULL;
 
 void qp_lvgl_flush(lv_disp_drv_t *disp, const lv_area_t *area, lv_color_t *color_p) {
     if (selected_display) {
-        uint32_t number_pixels = (area->x2 - area->x1 + 1) * (area->y2 - area->y1 + 1);
-        qp_viewport(selected_display, area->x1, area->y1, area->x2, area->y2);
-        qp_pixdata(selected_display, (void *)color_p, number_pixels);
-        qp_flush(selected_display);
+        qp_lvgl_transfer(selected_display, (const qp_lvgl_area_t *)area, color_p);
         lv_disp_flush_ready(disp);
     }
 }
@@ -41,9 +41,14 @@ static uint32_t tick_task_callback(uint32_t trigger_time, void *cb_arg) {
             lv_tick_inc(TIMER_DIFF_32(now, last_tick));
             last_tick = now;
         } break;
-        case 1:
+        case 1: {
+            // LVGL only joins areas that touch, so pull in nearby ones too before they get rendered and sent one by one
+            lv_disp_t *disp = lv_disp_get_default();
+            if (disp) {
+                disp->inv_p = qp_lvgl_merge_areas((qp_lvgl_area_t *)disp->inv_areas, disp->inv_area_joined, disp->inv_p, QP_LVGL_MERGE_OVERHEAD);
+            }
             lv_task_handler();
-            break;
+        } break;
 
         default:
             break;
@@ -95,9 +100,13 @@ bool qp_lvgl_attach(painter_device_t device) {
 
     // Set up lvgl display buffer
     static lv_disp_draw_buf_t draw_buf;
+#ifdef QP_LVGL_BUFFER_PIXELS
+    const size_t count_required = QP_LVGL_BUFFER_PIXELS;
+#else
     // Allocate a buffer for 1/10 screen size
-    const size_t count_required   = driver->panel_width * driver->panel_height / 10;
-    void *       new_color_buffer = realloc(color_buffer, sizeof(lv_color_t) * count_required);
+    const size_t count_required = driver->panel_width * driver->panel_height / 10;
+#endif
+    void *new_color_buffer = realloc(color_buffer, sizeof(lv_color_t) * count_required);
     if (!new_color_buffer) {
         qp_dprintf("qp_lvgl_attach: fail (could not set up memory buffer)\n");
         qp_lvgl_detach();
@@ -0,0 +1,62 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "qp_internal.h"
+#include "qp_lvgl_transfer.h"
+
+static uint32_t qp_lvgl_area_size(const qp_lvgl_area_t *area) {
+    return (uint32_t)(area->x2 - area->x1 + 1) * (uint32_t)(area->y2 - area->y1 + 1);
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Quantum Painter LVGL Integration Internal: qp_lvgl_merge_areas
+
+uint16_t qp_lvgl_merge_areas(qp_lvgl_area_t *areas, uint8_t *joined, uint16_t count, uint32_t overhead) {
+    // Merging grows an area, which may then take in ones it was too far from before
+    bool merged;
+    do {
+        merged = false;
+        for (uint16_t i = 0; i < count; ++i) {
+            if (joined[i]) {
+                continue;
+            }
+            for (uint16_t j = i + 1; j < count; ++j) {
+                if (joined[j]) {
+                    continue;
+                }
+
+                qp_lvgl_area_t bounds = {
+                    .x1 = QP_MIN(areas[i].x1, areas[j].x1),
+                    .y1 = QP_MIN(areas[i].y1, areas[j].y1),
+                    .x2 = QP_MAX(areas[i].x2, areas[j].x2),
+                    .y2 = QP_MAX(areas[i].y2, areas[j].y2),
+                };
+                if (qp_lvgl_area_size(&bounds) <= qp_lvgl_area_size(&areas[i]) + qp_lvgl_area_size(&areas[j]) + overhead) {
+                    areas[i]  = bounds;
+                    joined[j] = 1;
+                    merged    = true;
+                }
+            }
+        }
+    } while (merged);
+
+    uint16_t remaining = 0;
+    for (uint16_t i = 0; i < count; ++i) {
+        if (!joined[i]) {
+            areas[remaining++] = areas[i];
+        }
+    }
+    for (uint16_t i = 0; i < count; ++i) {
+        joined[i] = 0;
+    }
+    return remaining;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Quantum Painter LVGL Integration Internal: qp_lvgl_transfer
+
+void qp_lvgl_transfer(painter_device_t device, const qp_lvgl_area_t *area, const void *pixels) {
+    qp_viewport(device, area->x1, area->y1, area->x2, area->y2);
+    qp_pixdata(device, pixels, qp_lvgl_area_size(area));
+    qp_flush(device);
+}
@@ -0,0 +1,41 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include "qp.h"
+
+#ifndef QP_LVGL_MERGE_OVERHEAD
+#    define QP_LVGL_MERGE_OVERHEAD 64
+#endif
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Quantum Painter - LVGL Integration Internal API
+
+// Mirrors lv_area_t, with LVGL's default 16-bit coordinates
+typedef struct qp_lvgl_area_t {
+    int16_t x1;
+    int16_t y1;
+    int16_t x2;
+    int16_t y2;
+} qp_lvgl_area_t;
+
+/**
+ * Merges invalidated areas, so fewer, larger areas get rendered and sent to the display.
+ *
+ * Two areas are merged whenever their bounding box covers no more than both of them plus `overhead` pixels, which is
+ * what a separate transfer is reckoned to cost. Areas flagged in `joined` are skipped. The remaining areas are moved to
+ * the front of the list with their flags cleared.
+ *
+ * @param areas[in,out] the invalidated areas
+ * @param joined[in,out] per area, whether it has already been merged into another
+ * @param count[in] the number of areas
+ * @param overhead[in] the extra pixels a merge may cover
+ * @return the number of areas left
+ */
+uint16_t qp_lvgl_merge_areas(qp_lvgl_area_t *areas, uint8_t *joined, uint16_t count, uint32_t overhead);
+
+/**
+ * Sends a rendered area to the display.
+ */
+void qp_lvgl_transfer(painter_device_t device, const qp_lvgl_area_t *area, const void *pixels);
@@ -21,4 +21,5 @@ include $(LVGL_PATH)/src/misc/lv_misc.mk
 include $(LVGL_PATH)/src/widgets/lv_widgets.mk
 
 SRC += qp_lvgl.c \
+       qp_lvgl_transfer.c \
        $(CSRCS)
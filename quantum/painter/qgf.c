@@ -127,9 +127,9 @@ bool qgf_read_graphics_descriptor(qp_stream_t *stream, uint16_t *image_width, ui
     return true;
 }
 
-static bool qgf_read_frame_offset(qp_stream_t *stream, uint16_t frame_number, uint32_t *frame_offset) {
-    uint16_t frame_count;
-    if (!qgf_read_graphics_descriptor(stream, NULL, NULL, &frame_count, NULL)) {
+bool qgf_locate_frame_offsets(qp_stream_t *stream, uint32_t *frame_offsets_pos, uint16_t *frame_count) {
+    uint16_t count;
+    if (!qgf_read_graphics_descriptor(stream, NULL, NULL, &count, NULL)) {
         return false;
     }
 
@@ -141,17 +141,24 @@ static bool qgf_read_frame_offset(qp_stream_t *stream, uint16_t frame_number, ui
     }
 
     // Make sure this block is valid
-    if (!qgf_validate_block_header(&frame_offsets.header, QGF_FRAME_OFFSET_DESCRIPTOR_TYPEID, (frame_count * sizeof(uint32_t)))) {
+    if (!qgf_validate_block_header(&frame_offsets.header, QGF_FRAME_OFFSET_DESCRIPTOR_TYPEID, (count * sizeof(uint32_t)))) {
         return false;
     }
 
-    if (frame_number >= frame_count) {
-        qp_dprintf("Invalid frame number, was %d but only %d frames in image\n", (int)frame_number, (int)frame_count);
-        return false;
+    // Copy out the required info -- the stream is now positioned at the first frame offset
+    if (frame_offsets_pos) {
+        *frame_offsets_pos = qp_stream_tell(stream);
+    }
+    if (frame_count) {
+        *frame_count = count;
     }
 
-    // Skip the necessary amount of data to get to the requested frame offset
-    qp_stream_seek(stream, frame_number * sizeof(uint32_t), SEEK_CUR);
+    return true;
+}
+
+bool qgf_seek_to_frame_descriptor_via_offsets(qp_stream_t *stream, uint32_t frame_offsets_pos, uint16_t frame_number) {
+    // Jump straight to the requested entry in the frame offsets table
+    qp_stream_setpos(stream, frame_offsets_pos + frame_number * sizeof(uint32_t));
 
     // Read the frame offset
     uint32_t offset = 0;
@@ -160,21 +167,24 @@ static bool qgf_read_frame_offset(qp_stream_t *stream, uint16_t frame_number, ui
         return false;
     }
 
-    // Copy out the required info
-    if (frame_offset) {
-        *frame_offset = offset;
-    }
-
+    // Move to the offset
+    qp_stream_setpos(stream, offset);
     return true;
 }
 
 void qgf_seek_to_frame_descriptor(qp_stream_t *stream, uint16_t frame_number) {
-    // Read the offset
-    uint32_t offset = 0;
-    qgf_read_frame_offset(stream, frame_number, &offset);
+    uint32_t frame_offsets_pos;
+    uint16_t frame_count;
+    if (!qgf_locate_frame_offsets(stream, &frame_offsets_pos, &frame_count)) {
+        return;
+    }
 
-    // Move to the offset
-    qp_stream_setpos(stream, offset);
+    if (frame_number >= frame_count) {
+        qp_dprintf("Invalid frame number, was %d but only %d frames in image\n", (int)frame_number, (int)frame_count);
+        return;
+    }
+
+    qgf_seek_to_frame_descriptor_via_offsets(stream, frame_offsets_pos, frame_number);
 }
 
 bool qgf_validate_frame_descriptor(qp_stream_t *stream, uint16_t frame_number, uint8_t *bpp, bool *has_palette, bool *is_panel_native, bool *is_delta) {
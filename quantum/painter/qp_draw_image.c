@@ -13,6 +13,7 @@
 typedef struct qgf_image_handle_t {
     painter_image_desc_t base;
     bool                 validate_ok;
+    uint32_t             frame_offsets_pos;
     union {
         qp_stream_t        stream;
         qp_memory_stream_t mem_stream;
@@ -59,6 +60,12 @@ static painter_image_handle_t qp_load_image_internal(bool (*stream_factory)(qgf_
     // Fill out the QP image descriptor
     qgf_read_graphics_descriptor(&image->stream, &image->base.width, &image->base.height, &image->base.frame_count, NULL);
 
+    // Keep track of where the frame offsets live, so that rendering a frame can seek directly to it
+    if (!qgf_locate_frame_offsets(&image->stream, &image->frame_offsets_pos, NULL)) {
+        qp_dprintf("qp_load_image: fail (could not locate frame offsets)\n");
+        return NULL;
+    }
+
     // Validation success, we can return the handle
     image->validate_ok = true;
     qp_dprintf("qp_load_image: ok\n");
@@ -133,8 +140,11 @@ static bool qp_drawimage_prepare_frame_for_stream_read(painter_device_t device,
         return false;
     }
 
-    // Seek to the frame
-    qgf_seek_to_frame_descriptor(&qgf_image->stream, frame_number);
+    // Seek to the frame, indexing directly into the frame offsets table
+    if (frame_number >= qgf_image->base.frame_count || !qgf_seek_to_frame_descriptor_via_offsets(&qgf_image->stream, qgf_image->frame_offsets_pos, frame_number)) {
+        qp_dprintf("Failed to seek to frame %d\n", (int)frame_number);
+        return false;
+    }
 
     // Read the frame descriptor
     qgf_frame_v1_t frame_descriptor;
@@ -0,0 +1,204 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "autocorrect_flash.h"
+#include "flash_spi.h"
+
+/*
+ * The image is built by `qmk generate-autocorrect-flash`, see lib/python/qmk/autocorrect_flash.py for its layout.
+ * Addresses, dictionary roots included, are 3 bytes, little endian, counted from the start of the image. Each
+ * dictionary is a trie of its typos in reverse, matched from the last key typed, whose nodes are:
+ *
+ *   leaf    [0x80 | backspaces] [correction address]
+ *   chain   [0x40 | count] [count keycodes] [next node address]
+ *   branch  [count] then count times [keycode] [node address], sorted by keycode
+ *
+ * Dictionaries share identical subtrees and corrections ending other corrections, so they cost little more than one.
+ */
+#define HEADER_SIZE 8
+#define ENTRY_SIZE 16
+#define LEAF 0x80
+#define CHAIN 0x40
+#define COUNT_MASK 0x3F
+#define NO_LINE 0xFFFFFFFF
+
+static const uint8_t magic[] = {'Q', 'A', 'C', 0x01};
+
+typedef struct {
+    uint32_t line;
+    uint8_t  age;
+    uint8_t  data[AUTOCORRECT_FLASH_CACHE_LINE_SIZE];
+} cache_line_t;
+
+static cache_line_t cache[AUTOCORRECT_FLASH_CACHE_LINES];
+
+static bool     loaded;
+static uint8_t  dictionary_count;
+static uint8_t  selected;
+static bool     has_dictionary;
+static uint32_t root;
+static uint8_t  min_length;
+
+static void cache_clear(void) {
+    for (uint8_t i = 0; i < AUTOCORRECT_FLASH_CACHE_LINES; i++) {
+        cache[i].line = NO_LINE;
+        cache[i].age  = i;
+    }
+}
+
+// Makes a line the most recently used, ages stay a permutation of the line indexes
+static void cache_touch(uint8_t index) {
+    for (uint8_t i = 0; i < AUTOCORRECT_FLASH_CACHE_LINES; i++) {
+        if (cache[i].age < cache[index].age) {
+            cache[i].age++;
+        }
+    }
+    cache[index].age = 0;
+}
+
+static uint8_t read_byte(uint32_t address) {
+    uint32_t line   = address / AUTOCORRECT_FLASH_CACHE_LINE_SIZE;
+    uint8_t  offset = address % AUTOCORRECT_FLASH_CACHE_LINE_SIZE;
+    uint8_t  oldest = 0;
+    for (uint8_t i = 0; i < AUTOCORRECT_FLASH_CACHE_LINES; i++) {
+        if (cache[i].line == line) {
+            cache_touch(i);
+            return cache[i].data[offset];
+        }
+        if (cache[i].age > cache[oldest].age) {
+            oldest = i;
+        }
+    }
+
+    cache_line_t *entry = &cache[oldest];
+    if (flash_read_block(AUTOCORRECT_FLASH_ADDRESS + line * AUTOCORRECT_FLASH_CACHE_LINE_SIZE, entry->data, sizeof(entry->data)) != FLASH_STATUS_SUCCESS) {
+        entry->line = NO_LINE;
+        return 0;
+    }
+    entry->line = line;
+    cache_touch(oldest);
+    return entry->data[offset];
+}
+
+static uint32_t read_address(uint32_t address) {
+    return read_byte(address) | (uint32_t)read_byte(address + 1) << 8 | (uint32_t)read_byte(address + 2) << 16;
+}
+
+static void load(void) {
+    loaded           = true;
+    dictionary_count = 0;
+    has_dictionary   = false;
+
+    flash_init();
+    cache_clear();
+    for (uint8_t i = 0; i < sizeof(magic); i++) {
+        if (read_byte(i) != magic[i]) {
+            return;
+        }
+    }
+    dictionary_count = read_byte(4);
+    autocorrect_flash_select(0);
+}
+
+static inline void ensure_loaded(void) {
+    if (!loaded) {
+        load();
+    }
+}
+
+void autocorrect_flash_reload(void) {
+    loaded = false;
+}
+
+uint8_t autocorrect_flash_dictionary_count(void) {
+    ensure_loaded();
+    return dictionary_count;
+}
+
+bool autocorrect_flash_dictionary_name(uint8_t index, char *name) {
+    if (index >= autocorrect_flash_dictionary_count()) {
+        return false;
+    }
+    for (uint8_t i = 0; i < AUTOCORRECT_FLASH_NAME_SIZE; i++) {
+        name[i] = read_byte(HEADER_SIZE + ENTRY_SIZE * index + i);
+    }
+    name[AUTOCORRECT_FLASH_NAME_SIZE] = '\0';
+    return true;
+}
+
+bool autocorrect_flash_select(uint8_t index) {
+    if (index >= autocorrect_flash_dictionary_count()) {
+        return false;
+    }
+    uint32_t entry = HEADER_SIZE + ENTRY_SIZE * index + AUTOCORRECT_FLASH_NAME_SIZE;
+    if (read_byte(entry + 4) > AUTOCORRECT_FLASH_MAX_LENGTH || read_byte(entry + 5) > AUTOCORRECT_FLASH_MAX_CORRECTION) {
+        return false;
+    }
+    root           = read_address(entry);
+    min_length     = read_byte(entry + 3);
+    selected       = index;
+    has_dictionary = true;
+    return true;
+}
+
+uint8_t autocorrect_flash_selected(void) {
+    return selected;
+}
+
+uint8_t autocorrect_flash_min_length(void) {
+    ensure_loaded();
+    return has_dictionary ? min_length : 0xFF;
+}
+
+bool autocorrect_flash_find(const uint8_t *typed, uint8_t length, uint8_t *backspaces, char *correction) {
+    ensure_loaded();
+    if (!has_dictionary) {
+        return false;
+    }
+
+    uint32_t node = root;
+    int16_t  i    = length - 1;
+    while (i >= 0) {
+        uint8_t header = read_byte(node);
+        if (header & LEAF) {
+            return false;
+        }
+        if (header & CHAIN) {
+            uint8_t count = header & COUNT_MASK;
+            for (uint8_t j = 0; j < count; j++, i--) {
+                if (i < 0 || read_byte(node + 1 + j) != typed[i]) {
+                    return false;
+                }
+            }
+            node = read_address(node + 1 + count);
+        } else {
+            uint8_t low = 0, high = header;
+            while (low < high) {
+                uint8_t middle = (low + high) / 2;
+                if (read_byte(node + 1 + 4 * middle) < typed[i]) {
+                    low = middle + 1;
+                } else {
+                    high = middle;
+                }
+            }
+            if (low == header || read_byte(node + 1 + 4 * low) != typed[i]) {
+                return false;
+            }
+            node = read_address(node + 2 + 4 * low);
+            i--;
+        }
+
+        header = read_byte(node);
+        if (header & LEAF) {
+            uint32_t text = read_address(node + 1);
+            uint8_t  j    = 0;
+            while (j < AUTOCORRECT_FLASH_MAX_CORRECTION && (correction[j] = read_byte(text + j))) {
+                j++;
+            }
+            correction[j] = '\0';
+            *backspaces   = header & COUNT_MASK;
+            return true;
+        }
+    }
+    return false;
+}
@@ -0,0 +1,64 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <stdint.h>
+#include <stdbool.h>
+
+// Where `qmk generate-autocorrect-flash` images are written in external flash
+#ifndef AUTOCORRECT_FLASH_ADDRESS
+#    define AUTOCORRECT_FLASH_ADDRESS 0
+#endif
+
+// Longest typo and correction the selected dictionary may have, dictionaries needing more can't be selected
+#ifndef AUTOCORRECT_FLASH_MAX_LENGTH
+#    define AUTOCORRECT_FLASH_MAX_LENGTH 32
+#endif
+#ifndef AUTOCORRECT_FLASH_MAX_CORRECTION
+#    define AUTOCORRECT_FLASH_MAX_CORRECTION 32
+#endif
+
+// Flash is read through a cache of this many lines, the least recently used making way
+#ifndef AUTOCORRECT_FLASH_CACHE_LINES
+#    define AUTOCORRECT_FLASH_CACHE_LINES 4
+#endif
+#ifndef AUTOCORRECT_FLASH_CACHE_LINE_SIZE
+#    define AUTOCORRECT_FLASH_CACHE_LINE_SIZE 32
+#endif
+
+#define AUTOCORRECT_FLASH_NAME_SIZE 8
+
+/**
+ * \brief Looks for a typo ending the keycodes typed, with the selected dictionary.
+ *
+ * \param backspaces Characters to take back before typing the correction.
+ * \param correction At least AUTOCORRECT_FLASH_MAX_CORRECTION + 1 characters.
+ * \return Whether a typo was found.
+ */
+bool autocorrect_flash_find(const uint8_t *typed, uint8_t length, uint8_t *backspaces, char *correction);
+
+/**
+ * \brief Returns the shortest typo in the selected dictionary, or 0xFF without one.
+ */
+uint8_t autocorrect_flash_min_length(void);
+
+uint8_t autocorrect_flash_dictionary_count(void);
+
+/**
+ * \brief Copies the name of a dictionary into `name`, at least AUTOCORRECT_FLASH_NAME_SIZE + 1 characters.
+ */
+bool autocorrect_flash_dictionary_name(uint8_t index, char *name);
+
+/**
+ * \brief Selects the dictionary autocorrect uses. The first is selected once the image is read.
+ *
+ * \return Whether it was selected, not if it doesn't exist or needs more than the configured lengths.
+ */
+bool    autocorrect_flash_select(uint8_t index);
+uint8_t autocorrect_flash_selected(void);
+
+/**
+ * \brief Reads the image again, after writing a new one to flash.
+ */
+void autocorrect_flash_reload(void);
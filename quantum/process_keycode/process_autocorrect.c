@@ -12,7 +12,11 @@
 #include "send_string.h"
 #include "action_util.h"
 
-#if __has_include("autocorrect_data.h")
+#ifdef AUTOCORRECT_FLASH_ENABLE
+#    include "autocorrect_flash.h"
+#    define AUTOCORRECT_MAX_LENGTH AUTOCORRECT_FLASH_MAX_LENGTH
+#    define AUTOCORRECT_MIN_LENGTH autocorrect_flash_min_length()
+#elif __has_include("autocorrect_data.h")
 #    include "autocorrect_data.h"
 #else
 #    pragma message "Autocorrect is using the default library."
@@ -178,7 +182,7 @@ bool process_autocorrect_default_handler(uint16_t *keycode, keyrecord_t *record,
  * @brief handling for when autocorrection has been triggered
  *
  * @param backspaces number of characters to remove
- * @param str pointer to PROGMEM string to replace mistyped seletion with
+ * @param str pointer to PROGMEM string to replace mistyped seletion with, in RAM with AUTOCORRECT_FLASH_ENABLE
  * @param typo the wrong string that triggered a correction
  * @param correct what it would become after the changes
  * @return true apply correction
@@ -188,6 +192,88 @@ __attribute__((weak)) bool apply_autocorrect(uint8_t backspaces, const char *str
     return true;
 }
 
+#ifdef AUTOCORRECT_FLASH_ENABLE
+// Corrections are read from external flash into RAM
+#    define AUTOCORRECT_CORRECT_SIZE (AUTOCORRECT_MAX_LENGTH + AUTOCORRECT_FLASH_MAX_CORRECTION + 1)
+#    define autocorrect_strcpy strcpy
+#    define autocorrect_send_string send_string
+#else
+#    define AUTOCORRECT_CORRECT_SIZE (AUTOCORRECT_MAX_LENGTH + 10) // let's hope this is big enough
+#    define autocorrect_strcpy strcpy_P
+#    define autocorrect_send_string send_string_P
+#endif
+
+/**
+ * @brief Applies a correction once a typo is found in the buffer
+ *
+ * @param keycode the keycode that completed the typo
+ * @param backspaces number of characters to remove
+ * @param changes string to replace mistyped selection with, in PROGMEM unless read from external flash
+ * @return true Continue processing keycodes, and send to host
+ * @return false Stop processing keycodes, and don't send to host
+ */
+static bool autocorrect_apply(uint16_t keycode, uint8_t backspaces, const char *changes) {
+    /* Gather info about the typo'd word
+     *
+     * Since buffer may contain several words, delimited by spaces, we
+     * iterate from the end to find the start and length of the typo
+     */
+    char typo[AUTOCORRECT_MAX_LENGTH + 1] = {0}; // extra char for null terminator
+
+    uint8_t typo_len   = 0;
+    uint8_t typo_start = 0;
+    bool    space_last = typo_buffer[typo_buffer_size - 1] == KC_SPC;
+    for (uint8_t i = typo_buffer_size; i > 0; --i) {
+        // stop counting after finding space (unless it is the last thing)
+        if (typo_buffer[i - 1] == KC_SPC && i != typo_buffer_size) {
+            typo_start = i;
+            break;
+        }
+
+        ++typo_len;
+    }
+
+    // when detecting 'typo:', reduce the length of the string by one
+    if (space_last) {
+        --typo_len;
+    }
+
+    // convert buffer of keycodes into a string
+    for (uint8_t i = 0; i < typo_len; ++i) {
+        typo[i] = typo_buffer[typo_start + i] - KC_A + 'a';
+    }
+
+    /* Gather the corrected word
+     *
+     * A) Correction of 'typo:' -- Code takes into account
+     * an extra backspace to delete the space (which we dont copy)
+     * for this reason the offset is correct to "skip" the null terminator
+     *
+     * B) When correcting 'typo' -- Need extra offset for terminator
+     */
+    char correct[AUTOCORRECT_CORRECT_SIZE] = {0};
+
+    uint8_t offset = space_last ? backspaces : backspaces + 1;
+    strcpy(correct, typo);
+    autocorrect_strcpy(correct + typo_len - offset, changes);
+
+    if (apply_autocorrect(backspaces, changes, typo, correct)) {
+        for (uint8_t i = 0; i < backspaces; ++i) {
+            tap_code(KC_BSPC);
+        }
+        autocorrect_send_string(changes);
+    }
+
+    if (keycode == KC_SPC) {
+        typo_buffer[0]   = KC_SPC;
+        typo_buffer_size = 1;
+        return true;
+    } else {
+        typo_buffer_size = 0;
+        return false;
+    }
+}
+
 /**
  * @brief Process handler for autocorrect feature
  *
@@ -278,6 +364,14 @@ bool process_autocorrect(uint16_t keycode, keyrecord_t *record) {
         return true;
     }
 
+#ifdef AUTOCORRECT_FLASH_ENABLE
+    // Check for typo in buffer using the dictionary selected in external flash.
+    char    changes[AUTOCORRECT_FLASH_MAX_CORRECTION + 1];
+    uint8_t backspaces;
+    if (autocorrect_flash_find(typo_buffer, typo_buffer_size, &backspaces, changes)) {
+        return autocorrect_apply(keycode, backspaces + !record->event.pressed, changes);
+    }
+#else
     // Check for typo in buffer using a trie stored in `autocorrect_data`.
     uint16_t state = 0;
     uint8_t  code  = pgm_read_byte(autocorrect_data + state);
@@ -309,67 +403,9 @@ bool process_autocorrect(uint16_t keycode, keyrecord_t *record) {
         if (code & 128) { // A typo was found! Apply autocorrect.
             const uint8_t backspaces = (code & 63) + !record->event.pressed;
             const char *  changes    = (const char *)(autocorrect_data + state + 1);
-
-            /* Gather info about the typo'd word
-             *
-             * Since buffer may contain several words, delimited by spaces, we
-             * iterate from the end to find the start and length of the typo
-             */
-            char typo[AUTOCORRECT_MAX_LENGTH + 1] = {0}; // extra char for null terminator
-
-            uint8_t typo_len   = 0;
-            uint8_t typo_start = 0;
-            bool    space_last = typo_buffer[typo_buffer_size - 1] == KC_SPC;
-            for (uint8_t i = typo_buffer_size; i > 0; --i) {
-                // stop counting after finding space (unless it is the last thing)
-                if (typo_buffer[i - 1] == KC_SPC && i != typo_buffer_size) {
-                    typo_start = i;
-                    break;
-                }
-
-                ++typo_len;
-            }
-
-            // when detecting 'typo:', reduce the length of the string by one
-            if (space_last) {
-                --typo_len;
-            }
-
-            // convert buffer of keycodes into a string
-            for (uint8_t i = 0; i < typo_len; ++i) {
-                typo[i] = typo_buffer[typo_start + i] - KC_A + 'a';
-            }
-
-            /* Gather the corrected word
-             *
-             * A) Correction of 'typo:' -- Code takes into account
-             * an extra backspace to delete the space (which we dont copy)
-             * for this reason the offset is correct to "skip" the null terminator
-             *
-             * B) When correcting 'typo' -- Need extra offset for terminator
-             */
-            char correct[AUTOCORRECT_MAX_LENGTH + 10] = {0}; // let's hope this is big enough
-
-            uint8_t offset = space_last ? backspaces : backspaces + 1;
-            strcpy(correct, typo);
-            strcpy_P(correct + typo_len - offset, changes);
-
-            if (apply_autocorrect(backspaces, changes, typo, correct)) {
-                for (uint8_t i = 0; i < backspaces; ++i) {
-                    tap_code(KC_BSPC);
-                }
-                send_string_P(changes);
-            }
-
-            if (keycode == KC_SPC) {
-                typo_buffer[0]   = KC_SPC;
-                typo_buffer_size = 1;
-                return true;
-            } else {
-                typo_buffer_size = 0;
-                return false;
-            }
+            return autocorrect_apply(keycode, backspaces, changes);
         }
     }
+#endif
     return true;
 }
@@ -23,6 +23,9 @@
 #ifdef STENO_ENABLE_ALL
 #    include "eeprom.h"
 #endif
+#ifdef STENO_DICTIONARY_ENABLE
+#    include "steno_dictionary.h"
+#endif
 
 // All steno keys that have been pressed to form this chord,
 // stored in MAX_STROKE_SIZE groups of 8-bit arrays.
@@ -35,6 +38,11 @@ static uint8_t chord[MAX_STROKE_SIZE] = {0};
 // `n_pressed_keys` would be set to 2 because there are only two keys currently being pressed down.
 static int8_t n_pressed_keys = 0;
 
+#ifdef STENO_DICTIONARY_ENABLE
+// The same chord in steno order, for translating on the keyboard
+static uint32_t stroke = 0;
+#endif
+
 #ifdef STENO_ENABLE_ALL
 static steno_mode_t mode;
 #elif defined(STENO_ENABLE_GEMINI)
@@ -45,6 +53,9 @@ static const steno_mode_t mode = STENO_MODE_BOLT;
 
 static inline void steno_clear_chord(void) {
     memset(chord, 0, sizeof(chord));
+#ifdef STENO_DICTIONARY_ENABLE
+    stroke = 0;
+#endif
 }
 
 #ifdef STENO_ENABLE_GEMINI
@@ -195,6 +206,9 @@ bool process_steno(uint16_t keycode, keyrecord_t *record) {
         case STN__MIN ... STN__MAX:
             if (record->event.pressed) {
                 n_pressed_keys++;
+#ifdef STENO_DICTIONARY_ENABLE
+                stroke |= steno_dictionary_key_to_stroke(keycode - QK_STENO);
+#endif
                 switch (mode) {
 #ifdef STENO_ENABLE_BOLT
                     case STENO_MODE_BOLT:
@@ -227,6 +241,13 @@ bool process_steno(uint16_t keycode, keyrecord_t *record) {
                     steno_clear_chord();
                     return false;
                 }
+#ifdef STENO_DICTIONARY_ENABLE
+                if (steno_dictionary_is_enabled()) {
+                    steno_dictionary_translate(stroke);
+                    steno_clear_chord();
+                    return false;
+                }
+#endif
                 switch (mode) {
 #if defined(STENO_ENABLE_BOLT) && defined(VIRTSER_ENABLE)
                     case STENO_MODE_BOLT:
@@ -22,8 +22,36 @@
 #include "timer.h"
 #include "wait.h"
 
-static uint16_t active_td;
-static uint16_t last_tap_time;
+/* Dances which are still waiting for more taps, the oldest first, so that they finish in the order they were
+ * started. A dance started while all are waiting finishes the oldest, with a single one being the classic behavior
+ * of every other key press finishing the dance. */
+typedef struct {
+    uint16_t keycode;
+    uint16_t last_tap_time;
+} active_tap_dance_t;
+
+static active_tap_dance_t active_tds[TAP_DANCE_MAX_CONCURRENT];
+static uint8_t            active_td_count;
+
+static int8_t active_td_find(uint16_t keycode) {
+    for (uint8_t i = 0; i < active_td_count; i++) {
+        if (active_tds[i].keycode == keycode) {
+            return i;
+        }
+    }
+    return -1;
+}
+
+static void active_td_remove(uint16_t keycode) {
+    int8_t index = active_td_find(keycode);
+    if (index < 0) {
+        return;
+    }
+    active_td_count--;
+    for (uint8_t i = index; i < active_td_count; i++) {
+        active_tds[i] = active_tds[i + 1];
+    }
+}
 
 void tap_dance_pair_on_each_tap(tap_dance_state_t *state, void *user_data) {
     tap_dance_pair_t *pair = (tap_dance_pair_t *)user_data;
@@ -119,24 +147,33 @@ static inline void process_tap_dance_action_on_dance_finished(tap_dance_action_t
         send_keyboard_report();
         _process_tap_dance_action_fn(&action->state, action->user_data, action->fn.on_dance_finished);
     }
-    active_td = 0;
+    active_td_remove(TAP_DANCE_KEYCODE(&action->state));
     if (!action->state.pressed) {
         // There will not be a key release event, so reset now.
         process_tap_dance_action_on_reset(action);
     }
 }
 
-bool preprocess_tap_dance(uint16_t keycode, keyrecord_t *record) {
-    tap_dance_action_t *action;
+static void process_tap_dance_action_interrupted(tap_dance_action_t *action, uint16_t keycode) {
+    action->state.interrupted          = true;
+    action->state.interrupting_keycode = keycode;
+    process_tap_dance_action_on_dance_finished(action);
+}
 
+bool preprocess_tap_dance(uint16_t keycode, keyrecord_t *record) {
     if (!record->event.pressed) return false;
 
-    if (!active_td || keycode == active_td) return false;
+    if (!active_td_count || active_td_find(keycode) >= 0) return false;
 
-    action                             = &tap_dance_actions[TD_INDEX(active_td)];
-    action->state.interrupted          = true;
-    action->state.interrupting_keycode = keycode;
-    process_tap_dance_action_on_dance_finished(action);
+    if (IS_QK_TAP_DANCE(keycode)) {
+        // Another dance starts, which only finishes the oldest if there's no room left for it
+        if (active_td_count < TAP_DANCE_MAX_CONCURRENT) return false;
+        process_tap_dance_action_interrupted(&tap_dance_actions[TD_INDEX(active_tds[0].keycode)], keycode);
+    } else {
+        while (active_td_count) {
+            process_tap_dance_action_interrupted(&tap_dance_actions[TD_INDEX(active_tds[0].keycode)], keycode);
+        }
+    }
 
     // Tap dance actions can leave some weak mods active (e.g., if the tap dance is mapped to a keycode with
     // modifiers), but these weak mods should not affect the keypress which interrupted the tap dance.
@@ -158,16 +195,24 @@ bool process_tap_dance(uint16_t keycode, keyrecord_t *record) {
 
             action->state.pressed = record->event.pressed;
             if (record->event.pressed) {
-                last_tap_time = timer_read();
                 process_tap_dance_action_on_each_tap(action);
-                active_td = action->state.finished ? 0 : keycode;
+                if (action->state.finished) {
+                    active_td_remove(keycode);
+                } else {
+                    int8_t index = active_td_find(keycode);
+                    if (index < 0 && active_td_count < TAP_DANCE_MAX_CONCURRENT) {
+                        index                      = active_td_count++;
+                        active_tds[index].keycode = keycode;
+                    }
+                    if (index >= 0) {
+                        active_tds[index].last_tap_time = timer_read();
+                    }
+                }
             } else {
                 process_tap_dance_action_on_each_release(action);
                 if (action->state.finished) {
                     process_tap_dance_action_on_reset(action);
-                    if (active_td == keycode) {
-                        active_td = 0;
-                    }
+                    active_td_remove(keycode);
                 }
             }
 
@@ -178,17 +223,25 @@ bool process_tap_dance(uint16_t keycode, keyrecord_t *record) {
 }
 
 void tap_dance_task(void) {
-    tap_dance_action_t *action;
-
-    if (!active_td || timer_elapsed(last_tap_time) <= GET_TAPPING_TERM(active_td, &(keyrecord_t){})) return;
+    // A dance timing out finishes those started before it first, in case their tapping terms are longer
+    int8_t last_expired = -1;
+    for (uint8_t i = 0; i < active_td_count; i++) {
+        if (timer_elapsed(active_tds[i].last_tap_time) > GET_TAPPING_TERM(active_tds[i].keycode, &(keyrecord_t){})) {
+            last_expired = i;
+        }
+    }
 
-    action = &tap_dance_actions[TD_INDEX(active_td)];
-    if (!action->state.interrupted) {
-        process_tap_dance_action_on_dance_finished(action);
+    for (; last_expired >= 0 && active_td_count; last_expired--) {
+        tap_dance_action_t *action = &tap_dance_actions[TD_INDEX(active_tds[0].keycode)];
+        if (action->state.interrupted) {
+            active_td_remove(active_tds[0].keycode);
+        } else {
+            process_tap_dance_action_on_dance_finished(action);
+        }
     }
 }
 
 void reset_tap_dance(tap_dance_state_t *state) {
-    active_td = 0;
+    active_td_remove(TAP_DANCE_KEYCODE(state));
     process_tap_dance_action_on_reset((tap_dance_action_t *)state);
 }
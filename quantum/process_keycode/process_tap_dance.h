@@ -20,6 +20,11 @@
 #include <stdbool.h>
 #include "action.h"
 
+// How many dances may wait for more taps at once, rather than the next one finishing the last
+#ifndef TAP_DANCE_MAX_CONCURRENT
+#    define TAP_DANCE_MAX_CONCURRENT 1
+#endif
+
 typedef struct {
     uint16_t interrupting_keycode;
     uint8_t  count;
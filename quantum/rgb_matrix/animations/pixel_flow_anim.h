@@ -18,7 +18,7 @@ static bool PIXEL_FLOW(effect_params_t* params) {
         return 3000 / scale16by8(qadd8(rgb_matrix_config.speed, 16), 16);
     }
 
-    if (params->init) {
+    if (params->init && params->iter == 0) {
         // Clear LEDs and fill the state array
         rgb_matrix_set_color_all(0, 0, 0);
         for (uint8_t j = 0; j < RGB_MATRIX_LED_COUNT; ++j) {
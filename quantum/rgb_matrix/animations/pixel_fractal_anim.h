@@ -19,7 +19,7 @@ static bool PIXEL_FRACTAL(effect_params_t* params) {
         return 3000 / scale16by8(qadd8(rgb_matrix_config.speed, 16), 16);
     }
 
-    if (params->init) {
+    if (params->init && params->iter == 0) {
         rgb_matrix_set_color_all(0, 0, 0);
     }
 
@@ -22,8 +22,9 @@ static void raindrops_set_color(int i, effect_params_t* params) {
 bool RAINDROPS(effect_params_t* params) {
     RGB_MATRIX_USE_LIMITS(led_min, led_max);
     if (!params->init) {
-        // Change one LED every tick, make sure speed is not 0
-        if (scale16by8(g_rgb_timer, qadd8(rgb_matrix_config.speed, 16)) % 10 == 0) {
+        // Change one LED every tick, make sure speed is not 0. Only on the first iteration, so that a frame split
+        // into several iterations still changes a single LED
+        if (params->iter == 0 && scale16by8(g_rgb_timer, qadd8(rgb_matrix_config.speed, 16)) % 10 == 0) {
             raindrops_set_color(random8_max(RGB_MATRIX_LED_COUNT), params);
         }
     } else {
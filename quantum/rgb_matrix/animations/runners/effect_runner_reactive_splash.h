@@ -4,20 +4,73 @@
 
 typedef HSV (*reactive_splash_f)(HSV hsv, int16_t dx, int16_t dy, uint8_t dist, uint16_t tick);
 
-bool effect_runner_reactive_splash(uint8_t start, effect_params_t* params, reactive_splash_f effect_func) {
+#    ifdef RGB_MATRIX_SPLASH_DISTANCE_CACHE
+// Distances from the LEDs of recent hits to every other LED, computed once per hit instead of once per frame
+static uint8_t reactive_splash_distance[LED_HITS_TO_REMEMBER][RGB_MATRIX_LED_COUNT];
+static uint8_t reactive_splash_distance_led[LED_HITS_TO_REMEMBER] = {[0 ... LED_HITS_TO_REMEMBER - 1] = NO_LED};
+
+static inline bool reactive_splash_distance_in_use(uint8_t row) {
+    for (uint8_t j = 0; j < g_last_hit_tracker.count; j++) {
+        if (g_last_hit_tracker.index[j] == reactive_splash_distance_led[row]) return true;
+    }
+    return false;
+}
+
+static inline const uint8_t* reactive_splash_distances(uint8_t led) {
+    uint8_t row = 0;
+    for (uint8_t r = 0; r < LED_HITS_TO_REMEMBER; r++) {
+        if (reactive_splash_distance_led[r] == led) return reactive_splash_distance[r];
+    }
+    // There are as many rows as remembered hits, so at least one of them isn't used by the current hits
+    while (row < LED_HITS_TO_REMEMBER - 1 && reactive_splash_distance_in_use(row)) {
+        row++;
+    }
+    for (uint8_t i = 0; i < RGB_MATRIX_LED_COUNT; i++) {
+        int16_t dx                       = g_led_config.point[i].x - g_led_config.point[led].x;
+        int16_t dy                       = g_led_config.point[i].y - g_led_config.point[led].y;
+        reactive_splash_distance[row][i] = sqrt16(dx * dx + dy * dy);
+    }
+    reactive_splash_distance_led[row] = led;
+    return reactive_splash_distance[row];
+}
+#    endif // RGB_MATRIX_SPLASH_DISTANCE_CACHE
+
+/**
+ * Runs `effect_func` for every LED and every hit from `start` on, skipping the oldest hits whose scaled tick is above
+ * `tick_limit`: the last tick at which `effect_func` can still change an LED, once its ripple has passed all of them.
+ */
+bool effect_runner_reactive_splash_limit(uint8_t start, effect_params_t* params, reactive_splash_f effect_func, uint16_t tick_limit) {
     RGB_MATRIX_USE_LIMITS(led_min, led_max);
 
-    uint8_t count = g_last_hit_tracker.count;
+    uint8_t  count = g_last_hit_tracker.count;
+    uint16_t ticks[LED_HITS_TO_REMEMBER];
+    for (uint8_t j = start; j < count; j++) {
+        ticks[j] = scale16by8(g_last_hit_tracker.tick[j], qadd8(rgb_matrix_config.speed, 1));
+    }
+    // Hits are ordered from oldest to newest
+    while (start < count && ticks[start] > tick_limit) {
+        start++;
+    }
+#    ifdef RGB_MATRIX_SPLASH_DISTANCE_CACHE
+    const uint8_t* distances[LED_HITS_TO_REMEMBER];
+    for (uint8_t j = start; j < count; j++) {
+        distances[j] = reactive_splash_distances(g_last_hit_tracker.index[j]);
+    }
+#    endif
+
     for (uint8_t i = led_min; i < led_max; i++) {
         RGB_MATRIX_TEST_LED_FLAGS();
         HSV hsv = rgb_matrix_config.hsv;
         hsv.v   = 0;
         for (uint8_t j = start; j < count; j++) {
-            int16_t  dx   = g_led_config.point[i].x - g_last_hit_tracker.x[j];
-            int16_t  dy   = g_led_config.point[i].y - g_last_hit_tracker.y[j];
-            uint8_t  dist = sqrt16(dx * dx + dy * dy);
-            uint16_t tick = scale16by8(g_last_hit_tracker.tick[j], qadd8(rgb_matrix_config.speed, 1));
-            hsv           = effect_func(hsv, dx, dy, dist, tick);
+            int16_t dx = g_led_config.point[i].x - g_last_hit_tracker.x[j];
+            int16_t dy = g_led_config.point[i].y - g_last_hit_tracker.y[j];
+#    ifdef RGB_MATRIX_SPLASH_DISTANCE_CACHE
+            uint8_t dist = distances[j][i];
+#    else
+            uint8_t dist = sqrt16(dx * dx + dy * dy);
+#    endif
+            hsv = effect_func(hsv, dx, dy, dist, ticks[j]);
         }
         hsv.v   = scale8(hsv.v, rgb_matrix_config.hsv.v);
         RGB rgb = rgb_matrix_hsv_to_rgb(hsv);
@@ -26,4 +79,8 @@ bool effect_runner_reactive_splash(uint8_t start, effect_params_t* params, react
     return rgb_matrix_check_finished_leds(led_max);
 }
 
+bool effect_runner_reactive_splash(uint8_t start, effect_params_t* params, reactive_splash_f effect_func) {
+    return effect_runner_reactive_splash_limit(start, params, effect_func, UINT16_MAX);
+}
+
 #endif // RGB_MATRIX_KEYREACTIVE_ENABLED
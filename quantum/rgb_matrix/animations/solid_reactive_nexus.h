@@ -11,6 +11,7 @@ RGB_MATRIX_EFFECT(SOLID_REACTIVE_MULTINEXUS)
 
 #        ifdef RGB_MATRIX_CUSTOM_EFFECT_IMPLS
 
+// Only LEDs within a distance of 72 light up, so hits are done once tick passes 254 + 72
 static HSV SOLID_REACTIVE_NEXUS_math(HSV hsv, int16_t dx, int16_t dy, uint8_t dist, uint16_t tick) {
     uint16_t effect = tick - dist;
     if (effect > 255) effect = 255;
@@ -27,13 +28,13 @@ static HSV SOLID_REACTIVE_NEXUS_math(HSV hsv, int16_t dx, int16_t dy, uint8_t di
 
 #            ifdef ENABLE_RGB_MATRIX_SOLID_REACTIVE_NEXUS
 bool SOLID_REACTIVE_NEXUS(effect_params_t* params) {
-    return effect_runner_reactive_splash(qsub8(g_last_hit_tracker.count, 1), params, &SOLID_REACTIVE_NEXUS_math);
+    return effect_runner_reactive_splash_limit(qsub8(g_last_hit_tracker.count, 1), params, &SOLID_REACTIVE_NEXUS_math, 326);
 }
 #            endif
 
 #            ifdef ENABLE_RGB_MATRIX_SOLID_REACTIVE_MULTINEXUS
 bool SOLID_REACTIVE_MULTINEXUS(effect_params_t* params) {
-    return effect_runner_reactive_splash(0, params, &SOLID_REACTIVE_NEXUS_math);
+    return effect_runner_reactive_splash_limit(0, params, &SOLID_REACTIVE_NEXUS_math, 326);
 }
 #            endif
 
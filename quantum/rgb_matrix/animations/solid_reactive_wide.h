@@ -11,6 +11,7 @@ RGB_MATRIX_EFFECT(SOLID_REACTIVE_MULTIWIDE)
 
 #        ifdef RGB_MATRIX_CUSTOM_EFFECT_IMPLS
 
+// The effect never drops below tick, so hits are done once tick passes 254
 static HSV SOLID_REACTIVE_WIDE_math(HSV hsv, int16_t dx, int16_t dy, uint8_t dist, uint16_t tick) {
     uint16_t effect = tick + dist * 5;
     if (effect > 255) effect = 255;
@@ -23,13 +24,13 @@ static HSV SOLID_REACTIVE_WIDE_math(HSV hsv, int16_t dx, int16_t dy, uint8_t dis
 
 #            ifdef ENABLE_RGB_MATRIX_SOLID_REACTIVE_WIDE
 bool SOLID_REACTIVE_WIDE(effect_params_t* params) {
-    return effect_runner_reactive_splash(qsub8(g_last_hit_tracker.count, 1), params, &SOLID_REACTIVE_WIDE_math);
+    return effect_runner_reactive_splash_limit(qsub8(g_last_hit_tracker.count, 1), params, &SOLID_REACTIVE_WIDE_math, 254);
 }
 #            endif
 
 #            ifdef ENABLE_RGB_MATRIX_SOLID_REACTIVE_MULTIWIDE
 bool SOLID_REACTIVE_MULTIWIDE(effect_params_t* params) {
-    return effect_runner_reactive_splash(0, params, &SOLID_REACTIVE_WIDE_math);
+    return effect_runner_reactive_splash_limit(0, params, &SOLID_REACTIVE_WIDE_math, 254);
 }
 #            endif
 
@@ -11,6 +11,7 @@ RGB_MATRIX_EFFECT(MULTISPLASH)
 
 #        ifdef RGB_MATRIX_CUSTOM_EFFECT_IMPLS
 
+// Hits light up no LED once tick passes 254 + the largest possible distance of 255
 HSV SPLASH_math(HSV hsv, int16_t dx, int16_t dy, uint8_t dist, uint16_t tick) {
     uint16_t effect = tick - dist;
     if (effect > 255) effect = 255;
@@ -21,13 +22,13 @@ HSV SPLASH_math(HSV hsv, int16_t dx, int16_t dy, uint8_t dist, uint16_t tick) {
 
 #            ifdef ENABLE_RGB_MATRIX_SPLASH
 bool SPLASH(effect_params_t* params) {
-    return effect_runner_reactive_splash(qsub8(g_last_hit_tracker.count, 1), params, &SPLASH_math);
+    return effect_runner_reactive_splash_limit(qsub8(g_last_hit_tracker.count, 1), params, &SPLASH_math, 509);
 }
 #            endif
 
 #            ifdef ENABLE_RGB_MATRIX_MULTISPLASH
 bool MULTISPLASH(effect_params_t* params) {
-    return effect_runner_reactive_splash(0, params, &SPLASH_math);
+    return effect_runner_reactive_splash_limit(0, params, &SPLASH_math, 509);
 }
 #            endif
 
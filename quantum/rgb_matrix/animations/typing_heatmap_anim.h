@@ -56,7 +56,7 @@ static bool decrease_heatmap_values;
 bool TYPING_HEATMAP(effect_params_t* params) {
     RGB_MATRIX_USE_LIMITS(led_min, led_max);
 
-    if (params->init) {
+    if (params->init && params->iter == 0) {
         rgb_matrix_set_color_all(0, 0, 0);
         memset(g_rgb_frame_buffer, 0, sizeof g_rgb_frame_buffer);
     }
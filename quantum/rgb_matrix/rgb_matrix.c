@@ -29,6 +29,10 @@
 
 #include <lib/lib8tion/lib8tion.h>
 
+#if defined(RGB_MATRIX_FRAME_PACING) && defined(PROTOCOL_CHIBIOS)
+#    include <ch.h>
+#endif
+
 #ifndef RGB_MATRIX_CENTER
 const led_point_t k_rgb_matrix_center = {112, 32};
 #else
@@ -80,6 +84,23 @@ static rgb_task_states rgb_task_state    = SYNCING;
 static uint32_t rgb_anykey_timer;
 #endif // RGB_MATRIX_TIMEOUT > 0
 
+#ifdef RGB_MATRIX_FRAME_PACING
+static struct {
+    uint8_t  process_limit;   // LEDs rendered per iteration in the current frame
+    uint16_t led_cost;        // average render time per LED, in 1/16 us
+    uint32_t frame_render_us; // time spent rendering the current frame
+    uint16_t frame_leds;      // LEDs rendered in the current frame
+    uint32_t flush_us;        // time taken by the last flush
+    uint32_t last_return_us;  // when rgb_matrix_task() last returned
+    uint32_t yield_timer;     // when rgb_matrix_task() started yielding to a busy main loop
+    bool     yielding;
+    bool     frame_yielded; // the current frame already yielded once, render the rest of it
+    uint16_t frames;        // frames flushed since fps_timer
+    uint16_t fps;
+    uint32_t fps_timer;
+} rgb_pacing = {.process_limit = RGB_MATRIX_LED_PROCESS_LIMIT};
+#endif // RGB_MATRIX_FRAME_PACING
+
 // double buffers
 static uint32_t rgb_timer_buffer;
 #ifdef RGB_MATRIX_KEYREACTIVE_ENABLED
@@ -90,6 +111,18 @@ static last_hit_t last_hit_buffer;
 #if defined(RGB_MATRIX_ENABLE) && defined(RGB_MATRIX_SPLIT)
 const uint8_t k_rgb_matrix_split[2] = RGB_MATRIX_SPLIT;
 #endif
+#if defined(RGB_MATRIX_SPLIT) && defined(SPLIT_RGB_MATRIX_HITS_ENABLE)
+// Most recent switch events, on the master. rgb_split_hits_seq counts the events on both halves
+static rgb_matrix_split_hit_t rgb_split_hits[SPLIT_RGB_MATRIX_HITS_MAX];
+static uint8_t                rgb_split_hits_head;
+static uint8_t                rgb_split_hits_count;
+static uint8_t                rgb_split_hits_seq;
+static uint8_t                rgb_split_hits_sent_seq;
+static bool                   rgb_split_hits_synced;
+
+// How far ahead of the slave's timer update a hit may be, as the halves don't update their timers in step
+#    define RGB_SPLIT_HITS_MAX_SKEW 1000
+#endif // defined(RGB_MATRIX_SPLIT) && defined(SPLIT_RGB_MATRIX_HITS_ENABLE)
 
 EECONFIG_DEBOUNCE_HELPER(rgb_matrix, EECONFIG_RGB_MATRIX, rgb_matrix_config);
 
@@ -159,10 +192,8 @@ void rgb_matrix_set_color_all(uint8_t red, uint8_t green, uint8_t blue) {
 #endif
 }
 
-void process_rgb_matrix(uint8_t row, uint8_t col, bool pressed) {
-#ifndef RGB_MATRIX_SPLIT
-    if (!is_keyboard_master()) return;
-#endif
+// Records a switch event for the effects, `tick` ms after the last update of the double buffer timers
+static void rgb_matrix_process_switch(uint8_t row, uint8_t col, bool pressed, uint16_t tick) {
 #if RGB_MATRIX_TIMEOUT > 0
     rgb_anykey_timer = 0;
 #endif // RGB_MATRIX_TIMEOUT > 0
@@ -193,9 +224,11 @@ void process_rgb_matrix(uint8_t row, uint8_t col, bool pressed) {
         last_hit_buffer.x[index]     = g_led_config.point[led[i]].x;
         last_hit_buffer.y[index]     = g_led_config.point[led[i]].y;
         last_hit_buffer.index[index] = led[i];
-        last_hit_buffer.tick[index]  = 0;
+        last_hit_buffer.tick[index]  = tick;
         last_hit_buffer.count++;
     }
+#else
+    (void)tick;
 #endif // RGB_MATRIX_KEYREACTIVE_ENABLED
 
 #if defined(RGB_MATRIX_FRAMEBUFFER_EFFECTS) && defined(ENABLE_RGB_MATRIX_TYPING_HEATMAP)
@@ -212,6 +245,69 @@ void process_rgb_matrix(uint8_t row, uint8_t col, bool pressed) {
 #endif // defined(RGB_MATRIX_FRAMEBUFFER_EFFECTS) && defined(ENABLE_RGB_MATRIX_TYPING_HEATMAP)
 }
 
+void process_rgb_matrix(uint8_t row, uint8_t col, bool pressed) {
+#ifndef RGB_MATRIX_SPLIT
+    if (!is_keyboard_master()) return;
+#endif
+#if defined(RGB_MATRIX_SPLIT) && defined(SPLIT_RGB_MATRIX_HITS_ENABLE)
+    // The master sees the switches of both halves, and sends them to the slave along with when they were pressed
+    if (!is_keyboard_master()) return;
+    rgb_split_hits[rgb_split_hits_head] = (rgb_matrix_split_hit_t){.row = row, .col = col, .pressed = pressed, .time = rgb_timer_buffer};
+    rgb_split_hits_head                 = (rgb_split_hits_head + 1) % SPLIT_RGB_MATRIX_HITS_MAX;
+    if (rgb_split_hits_count < SPLIT_RGB_MATRIX_HITS_MAX) rgb_split_hits_count++;
+    rgb_split_hits_seq++;
+#endif
+    rgb_matrix_process_switch(row, col, pressed, 0);
+}
+
+#if defined(RGB_MATRIX_SPLIT) && defined(SPLIT_RGB_MATRIX_HITS_ENABLE)
+bool rgb_matrix_split_hits_pending(rgb_matrix_split_hits_t *hits) {
+    if (rgb_split_hits_seq == rgb_split_hits_sent_seq) {
+        return false;
+    }
+    // Always send the whole window, so events can be recovered if the slave missed the previous transaction
+    hits->seq   = rgb_split_hits_seq;
+    hits->count = rgb_split_hits_count;
+    for (uint8_t i = 0; i < rgb_split_hits_count; i++) {
+        hits->hits[i] = rgb_split_hits[(rgb_split_hits_head + SPLIT_RGB_MATRIX_HITS_MAX - rgb_split_hits_count + i) % SPLIT_RGB_MATRIX_HITS_MAX];
+    }
+    return true;
+}
+
+void rgb_matrix_split_hits_sent(const rgb_matrix_split_hits_t *hits) {
+    rgb_split_hits_sent_seq = hits->seq;
+}
+
+void rgb_matrix_split_hits_apply(const rgb_matrix_split_hits_t *hits) {
+    if (hits->count == 0) {
+        // Nothing received from the master yet
+        return;
+    }
+    uint8_t new_hits = hits->seq - rgb_split_hits_seq;
+    if (!rgb_split_hits_synced || (int8_t)new_hits < 0) {
+        // Either half restarted, so the window can't be matched up with what was already applied. Only a master which
+        // restarted too sends nothing but events since then, any other window is taken as already seen.
+        new_hits              = hits->seq == hits->count ? hits->count : 0;
+        rgb_split_hits_synced = true;
+    }
+    if (new_hits > hits->count) new_hits = hits->count;
+    for (uint8_t i = hits->count - new_hits; i < hits->count; i++) {
+        const rgb_matrix_split_hit_t *hit = &hits->hits[i];
+        // Count from the same timer update as the master, which the sync timer makes the same time on both halves
+        uint16_t tick = (uint16_t)rgb_timer_buffer - hit->time;
+        if (tick > UINT16_MAX - RGB_SPLIT_HITS_MAX_SKEW) {
+            // Updated the timer just before the master did
+            tick = 0;
+        } else if (tick >= UINT16_MAX / 2) {
+            // Too old to tell from a wrapped timestamp, and long expired either way
+            tick = UINT16_MAX;
+        }
+        rgb_matrix_process_switch(hit->row, hit->col, hit->pressed, tick);
+    }
+    rgb_split_hits_seq = hits->seq;
+}
+#endif // defined(RGB_MATRIX_SPLIT) && defined(SPLIT_RGB_MATRIX_HITS_ENABLE)
+
 void rgb_matrix_test(void) {
     // Mask out bits 4 and 5
     // Increase the factor to make the test animation slower (and reduce to make it faster)
@@ -277,9 +373,72 @@ static void rgb_task_sync(void) {
     if (sync_timer_elapsed32(g_rgb_timer) >= RGB_MATRIX_LED_FLUSH_LIMIT) rgb_task_state = STARTING;
 }
 
+uint32_t rgb_matrix_next_frame_ms(void) {
+    // Frames are rendered over several calls to rgb_matrix_task(), the next one starts once the flush limit has passed
+    if (rgb_task_state != SYNCING) return 0;
+    uint32_t elapsed = sync_timer_elapsed32(g_rgb_timer);
+    return elapsed >= RGB_MATRIX_LED_FLUSH_LIMIT ? 0 : RGB_MATRIX_LED_FLUSH_LIMIT - elapsed;
+}
+
+#ifdef RGB_MATRIX_FRAME_PACING
+// Returns 0 without a microsecond clock, which leaves the pacing at RGB_MATRIX_LED_PROCESS_LIMIT and never yields
+__attribute__((weak)) uint32_t rgb_matrix_pacing_timer_us(void) {
+#    if defined(PROTOCOL_CHIBIOS) && CH_CFG_ST_RESOLUTION == 32
+    return TIME_I2US(chVTGetSystemTimeX());
+#    else
+    return 0;
+#    endif
+}
+
+static void rgb_pacing_size_frame(void) {
+    // Per LED cost of the last frame, averaged over a few frames so that a single slow iteration doesn't halve the frame rate
+    if (rgb_pacing.frame_leds) {
+        uint32_t cost = rgb_pacing.frame_render_us * 16 / rgb_pacing.frame_leds;
+        if (cost > UINT16_MAX) cost = UINT16_MAX;
+        rgb_pacing.led_cost = rgb_pacing.led_cost ? (rgb_pacing.led_cost * 3 + cost) / 4 : cost;
+    }
+    rgb_pacing.frame_render_us = 0;
+    rgb_pacing.frame_leds      = 0;
+
+    // Without a measured cost, e.g. no microsecond clock, render as many LEDs as without pacing
+    uint32_t limit = rgb_pacing.led_cost ? (uint32_t)RGB_MATRIX_ITERATION_BUDGET_US * 16 / rgb_pacing.led_cost : RGB_MATRIX_LED_PROCESS_LIMIT;
+    if (limit < 1) limit = 1;
+    if (limit > RGB_MATRIX_LED_COUNT) limit = RGB_MATRIX_LED_COUNT;
+    rgb_pacing.process_limit = limit;
+}
+
+/* Returns true if this iteration should be skipped, because the rest of the main loop already took longer than the
+ * budget. Frames are dropped instead of delaying the matrix scan further, but only for one frame interval at a time.
+ * Once that interval is over the rest of the frame is rendered without yielding again, so the LEDs keep updating at
+ * no less than half the frame rate under sustained load, or when a coarse microsecond timer makes every iteration look
+ * over budget. */
+static bool rgb_pacing_yield(uint32_t now_us) {
+    if (rgb_pacing.frame_yielded || now_us - rgb_pacing.last_return_us <= RGB_MATRIX_ITERATION_BUDGET_US) {
+        rgb_pacing.yielding = false;
+        return false;
+    }
+    if (!rgb_pacing.yielding) {
+        rgb_pacing.yielding    = true;
+        rgb_pacing.yield_timer = sync_timer_read32();
+    } else if (sync_timer_elapsed32(rgb_pacing.yield_timer) >= RGB_MATRIX_LED_FLUSH_LIMIT) {
+        rgb_pacing.yielding      = false;
+        rgb_pacing.frame_yielded = true;
+        return false;
+    }
+    return true;
+}
+
+uint16_t rgb_matrix_get_fps(void) {
+    return rgb_pacing.fps;
+}
+#endif // RGB_MATRIX_FRAME_PACING
+
 static void rgb_task_start(void) {
     // reset iter
     rgb_effect_params.iter = 0;
+#ifdef RGB_MATRIX_FRAME_PACING
+    rgb_pacing_size_frame();
+#endif
 
     // update double buffers
     g_rgb_timer = rgb_timer_buffer;
@@ -358,6 +517,10 @@ static void rgb_task_flush(uint8_t effect) {
 
     // update pwm buffers
     rgb_matrix_update_pwm_buffers();
+#ifdef RGB_MATRIX_FRAME_PACING
+    rgb_pacing.frames++;
+    rgb_pacing.frame_yielded = false;
+#endif
 
     // next task
     rgb_task_state = SYNCING;
@@ -376,11 +539,29 @@ void rgb_matrix_task(void) {
 
     uint8_t effect = suspend_backlight || !rgb_matrix_config.enable ? 0 : rgb_matrix_config.mode;
 
+#ifdef RGB_MATRIX_FRAME_PACING
+    if (sync_timer_elapsed32(rgb_pacing.fps_timer) >= 1000) {
+        rgb_pacing.fps       = (uint32_t)rgb_pacing.frames * 1000 / sync_timer_elapsed32(rgb_pacing.fps_timer);
+        rgb_pacing.frames    = 0;
+        rgb_pacing.fps_timer = sync_timer_read32();
+    }
+
+    // Waiting for the next frame is cheap, only the work of a frame is worth yielding
+    uint32_t start_us = rgb_matrix_pacing_timer_us();
+    if (rgb_task_state != SYNCING && rgb_pacing_yield(start_us)) {
+        rgb_pacing.last_return_us = rgb_matrix_pacing_timer_us();
+        return;
+    }
+#endif // RGB_MATRIX_FRAME_PACING
+
     switch (rgb_task_state) {
         case STARTING:
             rgb_task_start();
             break;
-        case RENDERING:
+        case RENDERING: {
+#ifdef RGB_MATRIX_FRAME_PACING
+            struct rgb_matrix_limits_t limits = rgb_matrix_get_limits(rgb_effect_params.iter);
+#endif
             rgb_task_render(effect);
             if (effect) {
                 if (rgb_task_state == FLUSHING) { // ensure we only draw basic indicators once rendering is finished
@@ -388,14 +569,34 @@ void rgb_matrix_task(void) {
                 }
                 rgb_matrix_indicators_advanced(&rgb_effect_params);
             }
+#ifdef RGB_MATRIX_FRAME_PACING
+            uint32_t render_us = rgb_matrix_pacing_timer_us() - start_us;
+            rgb_pacing.frame_render_us += render_us;
+            if (limits.led_max_index > limits.led_min_index) {
+                rgb_pacing.frame_leds += limits.led_max_index - limits.led_min_index;
+            }
+            // Save an iteration if the last chunk left enough of the budget for the flush
+            if (rgb_task_state == FLUSHING && render_us + rgb_pacing.flush_us <= RGB_MATRIX_ITERATION_BUDGET_US) {
+                uint32_t flush_start_us = rgb_matrix_pacing_timer_us();
+                rgb_task_flush(effect);
+                rgb_pacing.flush_us = rgb_matrix_pacing_timer_us() - flush_start_us;
+            }
+#endif
             break;
+        }
         case FLUSHING:
             rgb_task_flush(effect);
+#ifdef RGB_MATRIX_FRAME_PACING
+            rgb_pacing.flush_us = rgb_matrix_pacing_timer_us() - start_us;
+#endif
             break;
         case SYNCING:
             rgb_task_sync();
             break;
     }
+#ifdef RGB_MATRIX_FRAME_PACING
+    rgb_pacing.last_return_us = rgb_matrix_pacing_timer_us();
+#endif
 }
 
 void rgb_matrix_indicators(void) {
@@ -412,7 +613,18 @@ __attribute__((weak)) bool rgb_matrix_indicators_user(void) {
 
 struct rgb_matrix_limits_t rgb_matrix_get_limits(uint8_t iter) {
     struct rgb_matrix_limits_t limits = {0};
-#if defined(RGB_MATRIX_LED_PROCESS_LIMIT) && RGB_MATRIX_LED_PROCESS_LIMIT > 0 && RGB_MATRIX_LED_PROCESS_LIMIT < RGB_MATRIX_LED_COUNT
+#if defined(RGB_MATRIX_FRAME_PACING)
+    // The number of LEDs per iteration only changes between frames
+    uint16_t led_min = (uint16_t)rgb_pacing.process_limit * iter;
+    uint16_t led_max = led_min + rgb_pacing.process_limit;
+    limits.led_min_index = led_min > RGB_MATRIX_LED_COUNT ? RGB_MATRIX_LED_COUNT : led_min;
+    limits.led_max_index = led_max > RGB_MATRIX_LED_COUNT ? RGB_MATRIX_LED_COUNT : led_max;
+#    if defined(RGB_MATRIX_SPLIT)
+    uint8_t k_rgb_matrix_split[2] = RGB_MATRIX_SPLIT;
+    if (is_keyboard_left() && (limits.led_max_index > k_rgb_matrix_split[0])) limits.led_max_index = k_rgb_matrix_split[0];
+    if (!(is_keyboard_left()) && (limits.led_min_index < k_rgb_matrix_split[0])) limits.led_min_index = k_rgb_matrix_split[0];
+#    endif
+#elif defined(RGB_MATRIX_LED_PROCESS_LIMIT) && RGB_MATRIX_LED_PROCESS_LIMIT > 0 && RGB_MATRIX_LED_PROCESS_LIMIT < RGB_MATRIX_LED_COUNT
 #    if defined(RGB_MATRIX_SPLIT)
     limits.led_min_index = RGB_MATRIX_LED_PROCESS_LIMIT * (iter);
     limits.led_max_index = limits.led_min_index + RGB_MATRIX_LED_PROCESS_LIMIT;
@@ -473,6 +685,14 @@ void rgb_matrix_init(void) {
     }
 #endif // RGB_MATRIX_KEYREACTIVE_ENABLED
 
+#if defined(RGB_MATRIX_SPLIT) && defined(SPLIT_RGB_MATRIX_HITS_ENABLE)
+    rgb_split_hits_head     = 0;
+    rgb_split_hits_count    = 0;
+    rgb_split_hits_seq      = 0;
+    rgb_split_hits_sent_seq = 0;
+    rgb_split_hits_synced   = false;
+#endif // defined(RGB_MATRIX_SPLIT) && defined(SPLIT_RGB_MATRIX_HITS_ENABLE)
+
     if (!eeconfig_is_enabled()) {
         dprintf("rgb_matrix_init_drivers eeconfig is not enabled.\n");
         eeconfig_init();
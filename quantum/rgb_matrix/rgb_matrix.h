@@ -107,6 +107,10 @@
 #    define RGB_MATRIX_LED_PROCESS_LIMIT ((RGB_MATRIX_LED_COUNT + 4) / 5)
 #endif
 
+#if defined(RGB_MATRIX_FRAME_PACING) && !defined(RGB_MATRIX_ITERATION_BUDGET_US)
+#    define RGB_MATRIX_ITERATION_BUDGET_US 500
+#endif
+
 struct rgb_matrix_limits_t {
     uint8_t led_min_index;
     uint8_t led_max_index;
@@ -167,7 +171,8 @@ void rgb_matrix_set_color_all(uint8_t red, uint8_t green, uint8_t blue);
 
 void process_rgb_matrix(uint8_t row, uint8_t col, bool pressed);
 
-void rgb_matrix_task(void);
+void     rgb_matrix_task(void);
+uint32_t rgb_matrix_next_frame_ms(void);
 
 // This runs after another backlight effect and replaces
 // colors already set
@@ -228,6 +233,20 @@ led_flags_t rgb_matrix_get_flags(void);
 void        rgb_matrix_set_flags(led_flags_t flags);
 void        rgb_matrix_set_flags_noeeprom(led_flags_t flags);
 
+#if defined(RGB_MATRIX_SPLIT) && defined(SPLIT_RGB_MATRIX_HITS_ENABLE)
+/* Split transport of the switch events driving the reactive effects. The master fills `hits` with its latest events
+ * if the slave hasn't been sent them yet, and marks them as sent once the transaction succeeded. The slave applies
+ * the events it hasn't seen yet. */
+bool rgb_matrix_split_hits_pending(rgb_matrix_split_hits_t *hits);
+void rgb_matrix_split_hits_sent(const rgb_matrix_split_hits_t *hits);
+void rgb_matrix_split_hits_apply(const rgb_matrix_split_hits_t *hits);
+#endif
+
+#ifdef RGB_MATRIX_FRAME_PACING
+uint16_t rgb_matrix_get_fps(void);
+uint32_t rgb_matrix_pacing_timer_us(void);
+#endif
+
 #ifndef RGBLIGHT_ENABLE
 #    define eeconfig_update_rgblight_current eeconfig_update_rgb_matrix
 #    define rgblight_reload_from_eeprom rgb_matrix_reload_from_eeprom
@@ -16,6 +16,10 @@
 
 #pragma once
 
+#ifdef __cplusplus
+#    define _Static_assert static_assert
+#endif
+
 #include <stdint.h>
 #include <stdbool.h>
 #include "color.h"
@@ -40,6 +44,25 @@ typedef struct PACKED {
 } last_hit_t;
 #endif // RGB_MATRIX_KEYREACTIVE_ENABLED
 
+#if defined(RGB_MATRIX_SPLIT) && defined(SPLIT_RGB_MATRIX_HITS_ENABLE)
+#    ifndef SPLIT_RGB_MATRIX_HITS_MAX
+#        define SPLIT_RGB_MATRIX_HITS_MAX 8
+#    endif
+
+typedef struct PACKED {
+    uint8_t  row;
+    uint8_t  col : 7;
+    bool     pressed : 1;
+    uint16_t time; // low 16 bits of the sync timer at the master's last double buffer timer update
+} rgb_matrix_split_hit_t;
+
+typedef struct PACKED {
+    uint8_t                seq; // number of switch events so far, modulo 256
+    uint8_t                count;
+    rgb_matrix_split_hit_t hits[SPLIT_RGB_MATRIX_HITS_MAX]; // the last `count` events, oldest first
+} rgb_matrix_split_hits_t;
+#endif // defined(RGB_MATRIX_SPLIT) && defined(SPLIT_RGB_MATRIX_HITS_ENABLE)
+
 typedef enum rgb_task_states { STARTING, RENDERING, FLUSHING, SYNCING } rgb_task_states;
 
 typedef uint8_t led_flags_t;
@@ -30,6 +30,10 @@
 #include "split_util.h"
 #include "synchronization_util.h"
 
+#ifdef PROTOCOL_CHIBIOS
+#    include <ch.h>
+#endif
+
 #ifdef BACKLIGHT_ENABLE
 #    include "backlight.h"
 #endif
@@ -64,8 +68,6 @@
 #    include "wpm.h"
 #endif
 
-#define SYNC_TIMER_OFFSET 2
-
 #ifndef FORCED_SYNC_THROTTLE_MS
 #    define FORCED_SYNC_THROTTLE_MS 100
 #endif // FORCED_SYNC_THROTTLE_MS
@@ -80,6 +82,9 @@
     { 0, 0, sizeof_member(split_shared_memory_t, member), offsetof(split_shared_memory_t, member), cb }
 #define trans_target2initiator_initializer(member) trans_target2initiator_initializer_cb(member, NULL)
 
+#define trans_bidirectional_initializer_cb(initiator2target_member, target2initiator_member, cb) \
+    { sizeof_member(split_shared_memory_t, initiator2target_member), offsetof(split_shared_memory_t, initiator2target_member), sizeof_member(split_shared_memory_t, target2initiator_member), offsetof(split_shared_memory_t, target2initiator_member), cb }
+
 #define transport_write(id, data, length) transport_execute_transaction(id, data, length, NULL, 0)
 #define transport_read(id, data, length) transport_execute_transaction(id, NULL, 0, data, length)
 
@@ -273,30 +278,64 @@ static void encoder_handlers_slave(matrix_row_t master_matrix[], matrix_row_t sl
 #ifndef DISABLE_SYNC_TIMER
 
 static bool sync_timer_handlers_master(matrix_row_t master_matrix[], matrix_row_t slave_matrix[]) {
-    static uint32_t last_update = 0;
+    static uint32_t            last_update = 0;
+    static sync_timer_sample_t sample      = {0};
 
     bool okay = true;
     if (timer_elapsed32(last_update) >= FORCED_SYNC_THROTTLE_MS) {
-        uint32_t sync_timer = sync_timer_read32() + SYNC_TIMER_OFFSET;
-        okay &= transport_write(PUT_SYNC_TIMER, &sync_timer, sizeof(sync_timer));
+        // The last round trip goes along with the request, for the slave to work out the offset from
+        uint32_t receive;
+        uint32_t request = timer_read32();
+        okay &= transport_execute_transaction(PUT_SYNC_TIMER, &sample, sizeof(sample), &receive, sizeof(receive));
         if (okay) {
             last_update = timer_read32();
+            sample      = (sync_timer_sample_t){.request = request, .receive = receive, .reply = last_update};
         }
     }
     return okay;
 }
 
+#    ifdef PROTOCOL_CHIBIOS
+// The callback may run from the serial ISR with the system locked, where timer_read32() can't be called, so it counts
+// on in system ticks from a timestamp taken each time round the slave loop
+static uint32_t  receive_base_ms    = 0;
+static systime_t receive_base_ticks = 0;
+
+static void sync_timer_receive_rebase(void) {
+    uint32_t now = timer_read32();
+    chSysLock();
+    receive_base_ms    = now;
+    receive_base_ticks = chVTGetSystemTimeX();
+    chSysUnlock();
+}
+
+static uint32_t sync_timer_receive_read32(void) {
+    return receive_base_ms + (uint32_t)TIME_I2MS(chTimeDiffX(receive_base_ticks, chVTGetSystemTimeX()));
+}
+#    else
+#        define sync_timer_receive_rebase()
+#        define sync_timer_receive_read32() timer_read32()
+#    endif
+
 static void sync_timer_handlers_slave(matrix_row_t master_matrix[], matrix_row_t slave_matrix[]) {
-    static uint32_t last_sync_timer = 0;
-    if (last_sync_timer != split_shmem->sync_timer) {
-        last_sync_timer = split_shmem->sync_timer;
-        sync_timer_update(last_sync_timer);
+    static uint32_t last_request = 0;
+    sync_timer_receive_rebase();
+    if (last_request != split_shmem->sync_timer.sample.request) {
+        sync_timer_sample_t sample = split_shmem->sync_timer.sample;
+        last_request               = sample.request;
+        sync_timer_sample(&sample);
     }
 }
 
+static void sync_timer_callback(uint8_t initiator2target_buffer_size, const void *initiator2target_buffer, uint8_t target2initiator_buffer_size, void *target2initiator_buffer) {
+    // Stamped as the request arrives, rather than whenever the slave gets round to it
+    uint32_t receive = sync_timer_receive_read32();
+    memcpy(target2initiator_buffer, &receive, sizeof(receive));
+}
+
 #    define TRANSACTIONS_SYNC_TIMER_MASTER() TRANSACTION_HANDLER_MASTER(sync_timer)
 #    define TRANSACTIONS_SYNC_TIMER_SLAVE() TRANSACTION_HANDLER_SLAVE_AUTOLOCK(sync_timer)
-#    define TRANSACTIONS_SYNC_TIMER_REGISTRATIONS [PUT_SYNC_TIMER] = trans_initiator2target_initializer(sync_timer),
+#    define TRANSACTIONS_SYNC_TIMER_REGISTRATIONS [PUT_SYNC_TIMER] = trans_bidirectional_initializer_cb(sync_timer.sample, sync_timer.receive, sync_timer_callback),
 
 #else // DISABLE_SYNC_TIMER
 
@@ -574,6 +613,42 @@ static void rgb_matrix_handlers_slave(matrix_row_t master_matrix[], matrix_row_t
 
 #endif // defined(RGB_MATRIX_ENABLE) && defined(RGB_MATRIX_SPLIT)
 
+#if defined(RGB_MATRIX_ENABLE) && defined(RGB_MATRIX_SPLIT) && defined(SPLIT_RGB_MATRIX_HITS_ENABLE)
+
+static bool rgb_matrix_hits_handlers_master(matrix_row_t master_matrix[], matrix_row_t slave_matrix[]) {
+    rgb_matrix_split_hits_t hits;
+    if (!rgb_matrix_split_hits_pending(&hits)) {
+        return true;
+    }
+    // Only send the events in use, the rest of the transaction buffer is ignored by the slave
+    bool okay = transport_write(PUT_RGB_MATRIX_HITS, &hits, offsetof(rgb_matrix_split_hits_t, hits) + hits.count * sizeof(hits.hits[0]));
+    if (okay) {
+        rgb_matrix_split_hits_sent(&hits);
+    }
+    return okay;
+}
+
+static void rgb_matrix_hits_handlers_slave(matrix_row_t master_matrix[], matrix_row_t slave_matrix[]) {
+    rgb_matrix_split_hits_t hits;
+    split_shared_memory_lock();
+    memcpy(&hits, &split_shmem->rgb_matrix_hits, sizeof(hits));
+    split_shared_memory_unlock();
+
+    rgb_matrix_split_hits_apply(&hits);
+}
+
+#    define TRANSACTIONS_RGB_MATRIX_HITS_MASTER() TRANSACTION_HANDLER_MASTER(rgb_matrix_hits)
+#    define TRANSACTIONS_RGB_MATRIX_HITS_SLAVE() TRANSACTION_HANDLER_SLAVE(rgb_matrix_hits)
+#    define TRANSACTIONS_RGB_MATRIX_HITS_REGISTRATIONS [PUT_RGB_MATRIX_HITS] = trans_initiator2target_initializer(rgb_matrix_hits),
+
+#else // defined(RGB_MATRIX_ENABLE) && defined(RGB_MATRIX_SPLIT) && defined(SPLIT_RGB_MATRIX_HITS_ENABLE)
+
+#    define TRANSACTIONS_RGB_MATRIX_HITS_MASTER()
+#    define TRANSACTIONS_RGB_MATRIX_HITS_SLAVE()
+#    define TRANSACTIONS_RGB_MATRIX_HITS_REGISTRATIONS
+
+#endif // defined(RGB_MATRIX_ENABLE) && defined(RGB_MATRIX_SPLIT) && defined(SPLIT_RGB_MATRIX_HITS_ENABLE)
+
 ////////////////////////////////////////////////////
 // WPM
 
@@ -906,6 +981,7 @@ split_transaction_desc_t split_transaction_table[NUM_TOTAL_TRANSACTIONS] = {
     TRANSACTIONS_RGBLIGHT_REGISTRATIONS
     TRANSACTIONS_LED_MATRIX_REGISTRATIONS
     TRANSACTIONS_RGB_MATRIX_REGISTRATIONS
+    TRANSACTIONS_RGB_MATRIX_HITS_REGISTRATIONS
     TRANSACTIONS_WPM_REGISTRATIONS
     TRANSACTIONS_OLED_REGISTRATIONS
     TRANSACTIONS_ST7565_REGISTRATIONS
@@ -936,6 +1012,7 @@ bool transactions_master(matrix_row_t master_matrix[], matrix_row_t slave_matrix
     TRANSACTIONS_RGBLIGHT_MASTER();
     TRANSACTIONS_LED_MATRIX_MASTER();
     TRANSACTIONS_RGB_MATRIX_MASTER();
+    TRANSACTIONS_RGB_MATRIX_HITS_MASTER();
     TRANSACTIONS_WPM_MASTER();
     TRANSACTIONS_OLED_MASTER();
     TRANSACTIONS_ST7565_MASTER();
@@ -959,6 +1036,7 @@ void transactions_slave(matrix_row_t master_matrix[], matrix_row_t slave_matrix[
     TRANSACTIONS_RGBLIGHT_SLAVE();
     TRANSACTIONS_LED_MATRIX_SLAVE();
     TRANSACTIONS_RGB_MATRIX_SLAVE();
+    TRANSACTIONS_RGB_MATRIX_HITS_SLAVE();
     TRANSACTIONS_WPM_SLAVE();
     TRANSACTIONS_OLED_SLAVE();
     TRANSACTIONS_ST7565_SLAVE();
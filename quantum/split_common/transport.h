@@ -52,6 +52,10 @@ bool transport_execute_transaction(int8_t id, const void *initiator2target_buf,
 #    include "rgblight.h"
 #endif // RGBLIGHT_ENABLE
 
+#ifndef DISABLE_SYNC_TIMER
+#    include "sync_timer.h"
+#endif // DISABLE_SYNC_TIMER
+
 typedef struct _split_slave_matrix_sync_t {
     uint8_t      checksum;
     matrix_row_t matrix[(MATRIX_ROWS) / 2];
@@ -70,6 +74,13 @@ typedef struct _split_slave_encoder_sync_t {
 } split_slave_encoder_sync_t;
 #endif // ENCODER_ENABLE
 
+#ifndef DISABLE_SYNC_TIMER
+typedef struct _split_sync_timer_t {
+    sync_timer_sample_t sample;  // the last round trip the master heard back from
+    uint32_t            receive; // slave time this request arrived
+} split_sync_timer_t;
+#endif // DISABLE_SYNC_TIMER
+
 #if !defined(NO_ACTION_LAYER) && defined(SPLIT_LAYER_STATE_ENABLE)
 typedef struct _split_layers_sync_t {
     layer_state_t layer_state;
@@ -162,7 +173,7 @@ typedef struct _split_shared_memory_t {
 #endif // ENCODER_ENABLE
 
 #ifndef DISABLE_SYNC_TIMER
-    uint32_t sync_timer;
+    split_sync_timer_t sync_timer;
 #endif // DISABLE_SYNC_TIMER
 
 #if !defined(NO_ACTION_LAYER) && defined(SPLIT_LAYER_STATE_ENABLE)
@@ -193,6 +204,10 @@ typedef struct _split_shared_memory_t {
     rgb_matrix_sync_t rgb_matrix_sync;
 #endif // defined(RGB_MATRIX_ENABLE) && defined(RGB_MATRIX_SPLIT)
 
+#if defined(RGB_MATRIX_ENABLE) && defined(RGB_MATRIX_SPLIT) && defined(SPLIT_RGB_MATRIX_HITS_ENABLE)
+    rgb_matrix_split_hits_t rgb_matrix_hits;
+#endif // defined(RGB_MATRIX_ENABLE) && defined(RGB_MATRIX_SPLIT) && defined(SPLIT_RGB_MATRIX_HITS_ENABLE)
+
 #if defined(WPM_ENABLE) && defined(SPLIT_WPM_ENABLE)
     uint8_t current_wpm;
 #endif // defined(WPM_ENABLE) && defined(SPLIT_WPM_ENABLE)
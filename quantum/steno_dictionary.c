@@ -0,0 +1,305 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <string.h>
+#include "steno_dictionary.h"
+#include "action.h"
+#include "keycodes.h"
+#include "progmem.h"
+#include "send_string.h"
+
+#if __has_include("steno_dictionary_data.h")
+#    include "steno_dictionary_data.h"
+#else
+#    error "No steno dictionary found, generate steno_dictionary_data.h with: qmk generate-steno-dictionary"
+#endif
+
+/*
+ * The dictionary is a trie laid out in level order, as generated by `qmk generate-steno-dictionary`. Each node is
+ * eight bytes, little endian: its stroke (3 bytes), the index of its first child (2 bytes) and the offset of its
+ * translation in steno_dictionary_text (3 bytes, or STENO_DICTIONARY_NO_TEXT). The children of a node sit sorted by
+ * stroke from its first child up to the first child of the node after it, so finding one is a binary search and the
+ * trie needs no pointers beyond that one index. The root is node 0, and a last node past the end bounds its siblings.
+ */
+#define NODE_SIZE 8
+#define NO_NODE 0
+#define STENO_DICTIONARY_NO_TEXT 0xFFFFFFUL
+
+_Static_assert(STENO_DICTIONARY_STROKES >= STENO_DICTIONARY_LONGEST, "STENO_DICTIONARY_STROKES is shorter than the longest dictionary entry");
+_Static_assert(STENO_DICTIONARY_STROKES < 255 && STENO_DICTIONARY_HISTORY < 255, "The steno dictionary history is limited to 254 entries");
+
+#define NONE 0xFF
+
+// Steno order bit for each steno key, number keys add the number bar and all four star keys are the star
+static const uint8_t key_map[] PROGMEM = {NONE, 0, 0, 0, 0, 0, 0, 1, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 10, NONE, NONE, NONE, 10, 10, 11, 12, 13, 14, 15, 16, 17, 18, 19, 20, 21, 0, 0, 0, 0, 0, 0, 22};
+
+static const char keys[STENO_DICTIONARY_KEY_COUNT] PROGMEM   = "#STKPWHRAO*EUFRPBLGTSDZ";
+static const char digits[STENO_DICTIONARY_KEY_COUNT] PROGMEM = {0, '1', '2', 0, '3', 0, '4', 0, '5', '0', 0, 0, 0, '6', 0, '7', 0, '8', 0, '9', 0, 0, 0};
+
+#define NUMBER_BAR (1UL << 0)
+#define FIRST_RIGHT 11
+#define MIDDLE_KEYS (0x1FUL << 8)
+
+typedef struct {
+    uint8_t strokes;
+    uint8_t length; // Characters typed, saturating
+    uint8_t state;  // Formatting state before it was typed
+} translation_t;
+
+// Strokes of the translations in the history, oldest first, with room for one more before trimming
+static uint32_t      strokes[STENO_DICTIONARY_STROKES + 1];
+static uint8_t       stroke_count;
+static translation_t history[STENO_DICTIONARY_HISTORY + 1];
+static uint8_t       history_count;
+
+// The next text attaches, is capitalized, or glues to the last, using the atom flags for each
+static uint8_t state = STENO_DICTIONARY_ATTACH_NEXT;
+
+static char    output[STENO_DICTIONARY_OUTPUT_SIZE + 1];
+static uint8_t output_length;
+static uint8_t output_backspaces;
+static uint8_t typed;
+
+static bool enabled = true;
+
+uint32_t steno_dictionary_key_to_stroke(uint8_t key) {
+    if (key >= sizeof(key_map)) {
+        return 0;
+    }
+    uint8_t bit = pgm_read_byte(&key_map[key]);
+    return bit == NONE ? 0 : 1UL << bit;
+}
+
+void steno_dictionary_stroke_to_string(uint32_t stroke, char *text) {
+    bool numbers = false;
+    for (uint8_t key = 1; key < STENO_DICTIONARY_KEY_COUNT; key++) {
+        if ((stroke & (1UL << key)) && pgm_read_byte(&digits[key])) {
+            numbers = stroke & NUMBER_BAR;
+        }
+    }
+    bool hyphen = !(stroke & MIDDLE_KEYS);
+
+    for (uint8_t key = 0; key < STENO_DICTIONARY_KEY_COUNT; key++) {
+        if (!(stroke & (1UL << key)) || (key == 0 && numbers)) {
+            continue;
+        }
+        if (key >= FIRST_RIGHT && hyphen) {
+            *text++ = '-';
+            hyphen  = false;
+        }
+        char digit = pgm_read_byte(&digits[key]);
+        *text++    = numbers && digit ? digit : pgm_read_byte(&keys[key]);
+    }
+    *text = '\0';
+}
+
+static uint32_t read_node(uint16_t node, uint8_t field, uint8_t size) {
+    uint32_t offset = (uint32_t)node * NODE_SIZE + field;
+    uint32_t value  = 0;
+    while (size--) {
+        value = (value << 8) | pgm_read_byte(&steno_dictionary_nodes[offset + size]);
+    }
+    return value;
+}
+
+static uint16_t find_child(uint16_t node, uint32_t stroke) {
+    uint16_t low  = read_node(node, 3, 2);
+    uint16_t end  = read_node(node + 1, 3, 2);
+    uint16_t high = end;
+    while (low < high) {
+        uint16_t middle = low + (high - low) / 2;
+        if (read_node(middle, 0, 3) < stroke) {
+            low = middle + 1;
+        } else {
+            high = middle;
+        }
+    }
+    return low < end && read_node(low, 0, 3) == stroke ? low : NO_NODE;
+}
+
+static uint32_t lookup(const uint32_t *outline, uint8_t count) {
+    uint16_t node = 0;
+    for (uint8_t i = 0; i < count; i++) {
+        node = find_child(node, outline[i]);
+        if (node == NO_NODE) {
+            return STENO_DICTIONARY_NO_TEXT;
+        }
+    }
+    return read_node(node, 5, 3);
+}
+
+static void flush(void) {
+    if (output_length || output_backspaces) {
+        output[output_length] = '\0';
+        steno_dictionary_output(output_backspaces, output);
+        output_length     = 0;
+        output_backspaces = 0;
+    }
+}
+
+static void erase(uint8_t count) {
+    if (output_length || output_backspaces > 255 - count) {
+        flush();
+    }
+    output_backspaces += count;
+}
+
+static void type(char c) {
+    if (output_length == STENO_DICTIONARY_OUTPUT_SIZE) {
+        flush();
+    }
+    output[output_length++] = c;
+    if (typed < 255) {
+        typed++;
+    }
+}
+
+static uint8_t read_atom(const uint8_t *atoms, bool in_progmem) {
+    return in_progmem ? pgm_read_byte(atoms) : *atoms;
+}
+
+static void format(const uint8_t *atoms, bool in_progmem) {
+    uint8_t c = read_atom(atoms, in_progmem);
+    while (c) {
+        uint8_t flags = c & ~STENO_DICTIONARY_ATOM;
+        c             = read_atom(++atoms, in_progmem);
+
+        // Atoms without text only change how the next text is typed
+        if (!c || (c & STENO_DICTIONARY_ATOM)) {
+            state |= flags & (STENO_DICTIONARY_ATTACH_NEXT | STENO_DICTIONARY_CAPITALIZE_NEXT);
+            continue;
+        }
+
+        bool glued = (flags & STENO_DICTIONARY_GLUE) && (state & STENO_DICTIONARY_GLUE);
+        if (!(state & STENO_DICTIONARY_ATTACH_NEXT) && !(flags & STENO_DICTIONARY_ATTACH_PREVIOUS) && !glued) {
+            type(' ');
+        }
+        if ((state & STENO_DICTIONARY_CAPITALIZE_NEXT) && c >= 'a' && c <= 'z') {
+            c -= 'a' - 'A';
+        }
+        while (c && !(c & STENO_DICTIONARY_ATOM)) {
+            type(c);
+            c = read_atom(++atoms, in_progmem);
+        }
+        state = flags & (STENO_DICTIONARY_ATTACH_NEXT | STENO_DICTIONARY_CAPITALIZE_NEXT | STENO_DICTIONARY_GLUE);
+    }
+}
+
+static void drop_oldest(void) {
+    stroke_count -= history[0].strokes;
+    memmove(strokes, &strokes[history[0].strokes], stroke_count * sizeof(strokes[0]));
+    memmove(history, &history[1], --history_count * sizeof(history[0]));
+}
+
+static void translate(uint32_t stroke) {
+    // Try the stroke with as many of the last translations as the longest entry allows, then fewer
+    uint8_t  merged   = history_count;
+    uint8_t  previous = stroke_count;
+    uint32_t text     = STENO_DICTIONARY_NO_TEXT;
+    strokes[stroke_count] = stroke;
+    for (;;) {
+        if (previous < STENO_DICTIONARY_LONGEST) {
+            text = lookup(&strokes[stroke_count - previous], previous + 1);
+            if (text != STENO_DICTIONARY_NO_TEXT) {
+                break;
+            }
+        }
+        if (!merged) {
+            break;
+        }
+        previous -= history[history_count - merged].strokes;
+        merged--;
+    }
+
+    uint16_t backspaces = 0;
+    while (merged--) {
+        translation_t *replaced = &history[--history_count];
+        backspaces += replaced->length;
+        state = replaced->state;
+    }
+    while (backspaces) {
+        uint8_t count = backspaces > 255 ? 255 : backspaces;
+        erase(count);
+        backspaces -= count;
+    }
+
+    translation_t *translation = &history[history_count++];
+    translation->strokes       = previous + 1;
+    translation->state         = state;
+    stroke_count++;
+
+    typed = 0;
+    if (text != STENO_DICTIONARY_NO_TEXT) {
+        format(&steno_dictionary_text[text], true);
+    } else {
+        // Untranslated strokes are typed in steno notation
+        uint8_t untranslated[STENO_DICTIONARY_KEY_COUNT + 3] = {STENO_DICTIONARY_ATOM};
+        steno_dictionary_stroke_to_string(stroke, (char *)&untranslated[1]);
+        format(untranslated, false);
+    }
+    translation->length = typed;
+
+    while (history_count > STENO_DICTIONARY_HISTORY || stroke_count > STENO_DICTIONARY_STROKES) {
+        drop_oldest();
+    }
+}
+
+static void undo(void) {
+    if (!history_count) {
+        return;
+    }
+    translation_t last = history[--history_count];
+    stroke_count -= last.strokes;
+    state = last.state;
+    erase(last.length);
+
+    // Bring back whatever the translation replaced, translating again all but its last stroke
+    uint32_t replay[STENO_DICTIONARY_LONGEST];
+    memcpy(replay, &strokes[stroke_count], (last.strokes - 1) * sizeof(replay[0]));
+    for (uint8_t i = 0; i + 1 < last.strokes; i++) {
+        translate(replay[i]);
+    }
+}
+
+void steno_dictionary_translate(uint32_t stroke) {
+    if (stroke == STENO_DICTIONARY_UNDO) {
+        undo();
+    } else if (stroke) {
+        translate(stroke);
+    }
+    flush();
+}
+
+void steno_dictionary_reset(void) {
+    stroke_count  = 0;
+    history_count = 0;
+    state         = STENO_DICTIONARY_ATTACH_NEXT;
+}
+
+bool steno_dictionary_is_enabled(void) {
+    return enabled;
+}
+
+void steno_dictionary_enable(void) {
+    enabled = true;
+}
+
+void steno_dictionary_disable(void) {
+    enabled = false;
+    steno_dictionary_reset();
+}
+
+void steno_dictionary_toggle(void) {
+    if (enabled) {
+        steno_dictionary_disable();
+    } else {
+        steno_dictionary_enable();
+    }
+}
+
+__attribute__((weak)) void steno_dictionary_output(uint8_t backspaces, const char *text) {
+    while (backspaces--) {
+        tap_code(KC_BSPC);
+    }
+    send_string(text);
+}
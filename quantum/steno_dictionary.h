@@ -0,0 +1,69 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <stdint.h>
+#include <stdbool.h>
+
+// Translations kept for longest match and undo
+#ifndef STENO_DICTIONARY_HISTORY
+#    define STENO_DICTIONARY_HISTORY 16
+#endif
+
+// Strokes kept across those translations, never fewer than the longest entry
+#ifndef STENO_DICTIONARY_STROKES
+#    define STENO_DICTIONARY_STROKES 32
+#endif
+
+// Characters gathered before handing them to steno_dictionary_output()
+#ifndef STENO_DICTIONARY_OUTPUT_SIZE
+#    define STENO_DICTIONARY_OUTPUT_SIZE 32
+#endif
+
+// A stroke is a bit per key, in steno order: #STKPWHRAO*EUFRPBLGTSDZ
+#define STENO_DICTIONARY_KEY_COUNT 23
+#define STENO_DICTIONARY_UNDO (1UL << 10)
+
+// Each translation is a run of atoms, a flags byte with the top bit set followed by its text
+#define STENO_DICTIONARY_ATOM 0x80
+#define STENO_DICTIONARY_ATTACH_PREVIOUS 0x01
+#define STENO_DICTIONARY_ATTACH_NEXT 0x02
+#define STENO_DICTIONARY_CAPITALIZE_NEXT 0x04
+#define STENO_DICTIONARY_GLUE 0x08
+
+/**
+ * \brief Returns the stroke bit for a steno key, `keycode - QK_STENO`, or 0 for keys which have none.
+ */
+uint32_t steno_dictionary_key_to_stroke(uint8_t key);
+
+/**
+ * \brief Translates a stroke, typing the text it makes and taking back whatever that replaces.
+ *
+ * The `*` stroke alone undoes the last translation.
+ */
+void steno_dictionary_translate(uint32_t stroke);
+
+/**
+ * \brief Forgets the translation history, so the next stroke starts afresh.
+ */
+void steno_dictionary_reset(void);
+
+/**
+ * \brief Writes a stroke in steno notation, such as `STKPW` or `-FRPB` or `1-9`.
+ *
+ * \param text At least STENO_DICTIONARY_KEY_COUNT + 2 characters.
+ */
+void steno_dictionary_stroke_to_string(uint32_t stroke, char *text);
+
+bool steno_dictionary_is_enabled(void);
+void steno_dictionary_enable(void);
+void steno_dictionary_disable(void);
+void steno_dictionary_toggle(void);
+
+/**
+ * \brief Types translated text, after first taking back `backspaces` characters.
+ *
+ * Defaults to tapping backspace and sending the text as a string.
+ */
+void steno_dictionary_output(uint8_t backspaces, const char *text);
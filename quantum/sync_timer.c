@@ -27,15 +27,19 @@ SOFTWARE.
 #include "keyboard.h"
 
 #if defined(SPLIT_KEYBOARD) && !defined(DISABLE_SYNC_TIMER)
-volatile int32_t sync_timer_ms;
+static sync_timer_discipline_t discipline;
 
 void sync_timer_init(void) {
-    sync_timer_ms = 0;
+    sync_timer_discipline_init(&discipline);
 }
 
-void sync_timer_update(uint32_t time) {
+void sync_timer_sample(const sync_timer_sample_t *sample) {
     if (is_keyboard_master()) return;
-    sync_timer_ms = time - timer_read32();
+    sync_timer_discipline_sample(&discipline, sample, timer_read32());
+}
+
+void sync_timer_quality(sync_timer_quality_t *quality) {
+    *quality = discipline.quality;
 }
 
 uint16_t sync_timer_read(void) {
@@ -45,7 +49,7 @@ uint16_t sync_timer_read(void) {
 
 uint32_t sync_timer_read32(void) {
     if (is_keyboard_master()) return timer_read32();
-    return sync_timer_ms + timer_read32();
+    return sync_timer_discipline_read(&discipline, timer_read32());
 }
 
 uint16_t sync_timer_elapsed(uint16_t last) {
@@ -27,6 +27,7 @@ SOFTWARE.
 
 #include <stdint.h>
 #include "timer.h"
+#include "sync_timer_discipline.h"
 
 #ifdef __cplusplus
 extern "C" {
@@ -34,7 +35,8 @@ extern "C" {
 
 #if defined(SPLIT_KEYBOARD) && !defined(DISABLE_SYNC_TIMER)
 void     sync_timer_init(void);
-void     sync_timer_update(uint32_t time);
+void     sync_timer_sample(const sync_timer_sample_t *sample);
+void     sync_timer_quality(sync_timer_quality_t *quality);
 uint16_t sync_timer_read(void);
 uint32_t sync_timer_read32(void);
 uint16_t sync_timer_elapsed(uint16_t last);
@@ -42,7 +44,7 @@ uint32_t sync_timer_elapsed32(uint32_t last);
 #else
 #    define sync_timer_init()
 #    define sync_timer_clear()
-#    define sync_timer_update(t)
+#    define sync_timer_sample(s)
 #    define sync_timer_read() timer_read()
 #    define sync_timer_read32() timer_read32()
 #    define sync_timer_elapsed(t) timer_elapsed(t)
@@ -0,0 +1,106 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "sync_timer_discipline.h"
+
+// Without exchanges the clock follows its drift estimate for this long, in ms, then holds its offset
+#define SYNC_TIMER_HOLDOVER 60000
+
+// Held up exchanges in a row before the link is taken to have slowed down for good
+#define SYNC_TIMER_SLOW_LIMIT 8
+
+// Exchanges in a row too far out to slew before the clock is stepped to them
+#define SYNC_TIMER_OUTLIER_LIMIT 3
+
+static int32_t floor_div(int32_t value, int32_t divisor) {
+    return value / divisor - (value % divisor < 0);
+}
+
+static int32_t clamp(int32_t value, int32_t limit) {
+    return value > limit ? limit : value < -limit ? -limit : value;
+}
+
+// Microseconds the offset has moved on from its whole ms at the anchor by the local time `local`
+static int32_t offset_us_at(const sync_timer_discipline_t *discipline, uint32_t local) {
+    int32_t elapsed = clamp((int32_t)(local - discipline->anchor), SYNC_TIMER_HOLDOVER);
+    return discipline->offset_us + elapsed * discipline->rate_ppm / 1000;
+}
+
+void sync_timer_discipline_init(sync_timer_discipline_t *discipline) {
+    *discipline             = (sync_timer_discipline_t){0};
+    discipline->delay_floor = SYNC_TIMER_MAX_DELAY;
+}
+
+static void step(sync_timer_discipline_t *discipline, const sync_timer_sample_t *sample) {
+    // The request reached the slave halfway through the round trip
+    uint32_t delay        = sample->reply - sample->request;
+    discipline->offset_ms = (int32_t)(sample->request - sample->receive) + delay / 2;
+    discipline->offset_us = (delay % 2) * 500;
+    discipline->anchor    = sample->receive;
+    discipline->rate_ppm  = discipline->drift_q8 / 256;
+}
+
+bool sync_timer_discipline_sample(sync_timer_discipline_t *discipline, const sync_timer_sample_t *sample, uint32_t now) {
+    sync_timer_quality_t *quality = &discipline->quality;
+    uint32_t              delay   = sample->reply - sample->request;
+
+    if (delay > SYNC_TIMER_MAX_DELAY) {
+        quality->rejected++;
+        return false;
+    }
+    if (delay < discipline->delay_floor) {
+        discipline->delay_floor = delay;
+    }
+    if (delay > discipline->delay_floor + SYNC_TIMER_DELAY_MARGIN) {
+        // How it was held up either way is unknown, which leaves the offset out by up to half of the extra delay
+        if (++discipline->slow < SYNC_TIMER_SLOW_LIMIT) {
+            quality->rejected++;
+            return false;
+        }
+        discipline->delay_floor = delay;
+    }
+    discipline->slow = 0;
+
+    // Twice the master's offset at the slave's receive time, less the whole ms the clock has for it
+    int32_t error_ms2 = (int32_t)(sample->request - sample->receive - discipline->offset_ms) + (int32_t)(sample->reply - sample->receive - discipline->offset_ms);
+    int32_t error_us  = clamp(error_ms2, 1L << 20) * 500 - offset_us_at(discipline, sample->receive);
+
+    if (!quality->synced || error_us > SYNC_TIMER_STEP_THRESHOLD * 1000L || error_us < -SYNC_TIMER_STEP_THRESHOLD * 1000L) {
+        // A lone wild exchange is not worth jumping the clock for, a master which restarted is
+        if (quality->synced && ++discipline->outliers < SYNC_TIMER_OUTLIER_LIMIT) {
+            quality->rejected++;
+            return false;
+        }
+        step(discipline, sample);
+    } else {
+        // Hold the clock where it is now while its rate changes underneath it
+        int32_t now_us        = offset_us_at(discipline, now);
+        int32_t now_ms        = floor_div(now_us, 1000);
+        discipline->offset_ms += now_ms;
+        discipline->offset_us = now_us - now_ms * 1000;
+        discipline->anchor    = now;
+
+        // The drift estimate integrates the error, the slew works off what is left over SYNC_TIMER_SLEW_TIME
+        int32_t interval = clamp((int32_t)(sample->receive - discipline->last_receive), SYNC_TIMER_HOLDOVER);
+        discipline->drift_q8 += (int64_t)error_us * interval * 1000 * 256 / (4LL * SYNC_TIMER_SLEW_TIME * SYNC_TIMER_SLEW_TIME);
+        discipline->drift_q8 = clamp(discipline->drift_q8, SYNC_TIMER_MAX_SLEW * 256L);
+        int32_t slew         = clamp((int64_t)error_us * 1000 / SYNC_TIMER_SLEW_TIME, SYNC_TIMER_MAX_SLEW);
+        discipline->rate_ppm = discipline->drift_q8 / 256 + slew;
+
+        int32_t magnitude = error_us < 0 ? -error_us : error_us;
+        quality->jitter_us += (magnitude - quality->jitter_us) / 8;
+    }
+
+    discipline->outliers     = 0;
+    discipline->last_receive = sample->receive;
+    quality->synced          = true;
+    quality->samples++;
+    quality->delay_ms  = delay;
+    quality->error_us  = clamp(error_us, INT16_MAX);
+    quality->drift_ppm = discipline->drift_q8 / 256;
+    return true;
+}
+
+uint32_t sync_timer_discipline_read(const sync_timer_discipline_t *discipline, uint32_t local) {
+    return local + discipline->offset_ms + floor_div(offset_us_at(discipline, local), 1000);
+}
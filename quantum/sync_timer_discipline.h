@@ -0,0 +1,79 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "util.h"
+
+// Exchanges taking longer than this, in ms, are never learnt from
+#ifndef SYNC_TIMER_MAX_DELAY
+#    define SYNC_TIMER_MAX_DELAY 20
+#endif
+
+// Exchanges this much slower than the quickest recent one, in ms, are dropped as held up on the way
+#ifndef SYNC_TIMER_DELAY_MARGIN
+#    define SYNC_TIMER_DELAY_MARGIN 2
+#endif
+
+// Time constant, in ms, an offset is slewed out over
+#ifndef SYNC_TIMER_SLEW_TIME
+#    define SYNC_TIMER_SLEW_TIME 2000
+#endif
+
+// Furthest the clock is sped up or slowed down, in parts per million
+#ifndef SYNC_TIMER_MAX_SLEW
+#    define SYNC_TIMER_MAX_SLEW 5000
+#endif
+
+// Offsets further out than this, in ms, are stepped rather than slewed
+#ifndef SYNC_TIMER_STEP_THRESHOLD
+#    define SYNC_TIMER_STEP_THRESHOLD 50
+#endif
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** \brief One round trip between the halves. */
+typedef struct PACKED {
+    uint32_t request; // master time the request went out
+    uint32_t receive; // slave time it arrived
+    uint32_t reply;   // master time the reply came back
+} sync_timer_sample_t;
+
+typedef struct {
+    bool     synced;    // the clock has been set from the master
+    uint16_t samples;   // exchanges learnt from
+    uint16_t rejected;  // exchanges dropped for taking too long
+    uint8_t  delay_ms;  // round trip of the last exchange learnt from
+    int16_t  error_us;  // how far out the clock was at that exchange
+    uint16_t jitter_us; // average size of that error
+    int16_t  drift_ppm; // how much faster the master's clock runs
+} sync_timer_quality_t;
+
+typedef struct {
+    int32_t              offset_ms;    // whole ms the master is ahead at the anchor
+    int32_t              offset_us;    // and the us on top of that, 0 to 999
+    uint32_t             anchor;       // local time the offset was worked out at
+    int32_t              rate_ppm;     // how fast the offset moves on from there
+    int32_t              drift_q8;     // drift estimate, in 1/256 ppm
+    uint32_t             last_receive; // local time of the last exchange learnt from
+    uint8_t              delay_floor;  // quickest recent round trip
+    uint8_t              slow;         // held up exchanges in a row
+    uint8_t              outliers;     // exchanges in a row too far out to slew
+    sync_timer_quality_t quality;
+} sync_timer_discipline_t;
+
+void sync_timer_discipline_init(sync_timer_discipline_t *discipline);
+
+/** \brief Learns from an exchange, `now` being the local time. Returns false if it was dropped. */
+bool sync_timer_discipline_sample(sync_timer_discipline_t *discipline, const sync_timer_sample_t *sample, uint32_t now);
+
+/** \brief Master time at the local time `local`. */
+uint32_t sync_timer_discipline_read(const sync_timer_discipline_t *discipline, uint32_t local);
+
+#ifdef __cplusplus
+}
+#endif
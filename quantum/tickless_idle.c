@@ -0,0 +1,93 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "tickless_idle.h"
+#include "keyboard.h"
+#include "matrix.h"
+#include "timer.h"
+#include "util.h"
+#ifdef DEFERRED_EXEC_ENABLE
+#    include "deferred_exec.h"
+#endif
+#ifdef LED_MATRIX_ENABLE
+#    include "led_matrix.h"
+#endif
+#ifdef RGB_MATRIX_ENABLE
+#    include "rgb_matrix.h"
+#endif
+#ifdef REPORT_SCHEDULER_ENABLE
+#    include "report_scheduler.h"
+#endif
+#ifdef DEFERRED_LOG_ENABLE
+#    include "deferred_log.h"
+#endif
+
+__attribute__((weak)) uint32_t tickless_idle_sleep_ms_user(uint32_t sleep_ms) {
+    return sleep_ms;
+}
+
+__attribute__((weak)) uint32_t tickless_idle_sleep_ms_kb(uint32_t sleep_ms) {
+    return tickless_idle_sleep_ms_user(sleep_ms);
+}
+
+// Platforms without a way to sleep keep spinning
+__attribute__((weak)) void tickless_idle_sleep_until(uint32_t deadline) {}
+__attribute__((weak)) void tickless_idle_wake(void) {}
+
+static bool any_key_pressed(void) {
+    for (uint8_t row = 0; row < MATRIX_ROWS; row++) {
+        if (matrix_get_row(row)) {
+            return true;
+        }
+    }
+    return false;
+}
+
+uint32_t tickless_idle_sleep_ms(void) {
+    uint32_t sleep_ms = TICKLESS_IDLE_SCAN_INTERVAL;
+
+    // Tapping terms, combo terms and the like only notice their timeouts as the loop goes round, which it has to do
+    // every millisecond while keys are held or were just released
+    if (sleep_ms > 1 && (any_key_pressed() || last_input_activity_elapsed() < TICKLESS_IDLE_ACTIVE_TIME)) {
+        sleep_ms = 1;
+    }
+
+#ifdef DEFERRED_EXEC_ENABLE
+    uint32_t trigger_time;
+    if (deferred_exec_next_deadline(&trigger_time)) {
+        int32_t until = (int32_t)TIMER_DIFF_32(trigger_time, timer_read32());
+        sleep_ms      = MIN(sleep_ms, (uint32_t)MAX(until, 0));
+    }
+#endif
+
+#ifdef LED_MATRIX_ENABLE
+    sleep_ms = MIN(sleep_ms, led_matrix_next_frame_ms());
+#endif
+
+#ifdef RGB_MATRIX_ENABLE
+    sleep_ms = MIN(sleep_ms, rgb_matrix_next_frame_ms());
+#endif
+
+#ifdef REPORT_SCHEDULER_ENABLE
+    // Queued reports go out as soon as their endpoint is ready
+    if (report_scheduler_pending()) {
+        sleep_ms = 0;
+    }
+#endif
+
+#ifdef DEFERRED_LOG_ENABLE
+    // Log records waiting on the console drain a packet per pass
+    if (deferred_log_pending()) {
+        sleep_ms = MIN(sleep_ms, 1);
+    }
+#endif
+
+    return tickless_idle_sleep_ms_kb(sleep_ms);
+}
+
+void tickless_idle_task(void) {
+    uint32_t sleep_ms = tickless_idle_sleep_ms();
+    if (sleep_ms) {
+        tickless_idle_sleep_until(timer_read32() + sleep_ms);
+    }
+}
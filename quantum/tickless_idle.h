@@ -0,0 +1,34 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <stdint.h>
+
+// Longest the main loop sleeps for when nothing is due, and so the longest a key press waits to be scanned
+#ifndef TICKLESS_IDLE_SCAN_INTERVAL
+#    define TICKLESS_IDLE_SCAN_INTERVAL 1
+#endif
+
+// Time after the last input during which the loop still goes round every millisecond
+#ifndef TICKLESS_IDLE_ACTIVE_TIME
+#    define TICKLESS_IDLE_ACTIVE_TIME 1000
+#endif
+
+/** \brief Works out how many milliseconds the main loop may sleep for before anything is due. */
+uint32_t tickless_idle_sleep_ms(void);
+
+uint32_t tickless_idle_sleep_ms_kb(uint32_t sleep_ms);
+uint32_t tickless_idle_sleep_ms_user(uint32_t sleep_ms);
+
+/** \brief Sleeps until anything is due, at the end of the main loop. */
+void tickless_idle_task(void);
+
+/** \brief Platform specific: sleeps until `deadline`, in timer_read32() time, or until tickless_idle_wake(). */
+void tickless_idle_sleep_until(uint32_t deadline);
+
+/**
+ * \brief Platform specific: cuts the current sleep short, or the next one if the loop is running. Meant for
+ * interrupt handlers, such as a pin change on the matrix.
+ */
+void tickless_idle_wake(void);
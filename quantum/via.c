@@ -33,6 +33,10 @@
 #include "wait.h"
 #include "version.h" // for QMK_BUILDDATE used in EEPROM magic
 
+#if defined(VIA_BULK_ENABLE)
+#    include "via_bulk.h"
+#endif
+
 #if defined(AUDIO_ENABLE)
 #    include "audio.h"
 #endif
@@ -447,6 +451,18 @@ void raw_hid_receive(uint8_t *data, uint8_t length) {
             dynamic_keymap_set_encoder(command_data[0], command_data[1], command_data[2] != 0, (command_data[3] << 8) | command_data[4]);
             break;
         }
+#endif
+#ifdef VIA_BULK_ENABLE
+        case id_bulk_begin:
+        case id_bulk_data:
+        case id_bulk_end:
+        case id_bulk_read: {
+            // Data reports inside a window go unanswered, reads send their own reports
+            if (!via_bulk_command(data, length)) {
+                return;
+            }
+            break;
+        }
 #endif
         default: {
             // The command ID is not known
@@ -93,6 +93,10 @@ enum via_command_id {
     id_dynamic_keymap_set_buffer            = 0x13,
     id_dynamic_keymap_get_encoder           = 0x14,
     id_dynamic_keymap_set_encoder           = 0x15,
+    id_bulk_begin                           = 0x16,
+    id_bulk_data                            = 0x17,
+    id_bulk_end                             = 0x18,
+    id_bulk_read                            = 0x19,
     id_unhandled                            = 0xFF,
 };
 
@@ -143,6 +147,22 @@ enum via_qmk_audio_value {
     id_qmk_audio_clicky_enable = 2,
 };
 
+enum via_bulk_target {
+    id_bulk_keymap = 0,
+    id_bulk_macro  = 1,
+};
+
+enum via_bulk_status {
+    id_bulk_ok           = 0,
+    id_bulk_bad_target   = 1,
+    id_bulk_bad_range    = 2,
+    id_bulk_not_started  = 3,
+    id_bulk_out_of_order = 4,
+    id_bulk_bad_data     = 5,
+    id_bulk_incomplete   = 6,
+    id_bulk_crc_mismatch = 7,
+};
+
 // Can be called in an overriding via_init_kb() to test if keyboard level code usage of
 // EEPROM is invalid and use/save defaults.
 bool via_eeprom_is_valid(void);
@@ -0,0 +1,303 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <string.h>
+#include "via_bulk.h"
+#include "via.h"
+#include "raw_hid.h"
+#include "dynamic_keymap.h"
+#include "matrix.h"
+#include "util.h"
+
+/*
+ * A write goes as:
+ *
+ *   id_bulk_begin  [target] [flags] [offset hi] [offset lo] [length hi] [length lo]
+ *                  -> [status] [window] [buffer size hi] [buffer size lo]
+ *   id_bulk_data   [sequence] [payload...], payload filling the rest of the report
+ *                  -> [status] [next sequence] [staged hi] [staged lo], only every VIA_BULK_WINDOW reports,
+ *                     after the last, or straight away for a report out of sequence
+ *   id_bulk_end    [crc32, most significant byte first]
+ *                  -> [status] [bytes changed hi] [bytes changed lo]
+ *
+ * With VIA_BULK_COMPRESSED set in the flags the payload is a stream of tokens: a byte below 0x80 is followed
+ * by that many plus one literal bytes, one from 0x80 up is followed by a distance of two bytes and copies
+ * its low seven bits plus three bytes from that far back in what was written so far. Copies may overlap
+ * what they write, which makes runs of the same keycode a single token.
+ *
+ * Nothing reaches the EEPROM until the CRC of the whole write checks out, and then only the bytes which changed.
+ *
+ * A read of up to VIA_BULK_WINDOW reports' worth goes as:
+ *
+ *   id_bulk_read   [target] [offset hi] [offset lo] [length hi] [length lo]
+ *                  -> [status] [sequence] [data...] for each report
+ */
+
+#define VIA_BULK_COMPRESSED 0x01
+
+static uint8_t staging[VIA_BULK_BUFFER_SIZE];
+
+static struct {
+    bool     active;
+    bool     compressed;
+    bool     resend_requested;
+    uint8_t  target;
+    uint8_t  sequence;
+    uint16_t offset;
+    uint16_t length;
+    uint16_t staged;
+    // Decoder state, tokens may span reports
+    uint8_t literal;
+    uint8_t copy;
+    uint8_t distance_bytes;
+    uint8_t distance_high;
+} bulk;
+
+static uint16_t target_size(uint8_t target) {
+    switch (target) {
+        case id_bulk_keymap:
+            return dynamic_keymap_get_layer_count() * MATRIX_ROWS * MATRIX_COLS * 2;
+        case id_bulk_macro:
+            return dynamic_keymap_macro_get_buffer_size();
+        default:
+            return 0;
+    }
+}
+
+static void target_read(uint8_t target, uint16_t offset, uint16_t size, uint8_t *data) {
+    if (target == id_bulk_keymap) {
+        dynamic_keymap_get_buffer(offset, size, data);
+    } else {
+        dynamic_keymap_macro_get_buffer(offset, size, data);
+    }
+}
+
+static void target_write(uint8_t target, uint16_t offset, uint16_t size, uint8_t *data) {
+    if (target == id_bulk_keymap) {
+        dynamic_keymap_set_buffer(offset, size, data);
+    } else {
+        dynamic_keymap_macro_set_buffer(offset, size, data);
+    }
+}
+
+static uint8_t check_range(uint8_t target, uint16_t offset, uint16_t length) {
+    uint16_t size = target_size(target);
+    if (!size) {
+        return id_bulk_bad_target;
+    }
+    if (offset > size || length > size - offset) {
+        return id_bulk_bad_range;
+    }
+    return id_bulk_ok;
+}
+
+static uint32_t crc32(const uint8_t *data, uint16_t length) {
+    uint32_t crc = 0xFFFFFFFF;
+    for (uint16_t i = 0; i < length; i++) {
+        crc ^= data[i];
+        for (uint8_t bit = 0; bit < 8; bit++) {
+            crc = (crc >> 1) ^ (0xEDB88320 & -(crc & 1));
+        }
+    }
+    return ~crc;
+}
+
+static bool stage(uint8_t value) {
+    if (bulk.staged >= bulk.length) {
+        return false;
+    }
+    staging[bulk.staged++] = value;
+    return true;
+}
+
+static bool decode(uint8_t value) {
+    if (!bulk.compressed) {
+        return stage(value);
+    }
+    if (bulk.literal) {
+        bulk.literal--;
+        return stage(value);
+    }
+    if (bulk.copy) {
+        if (!bulk.distance_bytes++) {
+            bulk.distance_high = value;
+            return true;
+        }
+        uint16_t distance   = (bulk.distance_high << 8) | value;
+        uint8_t  copy       = bulk.copy;
+        bulk.copy           = 0;
+        bulk.distance_bytes = 0;
+        if (distance == 0 || distance > bulk.staged) {
+            return false;
+        }
+        while (copy--) {
+            if (!stage(staging[bulk.staged - distance])) {
+                return false;
+            }
+        }
+        return true;
+    }
+    if (value & 0x80) {
+        bulk.copy = (value & 0x7F) + 3;
+    } else {
+        bulk.literal = value + 1;
+    }
+    return true;
+}
+
+// Writes only what changed, in as few EEPROM updates as the comparison allows
+static uint16_t commit(void) {
+    uint16_t changed = 0;
+    for (uint16_t start = 0; start < bulk.length; start += 32) {
+        uint8_t current[32];
+        uint8_t size = MIN(bulk.length - start, sizeof(current));
+        target_read(bulk.target, bulk.offset + start, size, current);
+
+        uint8_t first = 0, last = 0;
+        for (uint8_t i = 0; i < size; i++) {
+            if (current[i] != staging[start + i]) {
+                if (!last) first = i;
+                last = i + 1;
+                changed++;
+            }
+        }
+        if (last) {
+            target_write(bulk.target, bulk.offset + start + first, last - first, &staging[start + first]);
+        }
+    }
+    return changed;
+}
+
+static bool bulk_begin(uint8_t *command_data) {
+    uint8_t  target = command_data[0];
+    uint16_t offset = (command_data[2] << 8) | command_data[3];
+    uint16_t size   = (command_data[4] << 8) | command_data[5];
+
+    memset(&bulk, 0, sizeof(bulk));
+    uint8_t status = check_range(target, offset, size);
+    if (status == id_bulk_ok && size > VIA_BULK_BUFFER_SIZE) {
+        status = id_bulk_bad_range;
+    }
+    if (status == id_bulk_ok) {
+        bulk.active     = true;
+        bulk.compressed = command_data[1] & VIA_BULK_COMPRESSED;
+        bulk.target     = target;
+        bulk.offset     = offset;
+        bulk.length     = size;
+    }
+
+    command_data[0] = status;
+    command_data[1] = VIA_BULK_WINDOW;
+    command_data[2] = VIA_BULK_BUFFER_SIZE >> 8;
+    command_data[3] = VIA_BULK_BUFFER_SIZE & 0xFF;
+    return true;
+}
+
+static bool bulk_data(uint8_t *command_data, uint8_t length) {
+    if (!bulk.active) {
+        command_data[0] = id_bulk_not_started;
+        return true;
+    }
+
+    uint8_t sequence = command_data[0];
+    if (sequence != bulk.sequence) {
+        // Reports already sent ahead of a lost one would each ask again, so only ask once for those
+        bool ahead = (int8_t)(sequence - bulk.sequence) > 0;
+        if (ahead && bulk.resend_requested) {
+            return false;
+        }
+        bulk.resend_requested = ahead;
+        command_data[0]       = id_bulk_out_of_order;
+        command_data[1]       = bulk.sequence;
+        return true;
+    }
+    bulk.resend_requested = false;
+    bulk.sequence++;
+
+    // Whatever pads out the last report is left alone
+    for (uint8_t i = 1; i < length && bulk.staged < bulk.length; i++) {
+        if (!decode(command_data[i])) {
+            bulk.active     = false;
+            command_data[0] = id_bulk_bad_data;
+            return true;
+        }
+    }
+
+    if (bulk.staged < bulk.length && bulk.sequence % VIA_BULK_WINDOW) {
+        return false;
+    }
+    command_data[0] = id_bulk_ok;
+    command_data[1] = bulk.sequence;
+    command_data[2] = bulk.staged >> 8;
+    command_data[3] = bulk.staged & 0xFF;
+    return true;
+}
+
+static bool bulk_end(uint8_t *command_data) {
+    uint32_t crc = ((uint32_t)command_data[0] << 24) | ((uint32_t)command_data[1] << 16) | ((uint32_t)command_data[2] << 8) | command_data[3];
+
+    uint16_t changed = 0;
+    if (!bulk.active) {
+        command_data[0] = id_bulk_not_started;
+    } else if (bulk.staged < bulk.length) {
+        command_data[0] = id_bulk_incomplete;
+    } else if (crc32(staging, bulk.length) != crc) {
+        command_data[0] = id_bulk_crc_mismatch;
+    } else {
+        changed         = commit();
+        command_data[0] = id_bulk_ok;
+    }
+    bulk.active = false;
+
+    command_data[1] = changed >> 8;
+    command_data[2] = changed & 0xFF;
+    return true;
+}
+
+static bool bulk_read(uint8_t *data, uint8_t length) {
+    uint8_t *command_data = &data[1];
+    uint8_t  target       = command_data[0];
+    uint16_t offset       = (command_data[1] << 8) | command_data[2];
+    uint16_t size         = (command_data[3] << 8) | command_data[4];
+    uint8_t  payload      = length - 3;
+
+    uint8_t status = check_range(target, offset, size);
+    if (status == id_bulk_ok && size > VIA_BULK_WINDOW * payload) {
+        status = id_bulk_bad_range;
+    }
+    if (status != id_bulk_ok) {
+        command_data[0] = status;
+        return true;
+    }
+
+    for (uint8_t sequence = 0; sequence == 0 || size; sequence++) {
+        uint8_t chunk = MIN(size, payload);
+        memset(command_data, 0, length - 1);
+        command_data[0] = id_bulk_ok;
+        command_data[1] = sequence;
+        target_read(target, offset, chunk, &command_data[2]);
+        raw_hid_send(data, length);
+        offset += chunk;
+        size -= chunk;
+    }
+    return false;
+}
+
+bool via_bulk_command(uint8_t *data, uint8_t length) {
+    uint8_t *command_id   = &(data[0]);
+    uint8_t *command_data = &(data[1]);
+
+    switch (*command_id) {
+        case id_bulk_begin:
+            return bulk_begin(command_data);
+        case id_bulk_data:
+            return bulk_data(command_data, length - 1);
+        case id_bulk_end:
+            return bulk_end(command_data);
+        case id_bulk_read:
+            return bulk_read(data, length);
+        default:
+            *command_id = id_unhandled;
+            return true;
+    }
+}
@@ -0,0 +1,28 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <stdint.h>
+#include <stdbool.h>
+
+// RAM a write is staged in until its CRC checks out, larger writes are split by the host
+#ifndef VIA_BULK_BUFFER_SIZE
+#    if defined(__AVR__)
+#        define VIA_BULK_BUFFER_SIZE 256
+#    else
+#        define VIA_BULK_BUFFER_SIZE 1024
+#    endif
+#endif
+
+// Data reports the host may send before waiting for an acknowledgement, and read reports sent per request
+#ifndef VIA_BULK_WINDOW
+#    define VIA_BULK_WINDOW 8
+#endif
+
+/**
+ * \brief Handles the bulk transfer commands, `id_bulk_begin` to `id_bulk_read`.
+ *
+ * \return Whether `data` holds a reply to send back. Data reports inside a window are not replied to.
+ */
+bool via_bulk_command(uint8_t *data, uint8_t length);
@@ -0,0 +1,5 @@
+# Copyright 2024 QMK
+# SPDX-License-Identifier: GPL-2.0-or-later
+
+AUDIO_ENABLE = yes
+AUDIO_DRIVER = dac_additive
@@ -0,0 +1,250 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "test_common.hpp"
+
+extern "C" {
+#include "dac_additive.h"
+
+void advance_time(uint32_t ms);
+}
+
+namespace {
+
+// Synthesis as done before the fixed-point core: float sample positions, and a division per tone and sample
+class FloatReferenceSynth {
+   public:
+    explicit FloatReferenceSynth(const std::vector<float> &frequencies) : frequencies_(frequencies), positions_(frequencies.size(), 0.0f) {}
+
+    uint16_t next() {
+        uint_fast16_t value = 0;
+        for (size_t i = 0; i < frequencies_.size(); i++) {
+            float position = positions_[i] + frequencies_[i] * ((float)AUDIO_DAC_BUFFER_SIZE / AUDIO_DAC_SAMPLE_RATE * 2.0f / 3.0f);
+            while (position >= AUDIO_DAC_BUFFER_SIZE)
+                position -= AUDIO_DAC_BUFFER_SIZE;
+            positions_[i] = position;
+            value += sine((size_t)position) / frequencies_.size();
+        }
+        return value;
+    }
+
+    // The default AUDIO_DAC_SAMPLE_WAVEFORM_SINE table
+    static uint16_t sine(size_t index) {
+        return std::lround(AUDIO_DAC_SAMPLE_MAX / 2.0 * (1.0 - std::cos(2.0 * M_PI * index / AUDIO_DAC_BUFFER_SIZE)));
+    }
+
+   private:
+    std::vector<float> frequencies_;
+    std::vector<float> positions_;
+};
+
+class AudioDac : public TestFixture {
+   public:
+    void SetUp() override {
+        TestFixture::SetUp();
+        audio_on();
+        audio_stop_all();
+        samples.clear();
+        render_until_stopped(1000);
+        samples.clear();
+        elapsed_ms = 0;
+    }
+
+    void TearDown() override {
+        audio_stop_all();
+        render_until_stopped(1000);
+        TestFixture::TearDown();
+    }
+
+    // Renders `count` half-buffers, advancing the timer along with the rendered audio. Returns false if the output was stopped
+    bool render(size_t count) {
+        bool running = true;
+        for (size_t i = 0; i < count; i++) {
+            dacsample_t half[AUDIO_DAC_BUFFER_SIZE / 2];
+            running = audio_dac_render(half, AUDIO_DAC_BUFFER_SIZE / 2);
+            samples.insert(samples.end(), half, half + AUDIO_DAC_BUFFER_SIZE / 2);
+
+            uint32_t ms = (uint64_t)samples.size() * 1000 / AUDIO_DAC_OUTPUT_RATE;
+            advance_time(ms - elapsed_ms);
+            elapsed_ms = ms;
+        }
+        return running;
+    }
+
+    size_t render_ms(uint32_t ms) {
+        size_t count = ((uint64_t)ms * AUDIO_DAC_OUTPUT_RATE / 1000 + AUDIO_DAC_BUFFER_SIZE / 2 - 1) / (AUDIO_DAC_BUFFER_SIZE / 2);
+        render(count);
+        return count;
+    }
+
+    bool render_until_stopped(uint32_t timeout_ms) {
+        uint32_t start = elapsed_ms;
+        while (elapsed_ms - start < timeout_ms) {
+            if (!render(1)) {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    // Index of the first sample after the fade-in, once the output follows the generated waveform
+    size_t first_active_sample() {
+        for (size_t s = 0; s < samples.size(); s++) {
+            if (samples[s] != AUDIO_DAC_OFF_VALUE) {
+                return s;
+            }
+        }
+        return samples.size();
+    }
+
+    // Counts the rising edges through AUDIO_DAC_OFF_VALUE between `start` and the end of the rendered samples
+    size_t count_rising_edges(size_t start) {
+        size_t edges = 0;
+        for (size_t s = start + 1; s < samples.size(); s++) {
+            if (samples[s - 1] < AUDIO_DAC_OFF_VALUE && samples[s] >= AUDIO_DAC_OFF_VALUE) {
+                edges++;
+            }
+        }
+        return edges;
+    }
+
+    // Writes the rendered samples as a 16bit mono WAV file next to the test binary, for listening to or diffing
+    void write_wav(const std::string &name) {
+        std::string path = ".build/test/audio_dac_" + name + ".wav";
+        FILE       *file = fopen(path.c_str(), "wb");
+        ASSERT_NE(file, nullptr) << path;
+
+        auto put32 = [file](uint32_t v) {
+            uint8_t b[4] = {(uint8_t)v, (uint8_t)(v >> 8), (uint8_t)(v >> 16), (uint8_t)(v >> 24)};
+            fwrite(b, 1, 4, file);
+        };
+        auto put16 = [file](uint16_t v) {
+            uint8_t b[2] = {(uint8_t)v, (uint8_t)(v >> 8)};
+            fwrite(b, 1, 2, file);
+        };
+
+        uint32_t data_size = samples.size() * 2;
+        fwrite("RIFF", 1, 4, file);
+        put32(36 + data_size);
+        fwrite("WAVEfmt ", 1, 8, file);
+        put32(16);                        // fmt chunk size
+        put16(1);                         // PCM
+        put16(1);                         // mono
+        put32(AUDIO_DAC_OUTPUT_RATE);     // sample rate
+        put32(AUDIO_DAC_OUTPUT_RATE * 2); // byte rate
+        put16(2);                         // block align
+        put16(16);                        // bits per sample
+        fwrite("data", 1, 4, file);
+        put32(data_size);
+        for (uint16_t sample : samples) {
+            put16((uint16_t)(((int32_t)sample - (int32_t)(AUDIO_DAC_SAMPLE_MAX / 2)) * 16));
+        }
+        fclose(file);
+    }
+
+    std::vector<uint16_t> samples;
+    uint32_t              elapsed_ms = 0;
+};
+
+TEST_F(AudioDac, OutputIsOffWhileStopped) {
+    EXPECT_FALSE(render(4));
+    for (uint16_t sample : samples) {
+        EXPECT_EQ(sample, AUDIO_DAC_OFF_VALUE);
+    }
+}
+
+TEST_F(AudioDac, SingleToneHasTheRequestedFrequency) {
+    audio_play_tone(440.0f);
+    render_ms(1000);
+    write_wav("tone_440");
+
+    size_t start = first_active_sample();
+    ASSERT_LT(start, samples.size());
+    double seconds = (double)(samples.size() - start) / AUDIO_DAC_OUTPUT_RATE;
+    EXPECT_NEAR(count_rising_edges(start) / seconds, 440.0, 2.0);
+}
+
+TEST_F(AudioDac, ChordMatchesExactSynthesis) {
+    const std::vector<float> chord = {261.63f, 329.63f, 392.00f};
+    for (float pitch : chord) {
+        audio_play_tone(pitch);
+    }
+    render_ms(500);
+    write_wav("chord");
+
+    std::vector<float> frequencies;
+    for (uint8_t i = 0; i < audio_get_number_of_active_tones(); i++) {
+        frequencies.push_back(audio_get_processed_frequency(i));
+    }
+    ASSERT_EQ(frequencies.size(), chord.size());
+
+    // The tones are snapshotted after the first rendered sample, so sample `s` is at `s` phase increments
+    size_t start = first_active_sample();
+    ASSERT_LT(start, samples.size());
+    double total_error = 0;
+    for (size_t s = start; s < samples.size(); s++) {
+        double value = 0;
+        for (float frequency : frequencies) {
+            double phase = std::fmod((double)s * frequency / AUDIO_DAC_OUTPUT_RATE, 1.0);
+            value += FloatReferenceSynth::sine((size_t)(phase * AUDIO_DAC_BUFFER_SIZE));
+        }
+        value /= frequencies.size();
+        ASSERT_NEAR(samples[s], value, 64.0) << "sample " << s;
+        total_error += std::fabs(samples[s] - value);
+    }
+    EXPECT_LT(total_error / (samples.size() - start), 2.0);
+}
+
+TEST_F(AudioDac, SongPlaysToTheEndAndStops) {
+    float song[][2] = SONG(STARTUP_SOUND);
+    PLAY_SONG(song);
+    EXPECT_TRUE(render_until_stopped(5000));
+    write_wav("startup_song");
+
+    EXPECT_FALSE(audio_is_playing_melody());
+    EXPECT_LT(first_active_sample(), samples.size());
+    EXPECT_GT(elapsed_ms, 100);
+    for (size_t s = samples.size() - AUDIO_DAC_BUFFER_SIZE / 2; s < samples.size(); s++) {
+        EXPECT_EQ(samples[s], AUDIO_DAC_OFF_VALUE);
+    }
+}
+
+TEST_F(AudioDac, FillBenchmark) {
+    const std::vector<float> chord = {261.63f, 329.63f, 392.00f, 523.25f};
+    for (float pitch : chord) {
+        audio_play_tone(pitch);
+    }
+    render_ms(50);
+    ASSERT_LT(first_active_sample(), samples.size());
+
+    const size_t          count = AUDIO_DAC_OUTPUT_RATE * 10;
+    std::vector<uint16_t> buffer(count);
+
+    auto start = std::chrono::steady_clock::now();
+    for (size_t s = 0; s < count; s += AUDIO_DAC_BUFFER_SIZE / 2) {
+        dac_additive_fill(&buffer[s], AUDIO_DAC_BUFFER_SIZE / 2);
+    }
+    auto fixed_ns = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start).count();
+
+    FloatReferenceSynth reference(chord);
+    uint32_t            checksum = 0;
+    start                        = std::chrono::steady_clock::now();
+    for (size_t s = 0; s < count; s++) {
+        checksum += reference.next();
+    }
+    auto float_ns = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start).count();
+
+    for (uint16_t sample : buffer) {
+        ASSERT_LE(sample, AUDIO_DAC_SAMPLE_MAX);
+    }
+    printf("10s of a %zu tone chord: fixed-point %.2f ns/sample, float %.2f ns/sample (checksum %u)\n", chord.size(), (double)fixed_ns / count, (double)float_ns / count, checksum);
+}
+
+} // namespace
@@ -0,0 +1,23 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+// qmk generate-autocorrect-flash en.txt de.txt
+static const uint8_t autocorrect_image[238] = {
+    0x51, 0x41, 0x43, 0x01, 0x02, 0x00, 0x00, 0x00, 0x65, 0x6E, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x9B, 0x00, 0x00, 0x05, 0x06, 0x04, 0x00, 0x00, 0x64, 0x65, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0xDD, 0x00, 0x00, 0x05, 0x06, 0x04, 0x00, 0x00, 0x68, 0x74, 0x00, 0x61, 0x73, 0x00, 0x65, 0x69,
+    0x72, 0x00, 0x6C, 0x74, 0x65, 0x72, 0x00, 0x63, 0x68, 0x6F, 0x6E, 0x00, 0x67, 0x74, 0x68, 0x00,
+    0x73, 0x65, 0x00, 0x68, 0x65, 0x00, 0x81, 0x3C, 0x00, 0x00, 0x44, 0x17, 0x11, 0x08, 0x0F, 0x46,
+    0x00, 0x00, 0x82, 0x2E, 0x00, 0x00, 0x43, 0x0B, 0x17, 0x2C, 0x52, 0x00, 0x00, 0x83, 0x32, 0x00,
+    0x00, 0x43, 0x17, 0x0C, 0x09, 0x5D, 0x00, 0x00, 0x02, 0x0C, 0x56, 0x00, 0x00, 0x0F, 0x61, 0x00,
+    0x00, 0x41, 0x08, 0x68, 0x00, 0x00, 0x81, 0x40, 0x00, 0x00, 0x44, 0x08, 0x0F, 0x04, 0x09, 0x76,
+    0x00, 0x00, 0x81, 0x3D, 0x00, 0x00, 0x45, 0x0B, 0x0A, 0x11, 0x08, 0x0F, 0x82, 0x00, 0x00, 0x82,
+    0x43, 0x00, 0x00, 0x44, 0x0B, 0x08, 0x17, 0x2C, 0x8F, 0x00, 0x00, 0x05, 0x0B, 0x4A, 0x00, 0x00,
+    0x15, 0x71, 0x00, 0x00, 0x16, 0x7A, 0x00, 0x00, 0x17, 0x86, 0x00, 0x00, 0x2C, 0x93, 0x00, 0x00,
+    0x81, 0x28, 0x00, 0x00, 0x44, 0x17, 0x06, 0x0C, 0x11, 0xB0, 0x00, 0x00, 0x83, 0x37, 0x00, 0x00,
+    0x44, 0x12, 0x06, 0x0B, 0x16, 0xBC, 0x00, 0x00, 0x45, 0x08, 0x0F, 0x17, 0x0C, 0x09, 0x5D, 0x00,
+    0x00, 0x82, 0x2B, 0x00, 0x00, 0x44, 0x04, 0x16, 0x07, 0x2C, 0xD1, 0x00, 0x00, 0x04, 0x0B, 0xB4,
+    0x00, 0x00, 0x11, 0xC0, 0x00, 0x00, 0x15, 0xC8, 0x00, 0x00, 0x2C, 0xD5, 0x00, 0x00
+};
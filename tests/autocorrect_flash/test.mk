@@ -0,0 +1,6 @@
+# Copyright 2024 QMK
+# SPDX-License-Identifier: GPL-2.0-or-later
+
+AUTOCORRECT_ENABLE = yes
+AUTOCORRECT_FLASH_ENABLE = yes
+FLASH_DRIVER = custom
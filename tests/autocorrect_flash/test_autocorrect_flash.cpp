@@ -0,0 +1,338 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <chrono>
+#include <cstring>
+#include <iostream>
+#include <map>
+#include <memory>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "keycode.h"
+#include "test_common.hpp"
+
+extern "C" {
+#include "autocorrect_flash.h"
+#include "process_autocorrect.h"
+#include "flash_spi.h"
+}
+
+#include "autocorrect_image.h"
+
+using ::testing::_;
+using ::testing::AnyNumber;
+using ::testing::InSequence;
+
+namespace {
+
+std::vector<uint8_t> flash;
+size_t               flash_reads;
+
+void load_image(const std::vector<uint8_t> &image) {
+    flash = image;
+    autocorrect_flash_reload();
+}
+
+// A trie of reversed typos in the image format, without sharing anything, to benchmark large dictionaries with
+class ImageBuilder {
+   public:
+    explicit ImageBuilder(uint8_t dictionary_count) : data(8 + 16 * dictionary_count) {
+        memcpy(data.data(), "QAC\x01", 4);
+        data[4] = dictionary_count;
+    }
+
+    void add(const char *name, const std::vector<std::pair<std::string, std::string>> &entries) {
+        Node    root;
+        uint8_t shortest = 0xFF, longest = 0, longest_correction = 0;
+        for (auto &[typo, correction] : entries) {
+            if (insert(root, typo, correction)) {
+                shortest = std::min<uint8_t>(shortest, typo.size());
+                longest  = std::max<uint8_t>(longest, typo.size());
+            }
+        }
+        uint32_t address = write(root, longest_correction);
+        uint8_t *entry   = &data[8 + 16 * dictionaries++];
+        strncpy((char *)entry, name, 8);
+        memcpy(entry + 8, &address, 3);
+        entry[11] = shortest;
+        entry[12] = longest;
+        entry[13] = longest_correction;
+    }
+
+    std::vector<uint8_t> data;
+
+   private:
+    struct Node {
+        std::map<uint8_t, std::unique_ptr<Node>> children;
+        bool                                     leaf = false;
+        uint8_t                                  backspaces;
+        std::string                              correction;
+    };
+
+    uint8_t dictionaries = 0;
+
+    static uint8_t keycode(char c) {
+        return c == ':' ? KC_SPC : c == '\'' ? KC_QUOT : KC_A + c - 'a';
+    }
+
+    // Typos may not end one another, as with the generator
+    static bool insert(Node &root, const std::string &typo, const std::string &correction) {
+        Node *node = &root;
+        for (auto c = typo.rbegin(); c != typo.rend(); c++) {
+            auto &child = node->children[keycode(*c)];
+            if (!child) {
+                child = std::make_unique<Node>();
+            }
+            node = child.get();
+            if (node->leaf) {
+                return false;
+            }
+        }
+        if (!node->children.empty()) {
+            return false;
+        }
+        size_t same = 0;
+        while (same < typo.size() && same < correction.size() && typo[same] == correction[same]) {
+            same++;
+        }
+        node->leaf       = true;
+        node->backspaces = typo.size() - same - 1;
+        node->correction = correction.substr(same);
+        return true;
+    }
+
+    void put_address(std::vector<uint8_t> &out, uint32_t address) {
+        out.insert(out.end(), {uint8_t(address), uint8_t(address >> 8), uint8_t(address >> 16)});
+    }
+
+    uint32_t write(const Node &start, uint8_t &longest_correction) {
+        std::vector<uint8_t> out;
+        if (start.leaf) {
+            uint32_t text = data.size();
+            data.insert(data.end(), start.correction.begin(), start.correction.end());
+            data.push_back(0);
+            longest_correction = std::max<uint8_t>(longest_correction, start.correction.size());
+            out.push_back(0x80 | start.backspaces);
+            put_address(out, text);
+        } else if (start.children.size() == 1) {
+            const Node *node = &start;
+            out.push_back(0x40);
+            while (node->children.size() == 1 && !node->leaf && out.size() <= 63) {
+                out.push_back(node->children.begin()->first);
+                node = node->children.begin()->second.get();
+            }
+            out[0] |= out.size() - 1;
+            put_address(out, write(*node, longest_correction));
+        } else {
+            out.push_back(start.children.size());
+            for (auto &[key, child] : start.children) {
+                out.push_back(key);
+                put_address(out, write(*child, longest_correction));
+            }
+        }
+        uint32_t address = data.size();
+        data.insert(data.end(), out.begin(), out.end());
+        return address;
+    }
+};
+
+std::string random_word(std::mt19937 &random, size_t min_length, size_t max_length) {
+    std::string word(std::uniform_int_distribution<size_t>(min_length, max_length)(random), ' ');
+    for (auto &c : word) {
+        c = std::uniform_int_distribution<char>('a', 'z')(random);
+    }
+    return word;
+}
+
+} // namespace
+
+extern "C" void flash_init(void) {}
+
+extern "C" flash_status_t flash_read_block(uint32_t addr, void *buf, size_t len) {
+    flash_reads++;
+    memset(buf, 0xFF, len);
+    if (addr < flash.size()) {
+        memcpy(buf, &flash[addr], std::min(len, flash.size() - addr));
+    }
+    return FLASH_STATUS_SUCCESS;
+}
+
+class AutocorrectFlash : public TestFixture {
+   public:
+    void SetUp() override {
+        autocorrect_enable();
+        load_image(std::vector<uint8_t>(autocorrect_image, autocorrect_image + sizeof(autocorrect_image)));
+    }
+
+    void TapKeys(std::initializer_list<KeymapKey> keys) {
+        for (auto key : keys) {
+            key.press();
+            run_one_scan_loop();
+            key.release();
+            run_one_scan_loop();
+        }
+    }
+
+    void Type(const std::string &text) {
+        for (char c : text) {
+            keyrecord_t record   = {};
+            record.event.pressed = true;
+            record.event.type    = KEY_EVENT;
+            process_autocorrect(c == ' ' ? KC_SPC : KC_A + c - 'a', &record);
+        }
+    }
+};
+
+TEST_F(AutocorrectFlash, Dictionaries) {
+    char name[AUTOCORRECT_FLASH_NAME_SIZE + 1];
+    EXPECT_EQ(autocorrect_flash_dictionary_count(), 2);
+    EXPECT_TRUE(autocorrect_flash_dictionary_name(0, name));
+    EXPECT_STREQ(name, "en");
+    EXPECT_TRUE(autocorrect_flash_dictionary_name(1, name));
+    EXPECT_STREQ(name, "de");
+    EXPECT_FALSE(autocorrect_flash_dictionary_name(2, name));
+
+    EXPECT_EQ(autocorrect_flash_selected(), 0);
+    EXPECT_EQ(autocorrect_flash_min_length(), 5);
+    EXPECT_TRUE(autocorrect_flash_select(1));
+    EXPECT_EQ(autocorrect_flash_selected(), 1);
+    EXPECT_FALSE(autocorrect_flash_select(2));
+    EXPECT_EQ(autocorrect_flash_selected(), 1);
+}
+
+TEST_F(AutocorrectFlash, NoImage) {
+    load_image(std::vector<uint8_t>(64, 0xFF));
+    EXPECT_EQ(autocorrect_flash_dictionary_count(), 0);
+    EXPECT_EQ(autocorrect_flash_min_length(), 0xFF);
+    EXPECT_FALSE(autocorrect_flash_select(0));
+
+    uint8_t typed[] = {KC_F, KC_A, KC_L, KC_E, KC_S};
+    uint8_t backspaces;
+    char    correction[AUTOCORRECT_FLASH_MAX_CORRECTION + 1];
+    EXPECT_FALSE(autocorrect_flash_find(typed, sizeof(typed), &backspaces, correction));
+}
+
+TEST_F(AutocorrectFlash, Find) {
+    auto find = [](const std::string &text) {
+        std::vector<uint8_t> typed;
+        for (char c : text) {
+            typed.push_back(c == ':' ? KC_SPC : KC_A + c - 'a');
+        }
+        uint8_t backspaces;
+        char    correction[AUTOCORRECT_FLASH_MAX_CORRECTION + 1];
+        if (!autocorrect_flash_find(typed.data(), typed.size(), &backspaces, correction)) {
+            return std::string("none");
+        }
+        return std::to_string(backspaces) + correction;
+    };
+
+    EXPECT_EQ(find(":fales"), "1se");
+    EXPECT_EQ(find("xfitler"), "3lter");
+    EXPECT_EQ(find(":teh:"), "2he");
+    EXPECT_EQ(find("teh:"), "none");
+    EXPECT_EQ(find(":thier"), "2eir");
+    EXPECT_EQ(find("xthier"), "none");
+    EXPECT_EQ(find("nicth"), "none");
+
+    autocorrect_flash_select(1);
+    EXPECT_EQ(find(":fales"), "none");
+    EXPECT_EQ(find("nicth"), "1ht");
+    EXPECT_EQ(find("fitler"), "3lter");
+    EXPECT_EQ(find(":dsa:"), "2as");
+}
+
+// The same corrections as with the dictionary in internal flash
+TEST_F(AutocorrectFlash, fales_to_false_autocorrection) {
+    TestDriver driver;
+    auto       key_f = KeymapKey(0, 0, 0, KC_F);
+    auto       key_a = KeymapKey(0, 1, 0, KC_A);
+    auto       key_l = KeymapKey(0, 2, 0, KC_L);
+    auto       key_e = KeymapKey(0, 3, 0, KC_E);
+    auto       key_s = KeymapKey(0, 4, 0, KC_S);
+
+    set_keymap({key_f, key_a, key_l, key_e, key_s});
+
+    EXPECT_CALL(driver, send_keyboard_mock(KeyboardReport())).Times(AnyNumber());
+    {
+        InSequence s;
+        EXPECT_CALL(driver, send_keyboard_mock(KeyboardReport(KC_F)));
+        EXPECT_CALL(driver, send_keyboard_mock(KeyboardReport(KC_A)));
+        EXPECT_CALL(driver, send_keyboard_mock(KeyboardReport(KC_L)));
+        EXPECT_CALL(driver, send_keyboard_mock(KeyboardReport(KC_E)));
+        EXPECT_CALL(driver, send_keyboard_mock(KeyboardReport(KC_BACKSPACE)));
+        EXPECT_CALL(driver, send_keyboard_mock(KeyboardReport(KC_S)));
+        EXPECT_CALL(driver, send_keyboard_mock(KeyboardReport(KC_E)));
+    }
+
+    TapKeys({key_f, key_a, key_l, key_e, key_s});
+
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(AutocorrectFlash, fales_not_corrected_in_other_dictionary) {
+    TestDriver driver;
+    auto       key_f = KeymapKey(0, 0, 0, KC_F);
+    auto       key_a = KeymapKey(0, 1, 0, KC_A);
+    auto       key_l = KeymapKey(0, 2, 0, KC_L);
+    auto       key_e = KeymapKey(0, 3, 0, KC_E);
+    auto       key_s = KeymapKey(0, 4, 0, KC_S);
+
+    set_keymap({key_f, key_a, key_l, key_e, key_s});
+
+    EXPECT_CALL(driver, send_keyboard_mock(KeyboardReport())).Times(AnyNumber());
+    {
+        InSequence s;
+        EXPECT_CALL(driver, send_keyboard_mock(KeyboardReport(KC_F)));
+        EXPECT_CALL(driver, send_keyboard_mock(KeyboardReport(KC_A)));
+        EXPECT_CALL(driver, send_keyboard_mock(KeyboardReport(KC_L)));
+        EXPECT_CALL(driver, send_keyboard_mock(KeyboardReport(KC_E)));
+        EXPECT_CALL(driver, send_keyboard_mock(KeyboardReport(KC_S)));
+    }
+
+    autocorrect_flash_select(1);
+    TapKeys({key_f, key_a, key_l, key_e, key_s});
+
+    VERIFY_AND_CLEAR(driver);
+}
+
+// Per keystroke cost of 10k typos, typing random words with some of the typos among them
+TEST_F(AutocorrectFlash, Benchmark10kEntries) {
+    TestDriver driver;
+    EXPECT_ANY_REPORT(driver).Times(AnyNumber());
+
+    std::mt19937                                     random(1);
+    std::vector<std::pair<std::string, std::string>> entries;
+    while (entries.size() < 10000) {
+        std::string typo       = random_word(random, 6, 10);
+        std::string correction = typo;
+        size_t      position   = std::uniform_int_distribution<size_t>(0, typo.size() - 1)(random);
+        correction[position]   = correction[position] == 'z' ? 'a' : correction[position] + 1;
+        entries.push_back({typo, correction});
+    }
+    ImageBuilder image(1);
+    image.add("bench", entries);
+    load_image(image.data);
+    ASSERT_EQ(autocorrect_flash_min_length(), 6);
+
+    const int keystrokes_wanted = 50000;
+    int       keystrokes = 0, typos = 0;
+    size_t    reads_before = flash_reads;
+    auto      start        = std::chrono::steady_clock::now();
+    while (keystrokes < keystrokes_wanted) {
+        bool        typo = std::uniform_int_distribution<int>(0, 9)(random) == 0;
+        std::string word = typo ? entries[std::uniform_int_distribution<size_t>(0, entries.size() - 1)(random)].first : random_word(random, 2, 9);
+        Type(word + " ");
+        keystrokes += word.size() + 1;
+        typos += typo;
+    }
+    auto elapsed = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start).count();
+
+    double reads = double(flash_reads - reads_before) / keystrokes;
+    std::cout << "10000 typos in " << image.data.size() << " bytes, " << keystrokes << " keystrokes with " << typos << " typos: " << reads << " flash reads of " << AUTOCORRECT_FLASH_CACHE_LINE_SIZE << " bytes and " << elapsed / keystrokes << " ns per keystroke on the host" << std::endl;
+
+    // Random typos fill the first levels of the trie with branches of every letter, each spanning several lines
+    EXPECT_LT(reads, 8.0);
+    VERIFY_AND_CLEAR(driver);
+}
@@ -0,0 +1,302 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <algorithm>
+#include <map>
+#include <random>
+#include <set>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+extern "C" {
+#include "deferred_exec.h"
+#include "timer.h"
+void advance_time(uint32_t ms);
+}
+
+namespace {
+
+struct Call {
+    uint32_t now;
+    uint32_t trigger_time;
+    uintptr_t id;
+};
+
+std::vector<Call> calls;
+
+uint32_t record_call(uint32_t trigger_time, void *cb_arg) {
+    calls.push_back({timer_read32(), trigger_time, (uintptr_t)cb_arg});
+    return 0;
+}
+
+uint32_t repeat_every_10ms(uint32_t trigger_time, void *cb_arg) {
+    record_call(trigger_time, cb_arg);
+    return calls.size() < 3 ? 10 : 0;
+}
+
+class DeferredExec : public ::testing::Test {
+   protected:
+    void SetUp() override {
+        calls.clear();
+        // Leave the throttle of the last test behind
+        advance_time(1);
+        deferred_exec_task();
+    }
+
+    void TearDown() override {
+        for (deferred_token token : tokens) {
+            cancel_deferred_exec(token);
+        }
+        uint32_t trigger_time;
+        EXPECT_FALSE(deferred_exec_next_deadline(&trigger_time));
+    }
+
+    deferred_token defer(uint32_t delay_ms, deferred_exec_callback callback, uintptr_t id) {
+        deferred_token token = defer_exec(delay_ms, callback, (void *)id);
+        tokens.push_back(token);
+        return token;
+    }
+
+    void run_for(uint32_t ms) {
+        for (uint32_t i = 0; i < ms; ++i) {
+            advance_time(1);
+            deferred_exec_task();
+        }
+    }
+
+    std::vector<deferred_token> tokens;
+};
+
+TEST_F(DeferredExec, CallbackRunsOnceTheDelayHasPassed) {
+    uint32_t start = timer_read32();
+    EXPECT_NE(defer(10, record_call, 1), INVALID_DEFERRED_TOKEN);
+
+    run_for(9);
+    EXPECT_TRUE(calls.empty());
+    run_for(1);
+    ASSERT_EQ(calls.size(), 1);
+    EXPECT_EQ(calls[0].now, start + 10);
+    EXPECT_EQ(calls[0].trigger_time, start + 10);
+    run_for(100);
+    EXPECT_EQ(calls.size(), 1);
+}
+
+TEST_F(DeferredExec, RepeatsFromThePreviousTrigger) {
+    uint32_t start = timer_read32();
+    defer(5, repeat_every_10ms, 1);
+
+    run_for(100);
+    ASSERT_EQ(calls.size(), 3);
+    EXPECT_EQ(calls[0].trigger_time, start + 5);
+    EXPECT_EQ(calls[1].trigger_time, start + 15);
+    EXPECT_EQ(calls[2].trigger_time, start + 25);
+}
+
+TEST_F(DeferredExec, CallbacksRunInTriggerOrder) {
+    uint32_t start = timer_read32();
+    defer(30, record_call, 3);
+    defer(10, record_call, 1);
+    defer(20, record_call, 2);
+
+    uint32_t trigger_time;
+    ASSERT_TRUE(deferred_exec_next_deadline(&trigger_time));
+    EXPECT_EQ(trigger_time, start + 10);
+
+    // All of them are due by the time the task gets to run
+    advance_time(50);
+    deferred_exec_task();
+    ASSERT_EQ(calls.size(), 3);
+    EXPECT_EQ(calls[0].id, 1);
+    EXPECT_EQ(calls[1].id, 2);
+    EXPECT_EQ(calls[2].id, 3);
+}
+
+TEST_F(DeferredExec, ExtendAndCancel) {
+    uint32_t       start = timer_read32();
+    deferred_token a     = defer(10, record_call, 1);
+    deferred_token b     = defer(20, record_call, 2);
+
+    run_for(5);
+    EXPECT_TRUE(extend_deferred_exec(a, 30));
+    EXPECT_TRUE(cancel_deferred_exec(b));
+    EXPECT_FALSE(cancel_deferred_exec(b));
+    EXPECT_FALSE(extend_deferred_exec(b, 10));
+
+    uint32_t trigger_time;
+    ASSERT_TRUE(deferred_exec_next_deadline(&trigger_time));
+    EXPECT_EQ(trigger_time, start + 35);
+
+    run_for(100);
+    ASSERT_EQ(calls.size(), 1);
+    EXPECT_EQ(calls[0].id, 1);
+    EXPECT_EQ(calls[0].now, start + 35);
+    EXPECT_FALSE(cancel_deferred_exec(a));
+}
+
+TEST_F(DeferredExec, RejectsInvalidRequests) {
+    EXPECT_EQ(defer_exec(0, record_call, NULL), INVALID_DEFERRED_TOKEN);
+    EXPECT_EQ(defer_exec(10, NULL, NULL), INVALID_DEFERRED_TOKEN);
+    EXPECT_FALSE(cancel_deferred_exec(INVALID_DEFERRED_TOKEN));
+    EXPECT_FALSE(extend_deferred_exec(INVALID_DEFERRED_TOKEN, 10));
+}
+
+TEST_F(DeferredExec, FullTableRejectsMore) {
+    std::set<deferred_token> live;
+    for (int i = 0; i < 8; ++i) {
+        deferred_token token = defer(10 + i, record_call, i);
+        ASSERT_NE(token, INVALID_DEFERRED_TOKEN);
+        live.insert(token);
+    }
+    EXPECT_EQ(live.size(), 8);
+    EXPECT_EQ(defer_exec(10, record_call, NULL), INVALID_DEFERRED_TOKEN);
+
+    // Freed entries can be used again, under a token that was not just cancelled
+    EXPECT_TRUE(cancel_deferred_exec(tokens[3]));
+    deferred_token token = defer(10, record_call, 8);
+    EXPECT_NE(token, INVALID_DEFERRED_TOKEN);
+    EXPECT_NE(token, tokens[3]);
+    EXPECT_EQ(live.count(token), 0);
+}
+
+deferred_executor_t *requeue_table;
+deferred_token       requeue_token;
+
+uint32_t cancel_and_requeue(uint32_t trigger_time, void *cb_arg) {
+    record_call(trigger_time, cb_arg);
+    cancel_deferred_exec_advanced(requeue_table, 4, requeue_token);
+    if (calls.size() < 3) {
+        requeue_token = defer_exec_advanced(requeue_table, 4, 7, cancel_and_requeue, cb_arg);
+    }
+    // Ignored, as the executor was cancelled
+    return 1;
+}
+
+TEST_F(DeferredExec, CallbackCanCancelAndRequeueItself) {
+    deferred_executor_t table[4] = {};
+    uint32_t            last     = 0;
+    uint32_t            start    = timer_read32();
+    requeue_table                = table;
+    requeue_token                = defer_exec_advanced(table, 4, 3, cancel_and_requeue, NULL);
+
+    for (int i = 0; i < 100; ++i) {
+        advance_time(1);
+        deferred_exec_advanced_task(table, 4, &last);
+    }
+    ASSERT_EQ(calls.size(), 3);
+    EXPECT_EQ(calls[0].now, start + 3);
+    EXPECT_EQ(calls[1].now, start + 10);
+    EXPECT_EQ(calls[2].now, start + 17);
+
+    uint32_t trigger_time;
+    EXPECT_FALSE(deferred_exec_advanced_next_deadline(table, 4, &trigger_time));
+}
+
+// Hundreds of executors in one table, checked against a simple model of what should be pending
+class DeferredExecStress : public ::testing::TestWithParam<size_t> {};
+
+std::map<uintptr_t, uint32_t> expected_triggers;
+uint32_t                      stress_delay;
+
+uint32_t stress_callback(uint32_t trigger_time, void *cb_arg) {
+    uintptr_t id = (uintptr_t)cb_arg;
+    // Time moves on by up to 2ms between tasks
+    EXPECT_LE(timer_read32() - trigger_time, 2);
+    EXPECT_EQ(expected_triggers.count(id), 1);
+    EXPECT_EQ(expected_triggers[id], trigger_time);
+    calls.push_back({timer_read32(), trigger_time, id});
+
+    // Some repeat, the rest are done
+    if (id % 3 == 0 && stress_delay > 0) {
+        expected_triggers[id] = trigger_time + stress_delay;
+        return stress_delay;
+    }
+    expected_triggers.erase(id);
+    return 0;
+}
+
+TEST_P(DeferredExecStress, MatchesModel) {
+    const size_t                     count = GetParam();
+    std::vector<deferred_executor_t> table(count);
+    std::map<uintptr_t, deferred_token> tokens;
+    std::mt19937                     rng(count);
+    uint32_t                         last    = 0;
+    uintptr_t                        next_id = 0;
+
+    calls.clear();
+    expected_triggers.clear();
+
+    for (int step = 0; step < 20000; ++step) {
+        uint32_t now = timer_read32();
+
+        // Drop the tokens of the executors which have finished
+        for (auto it = tokens.begin(); it != tokens.end();) {
+            it = expected_triggers.count(it->first) ? std::next(it) : tokens.erase(it);
+        }
+
+        switch (rng() % 4) {
+            case 0:
+            case 1: {
+                uint32_t       delay = 1 + rng() % 200;
+                uintptr_t      id    = next_id++;
+                deferred_token token = defer_exec_advanced(table.data(), count, delay, stress_callback, (void *)id);
+                if (tokens.size() == count) {
+                    EXPECT_EQ(token, INVALID_DEFERRED_TOKEN);
+                    break;
+                }
+                ASSERT_NE(token, INVALID_DEFERRED_TOKEN);
+                for (auto &pending : tokens) {
+                    ASSERT_NE(pending.second, token);
+                }
+                tokens[id]            = token;
+                expected_triggers[id] = now + delay;
+                break;
+            }
+            case 2:
+                if (!tokens.empty()) {
+                    auto it = std::next(tokens.begin(), rng() % tokens.size());
+                    ASSERT_TRUE(cancel_deferred_exec_advanced(table.data(), count, it->second));
+                    EXPECT_FALSE(cancel_deferred_exec_advanced(table.data(), count, it->second));
+                    expected_triggers.erase(it->first);
+                    tokens.erase(it);
+                }
+                break;
+            case 3:
+                if (!tokens.empty()) {
+                    auto     it    = std::next(tokens.begin(), rng() % tokens.size());
+                    uint32_t delay = 1 + rng() % 200;
+                    ASSERT_TRUE(extend_deferred_exec_advanced(table.data(), count, it->second, delay));
+                    expected_triggers[it->first] = now + delay;
+                }
+                break;
+        }
+
+        uint32_t trigger_time;
+        if (expected_triggers.empty()) {
+            EXPECT_FALSE(deferred_exec_advanced_next_deadline(table.data(), count, &trigger_time));
+        } else {
+            uint32_t earliest = std::min_element(expected_triggers.begin(), expected_triggers.end(), [](auto &a, auto &b) { return a.second < b.second; })->second;
+            ASSERT_TRUE(deferred_exec_advanced_next_deadline(table.data(), count, &trigger_time));
+            ASSERT_EQ(trigger_time, earliest);
+        }
+
+        stress_delay = 1 + rng() % 50;
+        advance_time(rng() % 3);
+        deferred_exec_advanced_task(table.data(), count, &last);
+    }
+
+    // Everything left runs on time, and then the table is empty
+    for (int i = 0; i < 1000; ++i) {
+        stress_delay = 0;
+        advance_time(1);
+        deferred_exec_advanced_task(table.data(), count, &last);
+    }
+    uint32_t trigger_time;
+    EXPECT_FALSE(deferred_exec_advanced_next_deadline(table.data(), count, &trigger_time));
+    EXPECT_TRUE(expected_triggers.empty());
+    EXPECT_GT(calls.size(), count);
+}
+
+INSTANTIATE_TEST_CASE_P(TableSizes, DeferredExecStress, ::testing::Values(1, 8, 100, 255));
+
+} // namespace
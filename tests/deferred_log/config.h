@@ -0,0 +1,11 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include "test_common.h"
+
+#define DEFERRED_LOG_BUFFER_SIZE 128
+
+// Single threaded on the host
+#define IGNORE_ATOMIC_BLOCK
@@ -0,0 +1,190 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <algorithm>
+#include <cstring>
+#include <string>
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "gmock/gmock.h"
+
+extern "C" {
+#include "debug.h"
+#include "deferred_log.h"
+}
+
+using testing::ElementsAreArray;
+
+namespace {
+
+std::vector<uint8_t> host;
+size_t               budget = SIZE_MAX;
+
+struct Record {
+    uint32_t             id;
+    std::vector<uint8_t> args;
+};
+
+std::vector<Record> records(const std::vector<uint8_t> &stream) {
+    std::vector<Record> found;
+    for (size_t i = 0; i + 1 < stream.size();) {
+        EXPECT_EQ(stream[i], DEFERRED_LOG_SYNC) << "at " << i;
+        uint8_t length = stream[i + 1];
+        EXPECT_LE(i + 2 + length, stream.size());
+        uint32_t id = stream[i + 2] | stream[i + 3] << 8 | stream[i + 4] << 16 | (uint32_t)stream[i + 5] << 24;
+        found.push_back({id, std::vector<uint8_t>(&stream[i + 6], &stream[i + 2 + length])});
+        i += 2 + length;
+    }
+    return found;
+}
+
+std::vector<uint8_t> u32(uint32_t value) {
+    return {(uint8_t)value, (uint8_t)(value >> 8), (uint8_t)(value >> 16), (uint8_t)(value >> 24)};
+}
+
+std::vector<uint8_t> operator+(std::vector<uint8_t> a, const std::vector<uint8_t> &b) {
+    a.insert(a.end(), b.begin(), b.end());
+    return a;
+}
+
+std::vector<uint8_t> str(const char *s) {
+    return std::vector<uint8_t>(s, s + strlen(s) + 1);
+}
+
+} // namespace
+
+extern "C" uint8_t deferred_log_send(const uint8_t *data, uint8_t length) {
+    uint8_t taken = std::min<size_t>(length, budget);
+    host.insert(host.end(), data, data + taken);
+    budget -= taken;
+    return taken;
+}
+
+class DeferredLog : public ::testing::Test {
+   protected:
+    void SetUp() override {
+        budget = SIZE_MAX;
+        deferred_log_task();
+        host.clear();
+    }
+
+    std::vector<Record> flush() {
+        budget = SIZE_MAX;
+        deferred_log_task();
+        auto found = records(host);
+        host.clear();
+        return found;
+    }
+};
+
+TEST_F(DeferredLog, AppendsArgumentsRaw) {
+    static const char format[] = "%d %u %02x %c %s %5.*d%% %p";
+    deferred_log_write(format, -5, 7u, 0xABu, 'q', "hi", 3, 42, (void *)0x1234);
+
+    auto found = flush();
+    ASSERT_EQ(found.size(), 1);
+    EXPECT_EQ(found[0].id, (uint32_t)(uintptr_t)format);
+    EXPECT_THAT(found[0].args, ElementsAreArray(u32(-5) + u32(7) + u32(0xAB) + u32('q') + str("hi") + u32(3) + u32(42) + u32(0x1234)));
+}
+
+TEST_F(DeferredLog, TakesLengthModifiersOffTheList) {
+    static const char format[] = "%ld %lu %zu %hhx %lld %s";
+    deferred_log_write(format, -70000L, 70000UL, (size_t)9, 0x1FF, 5LL, "end");
+
+    auto found = flush();
+    ASSERT_EQ(found.size(), 1);
+    EXPECT_THAT(found[0].args, ElementsAreArray(u32(-70000) + u32(70000) + u32(9) + u32(0x1FF) + u32(5) + str("end")));
+}
+
+TEST_F(DeferredLog, CutsLongArgumentsShort) {
+    static const char format[] = "%s %s %u %u %u %u %u %u %u";
+    deferred_log_write(format, "a string well past the limit", "second string cut", 1, 2, 3, 4, 5, 6, 7);
+
+    auto found = flush();
+    ASSERT_EQ(found.size(), 1);
+    std::string first(found[0].args.begin(), found[0].args.begin() + DEFERRED_LOG_MAX_STRING);
+    EXPECT_EQ(first, std::string("a string well past the limit", DEFERRED_LOG_MAX_STRING));
+    EXPECT_EQ(found[0].args[DEFERRED_LOG_MAX_STRING], 0);
+    EXPECT_LE(found[0].args.size() + DEFERRED_LOG_HEADER_SIZE, DEFERRED_LOG_MAX_RECORD);
+    // Whole arguments only, the host fills in the rest
+    EXPECT_EQ((found[0].args.size() - 2 * (DEFERRED_LOG_MAX_STRING + 1)) % 4, 0);
+}
+
+TEST_F(DeferredLog, DebugPrintsGoThroughTheRing) {
+    debug_enable = true;
+    dprintf("matrix %u\n", 5);
+    print("no arguments");
+    for (int i = 0; i < 2; i++) {
+        dprintf("loop %d\n", i);
+    }
+    debug_enable = false;
+    dprintf("not shown %d\n", 1);
+
+    auto found = flush();
+    ASSERT_EQ(found.size(), 4);
+    EXPECT_THAT(found[0].args, ElementsAreArray(u32(5)));
+    EXPECT_TRUE(found[1].args.empty());
+    EXPECT_NE(found[0].id, found[1].id);
+    // Log sites keep their ID
+    EXPECT_EQ(found[2].id, found[3].id);
+    EXPECT_NE(found[2].id, found[0].id);
+    EXPECT_THAT(found[3].args, ElementsAreArray(u32(1)));
+}
+
+TEST_F(DeferredLog, DropsRatherThanWaitsWhenFull) {
+    static const char format[] = "%u";
+    budget                     = 0;
+
+    int written = 0;
+    for (uint32_t i = 0; i < 100; i++) {
+        if (deferred_log_write(format, i)) written++;
+    }
+    deferred_log_task();
+    EXPECT_TRUE(host.empty());
+    EXPECT_EQ(written, DEFERRED_LOG_BUFFER_SIZE / (DEFERRED_LOG_HEADER_SIZE + 4));
+    EXPECT_EQ(deferred_log_pending(), written * (DEFERRED_LOG_HEADER_SIZE + 4));
+
+    auto found = flush();
+    ASSERT_EQ(found.size(), written);
+    EXPECT_THAT(found.back().args, ElementsAreArray(u32(written - 1)));
+
+    // The count of those dropped goes out ahead of the next record
+    deferred_log_write(format, 1000);
+    found = flush();
+    ASSERT_EQ(found.size(), 2);
+    EXPECT_EQ(found[0].id, DEFERRED_LOG_DROPPED_ID);
+    EXPECT_THAT(found[0].args, ElementsAreArray(u32(100 - written)));
+    EXPECT_THAT(found[1].args, ElementsAreArray(u32(1000)));
+}
+
+TEST_F(DeferredLog, FlushesWhateverTheHostTakes) {
+    static const char format[] = "%u %s";
+    std::vector<uint8_t> stream;
+
+    // Round the ring several times with the host taking a few bytes at a time
+    uint32_t sent = 0;
+    for (uint32_t i = 0; i < 200; i++) {
+        if (deferred_log_write(format, i, i % 2 ? "odd" : "even")) sent++;
+        budget = 7;
+        deferred_log_task();
+        stream.insert(stream.end(), host.begin(), host.end());
+        host.clear();
+    }
+    budget = SIZE_MAX;
+    deferred_log_task();
+    stream.insert(stream.end(), host.begin(), host.end());
+    host.clear();
+
+    auto found = records(stream);
+    std::vector<uint32_t> values;
+    for (auto &record : found) {
+        if (record.id == DEFERRED_LOG_DROPPED_ID) continue;
+        uint32_t value = record.args[0] | record.args[1] << 8;
+        EXPECT_STREQ((const char *)&record.args[4], value % 2 ? "odd" : "even");
+        values.push_back(value);
+    }
+    EXPECT_EQ(values.size(), sent);
+    EXPECT_TRUE(std::is_sorted(values.begin(), values.end()));
+    EXPECT_EQ(deferred_log_pending(), 0);
+}
@@ -0,0 +1,198 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "gtest/gtest.h"
+#include "keyboard_report_util.hpp"
+#include "test_common.hpp"
+
+extern "C" {
+#include "latency_trace.h"
+}
+
+using testing::_;
+using testing::InSequence;
+
+class LatencyTrace : public TestFixture {
+   protected:
+    void SetUp() override {
+        latency_trace_reset();
+    }
+
+    latency_summary_t summary(latency_stage_t stage) {
+        latency_summary_t summary;
+        EXPECT_TRUE(latency_trace_summary(stage, &summary));
+        return summary;
+    }
+
+    // What the matrix reports when the key's switch closes or opens, ahead of debouncing
+    void raw_change(KeymapKey key, bool pressed) {
+        matrix_row_t previous[MATRIX_ROWS] = {0};
+        matrix_row_t current[MATRIX_ROWS]  = {0};
+        (pressed ? current : previous)[key.position.row] = (matrix_row_t)1 << key.position.col;
+        latency_trace_raw_changes(previous, current, 0, MATRIX_ROWS);
+    }
+};
+
+TEST_F(LatencyTrace, PlainKeysAreReportedInTheirOwnScan) {
+    TestDriver driver;
+    auto       key = KeymapKey(0, 0, 0, KC_A);
+    set_keymap({key});
+
+    EXPECT_REPORT(driver, (KC_A));
+    EXPECT_EMPTY_REPORT(driver);
+    tap_key(key);
+    VERIFY_AND_CLEAR(driver);
+
+    latency_summary_t total = summary(LATENCY_STAGE_TOTAL);
+    EXPECT_EQ(total.count, 2);
+    EXPECT_EQ(total.max_us, 0);
+    EXPECT_EQ(summary(LATENCY_STAGE_DEBOUNCE).count, 0);
+    EXPECT_EQ(latency_trace_unreported(), 0);
+}
+
+TEST_F(LatencyTrace, HeldModTapWaitsForTheTappingTerm) {
+    TestDriver driver;
+    auto       key = KeymapKey(0, 0, 0, LSFT_T(KC_P));
+    set_keymap({key});
+
+    EXPECT_NO_REPORT(driver);
+    key.press();
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+
+    EXPECT_REPORT(driver, (KC_LSFT));
+    idle_for(TAPPING_TERM);
+    VERIFY_AND_CLEAR(driver);
+
+    EXPECT_EMPTY_REPORT(driver);
+    key.release();
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+
+    // The press is held back by the tapping term, the release goes straight through
+    latency_summary_t process = summary(LATENCY_STAGE_PROCESS);
+    EXPECT_EQ(process.count, 2);
+    EXPECT_EQ(process.min_us, 0);
+    EXPECT_NEAR(process.max_us, TAPPING_TERM * 1000, 1000);
+    EXPECT_EQ(summary(LATENCY_STAGE_REPORT).max_us, 0);
+    EXPECT_EQ(summary(LATENCY_STAGE_TOTAL).max_us, process.max_us);
+}
+
+TEST_F(LatencyTrace, TappedModTapIsReportedOnRelease) {
+    TestDriver driver;
+    auto       key = KeymapKey(0, 0, 0, LSFT_T(KC_P));
+    set_keymap({key});
+
+    EXPECT_REPORT(driver, (KC_P));
+    EXPECT_EMPTY_REPORT(driver);
+    key.press();
+    idle_for(50);
+    key.release();
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+
+    latency_summary_t total = summary(LATENCY_STAGE_TOTAL);
+    EXPECT_EQ(total.count, 2);
+    EXPECT_EQ(total.min_us, 0);
+    EXPECT_EQ(total.max_us, 50000);
+}
+
+TEST_F(LatencyTrace, LayerKeysAreNotReported) {
+    TestDriver driver;
+    auto       key = KeymapKey(0, 0, 0, MO(1));
+    set_keymap({key});
+
+    EXPECT_NO_REPORT(driver);
+    tap_key(key);
+    VERIFY_AND_CLEAR(driver);
+
+    EXPECT_EQ(summary(LATENCY_STAGE_PROCESS).count, 2);
+    EXPECT_EQ(summary(LATENCY_STAGE_TOTAL).count, 0);
+    EXPECT_EQ(latency_trace_unreported(), 2);
+}
+
+TEST_F(LatencyTrace, RawChangesAreTracedThroughDebounce) {
+    TestDriver driver;
+    auto       key = KeymapKey(0, 1, 2, KC_A);
+    set_keymap({key});
+
+    EXPECT_REPORT(driver, (KC_A));
+    raw_change(key, true);
+    idle_for(5);
+    key.press();
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+
+    latency_summary_t debounce = summary(LATENCY_STAGE_DEBOUNCE);
+    EXPECT_EQ(debounce.count, 1);
+    EXPECT_EQ(debounce.max_us, 5000);
+    EXPECT_EQ(summary(LATENCY_STAGE_TOTAL).max_us, 5000);
+
+    EXPECT_EMPTY_REPORT(driver);
+    key.release();
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(LatencyTrace, BouncesAreForgotten) {
+    TestDriver driver;
+    auto       key = KeymapKey(0, 1, 2, KC_A);
+    set_keymap({key});
+
+    // The contact bounces open again before debouncing lets the press through
+    raw_change(key, true);
+    run_one_scan_loop();
+    raw_change(key, false);
+    idle_for(5);
+
+    EXPECT_REPORT(driver, (KC_A));
+    key.press();
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+
+    EXPECT_EQ(summary(LATENCY_STAGE_DEBOUNCE).count, 0);
+    EXPECT_EQ(summary(LATENCY_STAGE_TOTAL).max_us, 0);
+
+    EXPECT_EMPTY_REPORT(driver);
+    key.release();
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST(LatencyHistogram, PercentilesAreWithinAnEighth) {
+    latency_histogram_t histogram;
+    latency_histogram_reset(&histogram);
+    for (uint32_t ms = 1; ms <= 100; ms++) {
+        latency_histogram_add(&histogram, ms * 1000);
+    }
+
+    latency_summary_t summary;
+    latency_histogram_summary(&histogram, &summary);
+    EXPECT_EQ(summary.count, 100);
+    EXPECT_EQ(summary.min_us, 1000);
+    EXPECT_EQ(summary.avg_us, 50500);
+    EXPECT_EQ(summary.max_us, 100000);
+    EXPECT_NEAR(summary.p50_us, 50000, 50000 / 8);
+    EXPECT_NEAR(summary.p99_us, 99000, 99000 / 8);
+}
+
+TEST(LatencyHistogram, SmallLatenciesAreExact) {
+    latency_histogram_t histogram;
+    latency_histogram_reset(&histogram);
+    for (uint32_t us = 0; us < 8; us++) {
+        latency_histogram_add(&histogram, us);
+        EXPECT_EQ(latency_histogram_percentile(&histogram, 1000), us);
+    }
+}
+
+TEST(LatencyHistogram, EmptyHistogramSummarisesToZero) {
+    latency_histogram_t histogram;
+    latency_histogram_reset(&histogram);
+
+    latency_summary_t summary;
+    latency_histogram_summary(&histogram, &summary);
+    EXPECT_EQ(summary.count, 0);
+    EXPECT_EQ(summary.min_us, 0);
+    EXPECT_EQ(summary.p99_us, 0);
+    EXPECT_EQ(summary.max_us, 0);
+}
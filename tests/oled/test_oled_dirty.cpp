@@ -0,0 +1,157 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <cstdio>
+#include <cstring>
+
+#include "gtest/gtest.h"
+
+extern "C" {
+#include "oled_driver.h"
+extern OLED_BLOCK_TYPE oled_dirty;
+}
+
+namespace {
+
+constexpr uint8_t DISPLAY_PAGES = OLED_DISPLAY_HEIGHT / 8;
+
+// Emulates the SH1107's page addressing mode, so what ends up on the panel can be compared between partial and full
+// renders, and counts the bytes going over the wire.
+struct FakePanel {
+    uint8_t  ram[DISPLAY_PAGES][OLED_DISPLAY_WIDTH];
+    uint8_t  page;
+    uint8_t  column;
+    uint32_t cmd_bytes;
+    uint32_t data_bytes;
+
+    void reset_counters() {
+        cmd_bytes  = 0;
+        data_bytes = 0;
+    }
+} panel;
+
+} // namespace
+
+extern "C" {
+
+void oled_driver_init(void) {}
+
+bool oled_send_cmd(const uint8_t *data, uint16_t size) {
+    panel.cmd_bytes += size;
+    for (uint16_t i = 1; i < size; ++i) {
+        uint8_t cmd = data[i];
+        if ((cmd & 0xF0) == 0xB0) {
+            panel.page = cmd & 0x0F;
+        } else if ((cmd & 0xF0) == 0x00) {
+            panel.column = (panel.column & 0xF0) | (cmd & 0x0F);
+        } else if ((cmd & 0xF0) == 0x10) {
+            panel.column = (panel.column & 0x0F) | ((cmd & 0x0F) << 4);
+        } else {
+            // Anything else is configuration, which the dirty tracking doesn't send
+            break;
+        }
+    }
+    return true;
+}
+
+bool oled_send_cmd_P(const uint8_t *data, uint16_t size) {
+    return true;
+}
+
+bool oled_send_data(const uint8_t *data, uint16_t size) {
+    panel.data_bytes += size;
+    for (uint16_t i = 0; i < size; ++i) {
+        if (panel.page < DISPLAY_PAGES && panel.column < OLED_DISPLAY_WIDTH) {
+            panel.ram[panel.page][panel.column] = data[i];
+        }
+        panel.column++;
+    }
+    return true;
+}
+
+} // extern "C"
+
+class OledDirty : public ::testing::TestWithParam<oled_rotation_t> {
+   protected:
+    void SetUp() override {
+        memset(&panel, 0, sizeof(panel));
+        oled_init(GetParam());
+        oled_render_dirty(true);
+        panel.reset_counters();
+    }
+
+    // Forces every block to be re-sent and checks the panel didn't change, i.e. the partial updates had already left
+    // it in the same state as a full redraw would.
+    void ExpectPanelMatchesFullRender() {
+        uint8_t partial[DISPLAY_PAGES][OLED_DISPLAY_WIDTH];
+        memcpy(partial, panel.ram, sizeof(partial));
+        memset(panel.ram, 0xAA, sizeof(panel.ram));
+        oled_dirty = (OLED_BLOCK_TYPE)~0;
+        oled_render_dirty(true);
+        EXPECT_EQ(memcmp(partial, panel.ram, sizeof(partial)), 0);
+    }
+};
+
+TEST_P(OledDirty, SingleCharacterOnlySendsTouchedBytes) {
+    oled_set_cursor(3, 2);
+    oled_write_char('Q', false);
+    oled_render_dirty(true);
+
+    // Previously the whole 64-byte block holding the character was sent; now it's the character's 6 columns, or the
+    // single 8x8 tile holding it when rotated
+    uint32_t expected = (GetParam() & OLED_ROTATION_90) ? 8 : OLED_FONT_WIDTH;
+    printf("rotation %d: one character sent %u data bytes, %u command bytes (block size %u)\n", (int)GetParam(), (unsigned)panel.data_bytes, (unsigned)panel.cmd_bytes, (unsigned)OLED_BLOCK_SIZE);
+    EXPECT_EQ(panel.data_bytes, expected);
+    ExpectPanelMatchesFullRender();
+}
+
+TEST_P(OledDirty, UnchangedCharacterSendsNothing) {
+    oled_set_cursor(0, 0);
+    oled_write(" ", false);
+    oled_render_dirty(true);
+    EXPECT_EQ(panel.data_bytes, 0u);
+    EXPECT_EQ(panel.cmd_bytes, 0u);
+}
+
+TEST_P(OledDirty, StatusLineUpdate) {
+    oled_set_cursor(0, 1);
+    oled_write_ln("Layer: Base", false);
+    oled_render_dirty(true);
+    panel.reset_counters();
+
+    // Typical status update, only the layer name changes
+    oled_set_cursor(0, 1);
+    oled_write_ln("Layer: Nav", false);
+    oled_render_dirty(true);
+    printf("rotation %d: status line update sent %u data bytes, %u command bytes\n", (int)GetParam(), (unsigned)panel.data_bytes, (unsigned)panel.cmd_bytes);
+    EXPECT_LT(panel.data_bytes, 2u * OLED_BLOCK_SIZE);
+    ExpectPanelMatchesFullRender();
+}
+
+TEST_P(OledDirty, ScatteredWritesMatchFullRender) {
+    uint32_t seed = 12345;
+    auto     next = [&seed]() {
+        seed = seed * 1103515245 + 12345;
+        return (seed >> 16) & 0x7FFF;
+    };
+    for (int round = 0; round < 20; ++round) {
+        for (int i = 0; i < 10; ++i) {
+            switch (next() % 3) {
+                case 0:
+                    oled_write_pixel(next() % 128, next() % 128, next() & 1);
+                    break;
+                case 1:
+                    oled_set_cursor(next() % oled_max_chars(), next() % oled_max_lines());
+                    oled_write_char('!' + next() % 90, next() & 1);
+                    break;
+                case 2:
+                    oled_write_raw_byte(next() & 0xFF, next() % OLED_MATRIX_SIZE);
+                    break;
+            }
+        }
+        oled_render_dirty(true);
+    }
+    ExpectPanelMatchesFullRender();
+}
+
+INSTANTIATE_TEST_CASE_P(Rotations, OledDirty, ::testing::Values(OLED_ROTATION_0, OLED_ROTATION_90, OLED_ROTATION_180, OLED_ROTATION_270));
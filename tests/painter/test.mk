@@ -0,0 +1,8 @@
+# Copyright 2024 QMK
+# SPDX-License-Identifier: GPL-2.0-or-later
+
+QUANTUM_PAINTER_ENABLE = yes
+QUANTUM_PAINTER_DRIVERS = surface
+
+VPATH += $(QUANTUM_DIR)/painter/lvgl
+SRC += $(QUANTUM_DIR)/painter/lvgl/qp_lvgl_transfer.c
@@ -0,0 +1,216 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <cstdio>
+#include <cstring>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+extern "C" {
+#include "qp.h"
+#include "qp_internal.h"
+#include "qp_surface.h"
+#include "timer.h"
+void qp_internal_animation_tick(void);
+void advance_time(uint32_t ms);
+}
+
+namespace {
+
+constexpr uint16_t IMAGE_WIDTH  = 64;
+constexpr uint16_t IMAGE_HEIGHT = 64;
+constexpr uint16_t FRAME_DELAY  = 40;
+constexpr uint16_t DELTA_LEFT   = 28;
+constexpr uint16_t DELTA_TOP    = 24;
+constexpr uint16_t DELTA_SIZE   = 8;
+constexpr uint16_t FRAME_COUNT  = 8;
+
+// Builds a QGF image in memory, as `qmk painter-convert-graphics` would emit for a typical animated logo: a full first
+// frame followed by small RGB565 delta frames.
+class QGFBuilder {
+   public:
+    void u8(uint8_t v) {
+        data.push_back(v);
+    }
+    void u16(uint16_t v) {
+        u8(v & 0xFF);
+        u8(v >> 8);
+    }
+    void u24(uint32_t v) {
+        u16(v & 0xFFFF);
+        u8((v >> 16) & 0xFF);
+    }
+    void u32(uint32_t v) {
+        u16(v & 0xFFFF);
+        u16(v >> 16);
+    }
+    void header(uint8_t type_id, uint32_t length) {
+        u8(type_id);
+        u8(~type_id);
+        u24(length);
+    }
+    void put32(size_t pos, uint32_t v) {
+        for (int i = 0; i < 4; ++i) {
+            data[pos + i] = (v >> (8 * i)) & 0xFF;
+        }
+    }
+
+    std::vector<uint8_t> data;
+};
+
+uint16_t frame_color(uint16_t frame) {
+    return 0x1111 * (frame + 1);
+}
+
+std::vector<uint8_t> make_animation(void) {
+    QGFBuilder qgf;
+
+    // Graphics descriptor
+    qgf.header(0x00, 18);
+    qgf.u24(0x464751);
+    qgf.u8(0x01);
+    size_t total_size_pos = qgf.data.size();
+    qgf.u32(0);
+    qgf.u32(0);
+    qgf.u16(IMAGE_WIDTH);
+    qgf.u16(IMAGE_HEIGHT);
+    qgf.u16(FRAME_COUNT);
+
+    // Frame offsets
+    qgf.header(0x01, FRAME_COUNT * sizeof(uint32_t));
+    size_t offsets_pos = qgf.data.size();
+    for (uint16_t i = 0; i < FRAME_COUNT; ++i) {
+        qgf.u32(0);
+    }
+
+    for (uint16_t i = 0; i < FRAME_COUNT; ++i) {
+        bool is_delta = i > 0;
+        qgf.put32(offsets_pos + i * sizeof(uint32_t), qgf.data.size());
+
+        // Frame descriptor: RGB565, uncompressed
+        qgf.header(0x02, 6);
+        qgf.u8(0x08);
+        qgf.u8(is_delta ? 0x02 : 0x00);
+        qgf.u8(0x00);
+        qgf.u8(0x00);
+        qgf.u16(FRAME_DELAY);
+
+        uint16_t w = IMAGE_WIDTH, h = IMAGE_HEIGHT;
+        if (is_delta) {
+            qgf.header(0x04, 8);
+            qgf.u16(DELTA_LEFT);
+            qgf.u16(DELTA_TOP);
+            qgf.u16(DELTA_LEFT + DELTA_SIZE - 1);
+            qgf.u16(DELTA_TOP + DELTA_SIZE - 1);
+            w = h = DELTA_SIZE;
+        }
+
+        // Pixel data, big-endian RGB565 as the panel expects it
+        qgf.header(0x05, w * h * 2);
+        for (uint32_t p = 0; p < (uint32_t)w * h; ++p) {
+            qgf.u8(frame_color(i) >> 8);
+            qgf.u8(frame_color(i) & 0xFF);
+        }
+    }
+
+    qgf.put32(total_size_pos, qgf.data.size());
+    qgf.put32(total_size_pos + 4, ~(uint32_t)qgf.data.size());
+    return qgf.data;
+}
+
+// Tracks what gets pushed to the panel by wrapping the surface's driver
+painter_driver_vtable_t     counting_vtable;
+painter_driver_pixdata_func surface_pixdata;
+uint32_t                    pixdata_bytes;
+
+bool counting_pixdata(painter_device_t device, const void *pixel_data, uint32_t native_pixel_count) {
+    pixdata_bytes += native_pixel_count * ((painter_driver_t *)device)->native_bits_per_pixel / 8;
+    return surface_pixdata(device, pixel_data, native_pixel_count);
+}
+
+class QGFAnimation : public ::testing::Test {
+   protected:
+    static void SetUpTestSuite() {
+        // Surfaces are allocated from a fixed pool, so share the one device across tests
+        device = qp_make_rgb565_surface(IMAGE_WIDTH, IMAGE_HEIGHT, buffer);
+
+        painter_driver_t *driver = (painter_driver_t *)device;
+        counting_vtable          = *driver->driver_vtable;
+        surface_pixdata          = counting_vtable.pixdata;
+        counting_vtable.pixdata  = counting_pixdata;
+        driver->driver_vtable    = &counting_vtable;
+    }
+
+    void SetUp() override {
+        timer_clear();
+        memset(buffer, 0, sizeof(buffer));
+        ASSERT_TRUE(qp_init(device, QP_ROTATION_0));
+        pixdata_bytes = 0;
+
+        qgf   = make_animation();
+        image = qp_load_image_mem(qgf.data());
+        ASSERT_NE(image, nullptr);
+    }
+
+    void TearDown() override {
+        qp_close_image(image);
+    }
+
+    uint16_t pixel_at(uint16_t x, uint16_t y) {
+        const uint8_t *p = &buffer[(y * IMAGE_WIDTH + x) * 2];
+        return (p[0] << 8) | p[1];
+    }
+
+    static uint8_t          buffer[SURFACE_REQUIRED_BUFFER_BYTE_SIZE(IMAGE_WIDTH, IMAGE_HEIGHT, 16)];
+    static painter_device_t device;
+    std::vector<uint8_t>    qgf;
+    painter_image_handle_t  image;
+};
+
+uint8_t          QGFAnimation::buffer[SURFACE_REQUIRED_BUFFER_BYTE_SIZE(IMAGE_WIDTH, IMAGE_HEIGHT, 16)];
+painter_device_t QGFAnimation::device;
+
+} // namespace
+
+TEST_F(QGFAnimation, DeltaFramesOnlyPushChangedRegion) {
+    deferred_token token = qp_animate(device, 0, 0, image);
+    ASSERT_NE(token, INVALID_DEFERRED_TOKEN);
+
+    // The first frame is drawn in full
+    EXPECT_EQ(pixdata_bytes, IMAGE_WIDTH * IMAGE_HEIGHT * 2);
+    EXPECT_EQ(pixel_at(0, 0), frame_color(0));
+    EXPECT_EQ(pixel_at(DELTA_LEFT, DELTA_TOP), frame_color(0));
+
+    uint32_t total_bytes = pixdata_bytes;
+    for (uint16_t frame = 1; frame < FRAME_COUNT; ++frame) {
+        pixdata_bytes = 0;
+        advance_time(FRAME_DELAY);
+        qp_internal_animation_tick();
+
+        // Delta frames only stream their own rectangle, leaving the rest of the image alone
+        EXPECT_EQ(pixdata_bytes, DELTA_SIZE * DELTA_SIZE * 2) << "frame " << frame;
+        EXPECT_EQ(pixel_at(DELTA_LEFT, DELTA_TOP), frame_color(frame));
+        EXPECT_EQ(pixel_at(DELTA_LEFT + DELTA_SIZE - 1, DELTA_TOP + DELTA_SIZE - 1), frame_color(frame));
+        EXPECT_EQ(pixel_at(DELTA_LEFT - 1, DELTA_TOP), frame_color(0));
+        EXPECT_EQ(pixel_at(0, 0), frame_color(0));
+        total_bytes += pixdata_bytes;
+    }
+
+    printf("QGF animation: %d frames, %d bytes pushed (full-frame redraw would be %d bytes, %d bytes per frame)\n", (int)FRAME_COUNT, (int)total_bytes, (int)(FRAME_COUNT * IMAGE_WIDTH * IMAGE_HEIGHT * 2), (int)(total_bytes / FRAME_COUNT));
+
+    // Wrapping around redraws the full first frame
+    pixdata_bytes = 0;
+    advance_time(FRAME_DELAY);
+    qp_internal_animation_tick();
+    EXPECT_EQ(pixdata_bytes, IMAGE_WIDTH * IMAGE_HEIGHT * 2);
+    EXPECT_EQ(pixel_at(DELTA_LEFT, DELTA_TOP), frame_color(0));
+
+    qp_stop_animation(token);
+}
+
+TEST_F(QGFAnimation, DrawImageRendersFirstFrame) {
+    EXPECT_TRUE(qp_drawimage(device, 0, 0, image));
+    EXPECT_EQ(pixdata_bytes, IMAGE_WIDTH * IMAGE_HEIGHT * 2);
+    EXPECT_EQ(pixel_at(IMAGE_WIDTH - 1, IMAGE_HEIGHT - 1), frame_color(0));
+}
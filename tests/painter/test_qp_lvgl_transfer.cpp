@@ -0,0 +1,223 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <cstring>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+extern "C" {
+#include "qp.h"
+#include "qp_internal.h"
+#include "qp_comms.h"
+#include "qp_comms_dummy.h"
+#include "qp_surface.h"
+#include "qp_lvgl_transfer.h"
+}
+
+namespace {
+
+constexpr uint16_t PANEL_WIDTH   = 240;
+constexpr uint16_t PANEL_HEIGHT  = 135;
+constexpr uint32_t BUFFER_PIXELS = PANEL_WIDTH * PANEL_HEIGHT / 10;
+
+// CASET and RASET with their four parameter bytes each, then RAMWR, as a typical SPI panel sets its viewport
+constexpr uint32_t VIEWPORT_BYTES = 11;
+
+// Counts what would go over the wire by wrapping the surface's driver and its dummy comms
+painter_driver_vtable_t      counting_vtable;
+painter_comms_vtable_t       counting_comms_vtable;
+painter_driver_viewport_func surface_viewport;
+painter_driver_pixdata_func  surface_pixdata;
+painter_driver_flush_func    surface_flush;
+uint32_t                     comms_bytes;
+uint32_t                     flush_calls;
+
+uint32_t counting_send(painter_device_t device, const void *data, uint32_t byte_count) {
+    comms_bytes += byte_count;
+    return dummy_comms_vtable.comms_send(device, data, byte_count);
+}
+
+bool counting_viewport(painter_device_t device, uint16_t left, uint16_t top, uint16_t right, uint16_t bottom) {
+    uint8_t commands[VIEWPORT_BYTES] = {0};
+    qp_comms_send(device, commands, sizeof(commands));
+    return surface_viewport(device, left, top, right, bottom);
+}
+
+bool counting_pixdata(painter_device_t device, const void *pixel_data, uint32_t native_pixel_count) {
+    qp_comms_send(device, pixel_data, native_pixel_count * ((painter_driver_t *)device)->native_bits_per_pixel / 8);
+    return surface_pixdata(device, pixel_data, native_pixel_count);
+}
+
+bool counting_flush(painter_device_t device) {
+    flush_calls++;
+    return surface_flush(device);
+}
+
+uint32_t area_size(const qp_lvgl_area_t &area) {
+    return (area.x2 - area.x1 + 1) * (area.y2 - area.y1 + 1);
+}
+
+class QPLVGLTransfer : public ::testing::Test {
+   protected:
+    static void SetUpTestSuite() {
+        // Surfaces are allocated from a fixed pool, so share the one device across tests
+        device = qp_make_rgb565_surface(PANEL_WIDTH, PANEL_HEIGHT, framebuffer);
+
+        painter_driver_t *driver = (painter_driver_t *)device;
+        counting_vtable          = *driver->driver_vtable;
+        surface_viewport         = counting_vtable.viewport;
+        surface_pixdata          = counting_vtable.pixdata;
+        surface_flush            = counting_vtable.flush;
+        counting_vtable.viewport = counting_viewport;
+        counting_vtable.pixdata  = counting_pixdata;
+        counting_vtable.flush    = counting_flush;
+        driver->driver_vtable    = &counting_vtable;
+
+        counting_comms_vtable            = dummy_comms_vtable;
+        counting_comms_vtable.comms_send = counting_send;
+        driver->comms_vtable             = &counting_comms_vtable;
+    }
+
+    void SetUp() override {
+        memset(framebuffer, 0, sizeof(framebuffer));
+        ASSERT_TRUE(qp_init(device, QP_ROTATION_0));
+        comms_bytes = 0;
+        flush_calls = 0;
+    }
+
+    uint16_t pixel_at(uint16_t x, uint16_t y) {
+        const uint8_t *p = &framebuffer[(y * PANEL_WIDTH + x) * 2];
+        return p[0] | (p[1] << 8);
+    }
+
+    // Renders each area in strips that fit the draw buffer and sends them the way the LVGL integration does
+    void refresh(const std::vector<qp_lvgl_area_t> &areas, uint16_t color) {
+        uint16_t buffer[BUFFER_PIXELS];
+        for (auto &area : areas) {
+            int16_t width = area.x2 - area.x1 + 1;
+            int16_t rows  = BUFFER_PIXELS / width;
+            for (int16_t y = area.y1; y <= area.y2; y += rows) {
+                qp_lvgl_area_t strip = {area.x1, y, area.x2, (int16_t)QP_MIN(y + rows - 1, area.y2)};
+                for (uint32_t i = 0; i < area_size(strip); ++i) {
+                    buffer[i] = color;
+                }
+                qp_lvgl_transfer(device, &strip, buffer);
+            }
+        }
+    }
+
+    // The areas LVGL would refresh on its own, which drops areas inside another and joins those that overlap
+    static std::vector<qp_lvgl_area_t> lvgl_areas(std::vector<qp_lvgl_area_t> areas) {
+        std::vector<uint8_t> joined(areas.size(), 0);
+        areas.resize(qp_lvgl_merge_areas(areas.data(), joined.data(), areas.size(), 0));
+        return areas;
+    }
+
+    static uint8_t          framebuffer[SURFACE_REQUIRED_BUFFER_BYTE_SIZE(PANEL_WIDTH, PANEL_HEIGHT, 16)];
+    static painter_device_t device;
+};
+
+uint8_t          QPLVGLTransfer::framebuffer[SURFACE_REQUIRED_BUFFER_BYTE_SIZE(PANEL_WIDTH, PANEL_HEIGHT, 16)];
+painter_device_t QPLVGLTransfer::device;
+
+} // namespace
+
+TEST_F(QPLVGLTransfer, MergesNearbyAreas) {
+    qp_lvgl_area_t areas[] = {
+        {100, 10, 111, 29}, // two glyphs of a label, two pixels apart
+        {114, 10, 125, 29},
+        {10, 40, 57, 59}, // a label's old text and its shorter new text
+        {10, 40, 45, 59},
+        {200, 10, 215, 25}, // an indicator far from the rest
+    };
+    uint8_t joined[5] = {0};
+
+    ASSERT_EQ(qp_lvgl_merge_areas(areas, joined, 5, QP_LVGL_MERGE_OVERHEAD), 3);
+
+    EXPECT_EQ(areas[0].x1, 100);
+    EXPECT_EQ(areas[0].x2, 125);
+    EXPECT_EQ(areas[1].x1, 10);
+    EXPECT_EQ(areas[1].x2, 57);
+    EXPECT_EQ(areas[2].x1, 200);
+    for (auto flag : joined) {
+        EXPECT_EQ(flag, 0);
+    }
+}
+
+TEST_F(QPLVGLTransfer, NoOverheadOnlyMergesOverlappingAreas) {
+    qp_lvgl_area_t areas[] = {
+        {100, 10, 111, 29},
+        {114, 10, 125, 29},
+        {10, 40, 57, 59},
+        {10, 40, 45, 59},
+    };
+    uint8_t joined[4] = {0};
+
+    EXPECT_EQ(qp_lvgl_merge_areas(areas, joined, 4, 0), 3);
+}
+
+TEST_F(QPLVGLTransfer, SkipsJoinedAreas) {
+    qp_lvgl_area_t areas[] = {
+        {0, 0, 9, 9},
+        {0, 0, 239, 134}, // already joined into another area by LVGL
+        {100, 100, 109, 109},
+    };
+    uint8_t joined[3] = {0, 1, 0};
+
+    ASSERT_EQ(qp_lvgl_merge_areas(areas, joined, 3, QP_LVGL_MERGE_OVERHEAD), 2);
+    EXPECT_EQ(areas[0].x2, 9);
+    EXPECT_EQ(areas[1].x1, 100);
+}
+
+TEST_F(QPLVGLTransfer, TransferSendsArea) {
+    uint16_t       pixels[8 * 4];
+    qp_lvgl_area_t area = {16, 8, 23, 11};
+    for (auto &pixel : pixels) {
+        pixel = 0xF800;
+    }
+
+    qp_lvgl_transfer(device, &area, pixels);
+    EXPECT_EQ(comms_bytes, VIEWPORT_BYTES + sizeof(pixels));
+    EXPECT_EQ(flush_calls, 1);
+    EXPECT_EQ(pixel_at(16, 8), 0xF800);
+    EXPECT_EQ(pixel_at(23, 11), 0xF800);
+    EXPECT_EQ(pixel_at(24, 11), 0);
+}
+
+TEST_F(QPLVGLTransfer, WidgetUpdateBytesAndFlushes) {
+    // A status screen updating its WPM counter, layer name, WPM bar and caps lock indicator
+    const std::vector<qp_lvgl_area_t> invalidated = {
+        {100, 10, 111, 29}, {114, 10, 125, 29}, // "87" becomes "92"
+        {10, 40, 57, 59},   {10, 40, 45, 59},   // "BASE" becomes "NAV"
+        {10, 80, 130, 89},  {10, 80, 140, 89},  // the bar's indicator grows
+        {200, 10, 215, 25},                     // caps lock turns on
+    };
+
+    auto unmerged = lvgl_areas(invalidated);
+    refresh(unmerged, 0xFFFF);
+    uint32_t unmerged_bytes   = comms_bytes;
+    uint32_t unmerged_flushes = flush_calls;
+
+    std::vector<qp_lvgl_area_t> merged = invalidated;
+    std::vector<uint8_t>        joined(merged.size(), 0);
+    merged.resize(qp_lvgl_merge_areas(merged.data(), joined.data(), merged.size(), QP_LVGL_MERGE_OVERHEAD));
+
+    comms_bytes = 0;
+    flush_calls = 0;
+    refresh(merged, 0x1234);
+    uint32_t merged_bytes   = comms_bytes;
+    uint32_t merged_flushes = flush_calls;
+
+    // A merge saves a transfer for at most QP_LVGL_MERGE_OVERHEAD more pixels
+    EXPECT_EQ(unmerged_flushes, 5);
+    EXPECT_EQ(merged_flushes, 4);
+    EXPECT_LE(merged_bytes, unmerged_bytes + (unmerged_flushes - merged_flushes) * QP_LVGL_MERGE_OVERHEAD * sizeof(uint16_t));
+
+    // Everything invalidated still made it to the display
+    for (auto &area : invalidated) {
+        EXPECT_EQ(pixel_at(area.x1, area.y1), 0x1234);
+        EXPECT_EQ(pixel_at(area.x2, area.y2), 0x1234);
+    }
+    EXPECT_EQ(pixel_at(0, 0), 0);
+}
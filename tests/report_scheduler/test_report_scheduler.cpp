@@ -0,0 +1,248 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "gtest/gtest.h"
+#include "keyboard_report_util.hpp"
+#include "test_common.hpp"
+
+extern "C" {
+#include "digitizer.h"
+#include "report_scheduler.h"
+}
+
+using testing::_;
+using testing::InSequence;
+
+MATCHER_P3(MouseReport, buttons, x, y, "mouse report with buttons " + testing::PrintToString(buttons) + ", x " + testing::PrintToString(x) + " and y " + testing::PrintToString(y)) {
+    return arg.buttons == buttons && arg.x == x && arg.y == y;
+}
+
+MATCHER_P2(ExtraReport, report_id, usage, "extra report " + testing::PrintToString(report_id) + " with usage " + testing::PrintToString(usage)) {
+    return arg.report_id == report_id && arg.usage == usage;
+}
+
+MATCHER_P2(DigitizerReport, tip, x, "digitizer report with tip " + testing::PrintToString(tip) + " and x " + testing::PrintToString(x)) {
+    return arg.tip == tip && arg.x == x;
+}
+
+class ReportScheduler : public TestFixture {
+   protected:
+    void send_mouse(uint8_t buttons, int8_t x, int8_t y) {
+        report_mouse_t report = {};
+        report.buttons        = buttons;
+        report.x              = x;
+        report.y              = y;
+        host_mouse_send(&report);
+    }
+};
+
+TEST_F(ReportScheduler, ReportsGoOutRightAwayWhenTheEndpointIsReady) {
+    TestDriver driver;
+    auto       key_a = KeymapKey(0, 0, 0, KC_A);
+    set_keymap({key_a});
+
+    InSequence s;
+    EXPECT_REPORT(driver, (KC_A));
+    EXPECT_EMPTY_REPORT(driver);
+    EXPECT_CALL(driver, send_mouse_mock(MouseReport(0, 3, 4)));
+    tap_key(key_a);
+    send_mouse(0, 3, 4);
+    EXPECT_FALSE(report_scheduler_pending());
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(ReportScheduler, KeyboardReportsWaitForTheirEndpointInOrder) {
+    TestDriver driver;
+    auto       key_a = KeymapKey(0, 0, 0, KC_A);
+    auto       key_b = KeymapKey(0, 1, 0, KC_B);
+    set_keymap({key_a, key_b});
+
+    driver.set_endpoint_busy(REPORT_ID_KEYBOARD, true);
+    EXPECT_NO_REPORT(driver);
+    tap_keys(key_a, key_b);
+    EXPECT_TRUE(report_scheduler_pending());
+    VERIFY_AND_CLEAR(driver);
+
+    // Every edge reaches the host, none of them are coalesced
+    InSequence s;
+    EXPECT_REPORT(driver, (KC_A));
+    EXPECT_EMPTY_REPORT(driver);
+    EXPECT_REPORT(driver, (KC_B));
+    EXPECT_EMPTY_REPORT(driver);
+    driver.set_endpoint_busy(REPORT_ID_KEYBOARD, false);
+    run_one_scan_loop();
+    EXPECT_FALSE(report_scheduler_pending());
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(ReportScheduler, FullKeyboardQueueSendsTheOldestReport) {
+    TestDriver driver;
+    auto       key_a = KeymapKey(0, 0, 0, KC_A);
+    auto       key_b = KeymapKey(0, 1, 0, KC_B);
+    auto       key_c = KeymapKey(0, 2, 0, KC_C);
+    set_keymap({key_a, key_b, key_c});
+
+    driver.set_endpoint_busy(REPORT_ID_KEYBOARD, true);
+    InSequence s;
+    EXPECT_REPORT(driver, (KC_A));
+    EXPECT_EMPTY_REPORT(driver);
+    tap_keys(key_a, key_b, key_c);
+    VERIFY_AND_CLEAR(driver);
+
+    EXPECT_REPORT(driver, (KC_B));
+    EXPECT_EMPTY_REPORT(driver);
+    EXPECT_REPORT(driver, (KC_C));
+    EXPECT_EMPTY_REPORT(driver);
+    driver.set_endpoint_busy(REPORT_ID_KEYBOARD, false);
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(ReportScheduler, MouseMotionIsCoalesced) {
+    TestDriver driver;
+
+    driver.set_endpoint_busy(REPORT_ID_MOUSE, true);
+    EXPECT_CALL(driver, send_mouse_mock(_)).Times(0);
+    for (int i = 0; i < 10; i++) {
+        send_mouse(0, 5, -2);
+    }
+    VERIFY_AND_CLEAR(driver);
+
+    EXPECT_CALL(driver, send_mouse_mock(MouseReport(0, 50, -20)));
+    driver.set_endpoint_busy(REPORT_ID_MOUSE, false);
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(ReportScheduler, MouseButtonChangesAreNeverCoalesced) {
+    TestDriver driver;
+
+    driver.set_endpoint_busy(REPORT_ID_MOUSE, true);
+    InSequence s;
+    EXPECT_CALL(driver, send_mouse_mock(MouseReport(0, 5, 0)));
+    EXPECT_CALL(driver, send_mouse_mock(MouseReport(MOUSE_BTN1, 0, 0)));
+    send_mouse(0, 5, 0);
+    send_mouse(MOUSE_BTN1, 0, 0);
+    send_mouse(0, 0, 0);
+    VERIFY_AND_CLEAR(driver);
+
+    EXPECT_CALL(driver, send_mouse_mock(MouseReport(0, 0, 0)));
+    driver.set_endpoint_busy(REPORT_ID_MOUSE, false);
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(ReportScheduler, MouseMotionIsNotCoalescedPastTheReportRange) {
+    TestDriver driver;
+
+    driver.set_endpoint_busy(REPORT_ID_MOUSE, true);
+    InSequence s;
+    EXPECT_CALL(driver, send_mouse_mock(MouseReport(0, 100, 0)));
+    EXPECT_CALL(driver, send_mouse_mock(MouseReport(0, 100, -1)));
+    send_mouse(0, 100, 0);
+    send_mouse(0, 100, 0);
+    send_mouse(0, 0, -1);
+    driver.set_endpoint_busy(REPORT_ID_MOUSE, false);
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(ReportScheduler, KeyboardIsNotBlockedBehindABusyMouse) {
+    TestDriver driver;
+    auto       key_a = KeymapKey(0, 0, 0, KC_A);
+    set_keymap({key_a});
+
+    driver.set_endpoint_busy(REPORT_ID_MOUSE, true);
+    EXPECT_CALL(driver, send_mouse_mock(_)).Times(0);
+    send_mouse(0, 1, 1);
+
+    InSequence s;
+    EXPECT_REPORT(driver, (KC_A));
+    EXPECT_EMPTY_REPORT(driver);
+    tap_key(key_a);
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(ReportScheduler, KeyboardGoesFirstOnASharedEndpoint) {
+    TestDriver driver;
+    auto       key_a = KeymapKey(0, 0, 0, KC_A);
+    auto       vol_u = KeymapKey(0, 1, 0, KC_VOLU);
+    set_keymap({key_a, vol_u});
+
+    driver.set_endpoint_busy(REPORT_ID_KEYBOARD, true);
+    driver.set_endpoint_busy(REPORT_ID_CONSUMER, true);
+    driver.set_endpoint_busy(REPORT_ID_MOUSE, true);
+    send_mouse(0, 1, 1);
+    key_a.press();
+    run_one_scan_loop();
+    vol_u.press();
+    run_one_scan_loop();
+
+    InSequence s;
+    EXPECT_REPORT(driver, (KC_A));
+    EXPECT_CALL(driver, send_extra_mock(ExtraReport(REPORT_ID_CONSUMER, AUDIO_VOL_UP)));
+    EXPECT_CALL(driver, send_mouse_mock(MouseReport(0, 1, 1)));
+    driver.set_endpoint_busy(REPORT_ID_KEYBOARD, false);
+    driver.set_endpoint_busy(REPORT_ID_CONSUMER, false);
+    driver.set_endpoint_busy(REPORT_ID_MOUSE, false);
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+
+    EXPECT_EMPTY_REPORT(driver);
+    EXPECT_CALL(driver, send_extra_mock(ExtraReport(REPORT_ID_CONSUMER, 0)));
+    key_a.release();
+    vol_u.release();
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(ReportScheduler, ConsumerPressIsNotLostBehindABusyEndpoint) {
+    TestDriver driver;
+    auto       vol_u = KeymapKey(0, 0, 0, KC_VOLU);
+    set_keymap({vol_u});
+
+    driver.set_endpoint_busy(REPORT_ID_CONSUMER, true);
+    InSequence s;
+    EXPECT_CALL(driver, send_extra_mock(ExtraReport(REPORT_ID_CONSUMER, AUDIO_VOL_UP)));
+    tap_key(vol_u);
+    VERIFY_AND_CLEAR(driver);
+
+    EXPECT_CALL(driver, send_extra_mock(ExtraReport(REPORT_ID_CONSUMER, 0)));
+    driver.set_endpoint_busy(REPORT_ID_CONSUMER, false);
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(ReportScheduler, DigitizerKeepsTheLatestPosition) {
+    TestDriver driver;
+
+    driver.set_endpoint_busy(REPORT_ID_DIGITIZER, true);
+    InSequence s;
+    EXPECT_CALL(driver, send_digitizer_mock(DigitizerReport(false, 0x7FFF / 2)));
+    digitizer_in_range_on();
+    digitizer_set_position(0.25, 0.5);
+    digitizer_set_position(0.5, 0.5);
+    digitizer_tip_switch_on();
+    digitizer_set_position(0.75, 0.5);
+    VERIFY_AND_CLEAR(driver);
+
+    EXPECT_CALL(driver, send_digitizer_mock(DigitizerReport(true, (uint16_t)(0.75 * 0x7FFF))));
+    driver.set_endpoint_busy(REPORT_ID_DIGITIZER, false);
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(ReportScheduler, ANewDriverDropsPendingReports) {
+    {
+        TestDriver driver;
+        driver.set_endpoint_busy(REPORT_ID_MOUSE, true);
+        EXPECT_CALL(driver, send_mouse_mock(_)).Times(0);
+        send_mouse(0, 1, 1);
+        EXPECT_TRUE(report_scheduler_pending());
+    }
+
+    TestDriver driver;
+    EXPECT_FALSE(report_scheduler_pending());
+    EXPECT_CALL(driver, send_mouse_mock(_)).Times(0);
+    run_one_scan_loop();
+}
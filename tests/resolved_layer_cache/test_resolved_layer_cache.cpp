@@ -0,0 +1,175 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <chrono>
+#include <cstdio>
+
+#include "gtest/gtest.h"
+#include "keyboard_report_util.hpp"
+#include "test_common.hpp"
+
+using testing::_;
+using testing::InSequence;
+
+class ResolvedLayerCache : public TestFixture {
+   protected:
+    // Uncached reference implementation of layer_switch_get_layer()
+    uint8_t reference_layer(keypos_t key) {
+        layer_state_t layers = layer_state | default_layer_state;
+        for (int8_t i = MAX_LAYER - 1; i >= 0; i--) {
+            if ((layers & ((layer_state_t)1 << i)) && keymap_key_to_keycode(i, key) != KC_TRANSPARENT) {
+                return i;
+            }
+        }
+        return 0;
+    }
+
+    void expect_all_keys_match_reference() {
+        for (uint8_t row = 0; row < MATRIX_ROWS; row++) {
+            for (uint8_t col = 0; col < MATRIX_COLS; col++) {
+                keypos_t key = {.col = col, .row = row};
+                EXPECT_EQ(layer_switch_get_layer(key), reference_layer(key)) << "layer_state " << layer_state << " at (" << +col << "," << +row << ")";
+            }
+        }
+    }
+
+    // Every layer transparent, apart from a sparse sprinkling of keys, as a typical keymap's upper layers are
+    void add_stacked_layers(uint8_t count) {
+        for (uint8_t layer = 0; layer < count; layer++) {
+            for (uint8_t row = 0; row < MATRIX_ROWS; row++) {
+                for (uint8_t col = 0; col < MATRIX_COLS; col++) {
+                    bool opaque = layer == 0 || (row * MATRIX_COLS + col) % (layer + 2) == 0;
+                    add_key(KeymapKey(layer, col, row, opaque ? KC_A + (layer % 26) : KC_TRANSPARENT));
+                }
+            }
+        }
+    }
+
+    void benchmark(uint8_t count) {
+        add_stacked_layers(count);
+        layer_state_set((layer_state_t)(((uint64_t)1 << count) - 1));
+
+        // Lowest key is transparent on every layer but the base, which is the worst case for the uncached search
+        keypos_t  key        = {.col = 1, .row = 0};
+        const int iterations = 2000;
+
+        auto     start  = std::chrono::steady_clock::now();
+        uint32_t layers = 0;
+        for (int i = 0; i < iterations; i++) {
+            layers += reference_layer(key);
+        }
+        auto reference_time = std::chrono::steady_clock::now() - start;
+
+        start = std::chrono::steady_clock::now();
+        for (int i = 0; i < iterations; i++) {
+            layers -= layer_switch_get_layer(key);
+        }
+        auto cached_time = std::chrono::steady_clock::now() - start;
+
+        EXPECT_EQ(layers, 0);
+        printf("%u stacked layers: %d lookups took %lldus uncached, %lldus cached\n", count, iterations, (long long)std::chrono::duration_cast<std::chrono::microseconds>(reference_time).count(), (long long)std::chrono::duration_cast<std::chrono::microseconds>(cached_time).count());
+    }
+};
+
+TEST_F(ResolvedLayerCache, TransparentKeyFallsThrough) {
+    TestDriver driver;
+    KeymapKey  layer_key   = KeymapKey(0, 0, 0, MO(1));
+    KeymapKey  regular_key = KeymapKey(0, 1, 0, KC_A);
+
+    set_keymap({layer_key, regular_key, KeymapKey(1, 0, 0, KC_TRANSPARENT), KeymapKey(1, 1, 0, KC_TRANSPARENT)});
+
+    layer_key.press();
+    EXPECT_NO_REPORT(driver);
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+
+    regular_key.press();
+    EXPECT_REPORT(driver, (KC_A));
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+
+    regular_key.release();
+    EXPECT_EMPTY_REPORT(driver);
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+
+    layer_key.release();
+    EXPECT_NO_REPORT(driver);
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(ResolvedLayerCache, KeyFollowsLayerChanges) {
+    TestDriver driver;
+    InSequence s;
+    KeymapKey  layer_key   = KeymapKey(0, 0, 0, MO(1));
+    KeymapKey  regular_key = KeymapKey(0, 1, 0, KC_A);
+
+    set_keymap({layer_key, regular_key, KeymapKey(1, 0, 0, KC_TRANSPARENT), KeymapKey(1, 1, 0, KC_B)});
+
+    /* Tap the key on the base layer, so it's resolved layer is cached */
+    EXPECT_REPORT(driver, (KC_A));
+    EXPECT_EMPTY_REPORT(driver);
+    tap_key(regular_key);
+    VERIFY_AND_CLEAR(driver);
+
+    /* Turning on a layer above it must take effect */
+    layer_key.press();
+    run_one_scan_loop();
+    EXPECT_REPORT(driver, (KC_B));
+    EXPECT_EMPTY_REPORT(driver);
+    tap_key(regular_key);
+    VERIFY_AND_CLEAR(driver);
+
+    /* And turning it back off again */
+    layer_key.release();
+    run_one_scan_loop();
+    EXPECT_REPORT(driver, (KC_A));
+    EXPECT_EMPTY_REPORT(driver);
+    tap_key(regular_key);
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(ResolvedLayerCache, DirectLayerStateWriteIsNoticed) {
+    add_stacked_layers(4);
+    expect_all_keys_match_reference();
+
+    /* Some keymaps save and restore layer_state behind layer_state_set()'s back */
+    layer_state = 0b1010;
+    expect_all_keys_match_reference();
+    layer_state = 0;
+    expect_all_keys_match_reference();
+}
+
+TEST_F(ResolvedLayerCache, RandomLayerStatesMatchUncached) {
+    add_stacked_layers(MAX_LAYER);
+
+    uint32_t seed = 42;
+    for (int i = 0; i < 200; i++) {
+        seed = seed * 1103515245 + 12345;
+        switch ((seed >> 8) % 4) {
+            case 0:
+                layer_state_set((layer_state_t)(seed >> 3));
+                break;
+            case 1:
+                layer_on((seed >> 16) % MAX_LAYER);
+                break;
+            case 2:
+                layer_off((seed >> 16) % MAX_LAYER);
+                break;
+            case 3:
+                default_layer_set((layer_state_t)1 << ((seed >> 16) % MAX_LAYER));
+                break;
+        }
+        expect_all_keys_match_reference();
+    }
+    default_layer_set(1);
+}
+
+TEST_F(ResolvedLayerCache, Benchmark16StackedLayers) {
+    benchmark(16);
+}
+
+TEST_F(ResolvedLayerCache, Benchmark32StackedLayers) {
+    benchmark(32);
+}
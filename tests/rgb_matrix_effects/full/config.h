@@ -0,0 +1,10 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include "test_common.h"
+#include "../effects_config.h"
+
+#define TEST_LED_LAYOUT "full"
+#define RGB_MATRIX_LED_COUNT 104
@@ -0,0 +1,39 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "quantum.h"
+
+// clang-format off
+led_config_t g_led_config = {
+    {
+        {  0,   2,   5,   7,  10,  13,  15,  18,  20,  23},
+        { 26,  28,  31,  33,  36,  39,  41,  44,  46,  49},
+        { 52,  54,  57,  59,  62,  65,  67,  70,  72,  75},
+        { 78,  80,  83,  85,  88,  91,  93,  96,  98, 101},
+    }, {
+        {  5,  5}, { 25,  5}, { 35,  5}, { 45,  5}, { 55,  5}, { 70,  5}, { 80,  5}, { 90,  5}, {100,  5}, {114,  5},
+        {124,  5}, {134,  5}, {144,  5}, {  5, 20}, { 15, 20}, { 25, 20}, { 35, 20}, { 45, 20}, { 55, 20}, { 65, 20},
+        { 75, 20}, { 85, 20}, { 95, 20}, {105, 20}, {114, 20}, {124, 20}, {139, 20}, {  7, 30}, { 20, 30}, { 30, 30},
+        { 40, 30}, { 50, 30}, { 60, 30}, { 70, 30}, { 80, 30}, { 90, 30}, {100, 30}, {110, 30}, {119, 30}, {129, 30},
+        {142, 30}, {  9, 39}, { 22, 39}, { 32, 39}, { 42, 39}, { 52, 39}, { 62, 39}, { 72, 39}, { 82, 39}, { 92, 39},
+        {102, 39}, {112, 39}, {122, 39}, {138, 39}, { 11, 49}, { 27, 49}, { 37, 49}, { 47, 49}, { 57, 49}, { 67, 49},
+        { 77, 49}, { 87, 49}, { 97, 49}, {107, 49}, {117, 49}, {136, 49}, {  6, 59}, { 19, 59}, { 31, 59}, { 68, 59},
+        {106, 59}, {118, 59}, {131, 59}, {143, 59}, {157,  5}, {167,  5}, {177,  5}, {157, 20}, {167, 20}, {177, 20},
+        {157, 30}, {167, 30}, {177, 30}, {167, 49}, {157, 59}, {167, 59}, {177, 59}, {189, 20}, {199, 20}, {209, 20},
+        {219, 20}, {189, 30}, {199, 30}, {209, 30}, {189, 39}, {199, 39}, {209, 39}, {189, 49}, {199, 49}, {209, 49},
+        {194, 59}, {209, 59}, {219, 34}, {219, 54},
+    }, {
+        4, 4, 4, 4, 4, 4, 4, 4, 4, 4,
+        4, 4, 4, 4, 4, 4, 4, 4, 4, 4,
+        4, 4, 4, 4, 4, 4, 1, 1, 4, 4,
+        4, 4, 4, 4, 4, 4, 4, 4, 4, 4,
+        1, 1, 4, 4, 4, 4, 4, 4, 4, 4,
+        4, 4, 4, 1, 1, 4, 4, 4, 4, 4,
+        4, 4, 4, 4, 4, 1, 1, 1, 1, 1,
+        1, 1, 1, 1, 4, 4, 4, 4, 4, 4,
+        4, 4, 4, 4, 4, 4, 4, 4, 4, 4,
+        4, 4, 4, 4, 4, 4, 4, 4, 4, 4,
+        1, 4, 4, 4,
+    }
+};
+// clang-format on
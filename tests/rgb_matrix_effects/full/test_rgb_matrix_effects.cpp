@@ -0,0 +1,8 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "../rgb_matrix_effects.hpp"
+
+TEST_F(RgbMatrixEffects, AllEffects) {
+    render_and_check("");
+}
@@ -0,0 +1,311 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+/*
+  Renders every built-in RGB matrix effect through rgb_matrix_task() against a fake LED driver, so the rendering is
+  chunked by rgb_matrix_get_limits() and RGB_MATRIX_LED_PROCESS_LIMIT exactly as on a keyboard.
+
+  Included by the test of every layout directory, so that it is built with the LED count and configuration of that
+  layout.
+
+  Every flushed frame is hashed. The frames of each effect are checked against golden.txt in the layout directory, which
+  holds a digest of its frame hashes. The hashes themselves are written to .build/test/rgb_matrix_effects_<layout>.txt,
+  to be diffed against the output of a previous build when touching an effect, along with the digests for a new
+  golden.txt. The render times are printed per effect.
+
+  rand() is replaced with a fixed generator, so that the random effects render the same frames whatever the host libc.
+*/
+
+#pragma once
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <map>
+#include <string>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+extern "C" {
+#include "quantum.h"
+#include "lib/lib8tion/lib8tion.h"
+
+void advance_time(uint32_t ms);
+void set_time(uint32_t t);
+}
+
+#define EFFECT_FRAMES 120
+#define KEYPRESS_INTERVAL_MS 150
+
+namespace {
+
+const char *const effect_names[] = {
+    "NONE",
+#define RGB_MATRIX_EFFECT(name, ...) #name,
+#include "rgb_matrix_effects.inc"
+#undef RGB_MATRIX_EFFECT
+};
+
+RGB      leds[RGB_MATRIX_LED_COUNT];
+uint32_t flushes;
+uint32_t last_frame_hash;
+bool     keyboard_left = true;
+uint32_t rand_state    = 1;
+
+// LEDs written by the current render iteration, and whether they were outside its limits
+uint8_t chunk_min = UINT8_MAX;
+uint8_t chunk_max = 0;
+bool    chunk_rendered;
+bool    chunk_stray;
+
+void test_led_init(void) {}
+
+void test_led_set_color(int index, uint8_t r, uint8_t g, uint8_t b) {
+    leds[index].r = r;
+    leds[index].g = g;
+    leds[index].b = b;
+    chunk_min     = std::min<uint8_t>(chunk_min, index);
+    chunk_max     = std::max<uint8_t>(chunk_max, index + 1);
+}
+
+void test_led_set_color_all(uint8_t r, uint8_t g, uint8_t b) {
+    for (uint8_t i = 0; i < RGB_MATRIX_LED_COUNT; i++) {
+        leds[i].r = r;
+        leds[i].g = g;
+        leds[i].b = b;
+    }
+}
+
+// FNV-1a
+uint32_t fnv1a(uint32_t hash, uint8_t byte) {
+    return (hash ^ byte) * 16777619u;
+}
+
+void test_led_flush(void) {
+    uint32_t hash = 2166136261u;
+    for (uint8_t i = 0; i < RGB_MATRIX_LED_COUNT; i++) {
+        for (uint8_t channel : {leds[i].r, leds[i].g, leds[i].b}) {
+            hash = fnv1a(hash, channel);
+        }
+    }
+    last_frame_hash = hash;
+    flushes++;
+}
+
+struct EffectReport {
+    std::string           name;
+    std::vector<uint32_t> frame_hashes;
+    uint64_t              render_ns    = 0;
+    uint64_t              max_chunk_ns = 0;
+    uint32_t              chunks       = 0;
+    uint32_t              max_chunks   = 0;
+    uint32_t              stray_writes = 0;
+
+    uint32_t digest() const {
+        uint32_t hash = 2166136261u;
+        for (uint32_t frame : frame_hashes) {
+            for (int shift = 0; shift < 32; shift += 8) {
+                hash = fnv1a(hash, frame >> shift);
+            }
+        }
+        return hash;
+    }
+};
+
+// Renders `frames` frames of `mode` from a clean state, pressing a key every KEYPRESS_INTERVAL_MS
+EffectReport render_effect(uint8_t mode, uint32_t frames) {
+    EffectReport report;
+    report.name = effect_names[mode];
+
+    // Finish the frame in progress, so the new effect starts on a frame boundary
+    for (uint32_t flushed = flushes; flushes == flushed;) {
+        rgb_matrix_task();
+        advance_time(1);
+    }
+    // Split halves only render their own LEDs, leave the others off rather than showing the previous effect
+    test_led_set_color_all(0, 0, 0);
+
+    // Start every effect with the same seed and the same 16 bit time, so its frames don't depend on the effects rendered
+    // before it. Time still has to move forward for the effects keeping 32 bit timers of their own.
+    uint32_t start_time = (timer_read32() | 0xFFFF) + 1;
+    set_time(start_time);
+    srand(1);
+    random16_set_seed(1337);
+    rgb_matrix_init();
+    rgb_matrix_enable_noeeprom();
+    rgb_matrix_sethsv_noeeprom(0, 255, 255);
+    rgb_matrix_set_speed_noeeprom(RGB_MATRIX_DEFAULT_SPD);
+    rgb_matrix_mode_noeeprom(mode);
+
+    uint32_t start_flushes = flushes;
+    uint32_t frame_chunks  = 0;
+    uint32_t key           = 0;
+    uint32_t tasks         = 0;
+    while (flushes - start_flushes < frames && tasks++ < frames * 100) {
+        if (timer_elapsed32(start_time) % KEYPRESS_INTERVAL_MS == 0) {
+            process_rgb_matrix(key % MATRIX_ROWS, (key * 7) % MATRIX_COLS, true);
+            process_rgb_matrix(key % MATRIX_ROWS, (key * 7) % MATRIX_COLS, false);
+            key++;
+        }
+
+        chunk_rendered = false;
+        chunk_stray    = false;
+        chunk_min      = UINT8_MAX;
+        chunk_max      = 0;
+        uint32_t flushed = flushes;
+        auto     start   = std::chrono::steady_clock::now();
+        rgb_matrix_task();
+        uint64_t ns = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start).count();
+
+        if (chunk_rendered) {
+            report.render_ns += ns;
+            report.max_chunk_ns = std::max(report.max_chunk_ns, ns);
+            // Effects keeping their state in the LEDs step it on the first iteration of a frame, writing any LED
+            if (frame_chunks > 0) {
+                report.stray_writes += chunk_stray;
+            }
+            report.chunks++;
+            frame_chunks++;
+        }
+        if (flushes != flushed) {
+            report.frame_hashes.push_back(last_frame_hash);
+            report.max_chunks = std::max(report.max_chunks, frame_chunks);
+            frame_chunks      = 0;
+        }
+        // One main loop iteration per millisecond
+        advance_time(1);
+    }
+    return report;
+}
+
+// Number of render iterations rgb_matrix_get_limits() splits a frame into
+uint32_t iterations_per_frame() {
+    uint8_t iter = 0;
+    while (rgb_matrix_check_finished_leds(rgb_matrix_get_limits(iter).led_max_index)) {
+        iter++;
+    }
+    return iter + 1;
+}
+
+class RgbMatrixEffects : public ::testing::Test {
+   protected:
+    std::vector<EffectReport> render_all_effects() {
+        std::vector<EffectReport> reports;
+        for (uint8_t mode = RGB_MATRIX_NONE + 1; mode < RGB_MATRIX_EFFECT_MAX; mode++) {
+            reports.push_back(render_effect(mode, EFFECT_FRAMES));
+        }
+        return reports;
+    }
+
+    void write_report(const std::string &half, const std::vector<EffectReport> &reports) {
+        std::string path = std::string(".build/test/rgb_matrix_effects_") + TEST_LED_LAYOUT + half + ".txt";
+        FILE       *file = fopen(path.c_str(), "w");
+        ASSERT_NE(file, nullptr) << path;
+        for (const auto &report : reports) {
+            for (size_t frame = 0; frame < report.frame_hashes.size(); frame++) {
+                fprintf(file, "%s %zu %08x\n", report.name.c_str(), frame, report.frame_hashes[frame]);
+            }
+        }
+        fclose(file);
+
+        path = std::string(".build/test/rgb_matrix_effects_") + TEST_LED_LAYOUT + half + "_golden.txt";
+        file = fopen(path.c_str(), "w");
+        ASSERT_NE(file, nullptr) << path;
+        for (const auto &report : reports) {
+            fprintf(file, "%s %zu %08x\n", report.name.c_str(), report.frame_hashes.size(), report.digest());
+        }
+        fclose(file);
+
+        printf("%s%s: %d LEDs, %d per iteration\n", TEST_LED_LAYOUT, half.c_str(), RGB_MATRIX_LED_COUNT, RGB_MATRIX_LED_PROCESS_LIMIT);
+        for (const auto &report : reports) {
+            printf("  %-28s %8.0f ns/frame, max %6llu ns/iteration, %u iterations/frame", report.name.c_str(), (double)report.render_ns / report.frame_hashes.size(), (unsigned long long)report.max_chunk_ns, report.max_chunks);
+            if (report.stray_writes) {
+                printf(", %u iterations wrote outside their LEDs", report.stray_writes);
+            }
+            printf("\n");
+        }
+    }
+
+    void check(const std::vector<EffectReport> &reports) {
+        ASSERT_EQ(reports.size(), RGB_MATRIX_EFFECT_MAX - 1);
+        for (const auto &report : reports) {
+            EXPECT_EQ(report.frame_hashes.size(), EFFECT_FRAMES) << report.name;
+            EXPECT_GT(report.chunks, 0) << report.name;
+            EXPECT_LE(report.max_chunks, iterations_per_frame()) << report.name;
+            EXPECT_EQ(report.stray_writes, 0u) << report.name;
+        }
+    }
+
+    // Compares the frames of every effect with the digests of the golden frames
+    void check_golden(const std::string &half, const std::vector<EffectReport> &reports) {
+        std::string   path = std::string("tests/rgb_matrix_effects/") + TEST_LED_LAYOUT + "/golden" + half + ".txt";
+        std::ifstream file(path);
+        ASSERT_TRUE(file.is_open()) << path;
+
+        std::map<std::string, std::pair<size_t, uint32_t>> golden;
+        std::string                                        name;
+        size_t                                             frames;
+        uint32_t                                           digest;
+        while (file >> name >> std::dec >> frames >> std::hex >> digest) {
+            golden[name] = {frames, digest};
+        }
+
+        for (const auto &report : reports) {
+            auto it = golden.find(report.name);
+            if (it == golden.end()) {
+                ADD_FAILURE() << report.name << " is missing from " << path;
+                continue;
+            }
+            EXPECT_EQ(it->second, std::make_pair(report.frame_hashes.size(), report.digest())) << report.name << " renders different frames than in " << path << ", see .build/test/rgb_matrix_effects_" << TEST_LED_LAYOUT << half << "_golden.txt if that is intended";
+        }
+    }
+
+    void render_and_check(const std::string &half) {
+        auto reports = render_all_effects();
+        check(reports);
+        write_report(half, reports);
+        check_golden(half, reports);
+
+        // Rendering again from the same start must give the same frames. PIXEL_FRACTAL keeps its pixels in static state
+        // that survives switching effects, so its second run starts from where the first one ended.
+        auto again = render_all_effects();
+        for (size_t i = 0; i < reports.size(); i++) {
+            if (reports[i].name == "PIXEL_FRACTAL") continue;
+            EXPECT_EQ(reports[i].frame_hashes, again[i].frame_hashes) << reports[i].name << " is not reproducible";
+        }
+    }
+};
+
+} // namespace
+
+extern "C" {
+const rgb_matrix_driver_t rgb_matrix_driver = {
+    test_led_init,
+    test_led_set_color,
+    test_led_set_color_all,
+    test_led_flush,
+};
+
+bool is_keyboard_left(void) {
+    return keyboard_left;
+}
+
+// A fixed generator instead of whatever the host libc gives, up to its RAND_MAX as the effects expect
+int rand(void) noexcept {
+    rand_state = rand_state * 1103515245u + 12345u;
+    return (rand_state >> 1) % ((unsigned int)RAND_MAX + 1u);
+}
+
+void srand(unsigned int seed) noexcept {
+    rand_state = seed;
+}
+
+bool rgb_matrix_indicators_advanced_user(uint8_t led_min, uint8_t led_max) {
+    chunk_rendered = true;
+    chunk_stray    = chunk_max > 0 && (chunk_min < led_min || chunk_max > led_max);
+    return true;
+}
+}
@@ -0,0 +1,11 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include "test_common.h"
+#include "../effects_config.h"
+
+#define TEST_LED_LAYOUT "split_58"
+#define RGB_MATRIX_LED_COUNT 58
+#define RGB_MATRIX_SPLIT {29, 29}
@@ -0,0 +1,29 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "quantum.h"
+
+// clang-format off
+led_config_t g_led_config = {
+    {
+        {  0,   1,   2,   4,   5,   7,   8,  10,  11,  13},
+        { 14,  15,  17,  18,  20,  21,  23,  24,  26,  27},
+        { 29,  30,  31,  33,  34,  36,  37,  39,  40,  42},
+        { 43,  44,  46,  47,  49,  50,  52,  53,  55,  56},
+    }, {
+        {  7,  6}, { 21,  6}, { 35,  9}, { 49,  9}, { 63,  9}, { 77,  6}, {  7, 17}, { 21, 17}, { 35, 20}, { 49, 20},
+        { 63, 20}, { 77, 17}, {  7, 29}, { 21, 29}, { 35, 32}, { 49, 32}, { 63, 32}, { 77, 29}, {  7, 41}, { 21, 41},
+        { 35, 44}, { 49, 44}, { 63, 44}, { 77, 41}, { 35, 52}, { 49, 52}, { 63, 52}, { 77, 55}, { 91, 58}, {217,  6},
+        {203,  6}, {189,  9}, {175,  9}, {161,  9}, {147,  6}, {217, 17}, {203, 17}, {189, 20}, {175, 20}, {161, 20},
+        {147, 17}, {217, 29}, {203, 29}, {189, 32}, {175, 32}, {161, 32}, {147, 29}, {217, 41}, {203, 41}, {189, 44},
+        {175, 44}, {161, 44}, {147, 41}, {189, 52}, {175, 52}, {161, 52}, {147, 55}, {133, 58},
+    }, {
+        4, 4, 4, 4, 4, 4, 4, 4, 4, 4,
+        4, 4, 4, 4, 4, 4, 4, 4, 4, 4,
+        4, 4, 4, 4, 4, 4, 4, 1, 1, 4,
+        4, 4, 4, 4, 4, 4, 4, 4, 4, 4,
+        4, 4, 4, 4, 4, 4, 4, 4, 4, 4,
+        4, 4, 4, 4, 4, 4, 1, 1,
+    }
+};
+// clang-format on
@@ -0,0 +1,15 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "../rgb_matrix_effects.hpp"
+
+TEST_F(RgbMatrixEffects, LeftHalf) {
+    keyboard_left = true;
+    render_and_check("_left");
+}
+
+TEST_F(RgbMatrixEffects, RightHalf) {
+    keyboard_left = false;
+    render_and_check("_right");
+    keyboard_left = true;
+}
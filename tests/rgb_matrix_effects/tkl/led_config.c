@@ -0,0 +1,35 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "quantum.h"
+
+// clang-format off
+led_config_t g_led_config = {
+    {
+        {  0,   2,   4,   6,   8,  10,  13,  15,  17,  19},
+        { 21,  23,  26,  28,  30,  32,  34,  36,  39,  41},
+        { 43,  45,  47,  50,  52,  54,  56,  58,  60,  63},
+        { 65,  67,  69,  71,  73,  76,  78,  80,  82,  84},
+    }, {
+        {  6,  5}, { 31,  5}, { 43,  5}, { 55,  5}, { 68,  5}, { 86,  5}, { 98,  5}, {110,  5}, {123,  5}, {141,  5},
+        {153,  5}, {166,  5}, {178,  5}, {  6, 20}, { 18, 20}, { 31, 20}, { 43, 20}, { 55, 20}, { 68, 20}, { 80, 20},
+        { 92, 20}, {104, 20}, {117, 20}, {129, 20}, {141, 20}, {153, 20}, {172, 20}, {  9, 30}, { 25, 30}, { 37, 30},
+        { 49, 30}, { 61, 30}, { 74, 30}, { 86, 30}, { 98, 30}, {110, 30}, {123, 30}, {135, 30}, {147, 30}, {160, 30},
+        {175, 30}, { 11, 39}, { 28, 39}, { 40, 39}, { 52, 39}, { 64, 39}, { 77, 39}, { 89, 39}, {101, 39}, {114, 39},
+        {126, 39}, {138, 39}, {150, 39}, {170, 39}, { 14, 49}, { 34, 49}, { 46, 49}, { 58, 49}, { 71, 49}, { 83, 49},
+        { 95, 49}, {107, 49}, {120, 49}, {132, 49}, {144, 49}, {167, 49}, {  8, 59}, { 23, 59}, { 38, 59}, { 84, 59},
+        {130, 59}, {146, 59}, {161, 59}, {176, 59}, {193,  5}, {206,  5}, {218,  5}, {193, 20}, {206, 20}, {218, 20},
+        {193, 30}, {206, 30}, {218, 30}, {206, 49}, {193, 59}, {206, 59}, {218, 59},
+    }, {
+        4, 4, 4, 4, 4, 4, 4, 4, 4, 4,
+        4, 4, 4, 4, 4, 4, 4, 4, 4, 4,
+        4, 4, 4, 4, 4, 4, 1, 1, 4, 4,
+        4, 4, 4, 4, 4, 4, 4, 4, 4, 4,
+        1, 1, 4, 4, 4, 4, 4, 4, 4, 4,
+        4, 4, 4, 1, 1, 4, 4, 4, 4, 4,
+        4, 4, 4, 4, 4, 1, 1, 1, 1, 1,
+        1, 1, 1, 1, 4, 4, 4, 4, 4, 4,
+        4, 4, 4, 4, 4, 4, 4,
+    }
+};
+// clang-format on
@@ -0,0 +1,10 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include "test_common.h"
+
+#define RGB_MATRIX_LED_COUNT 61
+#define RGB_MATRIX_FRAME_PACING
+#define RGB_MATRIX_ITERATION_BUDGET_US 200
@@ -0,0 +1,31 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "quantum.h"
+
+// clang-format off
+led_config_t g_led_config = {
+    {
+        {  0,   1,   3,   4,   6,   7,   9,  10,  12,  13},
+        { 15,  16,  18,  19,  21,  22,  24,  25,  27,  28},
+        { 30,  32,  33,  35,  36,  38,  39,  41,  42,  44},
+        { 45,  47,  48,  50,  51,  53,  54,  56,  57,  59},
+    }, {
+        {  7,  6}, { 22,  6}, { 37,  6}, { 52,  6}, { 67,  6}, { 82,  6}, { 97,  6}, {112,  6}, {127,  6}, {142,  6},
+        {157,  6}, {172,  6}, {187,  6}, {209,  6}, { 11, 19}, { 30, 19}, { 45, 19}, { 60, 19}, { 75, 19}, { 90, 19},
+        {105, 19}, {119, 19}, {134, 19}, {149, 19}, {164, 19}, {179, 19}, {194, 19}, {213, 19}, { 13, 32}, { 34, 32},
+        { 49, 32}, { 63, 32}, { 78, 32}, { 93, 32}, {108, 32}, {123, 32}, {138, 32}, {153, 32}, {168, 32}, {183, 32},
+        {207, 32}, { 17, 45}, { 41, 45}, { 56, 45}, { 71, 45}, { 86, 45}, {101, 45}, {116, 45}, {131, 45}, {146, 45},
+        {161, 45}, {175, 45}, {203, 45}, {  9, 58}, { 28, 58}, { 47, 58}, {103, 58}, {159, 58}, {177, 58}, {196, 58},
+        {215, 58},
+    }, {
+        4, 4, 4, 4, 4, 4, 4, 4, 4, 4,
+        4, 4, 4, 1, 1, 4, 4, 4, 4, 4,
+        4, 4, 4, 4, 4, 4, 4, 1, 1, 4,
+        4, 4, 4, 4, 4, 4, 4, 4, 4, 4,
+        1, 1, 4, 4, 4, 4, 4, 4, 4, 4,
+        4, 4, 1, 1, 1, 1, 1, 1, 1, 1,
+        1,
+    }
+};
+// clang-format on
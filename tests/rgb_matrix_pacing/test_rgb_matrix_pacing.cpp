@@ -0,0 +1,175 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <algorithm>
+
+#include "gtest/gtest.h"
+
+extern "C" {
+#include "quantum.h"
+
+void set_time(uint32_t t);
+}
+
+namespace {
+
+// Simulated clock: the fake driver spends `led_cost_us` per LED written and `flush_cost_us` per flush
+uint32_t now_us;
+uint32_t led_cost_us;
+uint32_t flush_cost_us;
+
+// Whether rgb_matrix_pacing_timer_us() has a microsecond clock to read, as on AVR it doesn't
+bool has_us_clock;
+// Resolution of that clock, as it only advances on system ticks on ChibiOS
+uint32_t us_clock_tick;
+
+// LEDs in the largest render iteration since the last reset
+uint8_t max_chunk;
+
+void test_led_init(void) {}
+
+void test_led_set_color(int index, uint8_t r, uint8_t g, uint8_t b) {
+    now_us += led_cost_us;
+}
+
+void test_led_set_color_all(uint8_t r, uint8_t g, uint8_t b) {
+    now_us += led_cost_us * RGB_MATRIX_LED_COUNT;
+}
+
+void test_led_flush(void) {
+    now_us += flush_cost_us;
+}
+
+struct LoopStats {
+    uint32_t iterations     = 0;
+    uint32_t rgb_iterations = 0; // iterations in which rgb_matrix_task() did any work
+    uint32_t max_rgb_us     = 0;
+};
+
+class RgbMatrixPacing : public ::testing::Test {
+   protected:
+    void SetUp() override {
+        led_cost_us   = 10;
+        flush_cost_us = 100;
+        has_us_clock  = true;
+        us_clock_tick = 1;
+        rgb_matrix_init();
+        rgb_matrix_enable_noeeprom();
+        rgb_matrix_sethsv_noeeprom(0, 255, 255);
+        rgb_matrix_mode_noeeprom(RGB_MATRIX_SOLID_COLOR);
+    }
+
+    // Runs the main loop for `ms`, the rest of the loop taking `loop_us` per iteration
+    LoopStats run(uint32_t ms, uint32_t loop_us) {
+        LoopStats stats;
+        max_chunk    = 0;
+        uint32_t end = now_us + ms * 1000;
+        while ((int32_t)(end - now_us) > 0) {
+            now_us += loop_us;
+            uint32_t rgb_start = now_us;
+            rgb_matrix_task();
+            uint32_t rgb_us = now_us - rgb_start;
+
+            stats.iterations++;
+            stats.rgb_iterations += rgb_us > 0;
+            stats.max_rgb_us = std::max(stats.max_rgb_us, rgb_us);
+            set_time(now_us / 1000);
+        }
+        return stats;
+    }
+};
+
+TEST_F(RgbMatrixPacing, IterationsStayWithinBudget) {
+    run(500, 100);
+    auto stats = run(2000, 100);
+
+    EXPECT_LE(stats.max_rgb_us, RGB_MATRIX_ITERATION_BUDGET_US);
+    EXPECT_EQ(max_chunk, RGB_MATRIX_ITERATION_BUDGET_US / 10);
+    // Frames start every RGB_MATRIX_LED_FLUSH_LIMIT ms
+    EXPECT_GE(rgb_matrix_get_fps(), 55);
+    EXPECT_LE(rgb_matrix_get_fps(), 1000 / RGB_MATRIX_LED_FLUSH_LIMIT);
+}
+
+TEST_F(RgbMatrixPacing, ChunksFollowTheRenderCost) {
+    led_cost_us = 40;
+    run(1000, 100);
+    auto stats = run(500, 100);
+    EXPECT_EQ(max_chunk, RGB_MATRIX_ITERATION_BUDGET_US / 40);
+    EXPECT_LE(stats.max_rgb_us, RGB_MATRIX_ITERATION_BUDGET_US);
+
+    // Cheap enough to render the whole frame, and flush it, in one iteration
+    led_cost_us   = 1;
+    flush_cost_us = 50;
+    run(1000, 100);
+    stats = run(500, 100);
+    EXPECT_EQ(max_chunk, RGB_MATRIX_LED_COUNT);
+    EXPECT_LE(stats.max_rgb_us, RGB_MATRIX_ITERATION_BUDGET_US);
+}
+
+TEST_F(RgbMatrixPacing, SlowLedsStillRenderOneLedPerIteration) {
+    led_cost_us = RGB_MATRIX_ITERATION_BUDGET_US * 2;
+    run(2000, 100);
+    run(1000, 100);
+    EXPECT_EQ(max_chunk, 1);
+    EXPECT_GT(rgb_matrix_get_fps(), 0);
+}
+
+TEST_F(RgbMatrixPacing, NoMicrosecondClockKeepsProcessLimit) {
+    has_us_clock = false;
+    run(2000, 100);
+    run(500, 100);
+    EXPECT_EQ(max_chunk, RGB_MATRIX_LED_PROCESS_LIMIT);
+
+    // Nothing to measure the rest of the loop with, so frames aren't dropped either
+    uint16_t idle_fps = rgb_matrix_get_fps();
+    run(2000, 500);
+    EXPECT_GE(rgb_matrix_get_fps(), idle_fps * 9 / 10);
+}
+
+TEST_F(RgbMatrixPacing, BusyLoopDropsFrames) {
+    run(2000, 100);
+    uint16_t idle_fps = rgb_matrix_get_fps();
+    ASSERT_GE(idle_fps, 55);
+
+    // Typing burst: the rest of the loop takes more than the budget on every iteration. Every other frame is dropped,
+    // the ones in between are rendered without yielding again.
+    auto busy = run(2000, 500);
+    EXPECT_LT(rgb_matrix_get_fps(), idle_fps * 3 / 4);
+    EXPECT_GE(rgb_matrix_get_fps(), idle_fps / 2 - 1);
+    EXPECT_LT(busy.rgb_iterations * 10, busy.iterations);
+    EXPECT_LE(busy.max_rgb_us, RGB_MATRIX_ITERATION_BUDGET_US);
+
+    run(2000, 100);
+    EXPECT_EQ(rgb_matrix_get_fps(), idle_fps);
+}
+
+TEST_F(RgbMatrixPacing, CoarseClockKeepsFrameRate) {
+    // With a 1ms tick, and the rest of the loop taking a tick, every iteration looks over budget
+    us_clock_tick = 1000;
+    run(10000, 1000);
+
+    // One frame interval is dropped, then the frame is rendered without yielding again
+    EXPECT_GE(rgb_matrix_get_fps(), 1000 / (RGB_MATRIX_LED_FLUSH_LIMIT * 3));
+}
+
+} // namespace
+
+extern "C" {
+const rgb_matrix_driver_t rgb_matrix_driver = {
+    test_led_init,
+    test_led_set_color,
+    test_led_set_color_all,
+    test_led_flush,
+};
+
+uint32_t rgb_matrix_pacing_timer_us(void) {
+    return has_us_clock ? now_us / us_clock_tick * us_clock_tick : 0;
+}
+
+bool rgb_matrix_indicators_advanced_user(uint8_t led_min, uint8_t led_max) {
+    if (led_max > led_min) {
+        max_chunk = std::max<uint8_t>(max_chunk, led_max - led_min);
+    }
+    return true;
+}
+}
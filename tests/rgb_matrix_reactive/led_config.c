@@ -0,0 +1,52 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "quantum.h"
+
+// clang-format off
+led_config_t g_led_config = {
+    {
+        {  0,   1,   2,   3,   4,   5,   6,   7,   8,   9},
+        { 10,  11,  12,  13,  14,  15,  16,  17,  18,  19},
+        { 20,  21,  22,  23,  24,  25,  26,  27,  28,  29},
+        { 30,  31,  32,  33,  34,  35,  36,  37,  38,  39},
+    }, {
+        {  0,  0}, { 14,  0}, { 28,  0}, { 42,  0}, { 56,  0}, { 70,  0}, { 84,  0}, { 98,  0}, {112,  0}, {126,  0}, {140,  0}, {154,  0}, {168,  0}, {182,  0}, {196,  0}, {210,  0}, {224,  0},
+        {  0, 13}, { 11, 13}, { 22, 13}, { 34, 13}, { 45, 13}, { 56, 13}, { 67, 13}, { 78, 13}, { 90, 13}, {101, 13}, {112, 13}, {123, 13}, {134, 13}, {146, 13}, {157, 13}, {168, 13}, {179, 13}, {190, 13}, {202, 13}, {213, 13}, {224, 13},
+        {  0, 26}, { 11, 26}, { 22, 26}, { 34, 26}, { 45, 26}, { 56, 26}, { 67, 26}, { 78, 26}, { 90, 26}, {101, 26}, {112, 26}, {123, 26}, {134, 26}, {146, 26}, {157, 26}, {168, 26}, {179, 26}, {190, 26}, {202, 26}, {213, 26}, {224, 26},
+        {  0, 38}, { 14, 38}, { 28, 38}, { 42, 38}, { 56, 38}, { 70, 38}, { 84, 38}, { 98, 38}, {112, 38}, {126, 38}, {140, 38}, {154, 38}, {168, 38}, {182, 38}, {196, 38}, {210, 38}, {224, 38},
+        {  0, 51}, { 14, 51}, { 28, 51}, { 42, 51}, { 56, 51}, { 70, 51}, { 84, 51}, { 98, 51}, {112, 51}, {126, 51}, {140, 51}, {154, 51}, {168, 51}, {182, 51}, {196, 51}, {210, 51}, {224, 51},
+        {  0, 64}, { 14, 64}, { 28, 64}, { 42, 64}, { 56, 64}, { 70, 64}, { 84, 64}, { 98, 64}, {112, 64}, {126, 64}, {140, 64}, {154, 64}, {168, 64}, {182, 64}, {196, 64}, {210, 64}, {224, 64},
+    }, {
+        4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4,
+        4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4,
+        4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4,
+        4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4,
+        4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4,
+        4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4,
+    }
+};
+// clang-format on
+
+RGB test_led_frame[RGB_MATRIX_LED_COUNT];
+
+static void test_led_init(void) {}
+
+static void test_led_set_color(int index, uint8_t r, uint8_t g, uint8_t b) {
+    test_led_frame[index] = (RGB){.r = r, .g = g, .b = b};
+}
+
+static void test_led_set_color_all(uint8_t r, uint8_t g, uint8_t b) {
+    for (uint8_t i = 0; i < RGB_MATRIX_LED_COUNT; i++) {
+        test_led_set_color(i, r, g, b);
+    }
+}
+
+static void test_led_flush(void) {}
+
+const rgb_matrix_driver_t rgb_matrix_driver = {
+    .init          = test_led_init,
+    .set_color     = test_led_set_color,
+    .set_color_all = test_led_set_color_all,
+    .flush         = test_led_flush,
+};
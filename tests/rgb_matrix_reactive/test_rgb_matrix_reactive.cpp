@@ -0,0 +1,243 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <chrono>
+#include <cstdio>
+#include <random>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+extern "C" {
+#include "quantum.h"
+#include "lib/lib8tion/lib8tion.h"
+
+extern RGB test_led_frame[RGB_MATRIX_LED_COUNT];
+
+RGB rgb_matrix_hsv_to_rgb(HSV hsv);
+
+bool SOLID_REACTIVE_WIDE(effect_params_t *params);
+bool SOLID_REACTIVE_MULTIWIDE(effect_params_t *params);
+bool SOLID_REACTIVE_CROSS(effect_params_t *params);
+bool SOLID_REACTIVE_MULTICROSS(effect_params_t *params);
+bool SOLID_REACTIVE_NEXUS(effect_params_t *params);
+bool SOLID_REACTIVE_MULTINEXUS(effect_params_t *params);
+bool SPLASH(effect_params_t *params);
+bool MULTISPLASH(effect_params_t *params);
+bool SOLID_SPLASH(effect_params_t *params);
+bool SOLID_MULTISPLASH(effect_params_t *params);
+}
+
+namespace {
+
+typedef HSV (*reference_math_f)(HSV hsv, int16_t dx, int16_t dy, uint8_t dist, uint16_t tick);
+
+// Copies of the effect math, as the effects themselves only expose the whole render
+HSV reference_wide(HSV hsv, int16_t dx, int16_t dy, uint8_t dist, uint16_t tick) {
+    uint16_t effect = tick + dist * 5;
+    if (effect > 255) effect = 255;
+    hsv.v = qadd8(hsv.v, 255 - effect);
+    return hsv;
+}
+
+HSV reference_cross(HSV hsv, int16_t dx, int16_t dy, uint8_t dist, uint16_t tick) {
+    uint16_t effect = tick + dist;
+    dx              = dx < 0 ? dx * -1 : dx;
+    dy              = dy < 0 ? dy * -1 : dy;
+    dx              = dx * 16 > 255 ? 255 : dx * 16;
+    dy              = dy * 16 > 255 ? 255 : dy * 16;
+    effect += dx > dy ? dy : dx;
+    if (effect > 255) effect = 255;
+    hsv.v = qadd8(hsv.v, 255 - effect);
+    return hsv;
+}
+
+HSV reference_nexus(HSV hsv, int16_t dx, int16_t dy, uint8_t dist, uint16_t tick) {
+    uint16_t effect = tick - dist;
+    if (effect > 255) effect = 255;
+    if (dist > 72) effect = 255;
+    if ((dx > 8 || dx < -8) && (dy > 8 || dy < -8)) effect = 255;
+    hsv.h = rgb_matrix_config.hsv.h + dy / 4;
+    hsv.v = qadd8(hsv.v, 255 - effect);
+    return hsv;
+}
+
+HSV reference_splash(HSV hsv, int16_t dx, int16_t dy, uint8_t dist, uint16_t tick) {
+    uint16_t effect = tick - dist;
+    if (effect > 255) effect = 255;
+    hsv.h += effect;
+    hsv.v = qadd8(hsv.v, 255 - effect);
+    return hsv;
+}
+
+HSV reference_solid_splash(HSV hsv, int16_t dx, int16_t dy, uint8_t dist, uint16_t tick) {
+    uint16_t effect = tick - dist;
+    if (effect > 255) effect = 255;
+    hsv.v = qadd8(hsv.v, 255 - effect);
+    return hsv;
+}
+
+// The reactive splash runner as it was before hits were culled and distances cached
+void reference_render(uint8_t start, reference_math_f math, RGB *frame) {
+    for (uint8_t i = 0; i < RGB_MATRIX_LED_COUNT; i++) {
+        HSV hsv = rgb_matrix_config.hsv;
+        hsv.v   = 0;
+        for (uint8_t j = start; j < g_last_hit_tracker.count; j++) {
+            int16_t  dx   = g_led_config.point[i].x - g_last_hit_tracker.x[j];
+            int16_t  dy   = g_led_config.point[i].y - g_last_hit_tracker.y[j];
+            uint8_t  dist = sqrt16(dx * dx + dy * dy);
+            uint16_t tick = scale16by8(g_last_hit_tracker.tick[j], qadd8(rgb_matrix_config.speed, 1));
+            hsv           = math(hsv, dx, dy, dist, tick);
+        }
+        hsv.v    = scale8(hsv.v, rgb_matrix_config.hsv.v);
+        frame[i] = rgb_matrix_hsv_to_rgb(hsv);
+    }
+}
+
+struct ReactiveEffect {
+    const char *name;
+    bool (*effect)(effect_params_t *params);
+    reference_math_f math;
+    bool             multi;
+    // Expired hits used to shift the hue of SPLASH by one step each, which culling them no longer does
+    bool ignore_hue;
+};
+
+const ReactiveEffect effects[] = {
+    {"SOLID_REACTIVE_WIDE", SOLID_REACTIVE_WIDE, reference_wide, false, false},
+    {"SOLID_REACTIVE_MULTIWIDE", SOLID_REACTIVE_MULTIWIDE, reference_wide, true, false},
+    {"SOLID_REACTIVE_CROSS", SOLID_REACTIVE_CROSS, reference_cross, false, false},
+    {"SOLID_REACTIVE_MULTICROSS", SOLID_REACTIVE_MULTICROSS, reference_cross, true, false},
+    {"SOLID_REACTIVE_NEXUS", SOLID_REACTIVE_NEXUS, reference_nexus, false, false},
+    {"SOLID_REACTIVE_MULTINEXUS", SOLID_REACTIVE_MULTINEXUS, reference_nexus, true, false},
+    {"SPLASH", SPLASH, reference_splash, false, true},
+    {"MULTISPLASH", MULTISPLASH, reference_splash, true, true},
+    {"SOLID_SPLASH", SOLID_SPLASH, reference_solid_splash, false, false},
+    {"SOLID_MULTISPLASH", SOLID_MULTISPLASH, reference_solid_splash, true, false},
+};
+
+// Renders a whole frame, in as many iterations as RGB_MATRIX_LED_PROCESS_LIMIT requires
+void render(const ReactiveEffect &effect) {
+    effect_params_t params = {0, LED_FLAG_ALL, false};
+    while (effect.effect(&params)) {
+        params.iter++;
+    }
+}
+
+void reference_render(const ReactiveEffect &effect, RGB *frame) {
+    reference_render(effect.multi ? 0 : qsub8(g_last_hit_tracker.count, 1), effect.math, frame);
+}
+
+class RgbMatrixReactive : public ::testing::Test {
+   protected:
+    void SetUp() override {
+        rgb_matrix_config.hsv   = (HSV){0, 255, 255};
+        rgb_matrix_config.speed = RGB_MATRIX_DEFAULT_SPD;
+        hits.clear();
+        g_last_hit_tracker.count = 0;
+    }
+
+    // Presses the key at `led`, after `elapsed` ms without any presses
+    void press(uint8_t led, uint16_t elapsed) {
+        for (auto &hit : hits) {
+            hit.second = hit.second + elapsed > UINT16_MAX ? UINT16_MAX : hit.second + elapsed;
+        }
+        if (hits.size() == LED_HITS_TO_REMEMBER) {
+            hits.erase(hits.begin());
+        }
+        hits.push_back({led, 0});
+        update_tracker(hits.size());
+    }
+
+    // Makes the last `count` presses visible to the effects
+    void update_tracker(size_t count) {
+        g_last_hit_tracker.count = count;
+        for (size_t j = 0; j < count; j++) {
+            const auto &hit             = hits[hits.size() - count + j];
+            g_last_hit_tracker.x[j]     = g_led_config.point[hit.first].x;
+            g_last_hit_tracker.y[j]     = g_led_config.point[hit.first].y;
+            g_last_hit_tracker.index[j] = hit.first;
+            g_last_hit_tracker.tick[j]  = hit.second;
+        }
+    }
+
+    void expect_matches_reference(const ReactiveEffect &effect) {
+        RGB expected[RGB_MATRIX_LED_COUNT];
+        HSV hsv = rgb_matrix_config.hsv;
+        if (effect.ignore_hue) {
+            rgb_matrix_config.hsv.s = 0;
+        }
+        render(effect);
+        reference_render(effect, expected);
+        rgb_matrix_config.hsv = hsv;
+
+        for (uint8_t i = 0; i < RGB_MATRIX_LED_COUNT; i++) {
+            ASSERT_EQ(test_led_frame[i].r, expected[i].r) << effect.name << " led " << +i << " with " << +g_last_hit_tracker.count << " hits";
+            ASSERT_EQ(test_led_frame[i].g, expected[i].g) << effect.name << " led " << +i << " with " << +g_last_hit_tracker.count << " hits";
+            ASSERT_EQ(test_led_frame[i].b, expected[i].b) << effect.name << " led " << +i << " with " << +g_last_hit_tracker.count << " hits";
+        }
+    }
+
+    std::vector<std::pair<uint8_t, uint16_t>> hits;
+};
+
+TEST_F(RgbMatrixReactive, NoHitsLeaveTheLedsOff) {
+    for (const auto &effect : effects) {
+        render(effect);
+        for (uint8_t i = 0; i < RGB_MATRIX_LED_COUNT; i++) {
+            EXPECT_EQ(test_led_frame[i].r | test_led_frame[i].g | test_led_frame[i].b, 0) << effect.name << " led " << +i;
+        }
+    }
+}
+
+TEST_F(RgbMatrixReactive, TypingMatchesPerLedDistances) {
+    std::mt19937 rng(1234);
+    for (size_t press_count = 0; press_count < 400; press_count++) {
+        rgb_matrix_config.hsv   = (HSV){(uint8_t)rng(), 255, (uint8_t)(rng() | 1)};
+        rgb_matrix_config.speed = rng();
+        // Bursts of fast typing, separated by pauses long enough to let every ripple expire
+        press(rng() % RGB_MATRIX_LED_COUNT, press_count % 50 == 0 ? 5000 : rng() % 200);
+
+        for (size_t count : {size_t(1), size_t(8), size_t(16), size_t(32)}) {
+            if (count > hits.size()) break;
+            update_tracker(count);
+            for (const auto &effect : effects) {
+                expect_matches_reference(effect);
+                if (HasFatalFailure()) return;
+            }
+        }
+    }
+}
+
+TEST_F(RgbMatrixReactive, RenderBenchmark) {
+    const size_t frames = 2000;
+    std::mt19937 rng(5678);
+    RGB          expected[RGB_MATRIX_LED_COUNT];
+
+    for (size_t count : {size_t(8), size_t(16), size_t(32)}) {
+        // A fast typist: a key every 40 to 80ms
+        hits.clear();
+        for (size_t j = 0; j < count; j++) {
+            press(rng() % RGB_MATRIX_LED_COUNT, 40 + rng() % 40);
+        }
+
+        for (const auto &effect : effects) {
+            auto start = std::chrono::steady_clock::now();
+            for (size_t f = 0; f < frames; f++) {
+                render(effect);
+            }
+            auto render_ns = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start).count();
+
+            start = std::chrono::steady_clock::now();
+            for (size_t f = 0; f < frames; f++) {
+                reference_render(effect, expected);
+            }
+            auto reference_ns = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start).count();
+
+            printf("%-26s %2zu hits: %8.0f ns/frame, per-LED distances %8.0f ns/frame\n", effect.name, count, (double)render_ns / frames, (double)reference_ns / frames);
+            expect_matches_reference(effect);
+        }
+    }
+}
+
+} // namespace
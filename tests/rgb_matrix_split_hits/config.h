@@ -0,0 +1,14 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include "test_common.h"
+
+#define RGB_MATRIX_LED_COUNT 58
+#define RGB_MATRIX_SPLIT {29, 29}
+#define SPLIT_RGB_MATRIX_HITS_ENABLE
+#define RGB_MATRIX_KEYPRESSES
+
+#define ENABLE_RGB_MATRIX_SOLID_REACTIVE_MULTIWIDE
+#define ENABLE_RGB_MATRIX_MULTISPLASH
@@ -0,0 +1,323 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <algorithm>
+#include <cstring>
+#include <random>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+extern "C" {
+#include "quantum.h"
+
+void advance_time(uint32_t ms);
+void set_time(uint32_t t);
+}
+
+namespace {
+
+RGB      leds[RGB_MATRIX_LED_COUNT];
+bool     keyboard_master = true;
+uint32_t frame_hash;
+uint32_t flushes;
+
+void test_led_init(void) {}
+
+void test_led_set_color(int index, uint8_t r, uint8_t g, uint8_t b) {
+    leds[index].r = r;
+    leds[index].g = g;
+    leds[index].b = b;
+}
+
+void test_led_set_color_all(uint8_t r, uint8_t g, uint8_t b) {
+    for (uint8_t i = 0; i < RGB_MATRIX_LED_COUNT; i++) {
+        test_led_set_color(i, r, g, b);
+    }
+}
+
+void test_led_flush(void) {
+    uint32_t hash = 2166136261u;
+    for (uint8_t i = 0; i < RGB_MATRIX_LED_COUNT; i++) {
+        for (uint8_t channel : {leds[i].r, leds[i].g, leds[i].b}) {
+            hash = (hash ^ channel) * 16777619u;
+        }
+    }
+    frame_hash = hash;
+    flushes++;
+}
+
+struct SwitchEvent {
+    uint32_t time; // ms from the start of the run
+    uint8_t  row;
+    uint8_t  col;
+    bool     pressed;
+};
+
+struct Frame {
+    uint32_t   time;
+    uint32_t   hash;
+    last_hit_t hits;
+};
+
+// Transactions recorded on the master, delivered to the slave's shared memory after `delay_ms`
+struct LoopbackTransport {
+    struct Transaction {
+        uint32_t                time;
+        rgb_matrix_split_hits_t hits;
+        uint8_t                 length;
+    };
+
+    uint32_t                 delay_ms         = 0;
+    uint32_t                 fail_every       = 0; // fail every n-th transaction, 0 for none
+    uint32_t                 slave_read_every = 1; // the slave only runs its transactions every n ms
+    uint32_t                 attempts         = 0;
+    std::vector<Transaction> sent;
+};
+
+const uint32_t RUN_MS          = 3000;
+const uint32_t FRAME_RENDER_MS = 10;
+
+class RgbMatrixSplitHits : public ::testing::Test {
+   protected:
+    void SetUp() override {
+        std::mt19937 rng(42);
+        for (uint32_t t = 100; t < RUN_MS - 500; t += 20 + rng() % 100) {
+            uint8_t row = rng() % MATRIX_ROWS, col = rng() % MATRIX_COLS;
+            events.push_back({t, row, col, true});
+            events.push_back({t + 30, row, col, false});
+        }
+        std::sort(events.begin(), events.end(), [](const SwitchEvent &a, const SwitchEvent &b) { return a.time < b.time; });
+    }
+
+    // Starts both runs from the same state, on a 16 bit timer boundary
+    void start_run(bool master) {
+        keyboard_master = master;
+        set_time((timer_read32() | 0xFFFF) + 1);
+        rgb_matrix_init();
+        rgb_matrix_enable_noeeprom();
+        rgb_matrix_sethsv_noeeprom(0, 255, 255);
+        rgb_matrix_set_speed_noeeprom(RGB_MATRIX_DEFAULT_SPD);
+        rgb_matrix_mode_noeeprom(RGB_MATRIX_MULTISPLASH);
+    }
+
+    void record_frame(std::vector<Frame> &frames, uint32_t start, uint32_t flushed) {
+        if (flushes != flushed) {
+            frames.push_back({timer_read32() - start, frame_hash, g_last_hit_tracker});
+        }
+    }
+
+    std::vector<Frame> run_master(LoopbackTransport &transport) {
+        std::vector<Frame> frames;
+        start_run(true);
+        uint32_t start = timer_read32();
+        size_t   next  = 0;
+        for (uint32_t t = 0; t < RUN_MS; t++) {
+            for (; next < events.size() && events[next].time == t; next++) {
+                process_rgb_matrix(events[next].row, events[next].col, events[next].pressed);
+            }
+
+            rgb_matrix_split_hits_t hits;
+            if (rgb_matrix_split_hits_pending(&hits)) {
+                bool okay = !transport.fail_every || ++transport.attempts % transport.fail_every != 0;
+                if (okay) {
+                    transport.sent.push_back({t, hits, (uint8_t)(offsetof(rgb_matrix_split_hits_t, hits) + hits.count * sizeof(hits.hits[0]))});
+                    rgb_matrix_split_hits_sent(&hits);
+                }
+            }
+
+            uint32_t flushed = flushes;
+            rgb_matrix_task();
+            record_frame(frames, start, flushed);
+            advance_time(1);
+        }
+        return frames;
+    }
+
+    std::vector<Frame> run_slave(const LoopbackTransport &transport) {
+        std::vector<Frame>      frames;
+        rgb_matrix_split_hits_t shmem;
+        memset(&shmem, 0, sizeof(shmem));
+
+        start_run(false);
+        uint32_t start = timer_read32();
+        size_t   next = 0, delivered = 0;
+        for (uint32_t t = 0; t < RUN_MS; t++) {
+            for (; delivered < transport.sent.size() && transport.sent[delivered].time + transport.delay_ms <= t; delivered++) {
+                memcpy(&shmem, &transport.sent[delivered].hits, transport.sent[delivered].length);
+            }
+            if (t % transport.slave_read_every == 0) {
+                rgb_matrix_split_hits_apply(&shmem);
+            }
+
+            // The slave's own switches only reach the effects through the master
+            for (; next < events.size() && events[next].time == t; next++) {
+                process_rgb_matrix(events[next].row, events[next].col, events[next].pressed);
+            }
+
+            uint32_t flushed = flushes;
+            rgb_matrix_task();
+            record_frame(frames, start, flushed);
+            advance_time(1);
+        }
+        return frames;
+    }
+
+    // Compares the frames rendered once the slave had the time to receive the last switch event. Frames are recorded when
+    // flushed, but take their hits from when they started rendering.
+    void expect_same_frames(const std::vector<Frame> &master, const std::vector<Frame> &slave, uint32_t settle_ms) {
+        settle_ms += FRAME_RENDER_MS;
+        ASSERT_EQ(master.size(), slave.size());
+        size_t compared = 0, event = 0;
+        for (size_t f = 0; f < master.size(); f++) {
+            ASSERT_EQ(master[f].time, slave[f].time);
+            while (event + 1 < events.size() && events[event + 1].time <= master[f].time) {
+                event++;
+            }
+            if (master[f].time < events[event].time + settle_ms) {
+                continue;
+            }
+
+            const last_hit_t &m = master[f].hits, &s = slave[f].hits;
+            ASSERT_EQ(m.count, s.count) << "frame at " << master[f].time << "ms";
+            for (uint8_t i = 0; i < m.count; i++) {
+                EXPECT_EQ(m.index[i], s.index[i]) << "frame at " << master[f].time << "ms, hit " << +i;
+                EXPECT_EQ(m.tick[i], s.tick[i]) << "frame at " << master[f].time << "ms, hit " << +i;
+            }
+            EXPECT_EQ(master[f].hash, slave[f].hash) << "frame at " << master[f].time << "ms";
+            compared++;
+        }
+        EXPECT_GT(compared, master.size() / 2);
+    }
+
+    // Hashes of the frames flushed over the next `ms`
+    std::vector<uint32_t> render(uint32_t ms) {
+        std::vector<uint32_t> hashes;
+        for (uint32_t t = 0; t < ms; t++) {
+            uint32_t flushed = flushes;
+            rgb_matrix_task();
+            if (flushes != flushed) {
+                hashes.push_back(frame_hash);
+            }
+            advance_time(1);
+        }
+        return hashes;
+    }
+
+    // Starts a slave which has been running for a while, returning the frame it renders without any hits
+    uint32_t start_idle_slave() {
+        start_run(false);
+        render(500);
+        return frame_hash;
+    }
+
+    static bool all_idle(const std::vector<uint32_t> &hashes, uint32_t idle) {
+        return !hashes.empty() && std::all_of(hashes.begin(), hashes.end(), [&](uint32_t hash) { return hash == idle; });
+    }
+
+    rgb_matrix_split_hit_t hit_ago(uint32_t ms) {
+        return {.row = 0, .col = 1, .pressed = true, .time = (uint16_t)(timer_read32() - ms)};
+    }
+
+    std::vector<SwitchEvent> events;
+};
+
+TEST_F(RgbMatrixSplitHits, SlaveRendersTheMastersHits) {
+    LoopbackTransport transport;
+    auto              master = run_master(transport);
+    auto              slave  = run_slave(transport);
+    expect_same_frames(master, slave, 0);
+
+    // Only iterations with new switch events send anything
+    EXPECT_GT(transport.sent.size(), 0);
+    EXPECT_LE(transport.sent.size(), events.size());
+    EXPECT_LT(transport.sent.back().time, events.back().time + 1);
+    for (const auto &transaction : transport.sent) {
+        EXPECT_LE(transaction.length, sizeof(rgb_matrix_split_hits_t));
+    }
+}
+
+TEST_F(RgbMatrixSplitHits, LateAndOverwrittenTransactions) {
+    LoopbackTransport transport;
+    transport.delay_ms         = 3;
+    transport.slave_read_every = 4;
+    auto master                = run_master(transport);
+    auto slave                 = run_slave(transport);
+    expect_same_frames(master, slave, transport.delay_ms + transport.slave_read_every);
+}
+
+TEST_F(RgbMatrixSplitHits, FailedTransactionsAreRetried) {
+    LoopbackTransport transport;
+    transport.fail_every = 2;
+    auto master          = run_master(transport);
+    auto slave           = run_slave(transport);
+    expect_same_frames(master, slave, 2);
+}
+
+TEST_F(RgbMatrixSplitHits, OldHitIsNotAnimated) {
+    auto idle = start_idle_slave();
+
+    rgb_matrix_split_hits_t hits = {.seq = 1, .count = 1, .hits = {hit_ago(40000)}};
+    rgb_matrix_split_hits_apply(&hits);
+    EXPECT_TRUE(all_idle(render(500), idle));
+    EXPECT_EQ(g_last_hit_tracker.count, 0);
+}
+
+TEST_F(RgbMatrixSplitHits, WindowIsNotReplayedOnFirstSync) {
+    auto idle = start_idle_slave();
+
+    // The slave restarted while the master kept running, so the window holds hits it has already rendered
+    rgb_matrix_split_hits_t hits = {.seq = 57, .count = SPLIT_RGB_MATRIX_HITS_MAX};
+    for (uint8_t i = 0; i < hits.count; i++) {
+        hits.hits[i] = hit_ago(100 - i);
+    }
+    rgb_matrix_split_hits_apply(&hits);
+    EXPECT_TRUE(all_idle(render(500), idle));
+    EXPECT_EQ(g_last_hit_tracker.count, 0);
+
+    // Later hits are animated
+    memmove(&hits.hits[0], &hits.hits[1], (hits.count - 1) * sizeof(hits.hits[0]));
+    hits.hits[hits.count - 1] = hit_ago(0);
+    hits.seq++;
+    rgb_matrix_split_hits_apply(&hits);
+    EXPECT_FALSE(all_idle(render(500), idle));
+    EXPECT_EQ(g_last_hit_tracker.count, 1);
+}
+
+TEST_F(RgbMatrixSplitHits, WindowIsNotReplayedWhenSeqRewinds) {
+    auto idle = start_idle_slave();
+
+    rgb_matrix_split_hits_t hits = {.seq = 1, .count = 1, .hits = {hit_ago(0)}};
+    rgb_matrix_split_hits_apply(&hits);
+    render(5000);
+    uint8_t applied = g_last_hit_tracker.count;
+
+    // The sequence went backwards, from another master or one which restarted longer ago than its window
+    hits = {.seq = 200, .count = SPLIT_RGB_MATRIX_HITS_MAX};
+    for (uint8_t i = 0; i < hits.count; i++) {
+        hits.hits[i] = hit_ago(100 - i);
+    }
+    rgb_matrix_split_hits_apply(&hits);
+    EXPECT_TRUE(all_idle(render(500), idle));
+    EXPECT_EQ(g_last_hit_tracker.count, applied);
+}
+
+} // namespace
+
+extern "C" {
+const rgb_matrix_driver_t rgb_matrix_driver = {
+    test_led_init,
+    test_led_set_color,
+    test_led_set_color_all,
+    test_led_flush,
+};
+
+bool is_keyboard_master(void) {
+    return keyboard_master;
+}
+
+// Both runs render the same half, so their frames can be compared
+bool is_keyboard_left(void) {
+    return true;
+}
+}
@@ -0,0 +1,83 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+// Replaces tests/test_common/keymap.c for this test, so keymap_introspection.c picks up the sparse keymap.
+
+#include "quantum.h"
+
+// clang-format off
+
+// Sparse tables as emitted by `qmk json2c --sparse` for the layers below, using a 38 key LAYOUT which leaves
+// matrix positions [3][0] and [3][9] unused.
+// Sparse keymap: 260 bytes, 480 bytes as a dense keymaps[][MATRIX_ROWS][MATRIX_COLS] array
+#define KEYMAP_SPARSE
+
+const uint32_t PROGMEM keymap_sparse_layout[] = {0xBFFFFFFF, 0x0000007F};
+
+const uint32_t PROGMEM keymap_sparse_bitmap[][2] = {
+    [0] = {0xBFFFFFFF, 0x0000007F},
+    [1] = {0x0288218A, 0x00000000},
+    [2] = {0x08004800, 0x00000011},
+    [3] = {0x00000040, 0x00000000},
+    [4] = {0x00000000, 0x00000000},
+    [5] = {0xBFFFFFFF, 0x0000007F},
+};
+
+const uint16_t PROGMEM keymap_sparse_ranks[][2] = {
+    [0] = {0, 31},
+    [1] = {38, 46},
+    [2] = {46, 49},
+    [3] = {51, 52},
+    [4] = {52, 52},
+    [5] = {52, 83},
+};
+
+const uint16_t PROGMEM keymap_sparse_keycodes[] = {
+    /* [0] */ KC_B, KC_1, KC_C, KC_2, KC_1, KC_LSFT, KC_A, KC_A, KC_B, KC_ENT, KC_NO, KC_ENT, KC_A, KC_NO, KC_LSFT, KC_ENT, KC_A, KC_NO, KC_C, KC_NO, KC_A, KC_LSFT, KC_1, KC_2, KC_1, KC_LSFT, KC_B, KC_ENT, KC_B, KC_A, KC_NO, KC_B, KC_C, KC_LSFT, KC_A, KC_SPC, KC_A, KC_A,
+    /* [1] */ KC_2, KC_VOLU, KC_ENT, MO(1), KC_B, KC_NO, KC_SPC, KC_VOLU,
+    /* [2] */ MO(1), KC_B, KC_NO, MO(1), KC_SPC,
+    /* [3] */ KC_LSFT,
+    /* [5] */ KC_A, KC_LSFT, KC_2, XXXXXXX, KC_1, KC_NO, KC_ENT, MO(1), KC_VOLU, KC_LSFT, LT(2, KC_ESC), KC_2, KC_1, KC_SPC, KC_LSFT, LT(2, KC_ESC), KC_2, XXXXXXX, KC_B, KC_NO, KC_A, LCTL(KC_Z), XXXXXXX, LCTL(KC_Z), LCTL(KC_Z), KC_B, KC_1, KC_B, KC_LSFT, LT(2, KC_ESC), KC_ENT, LCTL(KC_Z), KC_C, KC_A, KC_LSFT, KC_SPC, KC_2, KC_LSFT,
+};
+
+// The same keymap as a dense array, as the LAYOUT macro would have expanded it
+const uint16_t PROGMEM dense_keymaps[][MATRIX_ROWS][MATRIX_COLS] = {
+    [0] = {
+        {KC_B, KC_1, KC_C, KC_2, KC_1, KC_LSFT, KC_A, KC_A, KC_B, KC_ENT},
+        {KC_NO, KC_ENT, KC_A, KC_NO, KC_LSFT, KC_ENT, KC_A, KC_NO, KC_C, KC_NO},
+        {KC_A, KC_LSFT, KC_1, KC_2, KC_1, KC_LSFT, KC_B, KC_ENT, KC_B, KC_A},
+        {KC_NO, KC_NO, KC_B, KC_C, KC_LSFT, KC_A, KC_SPC, KC_A, KC_A, KC_NO},
+    },
+    [1] = {
+        {KC_TRNS, KC_2, _______, KC_VOLU, _______, KC_TRNS, _______, KC_ENT, MO(1), _______},
+        {KC_TRNS, KC_TRNS, _______, KC_B, KC_TRNS, KC_TRNS, KC_TRNS, KC_TRNS, _______, KC_NO},
+        {_______, KC_TRNS, KC_TRNS, KC_SPC, _______, KC_VOLU, KC_TRNS, _______, KC_TRNS, KC_TRNS},
+        {KC_NO, KC_TRNS, KC_TRNS, _______, _______, _______, _______, _______, KC_TRNS, KC_NO},
+    },
+    [2] = {
+        {_______, _______, KC_TRNS, KC_TRNS, KC_TRNS, KC_TRNS, _______, KC_TRNS, KC_TRNS, KC_TRNS},
+        {_______, MO(1), KC_TRNS, _______, KC_B, KC_TRNS, KC_TRNS, _______, KC_TRNS, KC_TRNS},
+        {KC_TRNS, KC_TRNS, KC_TRNS, _______, _______, KC_TRNS, _______, KC_NO, KC_TRNS, KC_TRNS},
+        {KC_NO, _______, MO(1), KC_TRNS, KC_TRNS, _______, KC_SPC, KC_TRNS, _______, KC_NO},
+    },
+    [3] = {
+        {KC_TRNS, KC_TRNS, _______, _______, _______, KC_TRNS, KC_LSFT, KC_TRNS, _______, KC_TRNS},
+        {KC_TRNS, KC_TRNS, _______, KC_TRNS, _______, _______, KC_TRNS, _______, _______, KC_TRNS},
+        {KC_TRNS, KC_TRNS, KC_TRNS, _______, KC_TRNS, _______, KC_TRNS, _______, KC_TRNS, KC_TRNS},
+        {KC_NO, _______, KC_TRNS, KC_TRNS, KC_TRNS, KC_TRNS, KC_TRNS, _______, _______, KC_NO},
+    },
+    [4] = {
+        {KC_TRNS, KC_TRNS, KC_TRNS, KC_TRNS, _______, KC_TRNS, KC_TRNS, _______, _______, KC_TRNS},
+        {_______, _______, KC_TRNS, KC_TRNS, _______, KC_TRNS, _______, _______, _______, KC_TRNS},
+        {_______, KC_TRNS, KC_TRNS, KC_TRNS, _______, KC_TRNS, _______, _______, _______, _______},
+        {KC_NO, KC_TRNS, _______, KC_TRNS, KC_TRNS, KC_TRNS, _______, _______, KC_TRNS, KC_NO},
+    },
+    [5] = {
+        {KC_A, KC_LSFT, KC_2, XXXXXXX, KC_1, KC_NO, KC_ENT, MO(1), KC_VOLU, KC_LSFT},
+        {LT(2, KC_ESC), KC_2, KC_1, KC_SPC, KC_LSFT, LT(2, KC_ESC), KC_2, XXXXXXX, KC_B, KC_NO},
+        {KC_A, LCTL(KC_Z), XXXXXXX, LCTL(KC_Z), LCTL(KC_Z), KC_B, KC_1, KC_B, KC_LSFT, LT(2, KC_ESC)},
+        {KC_NO, KC_ENT, LCTL(KC_Z), KC_C, KC_A, KC_LSFT, KC_SPC, KC_2, KC_LSFT, KC_NO},
+    },
+};
+
+// clang-format on
@@ -0,0 +1,40 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "gtest/gtest.h"
+
+extern "C" {
+#include "quantum.h"
+#include "keymap_introspection.h"
+
+extern const uint16_t dense_keymaps[][MATRIX_ROWS][MATRIX_COLS];
+}
+
+#define NUM_DENSE_LAYERS 6
+
+TEST(SparseKeymap, LayerCountMatchesDenseKeymap) {
+    EXPECT_EQ(keymap_layer_count_raw(), NUM_DENSE_LAYERS);
+}
+
+TEST(SparseKeymap, EveryLookupMatchesDenseKeymap) {
+    for (uint8_t layer = 0; layer < NUM_DENSE_LAYERS; layer++) {
+        for (uint8_t row = 0; row < MATRIX_ROWS; row++) {
+            for (uint8_t col = 0; col < MATRIX_COLS; col++) {
+                EXPECT_EQ(keycode_at_keymap_location_raw(layer, row, col), dense_keymaps[layer][row][col]) << "layer " << +layer << " row " << +row << " col " << +col;
+            }
+        }
+    }
+}
+
+TEST(SparseKeymap, KeysOutsideLayoutAreNoOnEveryLayer) {
+    for (uint8_t layer = 0; layer < NUM_DENSE_LAYERS; layer++) {
+        EXPECT_EQ(keycode_at_keymap_location_raw(layer, 3, 0), KC_NO);
+        EXPECT_EQ(keycode_at_keymap_location_raw(layer, 3, 9), KC_NO);
+    }
+}
+
+TEST(SparseKeymap, OutOfRangeLookupsAreTransparent) {
+    EXPECT_EQ(keycode_at_keymap_location_raw(NUM_DENSE_LAYERS, 0, 0), KC_TRNS);
+    EXPECT_EQ(keycode_at_keymap_location_raw(0, MATRIX_ROWS, 0), KC_TRNS);
+    EXPECT_EQ(keycode_at_keymap_location_raw(0, 0, MATRIX_COLS), KC_TRNS);
+}
@@ -0,0 +1,53 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+/*******************************************************************************
+  88888888888 888      d8b                .d888 d8b 888               d8b
+      888     888      Y8P               d88P"  Y8P 888               Y8P
+      888     888                        888        888
+      888     88888b.  888 .d8888b       888888 888 888  .d88b.       888 .d8888b
+      888     888 "88b 888 88K           888    888 888 d8P  Y8b      888 88K
+      888     888  888 888 "Y8888b.      888    888 888 88888888      888 "Y8888b.
+      888     888  888 888      X88      888    888 888 Y8b.          888      X88
+      888     888  888 888  88888P'      888    888 888  "Y8888       888  88888P'
+                                                        888                 888
+                                                        888                 888
+                                                        888                 888
+     .d88b.   .d88b.  88888b.   .d88b.  888d888 8888b.  888888 .d88b.   .d88888
+    d88P"88b d8P  Y8b 888 "88b d8P  Y8b 888P"      "88b 888   d8P  Y8b d88" 888
+    888  888 88888888 888  888 88888888 888    .d888888 888   88888888 888  888
+    Y88b 888 Y8b.     888  888 Y8b.     888    888  888 Y88b. Y8b.     Y88b 888
+     "Y88888  "Y8888  888  888  "Y8888  888    "Y888888  "Y888 "Y8888   "Y88888
+         888
+    Y8b d88P
+     "Y88P"
+*******************************************************************************/
+
+#pragma once
+
+// Steno dictionary (18 entries, 264 bytes)
+#define STENO_DICTIONARY_LONGEST 3
+#define STENO_DICTIONARY_NODE_COUNT 20
+
+static const uint8_t steno_dictionary_nodes[168] PROGMEM = {
+    0x00, 0x00, 0x00, 0x01, 0x00, 0xFF, 0xFF, 0xFF, 0x03, 0x00, 0x00, 0x11, 0x00, 0x00, 0x00, 0x00,
+    0x05, 0x00, 0x00, 0x11, 0x00, 0x03, 0x00, 0x00, 0x18, 0x01, 0x00, 0x11, 0x00, 0x06, 0x00, 0x00,
+    0x18, 0x05, 0x00, 0x11, 0x00, 0x08, 0x00, 0x00, 0x00, 0x19, 0x00, 0x11, 0x00, 0x0B, 0x00, 0x00,
+    0x40, 0x00, 0x02, 0x12, 0x00, 0x0E, 0x00, 0x00, 0x14, 0x80, 0x02, 0x12, 0x00, 0x15, 0x00, 0x00,
+    0x00, 0x00, 0x04, 0x12, 0x00, 0x18, 0x00, 0x00, 0x50, 0x08, 0x04, 0x12, 0x00, 0x1D, 0x00, 0x00,
+    0x28, 0x00, 0x05, 0x12, 0x00, 0x23, 0x00, 0x00, 0x03, 0x00, 0x08, 0x12, 0x00, 0x26, 0x00, 0x00,
+    0x00, 0x01, 0x08, 0x12, 0x00, 0x30, 0x00, 0x00, 0x30, 0x1B, 0x08, 0x12, 0x00, 0x34, 0x00, 0x00,
+    0x04, 0x28, 0x08, 0x12, 0x00, 0x3A, 0x00, 0x00, 0x0C, 0x00, 0x12, 0x13, 0x00, 0x40, 0x00, 0x00,
+    0x20, 0x42, 0x22, 0x13, 0x00, 0x42, 0x00, 0x00, 0x08, 0x50, 0x00, 0x13, 0x00, 0xFF, 0xFF, 0xFF,
+    0x00, 0x00, 0x04, 0x14, 0x00, 0x49, 0x00, 0x00, 0x00, 0x01, 0x08, 0x14, 0x00, 0x56, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x14, 0x00, 0xFF, 0xFF, 0xFF
+};
+
+static const uint8_t steno_dictionary_text[96] PROGMEM = {
+    0x88, 0x31, 0x00, 0x88, 0x32, 0x00, 0x84, 0x00, 0x82, 0x84, 0x00, 0x80, 0x61, 0x00, 0x80, 0x68,
+    0x65, 0x6C, 0x6C, 0x6F, 0x00, 0x85, 0x2E, 0x00, 0x81, 0x69, 0x6E, 0x67, 0x00, 0x82, 0x6D, 0x65,
+    0x67, 0x61, 0x00, 0x81, 0x2C, 0x00, 0x80, 0x6E, 0x69, 0x6E, 0x65, 0x74, 0x65, 0x65, 0x6E, 0x00,
+    0x80, 0x61, 0x74, 0x00, 0x80, 0x62, 0x79, 0x74, 0x65, 0x00, 0x80, 0x74, 0x65, 0x73, 0x74, 0x00,
+    0x82, 0x00, 0x80, 0x77, 0x6F, 0x72, 0x6C, 0x64, 0x00, 0x80, 0x65, 0x78, 0x61, 0x6D, 0x69, 0x6E,
+    0x61, 0x74, 0x69, 0x6F, 0x6E, 0x00, 0x80, 0x61, 0x63, 0x63, 0x75, 0x72, 0x61, 0x74, 0x65, 0x00
+};
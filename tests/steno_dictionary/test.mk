@@ -0,0 +1,7 @@
+# Copyright 2024 QMK
+# SPDX-License-Identifier: GPL-2.0-or-later
+
+STENO_ENABLE = yes
+STENO_PROTOCOL = geminipr
+STENO_DICTIONARY_ENABLE = yes
+VIRTSER_ENABLE = no
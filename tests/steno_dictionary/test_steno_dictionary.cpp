@@ -0,0 +1,197 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <fstream>
+#include <string>
+#include <vector>
+
+#include "keycode.h"
+#include "test_common.hpp"
+
+extern "C" {
+#include "steno_dictionary.h"
+}
+
+using ::testing::_;
+
+namespace {
+
+std::string typed;
+int         output_calls;
+
+const std::string keys = "#STKPWHRAO*EUFRPBLGTSDZ";
+
+// Steno order, the inverse of the notation the keyboard types for untranslated strokes
+uint32_t parse_stroke(const std::string &text) {
+    const std::string digits      = "1234506789";
+    const uint8_t     digit_key[] = {1, 2, 4, 6, 8, 9, 13, 15, 17, 19};
+    uint32_t          stroke      = 0;
+    size_t            position    = 0;
+    for (char c : text) {
+        if (c == '-') {
+            position = std::max<size_t>(position, 11);
+            continue;
+        }
+        size_t key;
+        if (c == '#') {
+            key = 0;
+        } else if (digits.find(c) != std::string::npos) {
+            key = digit_key[digits.find(c)];
+            stroke |= 1;
+        } else {
+            key = keys.find(c, position);
+        }
+        EXPECT_TRUE(key != std::string::npos && key >= position) << "Invalid stroke " << text;
+        stroke |= 1UL << key;
+        position = key + 1;
+    }
+    return stroke;
+}
+
+std::vector<std::string> split(const std::string &text, char separator) {
+    std::vector<std::string> parts;
+    size_t                   start = 0, end;
+    while ((end = text.find(separator, start)) != std::string::npos) {
+        parts.push_back(text.substr(start, end - start));
+        start = end + 1;
+    }
+    parts.push_back(text.substr(start));
+    return parts;
+}
+
+} // namespace
+
+extern "C" void steno_dictionary_output(uint8_t backspaces, const char *text) {
+    typed.erase(typed.size() - std::min<size_t>(backspaces, typed.size()));
+    typed += text;
+    output_calls++;
+}
+
+class StenoDictionary : public TestFixture {
+   public:
+    // One key for each key in steno order
+    std::vector<KeymapKey> steno_keys = {
+        KeymapKey(0, 0, 0, STN_N1), KeymapKey(0, 1, 0, STN_S1), KeymapKey(0, 2, 0, STN_TL), KeymapKey(0, 3, 0, STN_KL), KeymapKey(0, 4, 0, STN_PL), KeymapKey(0, 5, 0, STN_WL), KeymapKey(0, 6, 0, STN_HL), KeymapKey(0, 7, 0, STN_RL), KeymapKey(0, 8, 0, STN_A), KeymapKey(0, 9, 0, STN_O), KeymapKey(0, 0, 1, STN_ST1), KeymapKey(0, 1, 1, STN_E), KeymapKey(0, 2, 1, STN_U), KeymapKey(0, 3, 1, STN_FR), KeymapKey(0, 4, 1, STN_RR), KeymapKey(0, 5, 1, STN_PR), KeymapKey(0, 6, 1, STN_BR), KeymapKey(0, 7, 1, STN_LR), KeymapKey(0, 8, 1, STN_GR), KeymapKey(0, 9, 1, STN_TR), KeymapKey(0, 0, 2, STN_SR), KeymapKey(0, 1, 2, STN_DR), KeymapKey(0, 2, 2, STN_ZR),
+    };
+
+    void SetUp() override {
+        steno_dictionary_enable();
+        steno_dictionary_reset();
+        typed.clear();
+        output_calls = 0;
+        for (auto &key : steno_keys) {
+            add_key(key);
+        }
+    }
+
+    // Chords the keys of a stroke, releasing them in the order they were pressed
+    void Stroke(uint32_t stroke) {
+        for (size_t key = 0; key < keys.size(); key++) {
+            if (stroke & (1UL << key)) {
+                steno_keys[key].press();
+                run_one_scan_loop();
+            }
+        }
+        for (size_t key = 0; key < keys.size(); key++) {
+            if (stroke & (1UL << key)) {
+                steno_keys[key].release();
+                run_one_scan_loop();
+            }
+        }
+    }
+
+    void Strokes(const std::string &outline) {
+        for (auto &stroke : split(outline, '/')) {
+            Stroke(parse_stroke(stroke));
+        }
+    }
+};
+
+// The cases the reference translator in lib/python/qmk/steno.py is tested against
+TEST_F(StenoDictionary, MatchesReferenceTranslator) {
+    TestDriver    driver;
+    std::string   path = __FILE__;
+    std::ifstream cases(path.substr(0, path.rfind('/') + 1) + "cases.txt");
+    ASSERT_TRUE(cases.is_open());
+
+    EXPECT_NO_REPORT(driver);
+    int         count = 0;
+    std::string line;
+    while (std::getline(cases, line)) {
+        if (line.empty() || line[0] == '#') {
+            continue;
+        }
+        size_t arrow = line.find(" ->");
+        ASSERT_NE(arrow, std::string::npos) << line;
+        std::string expected = line.substr(std::min(arrow + 4, line.size()));
+
+        steno_dictionary_reset();
+        typed.clear();
+        Strokes(line.substr(0, arrow));
+        EXPECT_EQ(typed, expected) << "Strokes " << line.substr(0, arrow);
+        count++;
+    }
+    EXPECT_GT(count, 20);
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(StenoDictionary, StrokeNotation) {
+    char text[STENO_DICTIONARY_KEY_COUNT + 2];
+    for (const char *stroke : {"STKPW", "-FRPB", "1-9", "#*", "KAEF", "12K3W4R50*EU6R7B8G9SDZ"}) {
+        steno_dictionary_stroke_to_string(parse_stroke(stroke), text);
+        EXPECT_STREQ(text, stroke);
+    }
+}
+
+TEST_F(StenoDictionary, OneOutputPerStroke) {
+    TestDriver driver;
+    EXPECT_NO_REPORT(driver);
+
+    Strokes("AEU/KUR/AT");
+    EXPECT_EQ(typed, "accurate");
+    EXPECT_EQ(output_calls, 3);
+
+    // Keys released part way through a chord only send once everything is up
+    steno_keys[6].press();
+    run_one_scan_loop();
+    steno_keys[17].press();
+    run_one_scan_loop();
+    steno_keys[6].release();
+    run_one_scan_loop();
+    EXPECT_EQ(output_calls, 3);
+    steno_keys[17].release();
+    run_one_scan_loop();
+    EXPECT_EQ(output_calls, 4);
+    EXPECT_EQ(typed, "accurate hello");
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(StenoDictionary, UndoIsBoundedByHistory) {
+    TestDriver driver;
+    EXPECT_NO_REPORT(driver);
+
+    for (int i = 0; i < STENO_DICTIONARY_HISTORY + 4; i++) {
+        Strokes("H-L");
+    }
+    for (int i = 0; i < STENO_DICTIONARY_HISTORY + 4; i++) {
+        Strokes("*");
+    }
+    EXPECT_EQ(typed, "hello hello hello hello");
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(StenoDictionary, DisabledSendsNothing) {
+    TestDriver driver;
+    EXPECT_NO_REPORT(driver);
+
+    steno_dictionary_toggle();
+    EXPECT_FALSE(steno_dictionary_is_enabled());
+    Strokes("H-L");
+    EXPECT_EQ(output_calls, 0);
+
+    steno_dictionary_toggle();
+    EXPECT_TRUE(steno_dictionary_is_enabled());
+    Strokes("H-L");
+    EXPECT_EQ(typed, "hello");
+    VERIFY_AND_CLEAR(driver);
+}
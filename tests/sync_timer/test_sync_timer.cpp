@@ -0,0 +1,228 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <cstdlib>
+#include <random>
+
+#include "gtest/gtest.h"
+
+extern "C" {
+#include "sync_timer_discipline.h"
+}
+
+namespace {
+
+struct Link {
+    double drift_ppm; // how much faster the master's crystal runs
+    double loss;      // chance of a request or a reply going missing
+    bool   spikes;    // whether some exchanges get held up for several ms
+};
+
+// Two halves a serial link apart, each with its own crystal, exchanging every 100 ms like the split transactions do
+class SyncTimerLoopback : public ::testing::Test {
+   protected:
+    void SetUp() override {
+        sync_timer_discipline_init(&discipline);
+    }
+
+    uint32_t master_ms(uint64_t us) {
+        return (master_origin_us + (int64_t)(us * (1.0 + link.drift_ppm / 1e6))) / 1000;
+    }
+
+    uint32_t slave_ms(uint64_t us) {
+        return (slave_origin_us + us) / 1000;
+    }
+
+    uint64_t latency() {
+        uint64_t us = 250 + std::uniform_int_distribution<uint64_t>(0, 500)(rng);
+        if (link.spikes && chance(0.05)) {
+            us += std::uniform_int_distribution<uint64_t>(2000, 15000)(rng);
+        }
+        return us;
+    }
+
+    bool chance(double p) {
+        return std::uniform_real_distribution<double>(0, 1)(rng) < p;
+    }
+
+    void tick() {
+        now_us += 1000;
+
+        if (!in_flight && now_us >= next_request_us) {
+            in_flight       = true;
+            request_lost    = chance(link.loss);
+            reply_lost      = chance(link.loss);
+            carried         = sample;
+            request         = master_ms(now_us);
+            arrive_us       = now_us + latency();
+            reply_us        = arrive_us + latency();
+            next_request_us = now_us + 100000;
+        }
+
+        if (in_flight && !request_lost && !arrived && now_us >= arrive_us) {
+            arrived = true;
+            receive = slave_ms(arrive_us);
+            if (carried.request != last_request) {
+                last_request = carried.request;
+                sync_timer_discipline_sample(&discipline, &carried, receive);
+            }
+        }
+
+        if (in_flight && now_us >= reply_us) {
+            if (arrived && !reply_lost) {
+                sample = (sync_timer_sample_t){.request = request, .receive = receive, .reply = master_ms(reply_us)};
+            }
+            in_flight = false;
+            arrived   = false;
+        }
+    }
+
+    // Runs the link for a while, keeping the worst the slave's clock was out by from the `settle` ms on
+    void run(uint32_t ms, uint32_t settle = 0) {
+        for (uint32_t i = 0; i < ms; i++) {
+            tick();
+            uint32_t read = sync_timer_discipline_read(&discipline, slave_ms(now_us));
+            if (i >= settle) {
+                worst = std::max(worst, std::abs((int32_t)(read - master_ms(now_us))));
+            }
+            if (i > 0) {
+                int32_t step  = read - last_read;
+                smallest_step = std::min(smallest_step, step);
+                largest_step  = std::max(largest_step, step);
+            }
+            last_read = read;
+        }
+    }
+
+    sync_timer_discipline_t discipline;
+    Link                    link            = {0, 0, false};
+    std::mt19937            rng{1234};
+    int64_t                 master_origin_us = 12345678;
+    int64_t                 slave_origin_us  = 321000;
+    uint64_t                now_us           = 0;
+    uint64_t                next_request_us  = 0;
+    uint64_t                arrive_us        = 0;
+    uint64_t                reply_us         = 0;
+    bool                    in_flight        = false;
+    bool                    arrived          = false;
+    bool                    request_lost     = false;
+    bool                    reply_lost       = false;
+    uint32_t                request          = 0;
+    uint32_t                receive          = 0;
+    uint32_t                last_request     = 0;
+    sync_timer_sample_t     sample           = {};
+    sync_timer_sample_t     carried          = {};
+    int32_t                 worst            = 0;
+    uint32_t                last_read        = 0;
+    int32_t                 smallest_step    = INT32_MAX;
+    int32_t                 largest_step     = INT32_MIN;
+};
+
+TEST_F(SyncTimerLoopback, FollowsLocalTimeUntilTheFirstExchange) {
+    sync_timer_quality_t quality = discipline.quality;
+    EXPECT_FALSE(quality.synced);
+    EXPECT_EQ(sync_timer_discipline_read(&discipline, 4321), 4321);
+}
+
+TEST_F(SyncTimerLoopback, StepsToTheMasterOnTheFirstExchange) {
+    // The first exchange completes at once, the slave learns from it with the second request
+    run(102);
+    EXPECT_TRUE(discipline.quality.synced);
+    EXPECT_EQ(discipline.quality.samples, 1);
+
+    worst = 0;
+    run(1000);
+    EXPECT_LE(worst, 1);
+}
+
+TEST_F(SyncTimerLoopback, SlewsOutAnOffsetWithoutStepping) {
+    run(30000, 1000);
+    ASSERT_LE(worst, 1);
+
+    // Well short of stepping, the clock should speed up to catch up rather than jump
+    master_origin_us += 20000;
+    worst         = 0;
+    smallest_step = INT32_MAX;
+    largest_step  = INT32_MIN;
+    run(60000, 30000);
+    EXPECT_LE(worst, 1);
+    EXPECT_EQ(smallest_step, 0);
+    EXPECT_LE(largest_step, 2);
+
+    // ... and slow down without ever going backwards
+    master_origin_us -= 20000;
+    worst         = 0;
+    smallest_step = INT32_MAX;
+    run(60000, 30000);
+    EXPECT_LE(worst, 1);
+    EXPECT_GE(smallest_step, 0);
+}
+
+TEST_F(SyncTimerLoopback, StepsWhenTheMasterRestarts) {
+    run(30000, 1000);
+    ASSERT_LE(worst, 1);
+
+    master_origin_us = -(int64_t)now_us;
+    run(250);
+    EXPECT_GT(std::abs((int32_t)(sync_timer_discipline_read(&discipline, slave_ms(now_us)) - master_ms(now_us))), 1000) << "stepped on a lone exchange";
+
+    worst = 0;
+    run(1000, 500);
+    EXPECT_LE(worst, 1);
+}
+
+TEST_F(SyncTimerLoopback, IgnoresALoneWildExchange) {
+    run(30000, 1000);
+    ASSERT_LE(worst, 1);
+
+    uint32_t            local    = slave_ms(now_us);
+    uint32_t            before   = sync_timer_discipline_read(&discipline, local);
+    uint16_t            rejected = discipline.quality.rejected;
+    sync_timer_sample_t wild     = {.request = before + 5000, .receive = local, .reply = before + 5001};
+    EXPECT_FALSE(sync_timer_discipline_sample(&discipline, &wild, local));
+    EXPECT_EQ(sync_timer_discipline_read(&discipline, local), before);
+    EXPECT_EQ(discipline.quality.rejected, rejected + 1);
+}
+
+TEST_F(SyncTimerLoopback, DropsHeldUpExchanges) {
+    run(30000, 1000);
+    ASSERT_LE(worst, 1);
+
+    // Held up on the way back by 12 ms, taking it at face value would put the master 6 ms ahead
+    uint32_t            local    = slave_ms(now_us);
+    uint32_t            before   = sync_timer_discipline_read(&discipline, local);
+    uint16_t            rejected = discipline.quality.rejected;
+    sync_timer_sample_t slow     = {.request = before, .receive = local, .reply = before + 12};
+    EXPECT_FALSE(sync_timer_discipline_sample(&discipline, &slow, local));
+    EXPECT_EQ(sync_timer_discipline_read(&discipline, local), before);
+    EXPECT_EQ(discipline.quality.rejected, rejected + 1);
+
+    slow.request = before + 100;
+    slow.reply   = before + 100 + SYNC_TIMER_MAX_DELAY + 1;
+    EXPECT_FALSE(sync_timer_discipline_sample(&discipline, &slow, local));
+    EXPECT_EQ(discipline.quality.rejected, rejected + 2);
+}
+
+class SyncTimerDrift : public SyncTimerLoopback, public ::testing::WithParamInterface<Link> {};
+
+TEST_P(SyncTimerDrift, TracksTheMasterOverALossyJitteryLink) {
+    link = GetParam();
+
+    // Ten minutes, by which time a 300 ppm crystal would be 180 ms out
+    run(600000, 60000);
+    EXPECT_LE(worst, 1);
+
+    sync_timer_quality_t quality = discipline.quality;
+    EXPECT_TRUE(quality.synced);
+    EXPECT_NEAR(quality.drift_ppm, link.drift_ppm, 25);
+    EXPECT_LE(quality.delay_ms, 1 + SYNC_TIMER_DELAY_MARGIN);
+    EXPECT_LT(quality.jitter_us, 1000);
+    EXPECT_GT(quality.samples, 2000);
+    if (link.spikes) {
+        EXPECT_GT(quality.rejected, 0);
+    }
+}
+
+INSTANTIATE_TEST_CASE_P(Links, SyncTimerDrift, ::testing::Values(Link{0, 0, false}, Link{150, 0.1, false}, Link{-300, 0.1, true}, Link{400, 0.3, true}));
+
+} // namespace
@@ -0,0 +1,9 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include "test_common.h"
+
+#define TAP_DANCE_MAX_CONCURRENT 2
+#define TAPPING_TERM_PER_KEY
@@ -0,0 +1,21 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "quantum.h"
+#include "tap_dance_defs.h"
+
+tap_dance_action_t tap_dance_actions[] = {
+    [TD_ESC_CAPS] = ACTION_TAP_DANCE_DOUBLE(KC_ESC, KC_CAPS),
+    [TD_X_Y]      = ACTION_TAP_DANCE_DOUBLE(KC_X, KC_Y),
+    [TD_N_M]      = ACTION_TAP_DANCE_DOUBLE(KC_N, KC_M),
+    [TD_SHORT]    = ACTION_TAP_DANCE_DOUBLE(KC_S, KC_T),
+};
+
+uint16_t get_tapping_term(uint16_t keycode, keyrecord_t *record) {
+    switch (keycode) {
+        case TD(TD_SHORT):
+            return SHORT_TAPPING_TERM;
+        default:
+            return TAPPING_TERM;
+    }
+}
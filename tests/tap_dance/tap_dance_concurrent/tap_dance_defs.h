@@ -0,0 +1,21 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+enum {
+    TD_ESC_CAPS,
+    TD_X_Y,
+    TD_N_M,
+    TD_SHORT,
+};
+
+#define SHORT_TAPPING_TERM 50
+
+#ifdef __cplusplus
+}
+#endif
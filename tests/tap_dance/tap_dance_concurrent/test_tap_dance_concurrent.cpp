@@ -0,0 +1,190 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "keyboard_report_util.hpp"
+#include "keycode.h"
+#include "test_common.hpp"
+#include "action_tapping.h"
+#include "test_keymap_key.hpp"
+#include "tap_dance_defs.h"
+
+using testing::_;
+using testing::InSequence;
+
+class TapDanceConcurrent : public TestFixture {};
+
+TEST_F(TapDanceConcurrent, InterleavedSingleTapsFinishInOrder) {
+    TestDriver driver;
+    InSequence s;
+    auto       key_esc_caps = KeymapKey{0, 1, 0, TD(TD_ESC_CAPS)};
+    auto       key_x_y      = KeymapKey{0, 2, 0, TD(TD_X_Y)};
+
+    set_keymap({key_esc_caps, key_x_y});
+
+    /* The second dance doesn't finish the first */
+    EXPECT_NO_REPORT(driver);
+    tap_key(key_esc_caps);
+    tap_key(key_x_y);
+    idle_for(TAPPING_TERM - 3);
+    VERIFY_AND_CLEAR(driver);
+
+    /* Each finishes once its own tapping term is over */
+    EXPECT_REPORT(driver, (KC_ESC));
+    EXPECT_EMPTY_REPORT(driver);
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+
+    EXPECT_NO_REPORT(driver);
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+
+    EXPECT_REPORT(driver, (KC_X));
+    EXPECT_EMPTY_REPORT(driver);
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(TapDanceConcurrent, InterleavedDoubleTaps) {
+    TestDriver driver;
+    InSequence s;
+    auto       key_esc_caps = KeymapKey{0, 1, 0, TD(TD_ESC_CAPS)};
+    auto       key_x_y      = KeymapKey{0, 2, 0, TD(TD_X_Y)};
+
+    set_keymap({key_esc_caps, key_x_y});
+
+    EXPECT_NO_REPORT(driver);
+    tap_key(key_esc_caps);
+    tap_key(key_x_y);
+    VERIFY_AND_CLEAR(driver);
+
+    /* Both dances still count their taps */
+    EXPECT_REPORT(driver, (KC_CAPS));
+    EXPECT_EMPTY_REPORT(driver);
+    tap_key(key_esc_caps);
+    VERIFY_AND_CLEAR(driver);
+
+    EXPECT_REPORT(driver, (KC_Y));
+    EXPECT_EMPTY_REPORT(driver);
+    tap_key(key_x_y);
+    VERIFY_AND_CLEAR(driver);
+
+    EXPECT_NO_REPORT(driver);
+    idle_for(TAPPING_TERM);
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(TapDanceConcurrent, RegularKeyFinishesAllInOrder) {
+    TestDriver driver;
+    InSequence s;
+    auto       key_esc_caps = KeymapKey{0, 1, 0, TD(TD_ESC_CAPS)};
+    auto       key_x_y      = KeymapKey{0, 2, 0, TD(TD_X_Y)};
+    auto       regular_key  = KeymapKey(0, 3, 0, KC_A);
+
+    set_keymap({key_esc_caps, key_x_y, regular_key});
+
+    EXPECT_NO_REPORT(driver);
+    tap_key(key_esc_caps);
+    tap_key(key_x_y);
+    VERIFY_AND_CLEAR(driver);
+
+    EXPECT_REPORT(driver, (KC_ESC));
+    EXPECT_EMPTY_REPORT(driver);
+    EXPECT_REPORT(driver, (KC_X));
+    EXPECT_EMPTY_REPORT(driver);
+    EXPECT_REPORT(driver, (KC_A));
+    regular_key.press();
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+
+    EXPECT_EMPTY_REPORT(driver);
+    regular_key.release();
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(TapDanceConcurrent, ShorterTappingTermFinishesEarlierDanceFirst) {
+    TestDriver driver;
+    InSequence s;
+    auto       key_esc_caps = KeymapKey{0, 1, 0, TD(TD_ESC_CAPS)};
+    auto       key_short    = KeymapKey{0, 2, 0, TD(TD_SHORT)};
+
+    set_keymap({key_esc_caps, key_short});
+
+    EXPECT_NO_REPORT(driver);
+    tap_key(key_esc_caps);
+    tap_key(key_short);
+    idle_for(SHORT_TAPPING_TERM - 1);
+    VERIFY_AND_CLEAR(driver);
+
+    /* The dance started first is not overtaken */
+    EXPECT_REPORT(driver, (KC_ESC));
+    EXPECT_EMPTY_REPORT(driver);
+    EXPECT_REPORT(driver, (KC_S));
+    EXPECT_EMPTY_REPORT(driver);
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+
+    EXPECT_NO_REPORT(driver);
+    idle_for(TAPPING_TERM);
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(TapDanceConcurrent, FullPoolFinishesOldest) {
+    TestDriver driver;
+    InSequence s;
+    auto       key_esc_caps = KeymapKey{0, 1, 0, TD(TD_ESC_CAPS)};
+    auto       key_x_y      = KeymapKey{0, 2, 0, TD(TD_X_Y)};
+    auto       key_n_m      = KeymapKey{0, 3, 0, TD(TD_N_M)};
+
+    set_keymap({key_esc_caps, key_x_y, key_n_m});
+
+    EXPECT_NO_REPORT(driver);
+    tap_key(key_esc_caps);
+    tap_key(key_x_y);
+    VERIFY_AND_CLEAR(driver);
+
+    /* A third dance makes room by finishing the first */
+    EXPECT_REPORT(driver, (KC_ESC));
+    EXPECT_EMPTY_REPORT(driver);
+    tap_key(key_n_m);
+    VERIFY_AND_CLEAR(driver);
+
+    /* The other two keep dancing */
+    EXPECT_REPORT(driver, (KC_Y));
+    EXPECT_EMPTY_REPORT(driver);
+    tap_key(key_x_y);
+    VERIFY_AND_CLEAR(driver);
+
+    EXPECT_REPORT(driver, (KC_N));
+    EXPECT_EMPTY_REPORT(driver);
+    idle_for(TAPPING_TERM);
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(TapDanceConcurrent, HeldDanceWhileAnotherDances) {
+    TestDriver driver;
+    InSequence s;
+    auto       key_esc_caps = KeymapKey{0, 1, 0, TD(TD_ESC_CAPS)};
+    auto       key_x_y      = KeymapKey{0, 2, 0, TD(TD_X_Y)};
+
+    set_keymap({key_esc_caps, key_x_y});
+
+    /* Hold the first dance and tap the second */
+    EXPECT_NO_REPORT(driver);
+    key_esc_caps.press();
+    run_one_scan_loop();
+    tap_key(key_x_y);
+    VERIFY_AND_CLEAR(driver);
+
+    /* Both finish, the held one stays pressed */
+    EXPECT_REPORT(driver, (KC_ESC));
+    EXPECT_REPORT(driver, (KC_ESC, KC_X));
+    EXPECT_REPORT(driver, (KC_ESC));
+    idle_for(TAPPING_TERM + 2);
+    VERIFY_AND_CLEAR(driver);
+
+    EXPECT_EMPTY_REPORT(driver);
+    key_esc_caps.release();
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+}
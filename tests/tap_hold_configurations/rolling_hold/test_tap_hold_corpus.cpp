@@ -0,0 +1,160 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <algorithm>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <map>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "keyboard_report_util.hpp"
+#include "keycode.h"
+#include "test_common.hpp"
+#include "action_tapping.h"
+#include "test_fixture.hpp"
+#include "test_keymap_key.hpp"
+
+using testing::_;
+using testing::AnyNumber;
+
+enum tap_hold_policy { DEFAULT_MODE, PERMISSIVE_HOLD_MODE, HOLD_ON_OTHER_KEY_PRESS_MODE, ROLLING_HOLD_MODE };
+
+static tap_hold_policy policy = ROLLING_HOLD_MODE;
+
+bool get_permissive_hold(uint16_t keycode, keyrecord_t *record) {
+    return policy == PERMISSIVE_HOLD_MODE;
+}
+
+bool get_hold_on_other_key_press(uint16_t keycode, keyrecord_t *record) {
+    return policy == HOLD_ON_OTHER_KEY_PRESS_MODE;
+}
+
+bool get_rolling_hold(uint16_t keycode, keyrecord_t *record) {
+    return policy == ROLLING_HOLD_MODE;
+}
+
+namespace {
+
+struct Sample {
+    std::string meant;
+    std::string events;
+};
+
+struct Result {
+    int      misfires = 0;
+    int      letters  = 0;
+    uint32_t latency  = 0;
+};
+
+std::vector<Sample> read_corpus() {
+    std::string         path = __FILE__;
+    std::ifstream       file(path.substr(0, path.rfind('/') + 1) + "corpus.txt");
+    std::vector<Sample> corpus;
+    std::string         line;
+    while (std::getline(file, line)) {
+        size_t separator = line.find('|');
+        if (line.empty() || line[0] == '#' || separator == std::string::npos) {
+            continue;
+        }
+        std::istringstream meant(line.substr(0, separator));
+        Sample             sample;
+        meant >> sample.meant;
+        sample.events = line.substr(separator + 1);
+        corpus.push_back(sample);
+    }
+    return corpus;
+}
+
+} // namespace
+
+class RollingHoldCorpus : public TestFixture {
+   public:
+    void TearDown() override {
+        policy = ROLLING_HOLD_MODE;
+        TestFixture::TearDown();
+    }
+
+    // Types every sample, returning how many were typed other than meant and how long letters took to be sent
+    Result type_corpus(TestDriver &driver, const std::vector<Sample> &corpus) {
+        std::map<char, KeymapKey> keys = {
+            {'f', KeymapKey(0, 0, 0, LSFT_T(KC_F))}, {'d', KeymapKey(0, 1, 0, LCTL_T(KC_D))}, {'j', KeymapKey(0, 2, 0, RSFT_T(KC_J))}, {'k', KeymapKey(0, 3, 0, RCTL_T(KC_K))}, {'e', KeymapKey(0, 4, 0, KC_E)},
+            {'i', KeymapKey(0, 5, 0, KC_I)},         {'o', KeymapKey(0, 6, 0, KC_O)},         {'n', KeymapKey(0, 7, 0, KC_N)},         {'t', KeymapKey(0, 8, 0, KC_T)},         {'u', KeymapKey(0, 9, 0, KC_U)},
+        };
+        set_keymap({keys.at('f'), keys.at('d'), keys.at('j'), keys.at('k'), keys.at('e'), keys.at('i'), keys.at('o'), keys.at('n'), keys.at('t'), keys.at('u')});
+
+        Result                    result;
+        std::string               typed;
+        std::map<char, uint16_t>  pressed_at;
+        std::vector<uint8_t>      previous;
+        EXPECT_CALL(driver, send_keyboard_mock(_)).Times(AnyNumber()).WillRepeatedly([&](report_keyboard_t &report) {
+            std::vector<uint8_t> current(report.keys, report.keys + KEYBOARD_REPORT_KEYS);
+            for (uint8_t code : current) {
+                if (std::find(previous.begin(), previous.end(), code) != previous.end() || code < KC_A || code > KC_Z) {
+                    continue;
+                }
+                char letter = 'a' + code - KC_A;
+                if (report.mods & MOD_MASK_CTRL) {
+                    typed += '^';
+                }
+                typed += (report.mods & MOD_MASK_SHIFT) ? letter - 'a' + 'A' : letter;
+                result.letters++;
+                result.latency += TIMER_DIFF_16(timer_read(), pressed_at[letter]);
+            }
+            previous = current;
+        });
+
+        for (auto &sample : corpus) {
+            typed.clear();
+            std::istringstream events(sample.events);
+            std::string        event;
+            while (events >> event) {
+                if (event[0] == '+' || event[0] == '-') {
+                    KeymapKey &key = keys.at(event[1]);
+                    if (event[0] == '+') {
+                        pressed_at[event[1]] = timer_read();
+                        key.press();
+                    } else {
+                        key.release();
+                    }
+                    run_one_scan_loop();
+                } else {
+                    idle_for(std::stoi(event) - 1);
+                }
+            }
+            idle_for(TAPPING_TERM * 2);
+            if (typed != sample.meant) {
+                result.misfires++;
+                test_logger.info() << "typed " << typed << " for " << sample.meant << ":" << sample.events << std::endl;
+            }
+        }
+        return result;
+    }
+};
+
+TEST_F(RollingHoldCorpus, misfires_and_latency_per_policy) {
+    const std::vector<Sample> corpus = read_corpus();
+    ASSERT_GT(corpus.size(), 20);
+
+    const std::vector<std::pair<tap_hold_policy, const char *>> policies = {
+        {DEFAULT_MODE, "default"},
+        {PERMISSIVE_HOLD_MODE, "permissive hold"},
+        {HOLD_ON_OTHER_KEY_PRESS_MODE, "hold on other key press"},
+        {ROLLING_HOLD_MODE, "rolling hold"},
+    };
+    std::map<tap_hold_policy, Result> results;
+    for (auto &[mode, name] : policies) {
+        TestDriver driver;
+        policy        = mode;
+        Result result = type_corpus(driver, corpus);
+        results[mode] = result;
+        std::cout << std::left << std::setw(24) << name << " misfires " << result.misfires << "/" << corpus.size() << " (" << 100 * result.misfires / corpus.size() << "%), " << result.latency / result.letters << "ms from key press to report on average" << std::endl;
+        VERIFY_AND_CLEAR(driver);
+    }
+
+    for (auto &[mode, result] : results) {
+        EXPECT_LE(results[ROLLING_HOLD_MODE].misfires, result.misfires);
+    }
+}
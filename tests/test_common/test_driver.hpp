@@ -30,11 +30,20 @@ class TestDriver {
     void set_leds(uint8_t leds) {
         m_leds = leds;
     }
+    /** @brief Makes the endpoint of `report_id` report itself busy, which only the report scheduler looks at. */
+    void set_endpoint_busy(uint8_t report_id, bool busy) {
+        m_busy_endpoints = busy ? m_busy_endpoints | (1 << report_id) : m_busy_endpoints & ~(1 << report_id);
+    }
 
     MOCK_METHOD1(send_keyboard_mock, void(report_keyboard_t&));
     MOCK_METHOD1(send_nkro_mock, void(report_nkro_t&));
     MOCK_METHOD1(send_mouse_mock, void(report_mouse_t&));
     MOCK_METHOD1(send_extra_mock, void(report_extra_t&));
+    MOCK_METHOD1(send_digitizer_mock, void(report_digitizer_t&));
+
+    static TestDriver* instance() {
+        return m_this;
+    }
 
    private:
     static uint8_t     keyboard_leds(void);
@@ -42,8 +51,10 @@ class TestDriver {
     static void        send_nkro(report_nkro_t* report);
     static void        send_mouse(report_mouse_t* report);
     static void        send_extra(report_extra_t* report);
+    static bool        report_ready(uint8_t report_id);
     host_driver_t      m_driver;
-    uint8_t            m_leds = 0;
+    uint8_t            m_leds           = 0;
+    uint16_t           m_busy_endpoints = 0;
     static TestDriver* m_this;
 };
 
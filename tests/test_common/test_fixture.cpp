@@ -58,7 +58,8 @@ void TestFixture::TearDownTestCase() {}
 TestFixture::TestFixture() {
     m_this = this;
     timer_clear();
-    test_logger.info() << "tapping term is " << +GET_TAPPING_TERM(KC_TRANSPARENT, &(keyrecord_t){}) << "ms" << std::endl;
+    keyrecord_t record = {};
+    test_logger.info() << "tapping term is " << +GET_TAPPING_TERM(KC_TRANSPARENT, &record) << "ms" << std::endl;
 }
 
 TestFixture::~TestFixture() {
@@ -99,6 +100,7 @@ void TestFixture::add_key(KeymapKey key) {
     }
 
     this->keymap.push_back(key);
+    resolved_layer_cache_invalidate();
 }
 
 void TestFixture::tap_key(KeymapKey key, unsigned delay_ms) {
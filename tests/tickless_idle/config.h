@@ -0,0 +1,9 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include "test_common.h"
+
+#define TICKLESS_IDLE_SCAN_INTERVAL 10
+#define TICKLESS_IDLE_ACTIVE_TIME 300
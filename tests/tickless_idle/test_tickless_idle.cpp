@@ -0,0 +1,219 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <algorithm>
+#include <random>
+#include <vector>
+
+#include "keyboard_report_util.hpp"
+#include "test_common.hpp"
+
+extern "C" {
+#include "deferred_exec.h"
+#include "tickless_idle.h"
+void set_time(uint32_t t);
+}
+
+using testing::_;
+using testing::Invoke;
+
+namespace {
+
+// Time taken by one go round the main loop
+const uint32_t LOOP_US = 50;
+
+bool     sleep_requested;
+uint32_t sleep_deadline;
+bool     wake_requested;
+uint64_t clock_us;
+
+} // namespace
+
+extern "C" void tickless_idle_sleep_until(uint32_t deadline) {
+    sleep_requested = true;
+    sleep_deadline  = deadline;
+}
+
+extern "C" void tickless_idle_wake(void) {
+    wake_requested = true;
+}
+
+namespace {
+
+struct KeyEvent {
+    uint64_t   time_us;
+    KeymapKey *key;
+    bool       pressed;
+};
+
+class TicklessIdle : public TestFixture {
+   protected:
+    void SetUp() override {
+        // Keep time going forwards from one test to the next, as the executors remember when they last ran
+        set_now(std::max(clock_us, (uint64_t)timer_read32() * 1000));
+        sleep_requested = false;
+        wake_requested  = false;
+        // Start out idle
+        run_for(TICKLESS_IDLE_ACTIVE_TIME);
+        loops = 0;
+    }
+
+    void TearDown() override {
+        clock_us = now_us;
+    }
+
+    void set_now(uint64_t us) {
+        now_us = us;
+        set_time(now_us / 1000);
+    }
+
+    void apply_events() {
+        while (next_event < events.size() && events[next_event].time_us <= now_us) {
+            KeyEvent &event = events[next_event++];
+            event.pressed ? event.key->press() : event.key->release();
+            if (pin_change_wake) {
+                tickless_idle_wake();
+            }
+        }
+    }
+
+    // The main loop, as in quantum/main.c
+    void loop_once() {
+        apply_events();
+        sleep_requested = false;
+        keyboard_task();
+        deferred_exec_task();
+        tickless_idle_task();
+        loops++;
+        set_now(now_us + LOOP_US);
+
+        if (!sleep_requested) return;
+        uint64_t until = (uint64_t)sleep_deadline * 1000;
+        if (wake_requested) {
+            until = now_us;
+        } else if (pin_change_wake && next_event < events.size()) {
+            until = std::min(until, std::max(now_us, events[next_event].time_us));
+        }
+        wake_requested = false;
+        if (until > now_us) set_now(until);
+    }
+
+    void run_for(uint32_t ms) {
+        uint64_t end = now_us + (uint64_t)ms * 1000;
+        while (now_us < end) {
+            loop_once();
+        }
+    }
+
+    // Taps of `key` every 100 to 500ms, held for 20 to 60ms
+    void schedule_taps(KeymapKey &key, uint32_t ms) {
+        std::mt19937 rng(42);
+        uint64_t     end = now_us + (uint64_t)ms * 1000 - 600000;
+        for (uint64_t t = now_us + 100000; t < end; t += 100000 + rng() % 400000) {
+            uint64_t hold = 20000 + rng() % 40000;
+            events.push_back({t + rng() % 1000, &key, true});
+            events.push_back({t + hold, &key, false});
+        }
+    }
+
+    // Time from each key event to the report it changed
+    std::vector<uint64_t> latencies_us() {
+        std::vector<uint64_t> latencies;
+        for (size_t i = 0; i < events.size() && i < report_times_us.size(); i++) {
+            latencies.push_back(report_times_us[i] - events[i].time_us);
+        }
+        return latencies;
+    }
+
+    void record_reports() {
+        EXPECT_CALL(driver, send_keyboard_mock(_)).WillRepeatedly(Invoke([this](report_keyboard_t &) { report_times_us.push_back(now_us); }));
+    }
+
+    TestDriver            driver;
+    uint64_t              now_us;
+    uint32_t              loops = 0;
+    bool                  pin_change_wake = false;
+    std::vector<KeyEvent> events;
+    size_t                next_event = 0;
+    std::vector<uint64_t> report_times_us;
+};
+
+TEST_F(TicklessIdle, IdleLoopRunsOncePerScanInterval) {
+    EXPECT_NO_REPORT(driver);
+
+    run_for(1000);
+    EXPECT_NEAR(loops, 1000 / TICKLESS_IDLE_SCAN_INTERVAL, 2);
+    // A spinning loop would have gone round 20000 times
+    EXPECT_LT(loops * 100, 1000000 / LOOP_US);
+}
+
+TEST_F(TicklessIdle, KeyPressesWaitNoLongerThanTheScanInterval) {
+    auto       key = KeymapKey(0, 0, 0, KC_A);
+    set_keymap({key});
+    record_reports();
+
+    schedule_taps(key, 10000);
+    run_for(10000);
+
+    auto latencies = latencies_us();
+    ASSERT_EQ(latencies.size(), events.size());
+    EXPECT_LE(*std::max_element(latencies.begin(), latencies.end()), TICKLESS_IDLE_SCAN_INTERVAL * 1000 + LOOP_US);
+    // Typing keeps the loop going round every millisecond for a while, the rest of the time it sleeps
+    EXPECT_LT(loops, 10000);
+    EXPECT_GT(loops, 10000 / TICKLESS_IDLE_SCAN_INTERVAL);
+    std::cout << "Main loop ran " << loops << " times instead of " << 10000000 / LOOP_US << std::endl;
+}
+
+TEST_F(TicklessIdle, PinChangeWakeScansRightAway) {
+    auto       key = KeymapKey(0, 0, 0, KC_A);
+    set_keymap({key});
+    record_reports();
+
+    pin_change_wake = true;
+    schedule_taps(key, 10000);
+    run_for(10000);
+
+    auto latencies = latencies_us();
+    ASSERT_EQ(latencies.size(), events.size());
+    EXPECT_LE(*std::max_element(latencies.begin(), latencies.end()), LOOP_US);
+}
+
+uint32_t trigger_times[2];
+uint32_t actual_times[2];
+
+uint32_t record_trigger(uint32_t trigger_time, void *cb_arg) {
+    uintptr_t i      = (uintptr_t)cb_arg;
+    trigger_times[i] = trigger_time;
+    actual_times[i]  = timer_read32();
+    return 0;
+}
+
+TEST_F(TicklessIdle, DeferredExecutionIsNotDelayed) {
+    EXPECT_NO_REPORT(driver);
+
+    defer_exec(37, record_trigger, (void *)0);
+    defer_exec(123, record_trigger, (void *)1);
+    run_for(200);
+    EXPECT_EQ(actual_times[0], trigger_times[0]);
+    EXPECT_EQ(actual_times[1], trigger_times[1]);
+    EXPECT_LT(loops, 200 / TICKLESS_IDLE_SCAN_INTERVAL + 4);
+}
+
+TEST_F(TicklessIdle, TappingTermIsNotStretched) {
+    auto       key = KeymapKey(0, 0, 0, LSFT_T(KC_P));
+    set_keymap({key});
+    record_reports();
+
+    events.push_back({now_us + 3000, &key, true});
+    events.push_back({now_us + 503000, &key, false});
+    run_for(1000);
+
+    // The hold is reported as the tapping term runs out, not at the next scan interval
+    ASSERT_EQ(report_times_us.size(), 2);
+    uint64_t scanned_us = report_times_us[0] - TAPPING_TERM * 1000;
+    EXPECT_GE(scanned_us, events[0].time_us);
+    EXPECT_LE(scanned_us, events[0].time_us + TICKLESS_IDLE_SCAN_INTERVAL * 1000 + 1000);
+    EXPECT_LE(report_times_us[0] - report_times_us[0] / 1000 * 1000, LOOP_US);
+}
+
+} // namespace
@@ -0,0 +1,181 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <random>
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "usb_sof_sync.h"
+
+namespace {
+
+// The host, as seen from the keyboard's clock: a start of frame every `frame_us`, and a poll of the keyboard endpoint
+// `token_us` into every frame, which completes the report waiting on it
+struct Host {
+    bool     sofs     = true;
+    uint32_t frame_us = USB_SOF_SYNC_FRAME_US;
+    uint32_t token_us = 20;
+};
+
+// The keyboard's main loop: a scan, the processing of any change it found, and whatever else runs after that
+struct Loop {
+    uint32_t scan_us    = 30;
+    uint32_t process_us = 20;
+    uint32_t rest_us    = 10;
+};
+
+// The frame length is averaged over the last frames, so it takes a few of them to follow a change in the host's clock
+const uint32_t TRACKING_SLACK_US = 5;
+
+class UsbSofSync : public ::testing::Test {
+   protected:
+    void SetUp() override {
+        usb_sof_sync_enable();
+        usb_sof_sync_reset_stats();
+    }
+
+    // Moves the keyboard's clock to `t`, running the host's frames on the way
+    void advance_to(uint32_t t) {
+        while (host.sofs) {
+            uint32_t next = token_pending ? token_time : next_sof;
+            if (next > t) break;
+            if (token_pending) {
+                token_pending = false;
+                if (report_in_flight) {
+                    report_in_flight = false;
+                    reports_sent++;
+                    usb_sof_sync_report_sent(token_time);
+                }
+            } else {
+                usb_sof_sync_sof(next_sof);
+                token_time    = next_sof + host.token_us;
+                token_pending = true;
+                next_sof += host.frame_us;
+            }
+        }
+        now = t;
+    }
+
+    void loop_once() {
+        advance_to(now + usb_sof_sync_wait_us(now));
+        usb_sof_sync_scan_start(now);
+        bool changed = next_press < presses.size() && presses[next_press] <= now;
+        advance_to(now + loop.scan_us);
+        if (changed) {
+            next_press++;
+            advance_to(now + loop.process_us);
+            usb_sof_sync_report_queued();
+            report_in_flight = true;
+        }
+        advance_to(now + loop.rest_us);
+    }
+
+    // Runs the main loop for `ms`, with a key event every 20 to 60ms
+    void run(uint32_t ms) {
+        std::mt19937 rng(1234);
+        uint32_t     end = now + ms * 1000;
+        for (uint32_t t = now + 20000; t < end - 100000; t += 20000 + rng() % 40000) {
+            presses.push_back(t);
+        }
+        while (now < end) {
+            loop_once();
+        }
+    }
+
+    Host                  host;
+    Loop                  loop;
+    uint32_t              now              = 0;
+    uint32_t              next_sof         = USB_SOF_SYNC_FRAME_US;
+    uint32_t              token_time       = 0;
+    bool                  token_pending    = false;
+    bool                  report_in_flight = false;
+    uint32_t              reports_sent     = 0;
+    std::vector<uint32_t> presses;
+    size_t                next_press = 0;
+};
+
+TEST_F(UsbSofSync, FreeRunningScansWaitUpToAWholeFrame) {
+    usb_sof_sync_disable();
+    run(10000);
+
+    const usb_sof_sync_stats_t *stats = usb_sof_sync_get_stats();
+    ASSERT_EQ(stats->count, presses.size());
+    EXPECT_GT(stats->max_us, 800);
+    EXPECT_GT(stats->total_us / stats->count, 400);
+    usb_sof_sync_print_stats();
+}
+
+TEST_F(UsbSofSync, ScansStartTheLeadTimeBeforeThePoll) {
+    run(10000);
+
+    const usb_sof_sync_stats_t *stats = usb_sof_sync_get_stats();
+    ASSERT_EQ(stats->count, presses.size());
+    EXPECT_GE(stats->min_us, USB_SOF_SYNC_LEAD_US);
+    EXPECT_LE(stats->max_us, USB_SOF_SYNC_LEAD_US + host.token_us);
+    EXPECT_EQ(stats->late_scans, 0);
+    EXPECT_EQ(stats->buckets[(USB_SOF_SYNC_LEAD_US + host.token_us) / USB_SOF_SYNC_HISTOGRAM_STEP_US], stats->count);
+}
+
+TEST_F(UsbSofSync, OneScanPerFrame) {
+    run(1000);
+
+    // Fast loops wait for the next frame instead of scanning again before the one they scanned for
+    uint32_t start = now, scans = 0;
+    while (now - start < 100000) {
+        loop_once();
+        scans++;
+    }
+    EXPECT_NEAR(scans, 100, 1);
+}
+
+TEST_F(UsbSofSync, FollowsTheHostClock) {
+    // The host's frames drift against the keyboard's clock
+    host.frame_us = USB_SOF_SYNC_FRAME_US + 3;
+    run(10000);
+    host.frame_us = USB_SOF_SYNC_FRAME_US - 3;
+    run(10000);
+
+    const usb_sof_sync_stats_t *stats = usb_sof_sync_get_stats();
+    EXPECT_EQ(stats->count, presses.size());
+    EXPECT_GE(stats->min_us, USB_SOF_SYNC_LEAD_US - TRACKING_SLACK_US);
+    EXPECT_LE(stats->max_us, USB_SOF_SYNC_LEAD_US + host.token_us + TRACKING_SLACK_US);
+}
+
+TEST_F(UsbSofSync, SurvivesTheFrameCounterWrapping) {
+    run(70000);
+
+    const usb_sof_sync_stats_t *stats = usb_sof_sync_get_stats();
+    EXPECT_EQ(stats->count, presses.size());
+    EXPECT_LE(stats->max_us, USB_SOF_SYNC_LEAD_US + host.token_us + TRACKING_SLACK_US);
+    EXPECT_EQ(stats->late_scans, 0);
+}
+
+TEST_F(UsbSofSync, SlowLoopsScanLate) {
+    // Every loop ends within the lead time of the next poll
+    loop.rest_us = 1100;
+    run(10000);
+
+    const usb_sof_sync_stats_t *stats = usb_sof_sync_get_stats();
+    EXPECT_EQ(stats->count, presses.size());
+    EXPECT_GT(stats->late_scans, 0);
+}
+
+TEST_F(UsbSofSync, FreeRunsWithoutStartOfFrames) {
+    run(100);
+    host.sofs = false;
+    advance_to(now + 5000);
+    for (int i = 0; i < 100; i++) {
+        EXPECT_EQ(usb_sof_sync_wait_us(now), 0);
+        advance_to(now + 100);
+    }
+}
+
+TEST_F(UsbSofSync, IdleRepeatsAreNotMeasured) {
+    usb_sof_sync_report_sent(1000);
+    usb_sof_sync_report_queued();
+    usb_sof_sync_report_sent(1000);
+    usb_sof_sync_report_sent(2000);
+    EXPECT_EQ(usb_sof_sync_get_stats()->count, 1);
+}
+
+} // namespace
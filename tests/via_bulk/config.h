@@ -0,0 +1,9 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include "test_common.h"
+
+#define DYNAMIC_KEYMAP_LAYER_COUNT 10
+#define EEPROM_SIZE 2048
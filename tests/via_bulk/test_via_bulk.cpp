@@ -0,0 +1,336 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <algorithm>
+#include <deque>
+#include <iostream>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+extern "C" {
+#include "via.h"
+#include "via_bulk.h"
+#include "raw_hid.h"
+#include "dynamic_keymap.h"
+#include "keycodes.h"
+}
+
+namespace {
+
+using Report = std::vector<uint8_t>;
+
+const uint8_t REPORT_SIZE = 32;
+const uint8_t COMPRESSED  = 0x01;
+
+std::deque<Report> replies;
+
+uint32_t crc32(const std::vector<uint8_t> &data) {
+    uint32_t crc = 0xFFFFFFFF;
+    for (uint8_t byte : data) {
+        crc ^= byte;
+        for (int bit = 0; bit < 8; bit++) {
+            crc = (crc >> 1) ^ (0xEDB88320 & -(crc & 1));
+        }
+    }
+    return ~crc;
+}
+
+// Greedy encoder for the token stream the keyboard decodes
+std::vector<uint8_t> compress(const std::vector<uint8_t> &data) {
+    std::vector<uint8_t> out;
+    std::vector<uint8_t> literals;
+    auto                 flush = [&]() {
+        if (!literals.empty()) {
+            out.push_back(literals.size() - 1);
+            out.insert(out.end(), literals.begin(), literals.end());
+            literals.clear();
+        }
+    };
+
+    for (size_t i = 0; i < data.size();) {
+        size_t best = 0, distance = 0;
+        for (size_t from = 0; from < i; from++) {
+            size_t length = 0;
+            while (i + length < data.size() && length < 130 && data[from + length] == data[i + length]) {
+                length++;
+            }
+            if (length > best) {
+                best     = length;
+                distance = i - from;
+            }
+        }
+        if (best >= 3) {
+            flush();
+            out.push_back(0x80 | (best - 3));
+            out.push_back(distance >> 8);
+            out.push_back(distance & 0xFF);
+            i += best;
+        } else {
+            literals.push_back(data[i++]);
+            if (literals.size() == 128) flush();
+        }
+    }
+    flush();
+    return out;
+}
+
+} // namespace
+
+extern "C" void raw_hid_send(uint8_t *data, uint8_t length) {
+    replies.emplace_back(data, data + length);
+}
+
+class ViaBulk : public ::testing::Test {
+   protected:
+    void SetUp() override {
+        replies.clear();
+        eeconfig_init_via();
+    }
+
+    // Sends a report, and takes the reply when `wait` is set, counting each wait as a round trip
+    Report send(Report report, bool wait = true) {
+        report.resize(REPORT_SIZE);
+        raw_hid_receive(report.data(), report.size());
+        if (!wait) {
+            EXPECT_TRUE(replies.empty()) << "reply to command " << (int)report[0] << " inside the window";
+            return {};
+        }
+        round_trips++;
+        EXPECT_EQ(replies.size(), 1);
+        if (replies.empty()) return {};
+        Report reply = replies.front();
+        replies.pop_front();
+        return reply;
+    }
+
+    void legacy_upload(const std::vector<uint8_t> &data) {
+        for (size_t offset = 0; offset < data.size(); offset += 28) {
+            uint8_t size   = std::min<size_t>(28, data.size() - offset);
+            Report  report = {id_dynamic_keymap_set_buffer, (uint8_t)(offset >> 8), (uint8_t)offset, size};
+            report.insert(report.end(), &data[offset], &data[offset] + size);
+            send(report);
+        }
+    }
+
+    Report begin(uint8_t target, uint8_t flags, uint16_t offset, uint16_t length) {
+        return send({id_bulk_begin, target, flags, (uint8_t)(offset >> 8), (uint8_t)offset, (uint8_t)(length >> 8), (uint8_t)length});
+    }
+
+    Report end(const std::vector<uint8_t> &data) {
+        uint32_t crc = crc32(data);
+        return send({id_bulk_end, (uint8_t)(crc >> 24), (uint8_t)(crc >> 16), (uint8_t)(crc >> 8), (uint8_t)crc});
+    }
+
+    // Sends the stream a window at a time, waiting for an acknowledgement at the end of each, skipping `lose` once
+    void stream(const std::vector<uint8_t> &payload, uint8_t window, int lose = -1) {
+        const size_t chunk  = REPORT_SIZE - 2;
+        size_t       frames = (payload.size() + chunk - 1) / chunk;
+        for (size_t sequence = 0; sequence < frames;) {
+            bool   last   = sequence + 1 == frames || (sequence + 1) % window == 0;
+            Report report = {id_bulk_data, (uint8_t)sequence};
+            report.insert(report.end(), payload.begin() + sequence * chunk, payload.begin() + std::min(payload.size(), (sequence + 1) * chunk));
+
+            if ((int)sequence == lose) {
+                lose = -1;
+                sequence++;
+                continue;
+            }
+            report.resize(REPORT_SIZE);
+            raw_hid_receive(report.data(), report.size());
+            if (!replies.empty()) {
+                round_trips++;
+                Report reply = replies.front();
+                replies.pop_front();
+                if (reply[1] == id_bulk_out_of_order) {
+                    sequence = reply[2];
+                    continue;
+                }
+                ASSERT_EQ(reply[1], id_bulk_ok);
+                ASSERT_EQ(reply[2], sequence + 1);
+            } else {
+                ASSERT_FALSE(last) << "no acknowledgement at the end of a window";
+            }
+            sequence++;
+        }
+    }
+
+    // Writes `data` in as many transfers as the keyboard's buffer takes, returning the bytes changed
+    uint16_t bulk_upload(uint8_t target, const std::vector<uint8_t> &data, uint8_t flags) {
+        uint16_t changed = 0;
+        Report   reply   = begin(target, flags, 0, 0);
+        uint16_t buffer  = reply[3] << 8 | reply[4];
+        uint8_t  window  = reply[2];
+        for (size_t offset = 0; offset < data.size(); offset += buffer) {
+            std::vector<uint8_t> part(data.begin() + offset, data.begin() + std::min(data.size(), offset + buffer));
+            EXPECT_EQ(begin(target, flags, offset, part.size())[1], id_bulk_ok);
+            stream(flags & COMPRESSED ? compress(part) : part, window);
+            reply = end(part);
+            EXPECT_EQ(reply[1], id_bulk_ok);
+            changed += reply[2] << 8 | reply[3];
+        }
+        return changed;
+    }
+
+    std::vector<uint8_t> keymap_buffer() {
+        std::vector<uint8_t> data(keymap_size());
+        dynamic_keymap_get_buffer(0, data.size(), data.data());
+        return data;
+    }
+
+    static size_t keymap_size() {
+        return dynamic_keymap_get_layer_count() * MATRIX_ROWS * MATRIX_COLS * 2;
+    }
+
+    // A base layer of letters, a few layers with some keys on them, and the rest left transparent
+    static std::vector<uint8_t> sample_keymap(uint16_t seed) {
+        std::vector<uint8_t> data;
+        for (uint8_t layer = 0; layer < dynamic_keymap_get_layer_count(); layer++) {
+            for (uint8_t key = 0; key < MATRIX_ROWS * MATRIX_COLS; key++) {
+                uint16_t keycode = layer == 0 ? KC_A + (key + seed) % 26 : layer < 4 && key % (3 + layer) == 0 ? KC_F1 + (key + seed) % 12 : KC_TRNS;
+                data.push_back(keycode >> 8);
+                data.push_back(keycode & 0xFF);
+            }
+        }
+        return data;
+    }
+
+    int round_trips = 0;
+};
+
+TEST_F(ViaBulk, UploadsAKeymapInAFractionOfTheRoundTrips) {
+    std::vector<uint8_t> keymap = sample_keymap(1);
+
+    legacy_upload(keymap);
+    EXPECT_EQ(keymap_buffer(), keymap);
+    int legacy = round_trips;
+    EXPECT_EQ(legacy, (keymap_size() + 27) / 28);
+
+    round_trips = 0;
+    bulk_upload(id_bulk_keymap, sample_keymap(2), 0);
+    EXPECT_EQ(keymap_buffer(), sample_keymap(2));
+    int windowed = round_trips;
+
+    round_trips = 0;
+    bulk_upload(id_bulk_keymap, sample_keymap(3), COMPRESSED);
+    EXPECT_EQ(keymap_buffer(), sample_keymap(3));
+    int compressed = round_trips;
+
+    EXPECT_EQ(dynamic_keymap_get_keycode(0, 0, 0), KC_D);
+    EXPECT_EQ(dynamic_keymap_get_keycode(1, 0, 0), KC_F4);
+    EXPECT_EQ(dynamic_keymap_get_keycode(9, 3, 9), KC_TRNS);
+
+    std::cout << "Round trips for a " << keymap_size() << " byte keymap: " << legacy << " one report at a time, " << windowed << " windowed, " << compressed << " windowed and compressed" << std::endl;
+    EXPECT_LE(windowed * 4, legacy);
+    EXPECT_LE(compressed * 7, legacy);
+}
+
+TEST_F(ViaBulk, OnlyWritesWhatChanged) {
+    std::vector<uint8_t> keymap = sample_keymap(5);
+    EXPECT_GT(bulk_upload(id_bulk_keymap, keymap, COMPRESSED), 0);
+    EXPECT_EQ(bulk_upload(id_bulk_keymap, keymap, COMPRESSED), 0);
+
+    keymap[2 * MATRIX_COLS + 1] = KC_ESC;
+    EXPECT_EQ(bulk_upload(id_bulk_keymap, keymap, COMPRESSED), 1);
+    EXPECT_EQ(dynamic_keymap_get_keycode(0, 1, 0), KC_ESC);
+}
+
+TEST_F(ViaBulk, WritesNothingUnlessTheCrcMatches) {
+    std::vector<uint8_t> before = keymap_buffer();
+    std::vector<uint8_t> keymap = sample_keymap(7);
+    keymap.resize(256);
+
+    ASSERT_EQ(begin(id_bulk_keymap, COMPRESSED, 0, keymap.size())[1], id_bulk_ok);
+    stream(compress(keymap), VIA_BULK_WINDOW);
+    keymap[100] ^= 1;
+    Report reply = end(keymap);
+    EXPECT_EQ(reply[1], id_bulk_crc_mismatch);
+    EXPECT_EQ(keymap_buffer(), before);
+
+    // The transfer is over either way
+    keymap[100] ^= 1;
+    EXPECT_EQ(end(keymap)[1], id_bulk_not_started);
+    EXPECT_EQ(keymap_buffer(), before);
+}
+
+TEST_F(ViaBulk, AsksAgainForALostReport) {
+    std::vector<uint8_t> keymap = sample_keymap(9);
+
+    ASSERT_EQ(begin(id_bulk_keymap, 0, 0, keymap.size())[1], id_bulk_ok);
+    stream(keymap, VIA_BULK_WINDOW, 3);
+    EXPECT_EQ(end(keymap)[1], id_bulk_ok);
+    EXPECT_EQ(keymap_buffer(), keymap);
+}
+
+TEST_F(ViaBulk, OnlyAsksOnceForReportsSentAheadOfALostOne) {
+    std::vector<uint8_t> keymap(200, 0x11);
+    ASSERT_EQ(begin(id_bulk_keymap, 0, 0, keymap.size())[1], id_bulk_ok);
+
+    Report reply = send({id_bulk_data, 1});
+    EXPECT_EQ(reply[1], id_bulk_out_of_order);
+    EXPECT_EQ(reply[2], 0);
+    send({id_bulk_data, 2}, false);
+    send({id_bulk_data, 3}, false);
+
+    // A resend from before where the keyboard is always gets an answer, in case the last one was lost
+    reply = send({id_bulk_data, 0xFF});
+    EXPECT_EQ(reply[1], id_bulk_out_of_order);
+    EXPECT_EQ(reply[2], 0);
+}
+
+TEST_F(ViaBulk, RejectsBadRequests) {
+    uint16_t size = keymap_size();
+    EXPECT_EQ(begin(7, 0, 0, 10)[1], id_bulk_bad_target);
+    EXPECT_EQ(begin(id_bulk_keymap, 0, size - 10, 11)[1], id_bulk_bad_range);
+    EXPECT_EQ(begin(id_bulk_keymap, 0, 0, VIA_BULK_BUFFER_SIZE + 1)[1], id_bulk_bad_range);
+    EXPECT_EQ(send({id_bulk_data, 0, 1, 2})[1], id_bulk_not_started);
+
+    // A copy from before the start of the transfer
+    ASSERT_EQ(begin(id_bulk_keymap, COMPRESSED, 0, 10)[1], id_bulk_ok);
+    EXPECT_EQ(send({id_bulk_data, 0, 0x00, 0x42, 0x80, 0x00, 0x02})[1], id_bulk_bad_data);
+    EXPECT_EQ(send({id_bulk_data, 1})[1], id_bulk_not_started);
+}
+
+TEST_F(ViaBulk, UploadsMacros) {
+    std::vector<uint8_t> macros(dynamic_keymap_macro_get_buffer_size(), 0);
+    const char           text[] = "hello\0world\0hello world\0";
+    std::copy(std::begin(text), std::end(text), macros.begin());
+
+    bulk_upload(id_bulk_macro, macros, COMPRESSED);
+    std::vector<uint8_t> stored(macros.size());
+    dynamic_keymap_macro_get_buffer(0, stored.size(), stored.data());
+    EXPECT_EQ(stored, macros);
+}
+
+TEST_F(ViaBulk, ReadsAWindowPerRequest) {
+    std::vector<uint8_t> keymap = sample_keymap(11);
+    legacy_upload(keymap);
+
+    const size_t         chunk = (REPORT_SIZE - 3) * VIA_BULK_WINDOW;
+    std::vector<uint8_t> read;
+    round_trips = 0;
+    for (size_t offset = 0; offset < keymap.size(); offset += chunk) {
+        uint16_t size = std::min(chunk, keymap.size() - offset);
+        Report   report{id_bulk_read, id_bulk_keymap, (uint8_t)(offset >> 8), (uint8_t)offset, (uint8_t)(size >> 8), (uint8_t)size};
+        report.resize(REPORT_SIZE);
+        raw_hid_receive(report.data(), report.size());
+        round_trips++;
+
+        ASSERT_EQ(replies.size(), (size + REPORT_SIZE - 4) / (REPORT_SIZE - 3));
+        for (uint8_t sequence = 0; !replies.empty(); sequence++) {
+            Report reply = replies.front();
+            replies.pop_front();
+            EXPECT_EQ(reply[0], id_bulk_read);
+            EXPECT_EQ(reply[1], id_bulk_ok);
+            EXPECT_EQ(reply[2], sequence);
+            uint16_t take = std::min<size_t>(REPORT_SIZE - 3, size);
+            read.insert(read.end(), reply.begin() + 3, reply.begin() + 3 + take);
+            size -= take;
+        }
+    }
+    EXPECT_EQ(read, keymap);
+    EXPECT_EQ(round_trips, (keymap.size() + chunk - 1) / chunk);
+
+    Report report{id_bulk_read, id_bulk_keymap, 0, 0, (uint8_t)((chunk + 1) >> 8), (uint8_t)(chunk + 1)};
+    EXPECT_EQ(send(report)[1], id_bulk_bad_range);
+}
@@ -0,0 +1,8 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+// Stands in for the version.h generated for keyboard builds, VIA uses the date for its EEPROM magic
+
+#pragma once
+
+#define QMK_BUILDDATE "2024-01-01-00:00:00"
@@ -58,6 +58,16 @@ ifeq ($(strip $(RING_BUFFERED_6KRO_REPORT_ENABLE)), yes)
     OPT_DEFS += -DRING_BUFFERED_6KRO_REPORT_ENABLE
 endif
 
+ifeq ($(strip $(REPORT_SCHEDULER_ENABLE)), yes)
+    OPT_DEFS += -DREPORT_SCHEDULER_ENABLE
+    SRC += $(PROTOCOL_DIR)/report_scheduler.c
+endif
+
+ifeq ($(strip $(USB_SOF_SYNC_ENABLE)), yes)
+    OPT_DEFS += -DUSB_SOF_SYNC_ENABLE
+    SRC += $(PROTOCOL_DIR)/usb_sof_sync.c
+endif
+
 ifeq ($(strip $(NO_SUSPEND_POWER_DOWN)), yes)
     OPT_DEFS += -DNO_SUSPEND_POWER_DOWN
 endif
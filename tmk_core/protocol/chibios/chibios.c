@@ -62,9 +62,10 @@ void    send_keyboard(report_keyboard_t *report);
 void    send_nkro(report_nkro_t *report);
 void    send_mouse(report_mouse_t *report);
 void    send_extra(report_extra_t *report);
+bool    report_ready(uint8_t report_id);
 
 /* host struct */
-host_driver_t chibios_driver = {keyboard_leds, send_keyboard, send_nkro, send_mouse, send_extra};
+host_driver_t chibios_driver = {keyboard_leds, send_keyboard, send_nkro, send_mouse, send_extra, report_ready};
 
 #ifdef VIRTSER_ENABLE
 void virtser_task(void);
@@ -203,6 +204,10 @@ void protocol_pre_task(void) {
 #    endif /* MOUSEKEY_ENABLE */
     }
 #endif
+
+#ifdef USB_SOF_SYNC_ENABLE
+    usb_sof_sync_task();
+#endif
 }
 
 void protocol_post_task(void) {
@@ -35,10 +35,17 @@
 #include "chibios_config.h"
 #include "debug.h"
 #include "suspend.h"
+#ifdef USB_SOF_SYNC_ENABLE
+#    include "usb_sof_sync.h"
+#    include "timer.h"
+#endif
 #ifdef SLEEP_LED_ENABLE
 #    include "sleep_led.h"
 #    include "led.h"
 #endif
+#ifdef DEFERRED_LOG_ENABLE
+#    include "deferred_log.h"
+#endif
 #include "wait.h"
 #include "usb_device_state.h"
 #include "usb_descriptor.h"
@@ -128,6 +135,37 @@ static void dummy_usb_cb(USBDriver *usbp, usbep_t ep) {
     (void)ep;
 }
 
+#ifdef USB_SOF_SYNC_ENABLE
+#    if CH_CFG_ST_RESOLUTION != 32
+#        error "USB_SOF_SYNC_ENABLE needs a 32 bit system timer for microsecond timing"
+#    endif
+
+// Doesn't lock, as it's also called from within locked sections and the USB ISRs
+static inline uint32_t sof_sync_timer_us(void) {
+    return TIME_I2US(chVTGetSystemTimeX());
+}
+
+void usb_sof_sync_task(void) {
+    osalSysLock();
+    uint32_t wait = usb_sof_sync_wait_us(sof_sync_timer_us());
+    osalSysUnlock();
+    if (wait) {
+        wait_us(wait);
+    }
+    usb_sof_sync_scan_start(sof_sync_timer_us());
+}
+
+#    ifndef KEYBOARD_SHARED_EP
+static void kbd_in_cb(USBDriver *usbp, usbep_t ep) {
+    (void)usbp;
+    (void)ep;
+    osalSysLockFromISR();
+    usb_sof_sync_report_sent(sof_sync_timer_us());
+    osalSysUnlockFromISR();
+}
+#    endif
+#endif
+
 #ifndef KEYBOARD_SHARED_EP
 /* keyboard endpoint state structure */
 static USBInEndpointState kbd_ep_state;
@@ -135,7 +173,11 @@ static USBInEndpointState kbd_ep_state;
 static const USBEndpointConfig kbd_ep_config = {
     USB_EP_MODE_TYPE_INTR,  /* Interrupt EP */
     NULL,                   /* SETUP packet notification callback */
+#    ifdef USB_SOF_SYNC_ENABLE
+    kbd_in_cb,              /* IN notification callback */
+#    else
     dummy_usb_cb,           /* IN notification callback */
+#    endif
     NULL,                   /* OUT notification callback */
     KEYBOARD_EPSIZE,        /* IN maximum packet size */
     0,                      /* OUT maximum packet size */
@@ -715,6 +757,9 @@ static bool usb_requests_hook_cb(USBDriver *usbp) {
 
 static void usb_sof_cb(USBDriver *usbp) {
     osalSysLockFromISR();
+#ifdef USB_SOF_SYNC_ENABLE
+    usb_sof_sync_sof(sof_sync_timer_us());
+#endif
     for (int i = 0; i < NUM_USB_DRIVERS; i++) {
         qmkusbSOFHookI(&drivers.array[i].driver);
     }
@@ -843,10 +888,54 @@ void send_report(uint8_t endpoint, void *report, size_t size) {
             return;
         }
     }
+#if defined(USB_SOF_SYNC_ENABLE) && !defined(KEYBOARD_SHARED_EP)
+    if (endpoint == KEYBOARD_IN_EPNUM) {
+        usb_sof_sync_report_queued();
+    }
+#endif
     usbStartTransmitI(&USB_DRIVER, endpoint, report, size);
     osalSysUnlock();
 }
 
+/* whether the endpoint carrying `report_id` is free to start a transfer
+ * not callable from ISR or locked state */
+bool report_ready(uint8_t report_id) {
+    usbep_t endpoint;
+    switch (report_id) {
+        case REPORT_ID_KEYBOARD:
+            endpoint = KEYBOARD_IN_EPNUM;
+            break;
+#ifdef MOUSE_ENABLE
+        case REPORT_ID_MOUSE:
+            endpoint = MOUSE_IN_EPNUM;
+            break;
+#endif
+#ifdef JOYSTICK_ENABLE
+        case REPORT_ID_JOYSTICK:
+            endpoint = JOYSTICK_IN_EPNUM;
+            break;
+#endif
+#ifdef DIGITIZER_ENABLE
+        case REPORT_ID_DIGITIZER:
+            endpoint = DIGITIZER_IN_EPNUM;
+            break;
+#endif
+        default:
+#ifdef SHARED_EP_ENABLE
+            endpoint = SHARED_IN_EPNUM;
+            break;
+#else
+            return true;
+#endif
+    }
+
+    osalSysLock();
+    /* reports sent while inactive are dropped right away, there is nothing to wait for */
+    bool ready = usbGetDriverStateI(&USB_DRIVER) != USB_ACTIVE || !usbGetTransmitStatusI(&USB_DRIVER, endpoint);
+    osalSysUnlock();
+    return ready;
+}
+
 /* prepare and start sending a report IN
  * not callable from ISR or locked state */
 void send_keyboard(report_keyboard_t *report) {
@@ -943,6 +1032,13 @@ int8_t sendchar(uint8_t c) {
     return result;
 }
 
+#    if defined(DEFERRED_LOG_ENABLE) && !defined(DEFERRED_LOG_RAW_HID)
+uint8_t deferred_log_send(const uint8_t *data, uint8_t length) {
+    // Whatever the console queue has room for right now, the rest waits for the next pass
+    return chnWriteTimeout(&drivers.console_driver.driver, data, length, TIME_IMMEDIATE);
+}
+#    endif
+
 // Just a dummy function for now, this could be exposed as a weak function
 // Or connected to the actual QMK console
 static void console_receive(uint8_t *data, uint8_t length) {
@@ -47,6 +47,18 @@ void usb_event_queue_init(void);
 /* Task to dequeue and execute any handlers for the USB events on the main thread */
 void usb_event_queue_task(void);
 
+/* ----------------------------
+ * SOF synchronized scanning
+ * ----------------------------
+ */
+
+#ifdef USB_SOF_SYNC_ENABLE
+
+/* Waits until the matrix scan should start to make the next keyboard endpoint poll */
+void usb_sof_sync_task(void);
+
+#endif /* USB_SOF_SYNC_ENABLE */
+
 /* --------------
  * Console header
  * --------------
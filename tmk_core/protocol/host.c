@@ -35,6 +35,14 @@ along with this program.  If not, see <http://www.gnu.org/licenses/>.
 #    include "outputselect.h"
 #endif
 
+#ifdef REPORT_SCHEDULER_ENABLE
+#    include "report_scheduler.h"
+#endif
+
+#ifdef LATENCY_TRACE_ENABLE
+#    include "latency_trace.h"
+#endif
+
 #ifdef NKRO_ENABLE
 #    include "keycode_config.h"
 extern keymap_config_t keymap_config;
@@ -45,6 +53,9 @@ static uint16_t       last_system_usage   = 0;
 static uint16_t       last_consumer_usage = 0;
 
 void host_set_driver(host_driver_t *d) {
+#ifdef REPORT_SCHEDULER_ENABLE
+    report_scheduler_clear();
+#endif
     driver = d;
 }
 
@@ -73,6 +84,9 @@ led_t host_keyboard_led_state(void) {
 
 /* send report */
 void host_keyboard_send(report_keyboard_t *report) {
+#ifdef LATENCY_TRACE_ENABLE
+    latency_trace_report();
+#endif
 #ifdef BLUETOOTH_ENABLE
     if (where_to_send() == OUTPUT_BLUETOOTH) {
         bluetooth_send_keyboard(report);
@@ -84,7 +98,11 @@ void host_keyboard_send(report_keyboard_t *report) {
 #ifdef KEYBOARD_SHARED_EP
     report->report_id = REPORT_ID_KEYBOARD;
 #endif
+#ifdef REPORT_SCHEDULER_ENABLE
+    report_scheduler_send_keyboard(report);
+#else
     (*driver->send_keyboard)(report);
+#endif
 
     if (debug_keyboard) {
         dprintf("keyboard_report: %02X | ", report->mods);
@@ -96,9 +114,16 @@ void host_keyboard_send(report_keyboard_t *report) {
 }
 
 void host_nkro_send(report_nkro_t *report) {
+#ifdef LATENCY_TRACE_ENABLE
+    latency_trace_report();
+#endif
     if (!driver) return;
     report->report_id = REPORT_ID_NKRO;
+#ifdef REPORT_SCHEDULER_ENABLE
+    report_scheduler_send_nkro(report);
+#else
     (*driver->send_nkro)(report);
+#endif
 
     if (debug_keyboard) {
         dprintf("nkro_report: %02X | ", report->mods);
@@ -110,6 +135,9 @@ void host_nkro_send(report_nkro_t *report) {
 }
 
 void host_mouse_send(report_mouse_t *report) {
+#ifdef LATENCY_TRACE_ENABLE
+    latency_trace_report();
+#endif
 #ifdef BLUETOOTH_ENABLE
     if (where_to_send() == OUTPUT_BLUETOOTH) {
         bluetooth_send_mouse(report);
@@ -126,26 +154,42 @@ void host_mouse_send(report_mouse_t *report) {
     report->boot_x = (report->x > 127) ? 127 : ((report->x < -127) ? -127 : report->x);
     report->boot_y = (report->y > 127) ? 127 : ((report->y < -127) ? -127 : report->y);
 #endif
+#ifdef REPORT_SCHEDULER_ENABLE
+    report_scheduler_send_mouse(report);
+#else
     (*driver->send_mouse)(report);
+#endif
 }
 
 void host_system_send(uint16_t usage) {
     if (usage == last_system_usage) return;
     last_system_usage = usage;
 
+#ifdef LATENCY_TRACE_ENABLE
+    latency_trace_report();
+#endif
+
     if (!driver) return;
 
     report_extra_t report = {
         .report_id = REPORT_ID_SYSTEM,
         .usage     = usage,
     };
+#ifdef REPORT_SCHEDULER_ENABLE
+    report_scheduler_send_extra(&report);
+#else
     (*driver->send_extra)(&report);
+#endif
 }
 
 void host_consumer_send(uint16_t usage) {
     if (usage == last_consumer_usage) return;
     last_consumer_usage = usage;
 
+#ifdef LATENCY_TRACE_ENABLE
+    latency_trace_report();
+#endif
+
 #ifdef BLUETOOTH_ENABLE
     if (where_to_send() == OUTPUT_BLUETOOTH) {
         bluetooth_send_consumer(usage);
@@ -159,7 +203,11 @@ void host_consumer_send(uint16_t usage) {
         .report_id = REPORT_ID_CONSUMER,
         .usage     = usage,
     };
+#ifdef REPORT_SCHEDULER_ENABLE
+    report_scheduler_send_extra(&report);
+#else
     (*driver->send_extra)(&report);
+#endif
 }
 
 #ifdef JOYSTICK_ENABLE
@@ -211,7 +259,11 @@ void host_joystick_send(joystick_t *joystick) {
 #    endif
     };
 
+#ifdef REPORT_SCHEDULER_ENABLE
+    report_scheduler_send_joystick(&report);
+#else
     send_joystick(&report);
+#endif
 }
 #endif
 
@@ -230,7 +282,11 @@ void host_digitizer_send(digitizer_t *digitizer) {
         .y        = (uint16_t)(digitizer->y * 0x7FFF),
     };
 
+#ifdef REPORT_SCHEDULER_ENABLE
+    report_scheduler_send_digitizer(&report);
+#else
     send_digitizer(&report);
+#endif
 }
 #endif
 
@@ -243,7 +299,11 @@ void host_programmable_button_send(uint32_t data) {
         .usage     = data,
     };
 
+#ifdef REPORT_SCHEDULER_ENABLE
+    report_scheduler_send_programmable_button(&report);
+#else
     send_programmable_button(&report);
+#endif
 }
 #endif
 
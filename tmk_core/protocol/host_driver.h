@@ -18,19 +18,30 @@ along with this program.  If not, see <http://www.gnu.org/licenses/>.
 #pragma once
 
 #include <stdint.h>
+#include <stdbool.h>
 #include "report.h"
 #ifdef MIDI_ENABLE
 #    include "midi.h"
 #endif
 
+#ifdef __cplusplus
+extern "C" {
+#endif
+
 typedef struct {
     uint8_t (*keyboard_leds)(void);
     void (*send_keyboard)(report_keyboard_t *);
     void (*send_nkro)(report_nkro_t *);
     void (*send_mouse)(report_mouse_t *);
     void (*send_extra)(report_extra_t *);
+    /* optional, whether the endpoint of `report_id` can take a report without waiting */
+    bool (*report_ready)(uint8_t report_id);
 } host_driver_t;
 
 void send_joystick(report_joystick_t *report);
 void send_digitizer(report_digitizer_t *report);
 void send_programmable_button(report_programmable_button_t *report);
+
+#ifdef __cplusplus
+}
+#endif
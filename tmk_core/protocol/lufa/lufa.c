@@ -67,6 +67,10 @@
 #    include "raw_hid.h"
 #endif
 
+#ifdef DEFERRED_LOG_ENABLE
+#    include "deferred_log.h"
+#endif
+
 uint8_t keyboard_idle = 0;
 /* 0: Boot Protocol, 1: Report Protocol(default) */
 uint8_t        keyboard_protocol  = 1;
@@ -677,6 +681,38 @@ ERROR_EXIT:
     Endpoint_SelectEndpoint(ep);
     return -1;
 }
+
+#    if defined(DEFERRED_LOG_ENABLE) && !defined(DEFERRED_LOG_RAW_HID)
+/** \brief Writes as much as the console endpoint takes without waiting
+ */
+uint8_t deferred_log_send(const uint8_t *data, uint8_t length) {
+    if (USB_DeviceState != DEVICE_STATE_Configured) return 0;
+
+    CONSOLE_FLUSH_SET(false);
+    uint8_t ep = Endpoint_GetCurrentEndpoint();
+    Endpoint_SelectEndpoint(CONSOLE_IN_EPNUM);
+
+    uint8_t sent = 0;
+    if (Endpoint_IsEnabled() && Endpoint_IsConfigured()) {
+        while (sent < length && Endpoint_IsReadWriteAllowed()) {
+            Endpoint_Write_8(data[sent++]);
+
+            // Send the bank once full, unless the host has yet to take the last one
+            if (!Endpoint_IsReadWriteAllowed()) {
+                if (!Endpoint_IsINReady()) break;
+                Endpoint_ClearIN();
+            }
+        }
+        // Console_Task() sends whatever is left in the bank
+        if (Endpoint_BytesInEndpoint()) {
+            CONSOLE_FLUSH_SET(true);
+        }
+    }
+
+    Endpoint_SelectEndpoint(ep);
+    return sent;
+}
+#    endif
 #endif
 
 /*******************************************************************************
@@ -0,0 +1,239 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <stdint.h>
+#include <string.h>
+#include "report_scheduler.h"
+#include "host.h"
+
+#ifdef JOYSTICK_ENABLE
+#    include "joystick.h"
+#endif
+
+#ifdef MOUSE_EXTENDED_REPORT
+#    define MOUSE_XY_MAX INT16_MAX
+#else
+#    define MOUSE_XY_MAX INT8_MAX
+#endif
+
+// Slots in priority order, after the keyboard queue
+enum report_slot {
+    SLOT_SYSTEM,
+    SLOT_CONSUMER,
+    SLOT_PROGRAMMABLE_BUTTON,
+    SLOT_MOUSE,
+    SLOT_DIGITIZER,
+    SLOT_JOYSTICK,
+    SLOT_COUNT,
+};
+
+static const uint8_t slot_report_id[SLOT_COUNT] = {
+    [SLOT_SYSTEM]              = REPORT_ID_SYSTEM,
+    [SLOT_CONSUMER]            = REPORT_ID_CONSUMER,
+    [SLOT_PROGRAMMABLE_BUTTON] = REPORT_ID_PROGRAMMABLE_BUTTON,
+    [SLOT_MOUSE]               = REPORT_ID_MOUSE,
+    [SLOT_DIGITIZER]           = REPORT_ID_DIGITIZER,
+    [SLOT_JOYSTICK]            = REPORT_ID_JOYSTICK,
+};
+
+typedef struct {
+    uint8_t report_id;
+    union {
+        report_keyboard_t keyboard;
+        report_nkro_t     nkro;
+    };
+} keyboard_entry_t;
+
+static keyboard_entry_t keyboard_queue[REPORT_SCHEDULER_KEYBOARD_QUEUE];
+static uint8_t          keyboard_head  = 0;
+static uint8_t          keyboard_count = 0;
+
+static report_extra_t               system_report;
+static report_extra_t               consumer_report;
+static report_programmable_button_t programmable_button_report;
+static report_mouse_t               mouse_report;
+static report_digitizer_t           digitizer_report;
+static report_joystick_t            joystick_report;
+static uint8_t                      pending_slots = 0;
+
+static bool report_ready(uint8_t report_id) {
+    host_driver_t *driver = host_get_driver();
+    return !driver || !driver->report_ready || driver->report_ready(report_id);
+}
+
+static void send_oldest_keyboard(void) {
+    host_driver_t    *driver = host_get_driver();
+    keyboard_entry_t *entry  = &keyboard_queue[keyboard_head];
+
+    keyboard_head = (keyboard_head + 1) % REPORT_SCHEDULER_KEYBOARD_QUEUE;
+    keyboard_count--;
+    if (!driver) return;
+    if (entry->report_id == REPORT_ID_NKRO) {
+        (*driver->send_nkro)(&entry->nkro);
+    } else {
+        (*driver->send_keyboard)(&entry->keyboard);
+    }
+}
+
+static void send_slot(uint8_t slot) {
+    host_driver_t *driver = host_get_driver();
+
+    pending_slots &= ~(1 << slot);
+    switch (slot) {
+        case SLOT_SYSTEM:
+            if (driver) (*driver->send_extra)(&system_report);
+            break;
+        case SLOT_CONSUMER:
+            if (driver) (*driver->send_extra)(&consumer_report);
+            break;
+        case SLOT_PROGRAMMABLE_BUTTON:
+            send_programmable_button(&programmable_button_report);
+            break;
+        case SLOT_MOUSE:
+            if (driver) (*driver->send_mouse)(&mouse_report);
+            break;
+        case SLOT_DIGITIZER:
+            send_digitizer(&digitizer_report);
+            break;
+        case SLOT_JOYSTICK:
+            send_joystick(&joystick_report);
+            break;
+    }
+}
+
+static inline bool slot_pending(uint8_t slot) {
+    return pending_slots & (1 << slot);
+}
+
+/* Sends every pending report up to `last_slot`, whether their endpoint is ready or not. Higher priority reports go
+ * first, so making room in a slot never lets it overtake them.
+ */
+static void flush_through(uint8_t last_slot) {
+    while (keyboard_count > 0) {
+        send_oldest_keyboard();
+    }
+    for (uint8_t slot = 0; slot <= last_slot; slot++) {
+        if (slot_pending(slot)) {
+            send_slot(slot);
+        }
+    }
+}
+
+static void set_pending(uint8_t slot) {
+    pending_slots |= 1 << slot;
+    report_scheduler_task();
+}
+
+static keyboard_entry_t *keyboard_enqueue(uint8_t report_id) {
+    // Every keyboard report is an edge the host has to see, make room by waiting for the oldest to go out
+    if (keyboard_count == REPORT_SCHEDULER_KEYBOARD_QUEUE) {
+        send_oldest_keyboard();
+    }
+    keyboard_entry_t *entry = &keyboard_queue[(keyboard_head + keyboard_count) % REPORT_SCHEDULER_KEYBOARD_QUEUE];
+    entry->report_id        = report_id;
+    keyboard_count++;
+    return entry;
+}
+
+void report_scheduler_send_keyboard(report_keyboard_t *report) {
+    keyboard_enqueue(REPORT_ID_KEYBOARD)->keyboard = *report;
+    report_scheduler_task();
+}
+
+void report_scheduler_send_nkro(report_nkro_t *report) {
+    keyboard_enqueue(REPORT_ID_NKRO)->nkro = *report;
+    report_scheduler_task();
+}
+
+void report_scheduler_send_extra(report_extra_t *report) {
+    uint8_t slot = report->report_id == REPORT_ID_SYSTEM ? SLOT_SYSTEM : SLOT_CONSUMER;
+
+    // Usages are only sent when they change, each of them is a press or a release
+    if (slot_pending(slot)) {
+        flush_through(slot);
+    }
+    if (slot == SLOT_SYSTEM) {
+        system_report = *report;
+    } else {
+        consumer_report = *report;
+    }
+    set_pending(slot);
+}
+
+void report_scheduler_send_programmable_button(report_programmable_button_t *report) {
+    if (slot_pending(SLOT_PROGRAMMABLE_BUTTON)) {
+        flush_through(SLOT_PROGRAMMABLE_BUTTON);
+    }
+    programmable_button_report = *report;
+    set_pending(SLOT_PROGRAMMABLE_BUTTON);
+}
+
+static inline bool mouse_sum_fits(int32_t a, int32_t b, int32_t max) {
+    return a + b >= -max && a + b <= max;
+}
+
+void report_scheduler_send_mouse(report_mouse_t *report) {
+    // Motion is relative: sum it up with the waiting report, as long as the buttons stay the same
+    if (slot_pending(SLOT_MOUSE)) {
+        if (report->buttons == mouse_report.buttons && mouse_sum_fits(mouse_report.x, report->x, MOUSE_XY_MAX) && mouse_sum_fits(mouse_report.y, report->y, MOUSE_XY_MAX) && mouse_sum_fits(mouse_report.v, report->v, INT8_MAX) && mouse_sum_fits(mouse_report.h, report->h, INT8_MAX)) {
+            mouse_report.x += report->x;
+            mouse_report.y += report->y;
+            mouse_report.v += report->v;
+            mouse_report.h += report->h;
+#ifdef MOUSE_EXTENDED_REPORT
+            mouse_report.boot_x = (mouse_report.x > 127) ? 127 : ((mouse_report.x < -127) ? -127 : mouse_report.x);
+            mouse_report.boot_y = (mouse_report.y > 127) ? 127 : ((mouse_report.y < -127) ? -127 : mouse_report.y);
+#endif
+            report_scheduler_task();
+            return;
+        }
+        flush_through(SLOT_MOUSE);
+    }
+    mouse_report = *report;
+    set_pending(SLOT_MOUSE);
+}
+
+void report_scheduler_send_digitizer(report_digitizer_t *report) {
+    // The position is absolute: only the latest one matters, as long as the pen stays in the same state
+    if (slot_pending(SLOT_DIGITIZER) && (report->in_range != digitizer_report.in_range || report->tip != digitizer_report.tip || report->barrel != digitizer_report.barrel)) {
+        flush_through(SLOT_DIGITIZER);
+    }
+    digitizer_report = *report;
+    set_pending(SLOT_DIGITIZER);
+}
+
+void report_scheduler_send_joystick(report_joystick_t *report) {
+#if JOYSTICK_BUTTON_COUNT > 0
+    // Axes are absolute: only the latest ones matter, as long as the buttons stay the same
+    if (slot_pending(SLOT_JOYSTICK) && memcmp(report->buttons, joystick_report.buttons, sizeof(report->buttons)) != 0) {
+        flush_through(SLOT_JOYSTICK);
+    }
+#endif
+    joystick_report = *report;
+    set_pending(SLOT_JOYSTICK);
+}
+
+void report_scheduler_task(void) {
+    while (keyboard_count > 0 && report_ready(keyboard_queue[keyboard_head].report_id)) {
+        send_oldest_keyboard();
+    }
+    for (uint8_t slot = 0; slot < SLOT_COUNT; slot++) {
+        if (slot_pending(slot) && report_ready(slot_report_id[slot])) {
+            send_slot(slot);
+        }
+    }
+}
+
+void report_scheduler_flush(void) {
+    flush_through(SLOT_COUNT - 1);
+}
+
+void report_scheduler_clear(void) {
+    keyboard_head  = 0;
+    keyboard_count = 0;
+    pending_slots  = 0;
+}
+
+bool report_scheduler_pending(void) {
+    return keyboard_count > 0 || pending_slots != 0;
+}
@@ -0,0 +1,50 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <stdbool.h>
+#include "report.h"
+
+#ifndef REPORT_SCHEDULER_KEYBOARD_QUEUE
+#    define REPORT_SCHEDULER_KEYBOARD_QUEUE 4
+#endif
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*
+ * Outbound report scheduler, sitting between host.c and the host driver.
+ *
+ * Keyboard reports are queued in order, as each of them can carry a key press the host has to see. Every other report
+ * type has a single slot, in which a report waits for its endpoint to be ready. Reports that only move the state on,
+ * such as mouse motion or digitizer and joystick positions, are coalesced with the one waiting. Any other change
+ * sends the waiting report first, blocking on the endpoint like an unscheduled send would.
+ *
+ * Pending reports are sent in priority order: keyboard, system, consumer, programmable button, mouse, digitizer and
+ * joystick. Reports of the same type always reach the host in order, reports of different types may not.
+ */
+
+void report_scheduler_send_keyboard(report_keyboard_t *report);
+void report_scheduler_send_nkro(report_nkro_t *report);
+void report_scheduler_send_extra(report_extra_t *report);
+void report_scheduler_send_programmable_button(report_programmable_button_t *report);
+void report_scheduler_send_mouse(report_mouse_t *report);
+void report_scheduler_send_digitizer(report_digitizer_t *report);
+void report_scheduler_send_joystick(report_joystick_t *report);
+
+/** \brief Sends the pending reports whose endpoint is ready, in priority order. */
+void report_scheduler_task(void);
+
+/** \brief Sends every pending report, waiting on busy endpoints. */
+void report_scheduler_flush(void);
+
+/** \brief Drops every pending report. */
+void report_scheduler_clear(void);
+
+bool report_scheduler_pending(void);
+
+#ifdef __cplusplus
+}
+#endif
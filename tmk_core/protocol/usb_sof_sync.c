@@ -0,0 +1,131 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <string.h>
+#include "usb_sof_sync.h"
+#include "debug.h"
+#include "timer.h"
+
+#ifndef USB_SOF_SYNC_PRINT_INTERVAL
+#    define USB_SOF_SYNC_PRINT_INTERVAL 10000
+#endif
+
+static struct {
+    bool     enabled;
+    bool     sof_seen;
+    uint32_t sof_us;       // time of the last start of frame
+    uint32_t frame_us_x16; // length of a frame on our clock, averaged over the last frames
+    uint16_t frame;        // frames seen so far, wrapping
+    uint16_t poll_phase;   // frame, modulo the polling interval, in which the host took the last report
+    uint16_t target_frame; // frame the last scan was aligned to
+    uint32_t scan_us;
+    uint32_t report_scan_us; // start of the scan the report in flight comes from
+    bool     report_in_flight;
+#ifdef DEBUG_USB_SOF_SYNC
+    uint32_t print_timer;
+#endif
+} sof_sync = {.enabled = true, .frame_us_x16 = USB_SOF_SYNC_FRAME_US * 16};
+
+static usb_sof_sync_stats_t stats = {.min_us = UINT16_MAX};
+
+void usb_sof_sync_enable(void) {
+    sof_sync.enabled = true;
+}
+
+void usb_sof_sync_disable(void) {
+    sof_sync.enabled = false;
+}
+
+bool usb_sof_sync_is_enabled(void) {
+    return sof_sync.enabled;
+}
+
+void usb_sof_sync_sof(uint32_t now_us) {
+    // Follow the host's clock, leaving out the frames missed while suspended or too busy to take the interrupt
+    uint32_t frame_us = now_us - sof_sync.sof_us;
+    if (sof_sync.sof_seen && frame_us > USB_SOF_SYNC_FRAME_US * 7 / 8 && frame_us < USB_SOF_SYNC_FRAME_US * 9 / 8) {
+        sof_sync.frame_us_x16 += frame_us - sof_sync.frame_us_x16 / 16;
+    }
+    sof_sync.sof_us   = now_us;
+    sof_sync.sof_seen = true;
+    sof_sync.frame++;
+}
+
+uint32_t usb_sof_sync_wait_us(uint32_t now_us) {
+    // Free run while disabled, suspended or disconnected
+    if (!sof_sync.enabled || !sof_sync.sof_seen || now_us - sof_sync.sof_us > 2 * USB_SOF_SYNC_FRAME_US) {
+        return 0;
+    }
+
+    // The host polls the endpoint early in every USB_POLLING_INTERVAL_MS-th frame: the one in progress has been polled
+    uint16_t frames_until = (sof_sync.poll_phase + USB_POLLING_INTERVAL_MS - sof_sync.frame % USB_POLLING_INTERVAL_MS - 1) % USB_POLLING_INTERVAL_MS + 1;
+    uint16_t target       = sof_sync.frame + frames_until;
+    // A fast loop comes back before the frame it scanned for has started, scan for the one after it instead
+    if ((int16_t)(target - sof_sync.target_frame) <= 0) {
+        target = sof_sync.target_frame + USB_POLLING_INTERVAL_MS;
+    }
+    sof_sync.target_frame = target;
+
+    int32_t wait = (int32_t)(sof_sync.sof_us + (uint16_t)(target - sof_sync.frame) * sof_sync.frame_us_x16 / 16 - USB_SOF_SYNC_LEAD_US - now_us);
+    if (wait < 0) {
+        stats.late_scans++;
+        return 0;
+    }
+    return wait;
+}
+
+void usb_sof_sync_scan_start(uint32_t now_us) {
+    sof_sync.scan_us = now_us;
+
+#ifdef DEBUG_USB_SOF_SYNC
+    if (timer_elapsed32(sof_sync.print_timer) >= USB_SOF_SYNC_PRINT_INTERVAL) {
+        sof_sync.print_timer = timer_read32();
+        usb_sof_sync_print_stats();
+    }
+#endif
+}
+
+void usb_sof_sync_report_queued(void) {
+    sof_sync.report_scan_us   = sof_sync.scan_us;
+    sof_sync.report_in_flight = true;
+}
+
+void usb_sof_sync_report_sent(uint32_t now_us) {
+    // Idle rate repeats of the last report carry nothing new
+    if (!sof_sync.report_in_flight) return;
+    sof_sync.report_in_flight = false;
+    sof_sync.poll_phase       = sof_sync.frame % USB_POLLING_INTERVAL_MS;
+
+    uint32_t latency = now_us - sof_sync.report_scan_us;
+    if (latency > UINT16_MAX) latency = UINT16_MAX;
+    uint32_t bucket = latency / USB_SOF_SYNC_HISTOGRAM_STEP_US;
+    if (bucket >= USB_SOF_SYNC_HISTOGRAM_BUCKETS) bucket = USB_SOF_SYNC_HISTOGRAM_BUCKETS - 1;
+
+    stats.count++;
+    stats.total_us += latency;
+    if (latency < stats.min_us) stats.min_us = latency;
+    if (latency > stats.max_us) stats.max_us = latency;
+    if (stats.buckets[bucket] < UINT16_MAX) stats.buckets[bucket]++;
+}
+
+const usb_sof_sync_stats_t *usb_sof_sync_get_stats(void) {
+    return &stats;
+}
+
+void usb_sof_sync_reset_stats(void) {
+    memset(&stats, 0, sizeof(stats));
+    stats.min_us = UINT16_MAX;
+}
+
+void usb_sof_sync_print_stats(void) {
+    if (!stats.count) {
+        dprintf("scan to IN: no reports, %lu late scans\n", stats.late_scans);
+        return;
+    }
+    dprintf("scan to IN: %lu reports, min %u avg %lu max %u us, %lu late scans\n", stats.count, stats.min_us, stats.total_us / stats.count, stats.max_us, stats.late_scans);
+    for (uint8_t i = 0; i < USB_SOF_SYNC_HISTOGRAM_BUCKETS; i++) {
+        if (stats.buckets[i]) {
+            dprintf("  %5u us%s: %u\n", i * USB_SOF_SYNC_HISTOGRAM_STEP_US, i == USB_SOF_SYNC_HISTOGRAM_BUCKETS - 1 ? "+" : "", stats.buckets[i]);
+        }
+    }
+}
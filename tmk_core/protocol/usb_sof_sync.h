@@ -0,0 +1,73 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#ifndef USB_POLLING_INTERVAL_MS
+#    define USB_POLLING_INTERVAL_MS 1
+#endif
+
+// How long before the host polls the keyboard endpoint the matrix scan starts, covering the scan and the report
+#ifndef USB_SOF_SYNC_LEAD_US
+#    define USB_SOF_SYNC_LEAD_US 250
+#endif
+
+#ifndef USB_SOF_SYNC_HISTOGRAM_STEP_US
+#    define USB_SOF_SYNC_HISTOGRAM_STEP_US 100
+#endif
+
+#ifndef USB_SOF_SYNC_HISTOGRAM_BUCKETS
+#    define USB_SOF_SYNC_HISTOGRAM_BUCKETS 16
+#endif
+
+#define USB_SOF_SYNC_FRAME_US 1000
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * Distribution of the time from the start of the matrix scan that produced a keyboard report to the completion of the
+ * IN transfer carrying it. The last bucket also counts every latency above it.
+ */
+typedef struct {
+    uint32_t count;
+    uint32_t total_us;
+    uint16_t min_us;
+    uint16_t max_us;
+    uint16_t buckets[USB_SOF_SYNC_HISTOGRAM_BUCKETS];
+    uint32_t late_scans; // scans that started after their target, the loop being busy for too long
+} usb_sof_sync_stats_t;
+
+void usb_sof_sync_enable(void);
+void usb_sof_sync_disable(void);
+bool usb_sof_sync_is_enabled(void);
+
+/** \brief Called on every start of frame, from the USB interrupt. */
+void usb_sof_sync_sof(uint32_t now_us);
+
+/**
+ * \brief Returns how long to wait before scanning the matrix, so that the scan starts `USB_SOF_SYNC_LEAD_US` before
+ * the next poll of the keyboard endpoint. Returns 0 when disabled, or while no start of frame is seen.
+ */
+uint32_t usb_sof_sync_wait_us(uint32_t now_us);
+
+/** \brief Marks the start of the matrix scan, which the reports sent until the next one come from. */
+void usb_sof_sync_scan_start(uint32_t now_us);
+
+/** \brief Called when a keyboard report transfer starts. */
+void usb_sof_sync_report_queued(void);
+
+/** \brief Called when a keyboard report transfer completes, from the USB interrupt. */
+void usb_sof_sync_report_sent(uint32_t now_us);
+
+const usb_sof_sync_stats_t *usb_sof_sync_get_stats(void);
+void                        usb_sof_sync_reset_stats(void);
+void                        usb_sof_sync_print_stats(void);
+
+#ifdef __cplusplus
+}
+#endif